@@ -40,6 +40,14 @@ namespace cv { namespace parallel {
  * - Configuration of compiler/linker options is responsibility of Application's scripts
  *
  *
+ * ### Work-stealing backend
+ *
+ * Builds with pthreads use the builtin `WORKSTEALING` backend by default: each worker thread owns a deque of tasks
+ * and idle threads steal work from other deques. Unlike the legacy pthreads thread pool, concurrent `parallel_for_()`
+ * calls from different application threads and nested calls are executed in parallel instead of falling back to
+ * serial execution. The legacy pool is used with `OPENCV_PARALLEL_PRIORITY_WORKSTEALING=0`.
+ *
+ *
  * ### Plugins support
  *
  * Runtime configuration options:
@@ -0,0 +1,82 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_UTILS_ARENA_HPP
+#define OPENCV_CORE_UTILS_ARENA_HPP
+
+#include "opencv2/core/utils/pooled_allocator.hpp"
+
+namespace cv { namespace utils {
+
+//! @addtogroup core_utils
+//! @{
+
+/** @brief Serves temporary buffers of OpenCV functions from a thread-local arena till the end of the scope.
+
+While the scope is active on the thread:
+- internal temporary buffers (utils::BufferArea) are taken from the arena of the thread with a pointer bump,
+  the memory is reclaimed at once when the outermost scope ends;
+- Mat temporaries use getPooledMatAllocator(), so their buffers are reused by the next iterations;
+- parallel_for_() stripes started by the thread run within scopes of the executing worker threads.
+
+Arena memory is kept between scopes: after the first iteration (warm-up) the arena has a single
+chunk of the peak size.
+
+@note Only temporaries allocated via utils::BufferArea (e.g. per-stripe buffers of Canny()) and Mat
+temporaries are served this way. AutoBuffer, filter engines and standard containers (e.g. in blur(),
+findContours() or ORB) still use the heap, so a scope doesn't make arbitrary code free of heap allocations.
+
+@code
+for (;;)
+{
+    cap >> frame;
+    cv::utils::ArenaScope arena;
+    cv::Canny(frame, edges, 50, 150);  // per-stripe buffers of Canny() are taken from the arena
+}
+@endcode
+
+Scopes can be nested, an inner scope reclaims its allocations on exit.
+Buffers allocated from the arena must not be used after the end of the scope.
+*/
+class CV_EXPORTS ArenaScope
+{
+public:
+    ArenaScope();
+    ~ArenaScope();
+
+    /** @brief Checks if the calling thread has an active scope. */
+    static bool isActive();
+
+    /** @brief Allocates memory from the arena of the calling thread.
+
+    Returns NULL if there is no active scope. The memory is released by deallocate() or at the end of the scope.
+    */
+    static void* allocate(size_t size, size_t alignment = CV_MALLOC_ALIGN);
+
+    /** @brief Returns the memory to the arena.
+
+    The space is reused immediately if it is the last allocation of the arena (allocations in the LIFO order).
+    */
+    static void deallocate(void* ptr, size_t size);
+
+    /** @brief Returns the size of arena memory of the calling thread. */
+    static size_t getReservedSize();
+
+    /** @brief Releases arena memory of the calling thread. Does nothing if a scope is active. */
+    static void releaseMemory();
+
+protected:
+    size_t markChunk, markUsed;  // the state of the arena to restore on exit
+    MatAllocatorScope matAllocatorScope;
+
+private:
+    ArenaScope(const ArenaScope&);  // disabled
+    ArenaScope& operator=(const ArenaScope&);  // disabled
+};
+
+//! @}
+
+}} // namespace
+
+#endif // OPENCV_CORE_UTILS_ARENA_HPP
@@ -20,6 +20,8 @@ This class allows to allocate one large memory block and split it into several s
 non-overlapping buffers. In safe mode each buffer allocation will be performed independently,
 this mode allows dynamic memory access instrumentation using valgrind or memory sanitizer.
 
+If ArenaScope is active on the thread, the memory block is taken from the arena of the thread.
+
 Safe mode can be explicitly switched ON in constructor. It will also be enabled when compiling with
 memory sanitizer support or in runtime with the environment variable `OPENCV_BUFFER_AREA_ALWAYS_SAFE`.
 
@@ -126,6 +128,7 @@ private:
     void * oneBuf;
     size_t totalSize;
     const bool safe;
+    bool arenaBuf;  // oneBuf is allocated by ArenaScope
 #endif
 };
 
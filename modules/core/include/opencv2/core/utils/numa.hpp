@@ -0,0 +1,40 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_UTILS_NUMA_HPP
+#define OPENCV_CORE_UTILS_NUMA_HPP
+
+#include "opencv2/core/mat.hpp"
+
+namespace cv { namespace utils {
+
+//! @addtogroup core_utils
+//! @{
+
+/** @brief Returns the number of NUMA nodes used by OpenCV.
+
+NUMA mode is opt-in: set `OPENCV_NUMA=1` environment variable. In this mode on multi-node Linux systems:
+- workers of the builtin thread pools are pinned to CPUs of NUMA nodes (round-robin);
+- the work-stealing backend assigns equal consecutive parts of parallel_for_() stripes to the nodes
+  (the first part goes to the first node and so on), idle threads steal from the same node first;
+- getNumaMatAllocator() becomes the default Mat allocator.
+
+Returns 1 if NUMA mode is disabled or the system has a single node.
+*/
+CV_EXPORTS int getNumaNodesCount();
+
+/** @brief Returns the allocator which distributes pages of Mat data between NUMA nodes.
+
+Buffers of `OPENCV_NUMA_ALLOCATOR_THRESHOLD` bytes and larger (2Mb by default) are split into
+getNumaNodesCount() equal parts, each part is placed on the node which processes the corresponding
+stripes of parallel_for_() over rows. Smaller buffers are allocated by Mat::getStdAllocator().
+Without NUMA mode this allocator is equal to the standard one.
+*/
+CV_EXPORTS MatAllocator* getNumaMatAllocator();
+
+//! @}
+
+}} // namespace
+
+#endif // OPENCV_CORE_UTILS_NUMA_HPP
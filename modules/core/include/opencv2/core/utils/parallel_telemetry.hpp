@@ -0,0 +1,82 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_UTILS_PARALLEL_TELEMETRY_HPP
+#define OPENCV_CORE_UTILS_PARALLEL_TELEMETRY_HPP
+
+#include "opencv2/core.hpp"
+
+namespace cv { namespace utils {
+
+//! @addtogroup core_utils
+//! @{
+
+/** @brief Measurements of a single parallel_for_() call */
+struct CV_EXPORTS ParallelJobTelemetry
+{
+    int rangeSize;         //!< size of the processed range
+    int stripes;           //!< number of stripes passed to the thread pool (1 for serial calls)
+    int callerStripes;     //!< stripes executed by the calling thread
+    bool serial;           //!< all the stripes are executed by the calling thread
+    bool serialFallback;   //!< parallel execution is declined: nested call or the thread pool is busy
+    double wallTimeMs;     //!< time from the call to the return
+};
+
+/** @brief Measurements of a thread pool worker
+ *
+ * Application threads which call parallel_for_() are not listed.
+ */
+struct CV_EXPORTS ParallelWorkerTelemetry
+{
+    int id;                   //!< worker index (cv::getThreadNum() - 1)
+    int64 tasks;              //!< executed tasks (ranges of stripes)
+    int64 steals;             //!< tasks taken from queues of other threads
+    int64 wakeups;            //!< wake-ups from the sleeping state
+    double busyMs;            //!< time of tasks execution
+    double idleMs;            //!< time of active waiting and sleeping
+    double wakeLatencyAvgUs;  //!< average time from the notification to the wake-up
+    double wakeLatencyMaxUs;  //!< maximal time from the notification to the wake-up
+};
+
+/** @brief Aggregated measurements of parallel_for_() calls since the last reset */
+struct CV_EXPORTS ParallelTelemetry
+{
+    String backend;                //!< name of the parallel backend
+    int numThreads;                //!< cv::getNumThreads()
+    int64 jobs;                    //!< all parallel_for_() calls
+    int64 parallelJobs;            //!< calls passed to the thread pool
+    int64 serialFallbacks;         //!< calls executed serially due to nesting or the busy thread pool
+    int64 oversubscriptionEvents;  //!< calls started while other application threads run parallel jobs
+                                   //!< and the number of threads exceeds the number of CPUs
+    int64 stripes;                 //!< stripes of all the parallel calls
+    double totalTimeMs;            //!< total wall time of the calls (nested calls are counted too)
+    double maxTimeMs;              //!< maximal wall time of a call
+    std::vector<ParallelWorkerTelemetry> workers;  //!< measurements of the thread pool workers
+    std::vector<ParallelJobTelemetry> recentJobs;  //!< the last calls, the oldest go first
+};
+
+/** @brief Enables or disables collecting of parallel_for_() telemetry.
+ *
+ * Telemetry is disabled by default, `OPENCV_PARALLEL_TELEMETRY=1` enables it on startup.
+ * The number of stored recent jobs is controlled by `OPENCV_PARALLEL_TELEMETRY_HISTORY` (256 by default).
+ * Disabled telemetry costs a single atomic load per parallel_for_() call.
+ *
+ * @note Workers measurements are provided by the builtin thread pools only (not by TBB/OpenMP backends).
+ */
+CV_EXPORTS void setParallelTelemetryEnabled(bool enabled);
+
+/** @brief Returns true if parallel_for_() telemetry is collected */
+CV_EXPORTS bool isParallelTelemetryEnabled();
+
+/** @brief Returns the collected telemetry */
+CV_EXPORTS void getParallelTelemetry(ParallelTelemetry& telemetry);
+
+/** @brief Resets all the counters and the history of jobs */
+CV_EXPORTS void resetParallelTelemetry();
+
+//! @}
+
+}} // namespace
+
+#endif // OPENCV_CORE_UTILS_PARALLEL_TELEMETRY_HPP
@@ -0,0 +1,84 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_UTILS_POOLED_ALLOCATOR_HPP
+#define OPENCV_CORE_UTILS_POOLED_ALLOCATOR_HPP
+
+#include "opencv2/core/mat.hpp"
+
+namespace cv { namespace utils {
+
+//! @addtogroup core_utils
+//! @{
+
+/** @brief Statistics of the pooled Mat allocator. */
+struct CV_EXPORTS PooledMatAllocatorStats
+{
+    int64 hits;           //!< allocations served from the pool
+    int64 misses;         //!< allocations which required a new buffer
+    size_t bytesHeld;     //!< memory of free buffers kept by the pool (including thread caches)
+    size_t bytesInUse;    //!< memory of buffers owned by Mat objects
+    size_t maxBytesHeld;  //!< limit of bytesHeld
+};
+
+/** @brief Returns the allocator which reuses freed Mat buffers.
+
+Buffer sizes are rounded up to size classes (4 classes per power of 2, the overhead is 25% at most),
+freed buffers are kept in per-class lists and reused by the next allocations of the same class.
+Small buffers (up to 256Kb) are cached by the freeing thread first, so hot loops don't take locks.
+This avoids page faults and `malloc()` overhead of large per-frame temporaries.
+
+The pool keeps at most `OPENCV_POOLED_ALLOCATOR_MAX_HELD` bytes (512Mb by default) of free buffers.
+Set `OPENCV_POOLED_ALLOCATOR=1` environment variable to use this allocator by default,
+or use Mat::setDefaultAllocator() / MatAllocatorScope.
+
+getBufferPoolController() of this allocator provides the same limit and trim controls.
+*/
+CV_EXPORTS MatAllocator* getPooledMatAllocator();
+
+/** @brief Returns statistics of getPooledMatAllocator(). */
+CV_EXPORTS void getPooledMatAllocatorStats(PooledMatAllocatorStats& stats);
+
+/** @brief Resets hits and misses counters of getPooledMatAllocator(). */
+CV_EXPORTS void resetPooledMatAllocatorStats();
+
+/** @brief Releases free buffers of getPooledMatAllocator().
+
+@param maxBytesHeld amount of free memory which is kept by the pool (0 releases all buffers).
+Buffers of other threads caches are released by these threads on their next allocation.
+The limit of the pool is not changed, use `getPooledMatAllocator()->getBufferPoolController()->setMaxReservedSize()`.
+*/
+CV_EXPORTS void trimPooledMatAllocator(size_t maxBytesHeld = 0);
+
+/** @brief Overrides Mat::getDefaultAllocator() for the current thread till the end of the scope.
+
+@code
+{
+    cv::utils::MatAllocatorScope scope(cv::utils::getPooledMatAllocator());
+    for (;;)
+        process(frame);  // temporaries of this thread reuse pooled buffers
+}
+@endcode
+
+Scopes can be nested. Worker threads of parallel_for_() are not affected.
+*/
+class CV_EXPORTS MatAllocatorScope
+{
+public:
+    explicit MatAllocatorScope(MatAllocator* allocator);
+    ~MatAllocatorScope();
+
+protected:
+    MatAllocator* const prev;
+
+private:
+    MatAllocatorScope(const MatAllocatorScope&);  // disabled
+    MatAllocatorScope& operator=(const MatAllocatorScope&);  // disabled
+};
+
+//! @}
+
+}} // namespace
+
+#endif // OPENCV_CORE_UTILS_POOLED_ALLOCATOR_HPP
@@ -0,0 +1,182 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include <opencv2/core/utils/arena.hpp>
+
+namespace cv { namespace utils {
+
+namespace arena {
+
+static const size_t MIN_CHUNK_SIZE = 64 << 10;
+
+/** Bump allocator of a thread. Chunks are used in order, the space is reclaimed by restoring of a mark. */
+struct Arena
+{
+    struct Chunk
+    {
+        uchar* data;
+        size_t size;
+        size_t used;
+    };
+
+    Arena() : depth(0), current(0) {}
+    ~Arena()
+    {
+        for (size_t i = 0; i < chunks.size(); i++)
+            fastFree(chunks[i].data);
+    }
+
+    void* allocate(size_t size, size_t alignment)
+    {
+        CV_DbgAssert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+        for (; current < chunks.size(); current++)
+        {
+            Chunk& c = chunks[current];
+            const size_t start = alignSize((size_t)c.data + c.used, alignment) - (size_t)c.data;
+            if (start + size <= c.size)
+            {
+                c.used = start + size;
+                return c.data + start;
+            }
+            if (current + 1 == chunks.size())
+                break;
+        }
+        // warm-up: the arena grows
+        const size_t chunkSize = std::max(std::max(size + alignment, getReservedSize()), MIN_CHUNK_SIZE);
+        Chunk c;
+        c.data = (uchar*)fastMalloc(chunkSize);
+        c.size = chunkSize;
+        c.used = 0;
+        chunks.push_back(c);
+        current = chunks.size() - 1;
+        return allocate(size, alignment);
+    }
+
+    void deallocate(void* ptr, size_t size)
+    {
+        if (current >= chunks.size())
+            return;
+        Chunk& c = chunks[current];
+        if ((uchar*)ptr >= c.data && (uchar*)ptr + size == c.data + c.used)
+            c.used = (uchar*)ptr - c.data;
+    }
+
+    void restore(size_t markChunk, size_t markUsed)
+    {
+        for (size_t i = markChunk; i < chunks.size(); i++)
+            chunks[i].used = i == markChunk ? markUsed : 0;
+        current = markChunk;
+        if (depth == 0 && chunks.size() > 1)
+        {
+            // a single chunk of the peak size serves the next iterations
+            const size_t size = getReservedSize();
+            releaseMemory();
+            Chunk c;
+            c.data = (uchar*)fastMalloc(size);
+            c.size = size;
+            c.used = 0;
+            chunks.push_back(c);
+        }
+    }
+
+    size_t getReservedSize() const
+    {
+        size_t size = 0;
+        for (size_t i = 0; i < chunks.size(); i++)
+            size += chunks[i].size;
+        return size;
+    }
+
+    void releaseMemory()
+    {
+        CV_Assert(depth == 0);
+        for (size_t i = 0; i < chunks.size(); i++)
+            fastFree(chunks[i].data);
+        chunks.clear();
+        current = 0;
+    }
+
+    int depth;  // nesting level of scopes
+    std::vector<Chunk> chunks;
+    size_t current;
+};
+
+// trivially destructible, so it is valid during destruction of other thread-local objects
+static thread_local Arena* currentArena = NULL;
+
+struct ArenaHolder
+{
+    ~ArenaHolder() { currentArena = NULL; }
+    Arena arena;
+};
+
+static Arena& getArena()
+{
+    if (!currentArena)
+    {
+        static thread_local ArenaHolder holder;
+        currentArena = &holder.arena;
+    }
+    return *currentArena;
+}
+
+}  // namespace arena
+
+ArenaScope::ArenaScope()
+    : markChunk(0), markUsed(0)
+    , matAllocatorScope(getPooledMatAllocator())
+{
+    arena::Arena& a = arena::getArena();
+    markChunk = a.current;
+    markUsed = a.current < a.chunks.size() ? a.chunks[a.current].used : 0;
+    a.depth++;
+}
+
+ArenaScope::~ArenaScope()
+{
+    arena::Arena* a = arena::currentArena;
+    if (!a)
+        return;
+    CV_DbgAssert(a->depth > 0);
+    a->depth--;
+    a->restore(markChunk, markUsed);
+}
+
+bool ArenaScope::isActive()
+{
+    const arena::Arena* a = arena::currentArena;
+    return a && a->depth > 0;
+}
+
+void* ArenaScope::allocate(size_t size, size_t alignment)
+{
+    arena::Arena* a = arena::currentArena;
+    if (!a || a->depth == 0)
+        return NULL;
+    return a->allocate(size, alignment);
+}
+
+void ArenaScope::deallocate(void* ptr, size_t size)
+{
+    arena::Arena* a = arena::currentArena;
+    if (a && ptr)
+        a->deallocate(ptr, size);
+}
+
+size_t ArenaScope::getReservedSize()
+{
+    const arena::Arena* a = arena::currentArena;
+    return a ? a->getReservedSize() : 0;
+}
+
+void ArenaScope::releaseMemory()
+{
+    arena::Arena* a = arena::currentArena;
+    if (a && a->depth == 0)
+        a->releaseMemory();
+}
+
+}}  // namespace cv::utils
@@ -4,6 +4,7 @@
 
 #include "opencv2/core/utils/buffer_area.private.hpp"
 #include "opencv2/core/utils/configuration.private.hpp"
+#include "opencv2/core/utils/arena.hpp"
 
 #ifndef OPENCV_ENABLE_MEMORY_SANITIZER
 static bool CV_BUFFER_AREA_OVERRIDE_SAFE_MODE =
@@ -87,7 +88,8 @@ private:
 BufferArea::BufferArea(bool safe_) :
     oneBuf(0),
     totalSize(0),
-    safe(safe_ || CV_BUFFER_AREA_OVERRIDE_SAFE_MODE)
+    safe(safe_ || CV_BUFFER_AREA_OVERRIDE_SAFE_MODE),
+    arenaBuf(false)
 {
     // nothing
 }
@@ -146,7 +148,10 @@ void BufferArea::commit()
         CV_Assert(totalSize > 0);
         CV_Assert(oneBuf == NULL);
         CV_Assert(!blocks.empty());
-        oneBuf = fastMalloc(totalSize);
+        oneBuf = ArenaScope::allocate(totalSize);
+        arenaBuf = oneBuf != NULL;
+        if (!arenaBuf)
+            oneBuf = fastMalloc(totalSize);
         void * ptr = oneBuf;
         for(std::vector<Block>::const_iterator i = blocks.begin(); i != blocks.end(); ++i)
         {
@@ -166,8 +171,12 @@ void BufferArea::release()
 #ifndef OPENCV_ENABLE_MEMORY_SANITIZER
     if (oneBuf)
     {
-        fastFree(oneBuf);
+        if (arenaBuf)
+            ArenaScope::deallocate(oneBuf, totalSize);
+        else
+            fastFree(oneBuf);
         oneBuf = 0;
+        arenaBuf = false;
     }
 #endif
 }
@@ -4,6 +4,11 @@
 
 #include "precomp.hpp"
 #include "bufferpool.impl.hpp"
+#include "numa.hpp"
+
+#include <opencv2/core/utils/numa.hpp>
+#include <opencv2/core/utils/pooled_allocator.hpp>
+#include <opencv2/core/utils/configuration.private.hpp>
 
 namespace cv {
 
@@ -176,16 +181,31 @@ public:
     }
 };
 
+static
+MatAllocator* initDefaultAllocator()
+{
+    if (utils::getConfigurationParameterBool("OPENCV_POOLED_ALLOCATOR", false))
+        return utils::getPooledMatAllocator();
+    // NUMA mode (opt-in) places large buffers on the nodes which process them
+    if (utils::numa::getNodesCount() > 1)
+        return utils::getNumaMatAllocator();
+    return Mat::getStdAllocator();
+}
+
 static
 MatAllocator*& getDefaultAllocatorMatRef()
 {
-    static MatAllocator* g_matAllocator = Mat::getStdAllocator();
+    static MatAllocator* g_matAllocator = initDefaultAllocator();
     return g_matAllocator;
 }
 
+// overridden by MatAllocatorScope
+static thread_local MatAllocator* g_threadMatAllocator = NULL;
+
 MatAllocator* Mat::getDefaultAllocator()
 {
-    return getDefaultAllocatorMatRef();
+    MatAllocator* allocator = g_threadMatAllocator;
+    return allocator ? allocator : getDefaultAllocatorMatRef();
 }
 
 void Mat::setDefaultAllocator(MatAllocator* allocator)
@@ -198,6 +218,17 @@ MatAllocator* Mat::getStdAllocator()
     CV_SINGLETON_LAZY_INIT(MatAllocator, new StdMatAllocator())
 }
 
+utils::MatAllocatorScope::MatAllocatorScope(MatAllocator* allocator)
+    : prev(g_threadMatAllocator)
+{
+    g_threadMatAllocator = allocator;
+}
+
+utils::MatAllocatorScope::~MatAllocatorScope()
+{
+    g_threadMatAllocator = prev;
+}
+
 //==================================================================================================
 
 bool MatSize::operator==(const MatSize& sz) const CV_NOEXCEPT
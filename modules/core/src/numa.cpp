@@ -0,0 +1,266 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include "numa.hpp"
+
+#include <opencv2/core/utils/numa.hpp>
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/logger.hpp>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <errno.h>
+#include <fstream>
+#if defined(SYS_mbind) && defined(CPU_SETSIZE)
+#define OPENCV_HAVE_NUMA 1
+#endif
+#endif
+
+namespace cv { namespace utils { namespace numa {
+
+#ifdef OPENCV_HAVE_NUMA
+
+struct Node
+{
+    int id;  // system node ID
+    std::vector<int> cpus;
+};
+
+struct Topology
+{
+    std::vector<Node> nodes;  // nodes with CPUs available for the process
+    std::vector<int> cpuNode;  // CPU => index of node
+};
+
+// parses lists of form "0-1,3,5-7"
+static std::vector<int> parseList(const std::string& str)
+{
+    std::vector<int> result;
+    std::istringstream ss(str);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        int start = 0, end = 0;
+        const int n = sscanf(item.c_str(), "%d-%d", &start, &end);
+        if (n < 1)
+            continue;
+        if (n == 1)
+            end = start;
+        for (int i = start; i <= end; i++)
+            result.push_back(i);
+    }
+    return result;
+}
+
+static std::string readLine(const std::string& filename)
+{
+    std::ifstream f(filename.c_str());
+    std::string line;
+    std::getline(f, line);
+    return line;
+}
+
+static Topology detectTopology()
+{
+    Topology t;
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return t;
+    const std::vector<int> online = parseList(readLine("/sys/devices/system/node/online"));
+    for (size_t i = 0; i < online.size(); i++)
+    {
+        Node node;
+        node.id = online[i];
+        const std::vector<int> cpus = parseList(readLine(cv::format("/sys/devices/system/node/node%d/cpulist", node.id)));
+        for (size_t k = 0; k < cpus.size(); k++)
+        {
+            if (cpus[k] < CPU_SETSIZE && CPU_ISSET(cpus[k], &allowed))
+                node.cpus.push_back(cpus[k]);
+        }
+        if (node.cpus.empty())
+            continue;  // memory-only node or CPUs are not available for the process
+        for (size_t k = 0; k < node.cpus.size(); k++)
+        {
+            if ((int)t.cpuNode.size() <= node.cpus[k])
+                t.cpuNode.resize(node.cpus[k] + 1, 0);
+            t.cpuNode[node.cpus[k]] = (int)t.nodes.size();
+        }
+        t.nodes.push_back(node);
+    }
+    return t;
+}
+
+static Topology initTopology()
+{
+    if (!utils::getConfigurationParameterBool("OPENCV_NUMA", false))
+        return Topology();
+    Topology t = detectTopology();
+    CV_LOG_INFO(NULL, "NUMA mode: " << t.nodes.size() << " node(s) with available CPUs");
+    return t.nodes.size() >= 2 ? t : Topology();
+}
+
+static const Topology& getTopology()
+{
+    static Topology t = initTopology();
+    return t;
+}
+
+int getNodesCount()
+{
+    return std::max((int)getTopology().nodes.size(), 1);
+}
+
+int getCurrentNode()
+{
+    const Topology& t = getTopology();
+    if (t.nodes.empty())
+        return 0;
+    const int cpu = sched_getcpu();
+    return (cpu >= 0 && cpu < (int)t.cpuNode.size()) ? t.cpuNode[cpu] : 0;
+}
+
+void bindCurrentThread(int node)
+{
+    const Topology& t = getTopology();
+    if (node < 0 || node >= (int)t.nodes.size())
+        return;
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (size_t i = 0; i < t.nodes[node].cpus.size(); i++)
+        CPU_SET(t.nodes[node].cpus[i], &cpus);
+    if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0)
+    {
+        CV_LOG_DEBUG(NULL, "NUMA: can't bind thread to node " << t.nodes[node].id << ": errno=" << errno);
+    }
+}
+
+void bindMemory(void* addr, size_t size, int node)
+{
+    const Topology& t = getTopology();
+    if (node < 0 || node >= (int)t.nodes.size() || size == 0)
+        return;
+    const int id = t.nodes[node].id;
+    const int MPOL_PREFERRED_ = 1;
+    const int maxNodes = 1024;
+    unsigned long mask[maxNodes / (8 * sizeof(unsigned long))] = {};
+    if (id >= maxNodes)
+        return;
+    mask[id / (8 * sizeof(unsigned long))] |= 1ul << (id % (8 * sizeof(unsigned long)));
+    // the kernel reads (maxnode - 1) bits of the mask
+    if (syscall(SYS_mbind, addr, size, MPOL_PREFERRED_, mask, (unsigned long)maxNodes + 1, 0) != 0)
+    {
+        CV_LOG_DEBUG(NULL, "NUMA: mbind() failed for node " << id << ": errno=" << errno);
+    }
+}
+
+#else  // OPENCV_HAVE_NUMA
+
+int getNodesCount() { return 1; }
+int getCurrentNode() { return 0; }
+void bindCurrentThread(int /*node*/) {}
+void bindMemory(void* /*addr*/, size_t /*size*/, int /*node*/) {}
+
+#endif  // OPENCV_HAVE_NUMA
+
+#ifdef OPENCV_HAVE_NUMA
+
+/** Places pages of large buffers on NUMA nodes in the proportion of parallel_for_() stripes */
+class NumaMatAllocator CV_FINAL : public MatAllocator
+{
+public:
+    NumaMatAllocator()
+        : threshold(utils::getConfigurationParameterSizeT("OPENCV_NUMA_ALLOCATOR_THRESHOLD", 2 << 20))
+        , pageSize((size_t)sysconf(_SC_PAGESIZE))
+    {
+        // nothing
+    }
+
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data0, size_t* step, AccessFlag flags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        const int nodes = getNodesCount();
+        size_t total = CV_ELEM_SIZE(type);
+        for (int i = dims - 1; i >= 0; i--)
+            total *= sizes[i];
+        if (data0 || nodes < 2 || total < threshold)
+            return Mat::getStdAllocator()->allocate(dims, sizes, type, data0, step, flags, usageFlags);
+
+        const size_t mapped = alignSize(total, pageSize);
+        void* data = mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (data == MAP_FAILED)
+            return Mat::getStdAllocator()->allocate(dims, sizes, type, data0, step, flags, usageFlags);
+        // pages are not touched yet, so the policy is applied on the first access
+        for (int k = 0; k < nodes; k++)
+        {
+            const size_t start = alignSize(mapped / nodes * k, pageSize);
+            const size_t end = k == nodes - 1 ? mapped : alignSize(mapped / nodes * (k + 1), pageSize);
+            if (start < end)
+                bindMemory((uchar*)data + start, end - start, k);
+        }
+
+        if (step)
+        {
+            size_t sz = CV_ELEM_SIZE(type);
+            for (int i = dims - 1; i >= 0; i--)
+            {
+                step[i] = sz;
+                sz *= sizes[i];
+            }
+        }
+        UMatData* u = new UMatData(this);
+        u->data = u->origdata = (uchar*)data;
+        u->size = total;
+        return u;
+    }
+
+    bool allocate(UMatData* u, AccessFlag /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        return u != NULL;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if (!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        munmap(u->origdata, alignSize(u->size, pageSize));
+        u->origdata = 0;
+        delete u;
+    }
+
+protected:
+    const size_t threshold;
+    const size_t pageSize;
+};
+
+#endif  // OPENCV_HAVE_NUMA
+
+}}  // namespace utils::numa
+
+namespace utils {
+
+int getNumaNodesCount()
+{
+    return numa::getNodesCount();
+}
+
+MatAllocator* getNumaMatAllocator()
+{
+#ifdef OPENCV_HAVE_NUMA
+    CV_SINGLETON_LAZY_INIT(MatAllocator, new numa::NumaMatAllocator())
+#else
+    return Mat::getStdAllocator();
+#endif
+}
+
+}  // namespace utils
+}  // namespace cv
@@ -0,0 +1,23 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#ifndef OPENCV_CORE_SRC_NUMA_HPP
+#define OPENCV_CORE_SRC_NUMA_HPP
+
+namespace cv { namespace utils { namespace numa {
+
+/** Number of used NUMA nodes: 1 if NUMA mode is disabled. Nodes are indexed from 0 (not system node IDs) */
+int getNodesCount();
+
+/** Node of the CPU which executes the calling thread (0 if unknown) */
+int getCurrentNode();
+
+/** Restricts the calling thread to CPUs of the node */
+void bindCurrentThread(int node);
+
+/** Sets the preferred node of memory pages (the range must be page-aligned) */
+void bindMemory(void* addr, size_t size, int node);
+
+}}}  // namespace
+
+#endif // OPENCV_CORE_SRC_NUMA_HPP
@@ -44,9 +44,11 @@
 
 #include <opencv2/core/utils/configuration.private.hpp>
 #include <opencv2/core/utils/trace.private.hpp>
+#include <opencv2/core/utils/arena.hpp>
 
 #include "opencv2/core/parallel/parallel_backend.hpp"
 #include "parallel/parallel.hpp"
+#include "parallel/parallel_telemetry.hpp"
 
 #if defined _WIN32 || defined WINCE
     #include <windows.h>
@@ -202,7 +204,7 @@ namespace {
     {
     public:
         ParallelLoopBodyWrapperContext(const cv::ParallelLoopBody& _body, const cv::Range& _r, double _nstripes) :
-            is_rng_used(false), hasException(false)
+            is_rng_used(false), telemetry(NULL), useArena(utils::ArenaScope::isActive()), hasException(false)
         {
 
             body = &_body;
@@ -269,6 +271,8 @@ namespace {
 #ifdef ENABLE_INSTRUMENTATION
         cv::instr::InstrNode *pThreadRoot;
 #endif
+        parallel::telemetry::JobScope* telemetry;
+        bool useArena;  // the caller has active ArenaScope
         bool hasException;
 #if CV__EXCEPTION_PTR
         std::exception_ptr pException;
@@ -355,9 +359,21 @@ namespace {
             CV_TRACE_ARG_VALUE(range_end, "range.end", (int64)r.end);
 #endif
 
+            if (ctx.telemetry)
+                ctx.telemetry->onStripes(sr.end - sr.start);
+
             try
             {
-                (*ctx.body)(r);
+                if (ctx.useArena && !utils::ArenaScope::isActive())
+                {
+                    // temporaries of worker threads are served by their arenas
+                    utils::ArenaScope arena;
+                    (*ctx.body)(r);
+                }
+                else
+                {
+                    (*ctx.body)(r);
+                }
             }
 #if CV__EXCEPTION_PTR
             catch (...)
@@ -502,7 +518,8 @@ static SchedPtr pplScheduler;
 
 /* ================================   parallel_for_  ================================ */
 
-static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes); // forward declaration
+static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes,
+                              parallel::telemetry::JobScope& telemetry); // forward declaration
 
 void parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes)
 {
@@ -517,6 +534,15 @@ void parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, dou
     if (range.empty())
         return;
 
+    parallel::telemetry::JobScope telemetry(range);
+
+    if (parallel::isNestedParallelForSupported(parallel::getCurrentParallelForAPI().get()))
+    {
+        // concurrent and nested calls are scheduled by the backend
+        parallel_for_impl(range, body, nstripes, telemetry);
+        return;
+    }
+
     static std::atomic<bool> flagNestedParallelFor(false);
     bool isNotNestedRegion = !flagNestedParallelFor.load();
     if (isNotNestedRegion)
@@ -525,7 +551,7 @@ void parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, dou
     {
         try
         {
-            parallel_for_impl(range, body, nstripes);
+            parallel_for_impl(range, body, nstripes, telemetry);
             flagNestedParallelFor = false;
         }
         catch (...)
@@ -537,6 +563,7 @@ void parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, dou
     else // nested parallel_for_() calls are not parallelized
     {
         CV_UNUSED(nstripes);
+        parallel::telemetry::onSerialFallback();
         body(range);
     }
 }
@@ -549,7 +576,8 @@ void parallel_for_cb(int start, int end, void* data)
     body(Range(start, end));
 }
 
-static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes)
+static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes,
+                              parallel::telemetry::JobScope& telemetry)
 {
     using namespace cv::parallel;
     if ((numThreads < 0 || numThreads > 1) && range.end - range.start > 1)
@@ -562,6 +590,11 @@ static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody
             body(range);
             return;
         }
+        if (telemetry.isActive())
+        {
+            ctx.telemetry = &telemetry;
+            telemetry.setParallel(stripeRange.end - stripeRange.start);
+        }
 
         std::shared_ptr<ParallelForAPI>& api = getCurrentParallelForAPI();
         if (api)
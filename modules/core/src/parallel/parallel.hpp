@@ -5,6 +5,7 @@
 #define OPENCV_CORE_SRC_PARALLEL_PARALLEL_HPP
 
 #include "opencv2/core/parallel/parallel_backend.hpp"
+#include "opencv2/core/utils/parallel_telemetry.hpp"
 
 namespace cv { namespace parallel {
 
@@ -12,6 +13,12 @@ extern int numThreads;
 
 std::shared_ptr<ParallelForAPI>& getCurrentParallelForAPI();
 
+/** Backend executes concurrent and nested parallel_for_() calls in parallel (no need to serialize them) */
+bool isNestedParallelForSupported(const ParallelForAPI* api);
+
+/** Collects (or resets if `reset` is true) telemetry of workers of the work-stealing backend. Returns false for other backends */
+bool getWorkStealingTelemetry(const ParallelForAPI* api, std::vector<utils::ParallelWorkerTelemetry>* workers, bool reset);
+
 #ifndef BUILD_PLUGIN
 
 #ifdef HAVE_TBB
@@ -22,6 +29,10 @@ std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendTBB();
 std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendOpenMP();
 #endif
 
+#if defined(HAVE_PTHREADS_PF) && !defined(OPENCV_DISABLE_THREAD_SUPPORT)
+std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendWorkStealing();
+#endif
+
 #endif  // BUILD_PLUGIN
 
 }}  // namespace
@@ -0,0 +1,249 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "../precomp.hpp"
+
+#include "parallel.hpp"
+#include "parallel_telemetry.hpp"
+#include "../parallel_impl.hpp"
+
+#include <opencv2/core/utils/configuration.private.hpp>
+
+#include <mutex>
+
+namespace cv { namespace parallel { namespace telemetry {
+
+std::atomic<bool> g_enabled(utils::getConfigurationParameterBool("OPENCV_PARALLEL_TELEMETRY", false));
+
+static size_t getHistorySize()
+{
+    static size_t size = utils::getConfigurationParameterSizeT("OPENCV_PARALLEL_TELEMETRY_HISTORY", 256);
+    return size;
+}
+
+static thread_local JobScope* currentJob = NULL;
+
+static void updateMax(std::atomic<int64>& value, int64 v)
+{
+    int64 current = value.load(std::memory_order_relaxed);
+    while (current < v && !value.compare_exchange_weak(current, v, std::memory_order_relaxed))
+    {
+        // retry
+    }
+}
+
+struct Counters
+{
+    Counters() : activeCallers(0) { reset(); }
+
+    void reset()
+    {
+        jobs = 0;
+        parallelJobs = 0;
+        serialFallbacks = 0;
+        oversubscriptionEvents = 0;
+        stripes = 0;
+        totalTicks = 0;
+        maxTicks = 0;
+        std::lock_guard<std::mutex> lock(mutex);
+        history.clear();
+        historyHead = 0;
+    }
+
+    void addJob(const utils::ParallelJobTelemetry& job, int64 ticks)
+    {
+        jobs.fetch_add(1, std::memory_order_relaxed);
+        totalTicks.fetch_add(ticks, std::memory_order_relaxed);
+        updateMax(maxTicks, ticks);
+
+        const size_t historySize = getHistorySize();
+        if (historySize == 0)
+            return;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (history.size() < historySize)
+        {
+            history.push_back(job);
+        }
+        else
+        {
+            history[historyHead] = job;
+            historyHead = (historyHead + 1) % history.size();
+        }
+    }
+
+    std::atomic<int64> jobs, parallelJobs, serialFallbacks, oversubscriptionEvents, stripes, totalTicks, maxTicks;
+    std::atomic<int> activeCallers;  // application threads which run parallel jobs (live value, not reset)
+
+    std::mutex mutex;
+    std::vector<utils::ParallelJobTelemetry> history;  // ring buffer
+    size_t historyHead;  // the oldest entry of the full buffer
+};
+
+static Counters& getCounters()
+{
+    CV_SINGLETON_LAZY_INIT_REF(Counters, new Counters())
+}
+
+
+void WorkerCounters::reset()
+{
+    busyTicks = 0;
+    idleTicks = 0;
+    tasks = 0;
+    steals = 0;
+    wakeups = 0;
+    wakeLatencyTicks = 0;
+    maxWakeLatencyTicks = 0;
+}
+
+void WorkerCounters::addBusy(int64 ticks, int64 tasks_)
+{
+    busyTicks.fetch_add(ticks, std::memory_order_relaxed);
+    tasks.fetch_add(tasks_, std::memory_order_relaxed);
+}
+
+void WorkerCounters::addWakeup(int64 latencyTicks)
+{
+    wakeups.fetch_add(1, std::memory_order_relaxed);
+    latencyTicks = std::max(latencyTicks, (int64)0);
+    wakeLatencyTicks.fetch_add(latencyTicks, std::memory_order_relaxed);
+    updateMax(maxWakeLatencyTicks, latencyTicks);
+}
+
+void WorkerCounters::get(utils::ParallelWorkerTelemetry& stat, int id) const
+{
+    const double msPerTick = 1000. / getTickFrequency();
+    stat.id = id;
+    stat.tasks = tasks.load();
+    stat.steals = steals.load();
+    stat.wakeups = wakeups.load();
+    stat.busyMs = busyTicks.load() * msPerTick;
+    stat.idleMs = idleTicks.load() * msPerTick;
+    stat.wakeLatencyAvgUs = stat.wakeups > 0 ? wakeLatencyTicks.load() * msPerTick * 1000. / stat.wakeups : 0.;
+    stat.wakeLatencyMaxUs = maxWakeLatencyTicks.load() * msPerTick * 1000.;
+}
+
+
+void JobScope::start(const Range& range)
+{
+    parallel = false;
+    external = false;
+    caller = utils::getThreadID();
+    callerStripes = 0;
+    stat = utils::ParallelJobTelemetry();
+    stat.rangeSize = range.size();
+    stat.stripes = 1;
+    outer = currentJob;
+    currentJob = this;
+    startTick = getTickCount();
+}
+
+void JobScope::startParallel(int stripes)
+{
+    Counters& c = getCounters();
+    parallel = true;
+    stat.stripes = stripes;
+    c.parallelJobs.fetch_add(1, std::memory_order_relaxed);
+    c.stripes.fetch_add(stripes, std::memory_order_relaxed);
+
+    // calls from worker threads (nested jobs) don't add threads
+    external = cv::getThreadNum() == 0;
+    if (external)
+    {
+        const int callers = c.activeCallers.fetch_add(1) + 1;
+        if (callers > 1 && cv::getNumThreads() - 1 + callers > cv::getNumberOfCPUs())
+            c.oversubscriptionEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void JobScope::onStripes(int count)
+{
+    if (utils::getThreadID() == caller)
+        callerStripes.fetch_add(count, std::memory_order_relaxed);
+}
+
+void JobScope::finish()
+{
+    const int64 ticks = getTickCount() - startTick;
+    Counters& c = getCounters();
+    if (external)
+        c.activeCallers.fetch_sub(1);
+    currentJob = outer;
+
+    stat.callerStripes = parallel ? callerStripes.load() : 1;
+    stat.serial = stat.callerStripes >= stat.stripes;
+    stat.wallTimeMs = ticks * 1000. / getTickFrequency();
+    c.addJob(stat, ticks);
+}
+
+void onSerialFallback()
+{
+    if (!isEnabled())
+        return;
+    getCounters().serialFallbacks.fetch_add(1, std::memory_order_relaxed);
+    if (currentJob)
+        currentJob->stat.serialFallback = true;
+}
+
+
+static void getWorkersTelemetry(std::vector<utils::ParallelWorkerTelemetry>* workers, bool reset)
+{
+    const std::shared_ptr<ParallelForAPI>& api = getCurrentParallelForAPI();
+    if (api)
+    {
+        getWorkStealingTelemetry(api.get(), workers, reset);
+        return;
+    }
+#ifdef HAVE_PTHREADS_PF
+    const char* framework = cv::currentParallelFramework();
+    if (framework && strcmp(framework, "pthreads") == 0)
+        parallel_pthreads_get_telemetry(workers, reset);
+#else
+    CV_UNUSED(workers); CV_UNUSED(reset);
+#endif
+}
+
+}}  // namespace parallel::telemetry
+
+namespace utils {
+
+void setParallelTelemetryEnabled(bool enabled)
+{
+    parallel::telemetry::g_enabled = enabled;
+}
+
+bool isParallelTelemetryEnabled()
+{
+    return parallel::telemetry::isEnabled();
+}
+
+void getParallelTelemetry(ParallelTelemetry& telemetry)
+{
+    parallel::telemetry::Counters& c = parallel::telemetry::getCounters();
+    const double msPerTick = 1000. / getTickFrequency();
+    telemetry.backend = cv::currentParallelFramework() ? cv::currentParallelFramework() : "";
+    telemetry.numThreads = cv::getNumThreads();
+    telemetry.jobs = c.jobs.load();
+    telemetry.parallelJobs = c.parallelJobs.load();
+    telemetry.serialFallbacks = c.serialFallbacks.load();
+    telemetry.oversubscriptionEvents = c.oversubscriptionEvents.load();
+    telemetry.stripes = c.stripes.load();
+    telemetry.totalTimeMs = c.totalTicks.load() * msPerTick;
+    telemetry.maxTimeMs = c.maxTicks.load() * msPerTick;
+    telemetry.workers.clear();
+    parallel::telemetry::getWorkersTelemetry(&telemetry.workers, false);
+    {
+        std::lock_guard<std::mutex> lock(c.mutex);
+        telemetry.recentJobs.assign(c.history.begin() + c.historyHead, c.history.end());
+        telemetry.recentJobs.insert(telemetry.recentJobs.end(), c.history.begin(), c.history.begin() + c.historyHead);
+    }
+}
+
+void resetParallelTelemetry()
+{
+    parallel::telemetry::getCounters().reset();
+    parallel::telemetry::getWorkersTelemetry(NULL, true);
+}
+
+}  // namespace utils
+}  // namespace cv
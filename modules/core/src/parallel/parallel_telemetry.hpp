@@ -0,0 +1,80 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#ifndef OPENCV_CORE_SRC_PARALLEL_PARALLEL_TELEMETRY_HPP
+#define OPENCV_CORE_SRC_PARALLEL_PARALLEL_TELEMETRY_HPP
+
+#include "opencv2/core/utils/parallel_telemetry.hpp"
+
+#include <atomic>
+
+namespace cv { namespace parallel { namespace telemetry {
+
+extern std::atomic<bool> g_enabled;
+
+static inline bool isEnabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+/** Counters of a thread pool worker. Updated by the worker thread only (when telemetry is enabled). */
+struct WorkerCounters
+{
+    WorkerCounters() { reset(); }
+
+    void reset();
+    void addBusy(int64 ticks, int64 tasks_);
+    void addIdle(int64 ticks) { idleTicks.fetch_add(ticks, std::memory_order_relaxed); }
+    void addSteal() { steals.fetch_add(1, std::memory_order_relaxed); }
+    void addWakeup(int64 latencyTicks);
+    void get(utils::ParallelWorkerTelemetry& stat, int id) const;
+
+    std::atomic<int64> busyTicks, idleTicks, tasks, steals, wakeups, wakeLatencyTicks, maxWakeLatencyTicks;
+};
+
+/** Measures a single parallel_for_() call. Inactive if telemetry is disabled. */
+class JobScope
+{
+public:
+    explicit JobScope(const Range& range)
+        : active(isEnabled())
+    {
+        if (active)
+            start(range);
+    }
+    ~JobScope()
+    {
+        if (active)
+            finish();
+    }
+
+    bool isActive() const { return active; }
+
+    /** The job is passed to the thread pool */
+    void setParallel(int stripes)
+    {
+        if (active)
+            startParallel(stripes);
+    }
+    /** Called by the loop body wrapper */
+    void onStripes(int count);
+
+protected:
+    void start(const Range& range);
+    void startParallel(int stripes);
+    void finish();
+
+    const bool active;
+    bool parallel, external;
+    int caller;
+    int64 startTick;
+    utils::ParallelJobTelemetry stat;
+    std::atomic<int> callerStripes;
+    JobScope* outer;  // enclosing job of the same thread
+
+    friend void onSerialFallback();
+};
+
+/** The current parallel_for_() job is executed serially: nested call or the thread pool is busy */
+void onSerialFallback();
+
+}}}  // namespace
+
+#endif // OPENCV_CORE_SRC_PARALLEL_PARALLEL_TELEMETRY_HPP
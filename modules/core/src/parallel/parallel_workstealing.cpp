@@ -0,0 +1,522 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "../precomp.hpp"
+
+#include "parallel.hpp"
+#include "parallel_telemetry.hpp"
+
+#if defined(HAVE_PTHREADS_PF) && !defined(OPENCV_DISABLE_THREAD_SUPPORT)
+
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/logger.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "../parallel_impl.hpp"  // defaultNumberOfThreads()
+#include "../numa.hpp"
+
+/*
+ Work-stealing thread pool:
+ - each worker owns a deque of tasks (ranges of stripes): the owner pushes/pops tasks at the back,
+   idle threads steal from the front (the largest ranges);
+ - tasks are split lazily in halves before execution, so idle threads get work as soon as possible;
+ - application threads (not workers) submit their jobs through the shared queue and participate
+   in computations of their own jobs, so concurrent parallel_for_() calls don't block each other;
+ - a thread waiting for a nested job executes tasks of this job only: bodies of other jobs are
+   never re-entered on the same stack (thread-local buffers of the outer body stay intact).
+ NUMA mode (OPENCV_NUMA=1): workers are pinned to nodes round-robin, jobs of application threads are split
+ into equal consecutive parts per node (see NumaMatAllocator), idle threads take tasks of own node first.
+*/
+
+namespace cv { namespace parallel { namespace workstealing {
+
+static const int WORKSTEALING_MAX_WORKERS = 1024;
+
+static int getActiveWaitIterations()
+{
+    static int iterations = (int)utils::getConfigurationParameterSizeT("OPENCV_THREAD_POOL_WORKSTEALING_ACTIVE_WAIT", 256);
+    return iterations;
+}
+
+struct Job
+{
+    Job(ParallelForAPI::FN_parallel_for_body_cb_t callback_, void* data_, int tasks)
+        : callback(callback_), data(data_), remaining(tasks)
+    {
+        // nothing
+    }
+
+    ParallelForAPI::FN_parallel_for_body_cb_t callback;
+    void* data;
+    std::atomic<int> remaining;  // number of tasks which are not completed yet
+};
+
+struct Task
+{
+    Job* job;
+    int start, end;
+};
+
+class TaskQueue
+{
+public:
+    void push(const Task& task)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(task);
+    }
+
+    // pops the most recent task of the job (any job if NULL)
+    bool popBack(Task& task, const Job* job)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::deque<Task>::reverse_iterator it = tasks.rbegin(); it != tasks.rend(); ++it)
+        {
+            if (!job || it->job == job)
+            {
+                task = *it;
+                tasks.erase(std::next(it).base());
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // pops the oldest (the largest) task of the job (any job if NULL)
+    bool popFront(Task& task, const Job* job)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::deque<Task>::iterator it = tasks.begin(); it != tasks.end(); ++it)
+        {
+            if (!job || it->job == job)
+            {
+                task = *it;
+                tasks.erase(it);
+                return true;
+            }
+        }
+        return false;
+    }
+
+protected:
+    std::mutex mutex;
+    std::deque<Task> tasks;
+};
+
+class ThreadPool;
+
+struct Worker
+{
+    Worker(ThreadPool& pool_, int index_, int node_) : pool(pool_), index(index_), node(node_) {}
+
+    ThreadPool& pool;
+    const int index;
+    const int node;  // NUMA node
+    TaskQueue queue;
+    std::thread thread;
+    telemetry::WorkerCounters stat;
+};
+
+static thread_local Worker* currentWorker = NULL;
+
+class ThreadPool
+{
+public:
+    ThreadPool()
+        : numThreads((int)defaultNumberOfThreads())
+        , workers(WORKSTEALING_MAX_WORKERS)
+        , numWorkers(0)
+        , activeWorkers(0)
+        , queuedTasks(0)
+        , sleepingWorkers(0)
+        , notifyTick(0)
+        , numaNodes(utils::numa::getNodesCount())
+        , nodeQueues(numaNodes)
+        , destroying(false)
+    {
+        // nothing
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            destroying = true;
+        }
+        cond_work.notify_all();
+        cond_park.notify_all();
+        const int n = numWorkers.load();
+        for (int i = 0; i < n; i++)
+        {
+            if (workers[i]->thread.joinable())
+                workers[i]->thread.join();
+        }
+    }
+
+    void run(int tasks, ParallelForAPI::FN_parallel_for_body_cb_t callback, void* data)
+    {
+        const int nthreads = std::min(numThreads.load(), WORKSTEALING_MAX_WORKERS + 1);
+        if (nthreads <= 1 || tasks <= 1)
+        {
+            callback(0, tasks, data);
+            return;
+        }
+        if (activeWorkers.load() != nthreads - 1)
+            reconfigure(nthreads - 1);
+
+        Job job(callback, data, tasks);
+        if (numaNodes > 1 && !isWorker())
+        {
+            // the first part of stripes goes to the first node and so on
+            for (int k = 0; k < numaNodes; k++)
+            {
+                const int start = (int)((int64)tasks * k / numaNodes), end = (int)((int64)tasks * (k + 1) / numaNodes);
+                if (start < end)
+                    push(nodeQueues[k], Task { &job, start, end });
+            }
+        }
+        else
+        {
+            execute(Task { &job, 0, tasks });
+        }
+        wait(job);
+    }
+
+    int getThreadNum() const
+    {
+        Worker* w = currentWorker;
+        return (w && &w->pool == this) ? w->index + 1 : 0;
+    }
+
+    void getTelemetry(std::vector<utils::ParallelWorkerTelemetry>* stats, bool reset)
+    {
+        const int n = numWorkers.load(std::memory_order_acquire);
+        for (int i = 0; i < n; i++)
+        {
+            Worker& w = *workers[i];
+            if (reset)
+                w.stat.reset();
+            if (stats && i < activeWorkers.load())
+            {
+                utils::ParallelWorkerTelemetry stat;
+                w.stat.get(stat, i);
+                stats->push_back(stat);
+            }
+        }
+    }
+
+    std::atomic<int> numThreads;  // including the calling thread
+
+protected:
+    bool isWorker() const
+    {
+        Worker* w = currentWorker;
+        return w && &w->pool == this;
+    }
+
+    TaskQueue& getQueue()
+    {
+        Worker* w = currentWorker;
+        return (w && &w->pool == this) ? w->queue : sharedQueue;
+    }
+
+    void push(TaskQueue& queue, const Task& task)
+    {
+        queue.push(task);
+        queuedTasks.fetch_add(1);
+        if (sleepingWorkers.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (telemetry::isEnabled())
+                notifyTick.store(getTickCount());
+            cond_work.notify_one();
+        }
+    }
+
+    // Takes a task of the job (any job if NULL): own queue first, then the shared queue, then steals
+    bool take(Task& task, const Job* job)
+    {
+        Worker* w = currentWorker;
+        const bool isWorker = w && &w->pool == this;
+        bool found = isWorker ? w->queue.popBack(task, job) : sharedQueue.popBack(task, job);
+        if (!found && isWorker)
+            found = sharedQueue.popFront(task, job);
+        if (!found && numaNodes > 1)
+        {
+            const int node = isWorker ? w->node : utils::numa::getCurrentNode();
+            for (int i = 0; i < numaNodes && !found; i++)
+                found = nodeQueues[(node + i) % numaNodes].popFront(task, job);
+        }
+        if (!found)
+        {
+            const int n = numWorkers.load(std::memory_order_acquire);
+            const int first = isWorker ? w->index + 1 : 0;
+            // NUMA: steal from workers of the same node first
+            const int passes = (numaNodes > 1 && isWorker) ? 2 : 1;
+            for (int pass = 0; pass < passes && !found; pass++)
+            {
+                for (int i = 0; i < n && !found; i++)
+                {
+                    Worker* victim = workers[(first + i) % n].get();
+                    if (victim == w || (passes > 1 && (victim->node == w->node) != (pass == 0)))
+                        continue;
+                    found = victim->queue.popFront(task, job);
+                }
+            }
+            if (found && isWorker && telemetry::isEnabled())
+                w->stat.addSteal();
+        }
+        if (found)
+            queuedTasks.fetch_sub(1);
+        return found;
+    }
+
+    void execute(Task task)
+    {
+        TaskQueue& queue = getQueue();
+        while (task.end - task.start > 1)
+        {
+            const int middle = task.start + (task.end - task.start) / 2;
+            push(queue, Task { task.job, middle, task.end });
+            task.end = middle;
+        }
+        Job& job = *task.job;
+        Worker* w = currentWorker;
+        const int64 startTick = (w && &w->pool == this && telemetry::isEnabled()) ? getTickCount() : 0;
+        job.callback(task.start, task.end, job.data);
+        if (startTick)
+            w->stat.addBusy(getTickCount() - startTick, 1);
+        if (job.remaining.fetch_sub(task.end - task.start) == task.end - task.start)
+        {
+            // job may be destroyed by the waiting thread since this moment
+            std::lock_guard<std::mutex> lock(mutex);
+            cond_done.notify_all();
+        }
+    }
+
+    void wait(Job& job)
+    {
+        const int activeWait = getActiveWaitIterations();
+        int idle = 0;
+        while (job.remaining.load() > 0)
+        {
+            Task task = Task();
+            if (take(task, &job))
+            {
+                execute(task);
+                idle = 0;
+                continue;
+            }
+            // the rest tasks are executed by other threads (or are being split by them)
+            if (idle++ < activeWait)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            if (job.remaining.load() > 0)
+                cond_done.wait(lock);
+            idle = 0;
+        }
+    }
+
+    void reconfigure(int nworkers)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = numWorkers.load(); i < nworkers; i++)
+        {
+            // the calling thread is expected on the first node
+            workers[i].reset(new Worker(*this, i, (i + 1) % numaNodes));
+            workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, workers[i].get());
+            numWorkers.store(i + 1, std::memory_order_release);
+        }
+        CV_LOG_VERBOSE(NULL, 1, "core(parallel): work-stealing pool: " << nworkers << " active workers (" << numWorkers.load() << " created)");
+        activeWorkers.store(nworkers);
+        cond_work.notify_all();  // sleeping workers above the limit are parked
+        cond_park.notify_all();
+    }
+
+    void workerLoop(Worker* w)
+    {
+        currentWorker = w;
+        (void)cv::utils::getThreadID(); // notify OpenCV about new thread
+        if (numaNodes > 1)
+            utils::numa::bindCurrentThread(w->node);
+        const int activeWait = getActiveWaitIterations();
+        for (;;)
+        {
+            Task task = Task();
+            if (w->index >= activeWorkers.load())
+            {
+                // parked (the number of threads is reduced): complete own tasks only
+                if (w->queue.popBack(task, NULL))
+                {
+                    queuedTasks.fetch_sub(1);
+                    execute(task);
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(mutex);
+                while (!destroying && w->index >= activeWorkers.load())
+                    cond_park.wait(lock);
+                if (destroying)
+                    break;
+                continue;
+            }
+            if (take(task, NULL))
+            {
+                execute(task);
+                continue;
+            }
+            const int64 idleTick = telemetry::isEnabled() ? getTickCount() : 0;
+            for (int i = 0; i < activeWait; i++)
+            {
+                if (queuedTasks.load() > 0)
+                    break;
+                std::this_thread::yield();
+            }
+            if (queuedTasks.load() > 0)
+            {
+                if (idleTick)
+                    w->stat.addIdle(getTickCount() - idleTick);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            if (destroying)
+                break;
+            sleepingWorkers.fetch_add(1);
+            if (queuedTasks.load() == 0 && w->index < activeWorkers.load())
+            {
+                const int64 sleepTick = idleTick ? getTickCount() : 0;
+                cond_work.wait(lock);
+                const int64 notified = notifyTick.load();
+                if (sleepTick && notified >= sleepTick)
+                    w->stat.addWakeup(getTickCount() - notified);
+            }
+            sleepingWorkers.fetch_sub(1);
+            if (idleTick)
+                w->stat.addIdle(getTickCount() - idleTick);
+            if (destroying)
+                break;
+        }
+        currentWorker = NULL;
+    }
+
+    std::vector<std::unique_ptr<Worker> > workers;  // fixed size, slots are filled once
+    std::atomic<int> numWorkers;  // created workers
+    std::atomic<int> activeWorkers;  // workers with index >= activeWorkers are parked
+    TaskQueue sharedQueue;  // tasks of non-worker threads
+    std::atomic<int> queuedTasks;
+    std::atomic<int> sleepingWorkers;
+    std::atomic<int64> notifyTick;  // the last wake-up notification of sleeping workers (telemetry)
+    const int numaNodes;
+    std::vector<TaskQueue> nodeQueues;  // NUMA mode: parts of jobs of non-worker threads
+
+    std::mutex mutex;
+    std::condition_variable cond_work;
+    std::condition_variable cond_done;
+    std::condition_variable cond_park;
+    bool destroying;
+};
+
+/** Work-stealing parallel_for API implementation
+ *
+ * Concurrent calls from different application threads and nested calls are executed in parallel.
+ */
+class ParallelForBackend : public ParallelForAPI
+{
+public:
+    ParallelForBackend()
+    {
+        CV_LOG_INFO(NULL, "Initializing work-stealing parallel backend");
+    }
+
+    virtual ~ParallelForBackend() {}
+
+    virtual void parallel_for(int tasks, FN_parallel_for_body_cb_t body_callback, void* callback_data) CV_OVERRIDE
+    {
+        pool.run(tasks, body_callback, callback_data);
+    }
+
+    virtual int getThreadNum() const CV_OVERRIDE
+    {
+        return pool.getThreadNum();
+    }
+
+    virtual int getNumThreads() const CV_OVERRIDE
+    {
+        return pool.numThreads.load();
+    }
+
+    virtual int setNumThreads(int nThreads) CV_OVERRIDE
+    {
+        // 0 disables parallel execution, negative values restore the default number of threads
+        return pool.numThreads.exchange(nThreads > 0 ? nThreads : nThreads == 0 ? 1 : (int)defaultNumberOfThreads());
+    }
+
+    const char* getName() const CV_OVERRIDE
+    {
+        return "workstealing";
+    }
+
+    void getTelemetry(std::vector<utils::ParallelWorkerTelemetry>* workers, bool reset)
+    {
+        pool.getTelemetry(workers, reset);
+    }
+
+protected:
+    ThreadPool pool;
+};
+
+}  // namespace workstealing
+
+static
+std::shared_ptr<cv::parallel::workstealing::ParallelForBackend>& getWorkStealingInstance()
+{
+    static std::shared_ptr<cv::parallel::workstealing::ParallelForBackend> g_instance = std::make_shared<cv::parallel::workstealing::ParallelForBackend>();
+    return g_instance;
+}
+
+std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendWorkStealing()
+{
+    return getWorkStealingInstance();
+}
+
+bool isNestedParallelForSupported(const ParallelForAPI* api)
+{
+    return api && dynamic_cast<const cv::parallel::workstealing::ParallelForBackend*>(api) != NULL;
+}
+
+bool getWorkStealingTelemetry(const ParallelForAPI* api, std::vector<utils::ParallelWorkerTelemetry>* workers, bool reset)
+{
+    cv::parallel::workstealing::ParallelForBackend* backend = api ?
+        dynamic_cast<cv::parallel::workstealing::ParallelForBackend*>(const_cast<ParallelForAPI*>(api)) : NULL;
+    if (!backend)
+        return false;
+    backend->getTelemetry(workers, reset);
+    return true;
+}
+
+}}  // namespace
+
+#else  // HAVE_PTHREADS_PF && !OPENCV_DISABLE_THREAD_SUPPORT
+
+namespace cv { namespace parallel {
+
+bool isNestedParallelForSupported(const ParallelForAPI* /*api*/)
+{
+    return false;
+}
+
+bool getWorkStealingTelemetry(const ParallelForAPI* /*api*/, std::vector<utils::ParallelWorkerTelemetry>* /*workers*/, bool /*reset*/)
+{
+    return false;
+}
+
+}}  // namespace
+
+#endif
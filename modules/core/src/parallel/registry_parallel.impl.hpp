@@ -41,6 +41,10 @@ std::vector<ParallelBackendInfo>& getBuiltinParallelBackendsInfo()
 #elif defined(PARALLEL_ENABLE_PLUGINS)
         DECLARE_DYNAMIC_BACKEND("OPENMP")  // TODO Intel OpenMP?
 #endif
+
+#if defined(HAVE_PTHREADS_PF) && !defined(OPENCV_DISABLE_THREAD_SUPPORT)
+        DECLARE_STATIC_BACKEND("WORKSTEALING", createParallelBackendWorkStealing)  // replaces builtin pthreads pool
+#endif
     };
     return g_backends;
 }
@@ -18,6 +18,9 @@
 
 #include <opencv2/core/utils/trace.private.hpp>
 
+#include "parallel/parallel_telemetry.hpp"
+#include "numa.hpp"
+
 //#define CV_PROFILE_THREADS 64
 //#define getTickCount getCPUTickCount  // use this if getTickCount() calls are expensive (and getCPUTickCount() is accurate)
 
@@ -130,6 +133,8 @@ public:
 
     Ptr<ParallelJob> job;
 
+    std::atomic<int64> jobSubmitTick;  // wake-up time of worker threads (telemetry)
+
 #ifdef CV_PROFILE_THREADS
     double tickFreq;
     int64 jobSubmitTime;
@@ -206,6 +211,8 @@ public:
 
     Ptr<ParallelJob> job;
 
+    parallel::telemetry::WorkerCounters telemetry;
+
     pthread_mutex_t mutex;
 #if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
     volatile bool isActive;
@@ -375,6 +382,10 @@ void WorkerThread::thread_body()
     (void)cv::utils::getThreadID(); // notify OpenCV about new thread
     CV_LOG_VERBOSE(NULL, 5, "Thread: new thread: " << id);
 
+    const int numaNodes = utils::numa::getNodesCount();
+    if (numaNodes > 1)
+        utils::numa::bindCurrentThread((id + 1) % numaNodes);  // the main thread is expected on the first node
+
     bool allow_active_wait = true;
 
 #ifdef CV_PROFILE_THREADS
@@ -383,6 +394,8 @@ void WorkerThread::thread_body()
 
     while (!stop_thread)
     {
+        const int64 idleTick = parallel::telemetry::isEnabled() ? getTickCount() : 0;
+        int64 sleepTick = 0;
         CV_LOG_VERBOSE(NULL, 5, "Thread: ... loop iteration: allow_active_wait=" << allow_active_wait << "   has_wake_signal=" << has_wake_signal);
         if (allow_active_wait && CV_WORKER_ACTIVE_WAIT > 0)
         {
@@ -404,6 +417,8 @@ void WorkerThread::thread_body()
         while (!has_wake_signal) // to handle spurious wakeups
         {
             //CV_LOG_VERBOSE(NULL, 5, "Thread: wait (sleep) ...");
+            if (idleTick && !sleepTick)
+                sleepTick = getTickCount();
 #if defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
             pthread_cond_wait(&thread_pool.cond_thread_wake, &mutex);
 #else
@@ -416,6 +431,14 @@ void WorkerThread::thread_body()
 #ifdef CV_PROFILE_THREADS
         stat.threadWake = getTickCount();
 #endif
+        if (idleTick)
+        {
+            const int64 wakeTick = getTickCount();
+            telemetry.addIdle(wakeTick - idleTick);
+            const int64 submitTick = thread_pool.jobSubmitTick.load();
+            if (sleepTick && submitTick >= sleepTick)
+                telemetry.addWakeup(wakeTick - submitTick);
+        }
 
         CV_LOG_VERBOSE(NULL, 5, "Thread: checking for new job");
         if (CV_WORKER_ACTIVE_WAIT_THREADS_LIMIT == 0)
@@ -439,7 +462,10 @@ void WorkerThread::thread_body()
                     stat.executedTasks = j->execute(true);
                     stat.threadExecuteStop = getTickCount();
 #else
-                    j->execute(true);
+                    const int64 executeTick = parallel::telemetry::isEnabled() ? getTickCount() : 0;
+                    const unsigned executedTasks = j->execute(true);
+                    if (executeTick)
+                        telemetry.addBusy(getTickCount() - executeTick, executedTasks);
 #endif
                     int completed = j->completed_thread_count.fetch_add(1, std::memory_order_seq_cst) + 1;
                     int active = j->active_thread_count.load(std::memory_order_acquire);
@@ -497,6 +523,7 @@ ThreadPool::ThreadPool()
         CV_LOG_FATAL(NULL, "Failed to initialize ThreadPool (pthreads)");
     }
     num_threads = defaultNumberOfThreads();
+    jobSubmitTick = 0;
 }
 
 bool ThreadPool::reconfigure_(unsigned new_threads_count)
@@ -569,10 +596,13 @@ void ThreadPool::run(const Range& range, const ParallelLoopBody& body, double ns
         if (job != NULL)
         {
             pthread_mutex_unlock(&mutex);
+            parallel::telemetry::onSerialFallback();
             body(range);
             return;
         }
         reconfigure_(num_threads - 1);
+        if (parallel::telemetry::isEnabled())
+            jobSubmitTick = getTickCount();
 
         {
             CV_LOG_VERBOSE(NULL, 1, "MainThread: initialize parallel job: " << range.size());
@@ -712,6 +742,8 @@ void ThreadPool::run(const Range& range, const ParallelLoopBody& body, double ns
     }
     else
     {
+        if (job != NULL)
+            parallel::telemetry::onSerialFallback();  // concurrent call
         body(range);
     }
 }
@@ -753,6 +785,25 @@ void parallel_for_pthreads(const Range& range, const ParallelLoopBody& body, dou
     ThreadPool::instance().run(range, body, nstripes);
 }
 
+void parallel_pthreads_get_telemetry(std::vector<utils::ParallelWorkerTelemetry>* workers, bool reset)
+{
+    ThreadPool& pool = ThreadPool::instance();
+    pthread_mutex_lock(&pool.mutex);
+    for (size_t i = 0; i < pool.threads.size(); i++)
+    {
+        WorkerThread& thread = *pool.threads[i];
+        if (reset)
+            thread.telemetry.reset();
+        if (workers)
+        {
+            utils::ParallelWorkerTelemetry stat;
+            thread.telemetry.get(stat, (int)thread.id);
+            workers->push_back(stat);
+        }
+    }
+    pthread_mutex_unlock(&pool.mutex);
+}
+
 }
 
 #endif
@@ -6,11 +6,14 @@
 
 namespace cv {
 
+namespace utils { struct ParallelWorkerTelemetry; }
+
 unsigned defaultNumberOfThreads();
 
 void parallel_for_pthreads(const Range& range, const ParallelLoopBody& body, double nstripes);
 size_t parallel_pthreads_get_threads_num();
 void parallel_pthreads_set_threads_num(int num);
+void parallel_pthreads_get_telemetry(std::vector<utils::ParallelWorkerTelemetry>* workers, bool reset);
 
 }
 
@@ -0,0 +1,332 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include <opencv2/core/bufferpool.hpp>
+#include <opencv2/core/utils/pooled_allocator.hpp>
+#include <opencv2/core/utils/configuration.private.hpp>
+
+#include <atomic>
+#include <mutex>
+
+namespace cv { namespace utils {
+
+namespace pool {
+
+static const size_t MIN_BLOCK_SIZE = 64;
+static const int CLASSES_PER_POWER_OF_2 = 4;
+static const int MAX_CLASSES = CLASSES_PER_POWER_OF_2 * (int)(sizeof(size_t) * 8 - 6) + 1;
+
+static const size_t THREAD_CACHE_MAX_BLOCK_SIZE = 256 << 10;
+static const int THREAD_CACHE_CLASSES = CLASSES_PER_POWER_OF_2 * (18 - 6) + 1;  // classes up to 2^18 bytes
+static const int THREAD_CACHE_DEPTH = 4;
+
+/** Rounds the size up to the size class: 64, 80, 96, 112, 128, 160, ... */
+static inline int getSizeClass(size_t size, size_t& classSize)
+{
+    if (size <= MIN_BLOCK_SIZE)
+    {
+        classSize = MIN_BLOCK_SIZE;
+        return 0;
+    }
+    int p = 0;  // 2^p < size <= 2^(p+1)
+    for (size_t v = size - 1; v > 1; v >>= 1)
+        p++;
+    const size_t base = (size_t)1 << p, step = base / CLASSES_PER_POWER_OF_2;
+    const size_t k = (size - base + step - 1) / step;
+    classSize = base + k * step;
+    return (p - 6) * CLASSES_PER_POWER_OF_2 + (int)k;
+}
+
+struct ThreadCache
+{
+    ThreadCache() : epoch(0) { memset(count, 0, sizeof(count)); }
+
+    unsigned epoch;  // trim requests are applied on mismatch with the pool
+    int count[THREAD_CACHE_CLASSES];
+    void* blocks[THREAD_CACHE_CLASSES][THREAD_CACHE_DEPTH];
+};
+
+static ThreadCache* getThreadCache();
+
+class MatBufferPool CV_FINAL : public BufferPoolController
+{
+public:
+    MatBufferPool()
+        : maxReservedSize(utils::getConfigurationParameterSizeT("OPENCV_POOLED_ALLOCATOR_MAX_HELD", (size_t)512 << 20))
+        , epoch(0), hits(0), misses(0), bytesHeld(0), bytesInUse(0)
+    {
+        // nothing
+    }
+
+    void* allocate(size_t size)
+    {
+        size_t classSize = 0;
+        const int idx = getSizeClass(size, classSize);
+        void* ptr = NULL;
+        ThreadCache* cache = classSize <= THREAD_CACHE_MAX_BLOCK_SIZE ? getThreadCache() : NULL;
+        if (cache)
+        {
+            syncThreadCache(*cache);
+            if (cache->count[idx] > 0)
+                ptr = cache->blocks[idx][--cache->count[idx]];
+        }
+        if (!ptr)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<void*>& list = freeBlocks[idx];
+            if (!list.empty())
+            {
+                ptr = list.back();
+                list.pop_back();
+            }
+        }
+        if (ptr)
+        {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            bytesHeld.fetch_sub(classSize, std::memory_order_relaxed);
+        }
+        else
+        {
+            misses.fetch_add(1, std::memory_order_relaxed);
+            ptr = fastMalloc(classSize);
+        }
+        bytesInUse.fetch_add(classSize, std::memory_order_relaxed);
+        return ptr;
+    }
+
+    void release(void* ptr, size_t size)
+    {
+        size_t classSize = 0;
+        const int idx = getSizeClass(size, classSize);
+        bytesInUse.fetch_sub(classSize, std::memory_order_relaxed);
+        if (!keep(classSize))
+        {
+            fastFree(ptr);
+            return;
+        }
+        ThreadCache* cache = classSize <= THREAD_CACHE_MAX_BLOCK_SIZE ? getThreadCache() : NULL;
+        if (cache)
+        {
+            syncThreadCache(*cache);
+            if (cache->count[idx] < THREAD_CACHE_DEPTH)
+            {
+                cache->blocks[idx][cache->count[idx]++] = ptr;
+                return;
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        freeBlocks[idx].push_back(ptr);
+    }
+
+    /** Moves buffers of the exiting thread to the shared lists */
+    void releaseThreadCache(ThreadCache& cache)
+    {
+        syncThreadCache(cache);
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int idx = 0; idx < THREAD_CACHE_CLASSES; idx++)
+        {
+            for (int i = 0; i < cache.count[idx]; i++)
+                freeBlocks[idx].push_back(cache.blocks[idx][i]);
+            cache.count[idx] = 0;
+        }
+    }
+
+    void trim(size_t maxBytesHeld)
+    {
+        epoch.fetch_add(1);
+        std::lock_guard<std::mutex> lock(mutex);
+        // large buffers first
+        for (int idx = MAX_CLASSES - 1; idx >= 0 && bytesHeld.load() > maxBytesHeld; idx--)
+        {
+            std::vector<void*>& list = freeBlocks[idx];
+            if (list.empty())
+                continue;
+            const size_t classSize = getClassSize(idx);
+            while (!list.empty() && bytesHeld.load() > maxBytesHeld)
+            {
+                fastFree(list.back());
+                list.pop_back();
+                bytesHeld.fetch_sub(classSize);
+            }
+            if (list.empty())
+                std::vector<void*>().swap(list);
+        }
+    }
+
+    void getStats(PooledMatAllocatorStats& stats) const
+    {
+        stats.hits = hits.load();
+        stats.misses = misses.load();
+        stats.bytesHeld = bytesHeld.load();
+        stats.bytesInUse = bytesInUse.load();
+        stats.maxBytesHeld = maxReservedSize.load();
+    }
+
+    void resetStats()
+    {
+        hits = 0;
+        misses = 0;
+    }
+
+    // BufferPoolController
+    size_t getReservedSize() const CV_OVERRIDE { return bytesHeld.load(); }
+    size_t getMaxReservedSize() const CV_OVERRIDE { return maxReservedSize.load(); }
+    void setMaxReservedSize(size_t size) CV_OVERRIDE
+    {
+        maxReservedSize = size;
+        trim(size);
+    }
+    void freeAllReservedBuffers() CV_OVERRIDE { trim(0); }
+
+protected:
+    /** Accounts the freed buffer if it fits into the limit */
+    bool keep(size_t classSize)
+    {
+        const size_t limit = maxReservedSize.load(std::memory_order_relaxed);
+        size_t held = bytesHeld.load(std::memory_order_relaxed);
+        do
+        {
+            if (held + classSize > limit)
+                return false;
+        } while (!bytesHeld.compare_exchange_weak(held, held + classSize, std::memory_order_relaxed));
+        return true;
+    }
+
+    void syncThreadCache(ThreadCache& cache)
+    {
+        const unsigned current = epoch.load(std::memory_order_relaxed);
+        if (cache.epoch == current)
+            return;
+        cache.epoch = current;
+        for (int idx = 0; idx < THREAD_CACHE_CLASSES; idx++)
+        {
+            if (cache.count[idx] == 0)
+                continue;
+            const size_t classSize = getClassSize(idx);
+            for (int i = 0; i < cache.count[idx]; i++)
+                fastFree(cache.blocks[idx][i]);
+            bytesHeld.fetch_sub(classSize * cache.count[idx]);
+            cache.count[idx] = 0;
+        }
+    }
+
+    static size_t getClassSize(int idx)
+    {
+        if (idx == 0)
+            return MIN_BLOCK_SIZE;
+        const int p = (idx - 1) / CLASSES_PER_POWER_OF_2 + 6;
+        const size_t base = (size_t)1 << p;
+        return base + (size_t)((idx - 1) % CLASSES_PER_POWER_OF_2 + 1) * (base / CLASSES_PER_POWER_OF_2);
+    }
+
+    std::atomic<size_t> maxReservedSize;
+    std::atomic<unsigned> epoch;
+    std::atomic<int64> hits, misses;
+    std::atomic<size_t> bytesHeld, bytesInUse;
+
+    std::mutex mutex;
+    std::vector<void*> freeBlocks[MAX_CLASSES];  // guarded by mutex
+};
+
+static MatBufferPool& getPool()
+{
+    CV_SINGLETON_LAZY_INIT_REF(MatBufferPool, new MatBufferPool())
+}
+
+// trivially destructible, so they are valid during destruction of other thread-local objects
+static thread_local ThreadCache* currentCache = NULL;
+static thread_local bool currentCacheReleased = false;
+
+struct ThreadCacheHolder
+{
+    ~ThreadCacheHolder()
+    {
+        currentCache = NULL;
+        currentCacheReleased = true;
+        getPool().releaseThreadCache(cache);
+    }
+
+    ThreadCache cache;
+};
+
+static ThreadCache* getThreadCache()
+{
+    if (currentCache || currentCacheReleased)
+        return currentCache;
+    static thread_local ThreadCacheHolder holder;
+    currentCache = &holder.cache;
+    return currentCache;
+}
+
+
+class PooledMatAllocator CV_FINAL : public MatAllocator
+{
+public:
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data0, size_t* step, AccessFlag flags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        if (data0)
+            return Mat::getStdAllocator()->allocate(dims, sizes, type, data0, step, flags, usageFlags);
+
+        size_t total = CV_ELEM_SIZE(type);
+        for (int i = dims - 1; i >= 0; i--)
+        {
+            if (step)
+                step[i] = total;
+            total *= sizes[i];
+        }
+        UMatData* u = new UMatData(this);
+        u->data = u->origdata = (uchar*)getPool().allocate(total);
+        u->size = total;
+        return u;
+    }
+
+    bool allocate(UMatData* u, AccessFlag /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        return u != NULL;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if (!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        getPool().release(u->origdata, u->size);
+        u->origdata = 0;
+        delete u;
+    }
+
+    BufferPoolController* getBufferPoolController(const char* /*id*/) const CV_OVERRIDE
+    {
+        return &getPool();
+    }
+};
+
+}  // namespace pool
+
+MatAllocator* getPooledMatAllocator()
+{
+    CV_SINGLETON_LAZY_INIT(MatAllocator, new pool::PooledMatAllocator())
+}
+
+void getPooledMatAllocatorStats(PooledMatAllocatorStats& stats)
+{
+    pool::getPool().getStats(stats);
+}
+
+void resetPooledMatAllocatorStats()
+{
+    pool::getPool().resetStats();
+}
+
+void trimPooledMatAllocator(size_t maxBytesHeld)
+{
+    pool::getPool().trim(maxBytesHeld);
+}
+
+}}  // namespace cv::utils
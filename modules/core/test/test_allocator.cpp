@@ -3,6 +3,11 @@
 // of this distribution and at http://opencv.org/license.html.
 #include "test_precomp.hpp"
 
+#include <opencv2/core/utils/numa.hpp>
+#include <opencv2/core/utils/pooled_allocator.hpp>
+#include <opencv2/core/bufferpool.hpp>
+#include <thread>
+
 namespace opencv_test { namespace {
 
 // Dummy allocator implementation copied from the default OpenCV allocator with some simplifications
@@ -141,4 +146,131 @@ TEST_F(AllocatorTest, DummyAllocator)
     EXPECT_EQ(2, DummyAllocator::deallocations);
 }
 
+TEST(Core_Allocator, numa_allocator)
+{
+    cv::MatAllocator* numa = cv::utils::getNumaMatAllocator();
+    ASSERT_TRUE(numa != NULL);
+    EXPECT_GE(cv::utils::getNumaNodesCount(), 1);
+
+    // large buffer is placed on all the nodes, small one is allocated by the standard allocator
+    cv::Mat large, small;
+    large.allocator = numa;
+    small.allocator = numa;
+    large.create(2048, 1536, CV_8UC3);
+    small.create(16, 16, CV_32FC1);
+    ASSERT_TRUE(large.isContinuous());
+    EXPECT_EQ((size_t)1536 * 3, large.step[0]);
+    EXPECT_EQ(small.u->currAllocator, cv::Mat::getStdAllocator());
+    if (cv::utils::getNumaNodesCount() > 1)
+    {
+        EXPECT_EQ(large.u->currAllocator, numa);
+    }
+
+    cv::parallel_for_(cv::Range(0, large.rows), [&](const cv::Range& r) {
+        for (int y = r.start; y < r.end; y++)
+            large.row(y).setTo(cv::Scalar::all(y & 255));
+    });
+    small.setTo(1);
+    const double expectedSum = (large.rows / 256) * (255 * 256 / 2) * (double)large.cols;  // rows are filled by 0..255
+    EXPECT_EQ(cv::Scalar(expectedSum, expectedSum, expectedSum, 0), cv::sum(large));
+    EXPECT_EQ(16 * 16, cv::sum(small)[0]);
+
+    cv::Mat roi = large(cv::Rect(10, 10, 100, 100)).clone();
+    large.release();
+    EXPECT_EQ(10, roi.at<cv::Vec3b>(0, 0)[0]);
+}
+
+TEST(Core_Allocator, pooled_allocator)
+{
+    cv::MatAllocator* pooled = cv::utils::getPooledMatAllocator();
+    ASSERT_TRUE(pooled != NULL);
+    cv::utils::trimPooledMatAllocator();
+    cv::utils::resetPooledMatAllocatorStats();
+
+    cv::utils::PooledMatAllocatorStats stats;
+    const uchar* largeData = NULL;
+    const uchar* smallData = NULL;
+    for (int iter = 0; iter < 3; iter++)
+    {
+        cv::Mat large, small;
+        large.allocator = pooled;
+        small.allocator = pooled;
+        large.create(1080, 1920, CV_8UC3);
+        small.create(10, 10, CV_32FC1);  // thread cache
+        ASSERT_TRUE(large.isContinuous());
+        EXPECT_EQ(large.u->currAllocator, pooled);
+        if (iter == 0)
+        {
+            largeData = large.data;
+            smallData = small.data;
+        }
+        else
+        {
+            // released buffers are reused
+            EXPECT_EQ(largeData, large.data);
+            EXPECT_EQ(smallData, small.data);
+        }
+        large.setTo(cv::Scalar::all(iter));
+        EXPECT_EQ(iter * 1080 * 1920, cv::sum(large)[0]);
+
+        cv::utils::getPooledMatAllocatorStats(stats);
+        EXPECT_EQ(0u, stats.bytesHeld);
+        EXPECT_GE(stats.bytesInUse, large.total() * large.elemSize() + small.total() * small.elemSize());
+        EXPECT_LE(stats.bytesInUse, (large.total() * large.elemSize() + small.total() * small.elemSize()) * 5 / 4);
+    }
+
+    cv::utils::getPooledMatAllocatorStats(stats);
+    EXPECT_EQ(2, stats.misses);
+    EXPECT_EQ(4, stats.hits);
+    EXPECT_EQ(0u, stats.bytesInUse);
+    EXPECT_GE(stats.bytesHeld, (size_t)1080 * 1920 * 3);
+
+    cv::BufferPoolController* controller = pooled->getBufferPoolController();
+    ASSERT_TRUE(controller != NULL);
+    EXPECT_EQ(stats.bytesHeld, controller->getReservedSize());
+    EXPECT_EQ(stats.maxBytesHeld, controller->getMaxReservedSize());
+
+    cv::utils::trimPooledMatAllocator(0);
+    cv::Mat m;
+    m.allocator = pooled;
+    m.create(16, 16, CV_8UC1);  // applies trim to the thread cache
+    cv::utils::getPooledMatAllocatorStats(stats);
+    EXPECT_EQ(0u, stats.bytesHeld);
+
+    // buffers over the limit are not kept
+    const size_t maxReserved = controller->getMaxReservedSize();
+    controller->setMaxReservedSize(1 << 20);
+    {
+        cv::Mat large;
+        large.allocator = pooled;
+        large.create(1080, 1920, CV_8UC3);
+    }
+    EXPECT_EQ(0u, controller->getReservedSize());
+    controller->setMaxReservedSize(maxReserved);
+}
+
+TEST(Core_Allocator, allocator_scope)
+{
+    cv::MatAllocator* defaultAllocator = cv::Mat::getDefaultAllocator();
+    cv::MatAllocator* pooled = cv::utils::getPooledMatAllocator();
+    {
+        cv::utils::MatAllocatorScope scope(pooled);
+        EXPECT_EQ(pooled, cv::Mat::getDefaultAllocator());
+        cv::Mat m(100, 100, CV_8UC1, cv::Scalar(1));
+        EXPECT_EQ(pooled, m.u->currAllocator);
+        {
+            cv::utils::MatAllocatorScope nested(cv::Mat::getStdAllocator());
+            EXPECT_EQ(cv::Mat::getStdAllocator(), cv::Mat::getDefaultAllocator());
+        }
+        EXPECT_EQ(pooled, cv::Mat::getDefaultAllocator());
+
+        // other threads are not affected
+        cv::MatAllocator* threadAllocator = NULL;
+        std::thread t([&]() { threadAllocator = cv::Mat::getDefaultAllocator(); });
+        t.join();
+        EXPECT_EQ(defaultAllocator, threadAllocator);
+    }
+    EXPECT_EQ(defaultAllocator, cv::Mat::getDefaultAllocator());
+}
+
 }} // namespace
@@ -7,6 +7,7 @@
 #include "opencv2/core/utils/logger.hpp"
 
 #include <opencv2/core/utils/fp_control_utils.hpp>
+#include <opencv2/core/utils/parallel_telemetry.hpp>
 
 #include <chrono>
 #include <thread>
@@ -304,6 +305,125 @@ TEST(Core_Parallel, propagate_fp_denormals_ignore_hint)
     }
 }
 
+TEST(Core_Parallel, workstealing_concurrent_and_nested_calls)
+{
+    if (std::string(cv::currentParallelFramework()) != "workstealing")
+        throw SkipTestException("Work-stealing parallel backend is not used");
+
+    const int prevNumThreads = cv::getNumThreads();
+    cv::setNumThreads(4);
+
+    const int N = 64, M = 16;
+    std::atomic<int> nestedParallelCalls(0);
+    std::vector<std::thread> callers;
+    std::vector<Mat> results(6);
+    for (int c = 0; c < (int)results.size(); c++)
+    {
+        callers.push_back(std::thread([&, c]() {
+            for (int iter = 0; iter < 5; iter++)
+            {
+                Mat& counters = results[c];
+                counters = Mat::zeros(N, M, CV_32S);
+                parallel_for_(Range(0, N), [&](const Range& r) {
+                    for (int i = r.start; i < r.end; i++)
+                    {
+                        std::mutex threadsMutex;
+                        std::set<int> threads;
+                        parallel_for_(Range(0, M), [&](const Range& r2) {
+                            {
+                                std::lock_guard<std::mutex> lock(threadsMutex);
+                                threads.insert(cv::getThreadNum());
+                            }
+                            for (int j = r2.start; j < r2.end; j++)
+                            {
+                                counters.at<int>(i, j)++;
+                                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                            }
+                        });
+                        if (threads.size() > 1)
+                            nestedParallelCalls++;
+                    }
+                });
+                EXPECT_EQ(N * M, cv::countNonZero(counters == 1)) << "caller=" << c << " iter=" << iter;
+            }
+        }));
+    }
+    for (size_t i = 0; i < callers.size(); i++)
+        callers[i].join();
+
+    cv::setNumThreads(prevNumThreads);
+
+    // legacy thread pool executes nested and concurrent calls serially
+    EXPECT_GT(nestedParallelCalls.load(), 0);
+}
+
+TEST(Core_Parallel, telemetry)
+{
+    const bool prevEnabled = cv::utils::isParallelTelemetryEnabled();
+    const int prevNumThreads = cv::getNumThreads();
+    cv::setNumThreads(4);
+    cv::utils::setParallelTelemetryEnabled(true);
+    cv::utils::resetParallelTelemetry();
+
+    const int N = 32;
+    std::atomic<int> processed(0);
+    parallel_for_(Range(0, N), [&](const Range& r) {
+        for (int i = r.start; i < r.end; i++)
+        {
+            processed++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    parallel_for_(Range(0, 1), [&](const Range& r) { processed += r.size(); });
+
+    cv::utils::ParallelTelemetry stat;
+    cv::utils::getParallelTelemetry(stat);
+    cv::utils::setParallelTelemetryEnabled(false);
+    cv::setNumThreads(prevNumThreads);
+
+    EXPECT_EQ(N + 1, processed.load());
+    EXPECT_EQ(2, stat.jobs);
+    EXPECT_EQ(1, stat.parallelJobs);
+    EXPECT_EQ(0, stat.serialFallbacks);
+    EXPECT_GT(stat.totalTimeMs, 0.);
+    EXPECT_GE(stat.totalTimeMs, stat.maxTimeMs);
+    ASSERT_EQ(2u, stat.recentJobs.size());
+    const cv::utils::ParallelJobTelemetry& job = stat.recentJobs[0];
+    EXPECT_EQ(N, job.rangeSize);
+    EXPECT_EQ(N, job.stripes);
+    EXPECT_EQ(stat.stripes, job.stripes);
+    EXPECT_LE(job.callerStripes, job.stripes);
+    EXPECT_GT(job.wallTimeMs, 0.);
+    EXPECT_TRUE(stat.recentJobs[1].serial);
+    EXPECT_EQ(1, stat.recentJobs[1].stripes);
+
+    const std::string backend = stat.backend;
+    if (backend == "workstealing" || backend == "pthreads")
+    {
+        ASSERT_FALSE(stat.workers.empty());
+        int64 workerTasks = 0;
+        for (size_t i = 0; i < stat.workers.size(); i++)
+        {
+            workerTasks += stat.workers[i].tasks;
+            EXPECT_GE(stat.workers[i].busyMs, 0.);
+        }
+        EXPECT_GT(workerTasks, 0);
+        EXPECT_FALSE(job.serial);
+    }
+
+    // disabled telemetry is not collected
+    parallel_for_(Range(0, N), [&](const Range&) {});
+    cv::utils::ParallelTelemetry stat2;
+    cv::utils::getParallelTelemetry(stat2);
+    EXPECT_EQ(stat.jobs, stat2.jobs);
+    cv::utils::resetParallelTelemetry();
+    cv::utils::getParallelTelemetry(stat2);
+    EXPECT_EQ(0, stat2.jobs);
+    EXPECT_TRUE(stat2.recentJobs.empty());
+
+    cv::utils::setParallelTelemetryEnabled(prevEnabled);
+}
+
 TEST(Core_Version, consistency)
 {
     // this test verifies that OpenCV version loaded in runtime
@@ -7,6 +7,7 @@
 #define CV_LOG_STRIP_LEVEL CV_LOG_LEVEL_VERBOSE + 1
 #include "opencv2/core/utils/logger.hpp"
 #include "opencv2/core/utils/buffer_area.private.hpp"
+#include "opencv2/core/utils/arena.hpp"
 
 #include "opencv2/core/utils/filesystem.private.hpp"
 
@@ -494,5 +495,99 @@ TEST_P(BufferArea, bad)
 
 INSTANTIATE_TEST_CASE_P(/**/, BufferArea, testing::Values(true, false));
 
+TEST(ArenaScope, basic)
+{
+    using cv::utils::ArenaScope;
+    cv::utils::ArenaScope::releaseMemory();
+    EXPECT_FALSE(ArenaScope::isActive());
+    EXPECT_TRUE(ArenaScope::allocate(100) == NULL);
+
+    const int* first = NULL;
+    size_t reserved = 0;
+    for (int iter = 0; iter < 3; iter++)
+    {
+        ArenaScope arena;
+        EXPECT_TRUE(ArenaScope::isActive());
+
+        int* buf = NULL;
+        double* buf2 = NULL;
+        cv::utils::BufferArea area;
+        area.allocate(buf, 1000);
+        area.allocate(buf2, 1 << 20, 64);  // the arena grows on the first iteration
+        area.commit();
+        ASSERT_TRUE(buf != NULL);
+        ASSERT_TRUE(buf2 != NULL);
+        EXPECT_EQ(0u, (size_t)buf2 % 64);
+        buf[999] = iter;
+        buf2[(1 << 20) - 1] = iter;
+        if (iter > 0)
+        {
+            EXPECT_EQ(reserved, ArenaScope::getReservedSize());  // no allocations after warm-up
+        }
+        if (iter == 1)
+        {
+            first = buf;
+        }
+        else if (iter > 1)
+        {
+            EXPECT_EQ(first, buf);
+        }
+        reserved = ArenaScope::getReservedSize();
+        EXPECT_GE(reserved, (1000 * sizeof(int) + (1 << 20) * sizeof(double)));
+
+        // Mat temporaries reuse buffers
+        cv::Mat m(100, 100, CV_8UC1);
+        EXPECT_EQ(cv::utils::getPooledMatAllocator(), m.u->currAllocator);
+    }
+    EXPECT_FALSE(ArenaScope::isActive());
+    EXPECT_NE(cv::utils::getPooledMatAllocator(), cv::Mat::getDefaultAllocator());
+
+    cv::utils::ArenaScope::releaseMemory();
+    EXPECT_EQ(0u, ArenaScope::getReservedSize());
+}
+
+TEST(ArenaScope, nested)
+{
+    using cv::utils::ArenaScope;
+    ArenaScope arena;
+    void* a = ArenaScope::allocate(100);
+    ASSERT_TRUE(a != NULL);
+    void* b = NULL;
+    {
+        ArenaScope inner;
+        b = ArenaScope::allocate(1000);
+        ASSERT_TRUE(b != NULL);
+        EXPECT_NE(a, b);
+    }
+    // space of the inner scope is reclaimed
+    void* c = ArenaScope::allocate(1000);
+    EXPECT_EQ(b, c);
+
+    // LIFO deallocation
+    ArenaScope::deallocate(c, 1000);
+    void* d = ArenaScope::allocate(500);
+    EXPECT_EQ(c, d);
+}
+
+TEST(ArenaScope, parallel_for)
+{
+    using cv::utils::ArenaScope;
+    cv::Mat_<int> active(1, 16, 0);
+    {
+        ArenaScope arena;
+        cv::parallel_for_(cv::Range(0, active.cols), [&](const cv::Range& r) {
+            for (int i = r.start; i < r.end; i++)
+                active(0, i) = ArenaScope::isActive() && ArenaScope::allocate(16) != NULL ? 1 : 0;
+        });
+    }
+    EXPECT_EQ(active.cols, cv::countNonZero(active));
+    // workers' scopes are closed
+    cv::parallel_for_(cv::Range(0, active.cols), [&](const cv::Range& r) {
+        for (int i = r.start; i < r.end; i++)
+            active(0, i) = ArenaScope::isActive() ? 1 : 0;
+    });
+    EXPECT_EQ(0, cv::countNonZero(active));
+}
+
 
 }} // namespace
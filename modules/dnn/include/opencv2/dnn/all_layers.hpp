@@ -292,6 +292,7 @@ CV__DNN_INLINE_NS_BEGIN
         bool fusedActivation = false;
         bool fusedAdd = false;
         bool useWinograd = true; // Flag whether to use Winograd to speed up 3x3 convolution.
+        int weightsType = DNN_WEIGHTS_FP32; // Storage type of packed weights, see WeightsType.
     };
 
     class CV_EXPORTS ConvolutionLayerInt8 : public BaseConvolutionLayer
@@ -1156,12 +1157,19 @@ CV__DNN_INLINE_NS_BEGIN
         bool trans_b;
         float alpha;
         float beta;
+        bool fusedActivation = false;
+        bool fusedAdd = false;  //!< output already holds a residual to accumulate to
+        bool dynamicQuantization = false;  //!< use int8 weights and runtime quantization of inputs on CPU
 
         static Ptr<GemmLayer> create(const LayerParams& params);
     };
 
     class CV_EXPORTS MatMulLayer : public Layer {
      public:
+        bool fusedActivation = false;
+        bool fusedAdd = false;  //!< output already holds a residual to accumulate to
+        bool dynamicQuantization = false;  //!< use int8 weights and runtime quantization of inputs on CPU
+
         static Ptr<MatMulLayer> create(const LayerParams &params);
     };
 
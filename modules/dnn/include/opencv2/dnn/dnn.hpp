@@ -122,6 +122,17 @@ CV__DNN_INLINE_NS_BEGIN
         DNN_LAYOUT_PLANAR = 6,     //!< Tensorflow-like data layout, it should only be used at tf or tflite model parsing.
     };
 
+    /**
+     * @brief Enum of storage types for packed weights of CPU layers.
+     * @see Net::setPreferableWeightsType
+     */
+    enum WeightsType
+    {
+        DNN_WEIGHTS_FP32 = 0,  //!< Full precision weights.
+        DNN_WEIGHTS_FP16 = 1,  //!< Half precision weights, converted to FP32 during computation.
+        DNN_WEIGHTS_BF16 = 2,  //!< Brain floating point weights, converted to FP32 during computation.
+    };
+
     CV_EXPORTS std::vector< std::pair<Backend, Target> > getAvailableBackends();
     CV_EXPORTS_W std::vector<Target> getAvailableTargets(dnn::Backend be);
 
@@ -137,6 +148,24 @@ CV__DNN_INLINE_NS_BEGIN
      */
     CV_EXPORTS void enableModelDiagnostics(bool isDiagnosticsMode);
 
+    /**
+     * @brief Sets the directory of the persistent cache of packed layer weights.
+     * @param[in] path cache directory, empty path disables the cache.
+     *
+     * During network initialization CPU layers of DNN_BACKEND_OPENCV transform weights into kernel
+     * specific layouts (convolution packing, Winograd transform, GEMM packing). With the cache enabled
+     * transformed weights are stored in this directory and loaded instead of being recomputed when
+     * the same weights are initialized again, e.g. on the next start of the application.
+     * Entries are keyed by the source weights, packing parameters, OpenCV version and CPU features.
+     * Default value is taken from OPENCV_DNN_PACKED_WEIGHTS_CACHE_DIR environment variable.
+     */
+    CV_EXPORTS_W void setPackedWeightsCacheDir(const String& path);
+
+    /** @brief Returns the directory of the persistent cache of packed layer weights.
+     * @see setPackedWeightsCacheDir
+     */
+    CV_EXPORTS_W String getPackedWeightsCacheDir();
+
     /** @brief This class provides all data needed to initialize layer.
      *
      * It includes dictionary with scalar params (which can be read by using Dict interface),
@@ -461,6 +490,33 @@ CV__DNN_INLINE_NS_BEGIN
         virtual ~Layer();
     };
 
+    /** @brief Profile of a single layer collected during the last Net::forward() call.
+     *
+     * Traffic is estimated as the size of layer inputs and weights (read) and outputs (written),
+     * so achieved throughput and arithmetic intensity can be placed on a roofline plot.
+     * @see Net::getLayersProfile
+     */
+    struct CV_EXPORTS LayerProfile
+    {
+        int id;               //!< Layer id.
+        String name;          //!< Layer name.
+        String type;          //!< Layer type.
+        bool fused;           //!< Layer is fused into another one and is not computed separately.
+        double startMs;       //!< Start time relative to the first computed layer, in milliseconds.
+        double timeMs;        //!< Wall time of the layer, in milliseconds.
+        int64 flops;          //!< Number of floating point operations reported by Layer::getFLOPS().
+        int64 bytesRead;      //!< Size of inputs and weights.
+        int64 bytesWritten;   //!< Size of outputs.
+        double gflops;        //!< Achieved performance, GFLOP/s.
+        double gbps;          //!< Achieved memory throughput, GB/s.
+        double arithmeticIntensity;  //!< FLOPs per byte of memory traffic.
+        String kernel;        //!< Implementation selected by the layer (e.g. "winograd_f63", "im2col_generic"), empty if unknown.
+        int threads;          //!< Number of threads available to the layer (see cv::getNumThreads()).
+        int worker;           //!< Index of the inter-op thread which computed the layer, 0 is the calling thread (see Net::setNumInterOpThreads()).
+
+        LayerProfile();
+    };
+
     /** @brief This class allows to create and manipulate comprehensive artificial neural networks.
      *
      * Neural network is presented as directed acyclic graph (DAG), where vertices are Layer instances,
@@ -716,6 +772,28 @@ CV__DNN_INLINE_NS_BEGIN
          */
         CV_WRAP void setPreferableTarget(int targetId);
 
+        /**
+         * @brief Ask network to store packed weights of CPU layers in reduced precision.
+         * @param[in] weightsType weights storage type, see WeightsType.
+         *
+         * Computations are still done in FP32: weights are converted in registers, which halves the
+         * memory footprint and bandwidth of weights. Supported by DNN_BACKEND_OPENCV with DNN_TARGET_CPU
+         * for generic convolutions on x86 CPUs with AVX2, other layers and platforms keep FP32 weights.
+         */
+        CV_WRAP void setPreferableWeightsType(int weightsType);
+
+        /**
+         * @brief Sets the number of threads which compute independent layers of the network concurrently.
+         * @param[in] nthreads 0 or 1 (default) computes layers one by one,
+         *                     -1 selects the number of threads by the width of the graph (limited by getNumThreads()).
+         *
+         * Branches of the graph (Inception blocks, multi-head outputs) are scheduled as a DAG.
+         * Heavy layers (see OPENCV_DNN_INTEROP_HEAVY_LAYER_FLOPS) are still computed alone using
+         * all the threads of cv::parallel_for_(), light layers of different branches share the CPU.
+         * Supported by DNN_BACKEND_OPENCV with DNN_TARGET_CPU, ignored for other backends.
+         */
+        CV_WRAP void setNumInterOpThreads(int nthreads);
+
         /** @brief Sets the new input value for the network
          *  @param blob        A new blob. Should have CV_32F or CV_8U depth.
          *  @param name        A name of input layer.
@@ -874,6 +952,82 @@ CV__DNN_INLINE_NS_BEGIN
         */
         CV_WRAP void enableWinograd(bool useWinograd);
 
+        /** @brief Enables or disables dynamic INT8 quantization of Gemm and MatMul layers with constant weights.
+         *
+         * Weights are quantized per output channel once, inputs are quantized per row on every forward pass,
+         * so no calibration data is required (unlike Net::quantize()). Supported by DNN_BACKEND_OPENCV on DNN_TARGET_CPU;
+         * other layers and targets keep FP32 computations.
+         * @param enable true to enable dynamic quantization. The default is false.
+         */
+        CV_WRAP void enableDynamicQuantization(bool enable);
+
+        /** @brief Enables or disables streaming (stateful) inference of recurrent layers.
+         *
+         * In streaming mode LSTM and GRU layers keep their final hidden (and cell) states after forward()
+         * and use them as initial states on the next call, so a sequence can be fed one timestep (or chunk)
+         * at a time. Initial states passed as layer inputs take precedence. Bidirectional and reversed
+         * layers are not supported. Supported by DNN_BACKEND_OPENCV.
+         * @param enable true to enable streaming mode. The default is false. Switching the mode resets states.
+         * @see resetStates, getStates, setStates
+         */
+        CV_WRAP void enableStreaming(bool enable);
+
+        /** @brief Resets states of recurrent layers in streaming mode to their initial values.
+         */
+        CV_WRAP void resetStates();
+
+        /** @brief Returns copies of states of recurrent layers in streaming mode.
+         *
+         * States are ordered by layer id: LSTM layers contribute hidden and cell states, GRU layers contribute
+         * hidden state. States of layers which have not been computed yet are empty.
+         * The snapshot may be restored by setStates(), e.g. to switch between independent streams.
+         * @param[out] states copies of states.
+         */
+        CV_WRAP void getStates(CV_OUT std::vector<Mat>& states) const;
+
+        /** @brief Restores states of recurrent layers in streaming mode.
+         * @param states states in the order returned by getStates(). Empty matrices reset corresponding states.
+         */
+        CV_WRAP void setStates(const std::vector<Mat>& states);
+
+        /** @brief Creates an execution context sharing weights with this network.
+         *
+         * The returned network shares layer instances with this one (weights and prepacked
+         * buffers such as packed convolution or GEMM weights are read-only during inference)
+         * but owns input, output and intermediate blobs. So different threads may run
+         * forward() concurrently on different contexts created from the same network.
+         *
+         * If the network is not allocated yet, it is allocated for the default output and
+         * the input shapes set by setInput(). Lazily initialized data of layers (e.g. packed
+         * convolution weights) is prepared here, so no forward() call is required before.
+         * Contexts work with the same input shapes and outputs as the network at the moment
+         * of creation and can't be reconfigured. The base network must not be modified
+         * (setPreferableBackend(), setParam(), inputs of other shapes, etc.) while contexts are in use.
+         * Layers which keep mutable state between calls (e.g. recurrent layers with the
+         * preserved states) are not safe for concurrent execution.
+         * Supported by DNN_BACKEND_OPENCV on CPU targets only.
+         */
+        CV_WRAP Net createExecutionContext();
+
+        /** @brief Enables or disables static memory planning for intermediate blobs.
+         *
+         * When enabled, lifetimes of all the intermediate blobs are computed before allocation
+         * and the blobs are packed into a single arena (per data type) so that blobs which are alive
+         * at the same time never overlap. It reduces peak memory compared to the default greedy reuse.
+         * Supported by DNN_BACKEND_OPENCV on CPU targets only. Default value is controlled by
+         * OPENCV_DNN_MEMORY_PLANNER environment variable (disabled by default).
+         * @param enable true to enable memory planning.
+         */
+        CV_WRAP void enableMemoryPlanner(bool enable);
+
+        /** @brief Returns statistics of the memory plan computed during the last network allocation.
+         * @param[out] plannedBytes memory used by the planned arenas.
+         * @param[out] naiveBytes memory required if every intermediate blob got its own buffer.
+         *
+         * Both values are zero if the memory planner is disabled or the network is not allocated yet.
+         */
+        CV_WRAP void getMemoryPlanStatistics(CV_OUT size_t& plannedBytes, CV_OUT size_t& naiveBytes) const;
+
         /** @brief Returns overall time for inference and timings (in ticks) for layers.
          *
          * Indexes in returned vector correspond to layers ids. Some layers can be fused with others,
@@ -884,6 +1038,29 @@ CV__DNN_INLINE_NS_BEGIN
          */
         CV_WRAP int64 getPerfProfile(CV_OUT std::vector<double>& timings);
 
+        /** @brief Returns detailed per-layer profile of the last forward pass.
+         *
+         * In addition to timings it reports FLOPs, memory traffic, achieved GFLOP/s and GB/s,
+         * selected kernel and number of threads of every layer. Fused layers are reported with zero time.
+         * Timings are supported by DNN_BACKEND_OPENCV on DNN_TARGET_CPU only.
+         *
+         * @param[out] profile per-layer profiles ordered by layer id (the network input layer is not included).
+         */
+        void getLayersProfile(CV_OUT std::vector<LayerProfile>& profile) const;
+
+        /** @brief Dumps profile of the last forward pass as JSON.
+         * @see getLayersProfile
+         */
+        CV_WRAP String dumpProfile() const;
+
+        /** @brief Dumps profile of the last forward pass in Chrome trace event format.
+         *
+         * The result can be loaded into chrome://tracing or https://ui.perfetto.dev.
+         * Layers are placed on the tracks of inter-op threads which computed them (LayerProfile::worker).
+         * @see getLayersProfile
+         */
+        CV_WRAP String dumpProfileChromeTrace() const;
+
 
         struct Impl;
         inline Impl* getImpl() const { return impl.get(); }
@@ -1136,7 +1313,7 @@ CV__DNN_INLINE_NS_BEGIN
      *  @param swapRB flag which indicates that swap first and last channels
      *  in 3-channel image is necessary.
      *  @param crop flag which indicates whether image will be cropped after resize or not
-     *  @param ddepth Depth of output blob. Choose CV_32F or CV_8U.
+     *  @param ddepth Depth of output blob. Choose CV_32F, CV_16F or CV_8U.
      *  @details if @p crop is true, input image is resized so one side after resize is equal to corresponding
      *  dimension in @p size and another one is equal or larger. Then, crop from the center is performed.
      *  If @p crop is false, direct resize without cropping and preserving aspect ratio is performed.
@@ -1169,7 +1346,7 @@ CV__DNN_INLINE_NS_BEGIN
      *  @param swapRB flag which indicates that swap first and last channels
      *  in 3-channel image is necessary.
      *  @param crop flag which indicates whether image will be cropped after resize or not
-     *  @param ddepth Depth of output blob. Choose CV_32F or CV_8U.
+     *  @param ddepth Depth of output blob. Choose CV_32F, CV_16F or CV_8U.
      *  @details if @p crop is true, input image is resized so one side after resize is equal to corresponding
      *  dimension in @p size and another one is equal or larger. Then, crop from the center is performed.
      *  If @p crop is false, direct resize without cropping and preserving aspect ratio is performed.
@@ -1226,10 +1403,15 @@ CV__DNN_INLINE_NS_BEGIN
         CV_PROP_RW Size size;    //!< Spatial size for output image.
         CV_PROP_RW Scalar mean;  //!< Scalar with mean values which are subtracted from channels.
         CV_PROP_RW bool swapRB;  //!< Flag which indicates that swap first and last channels
-        CV_PROP_RW int ddepth;   //!< Depth of output blob. Choose CV_32F or CV_8U.
+        CV_PROP_RW int ddepth;   //!< Depth of output blob. Choose CV_32F, CV_16F or CV_8U.
         CV_PROP_RW DataLayout datalayout; //!< Order of output dimensions. Choose DNN_LAYOUT_NCHW or DNN_LAYOUT_NHWC.
         CV_PROP_RW ImagePaddingMode paddingmode;   //!< Image padding mode. @see ImagePaddingMode.
         CV_PROP_RW Scalar borderValue;   //!< Value used in padding mode for padding.
+        /** Resize images within the normalization pass, the source pixels are read once.
+         *  Bilinear interpolation is computed in floating point without intermediate rounding to the image depth,
+         *  so the results differ from @ref resize by a rounding error of 8-bit images. Default is false.
+         */
+        CV_PROP_RW bool fusedResize;
 
         /** @brief Get rectangle coordinates in original image system from rectangle in blob coordinates.
          *  @param rBlob rect in blob coordinates.
@@ -1251,6 +1433,10 @@ CV__DNN_INLINE_NS_BEGIN
      *  @details This function is an extension of @ref blobFromImage to meet more image preprocess needs.
      *  Given input image and preprocessing parameters, and function outputs the blob.
      *
+     *  For Mat inputs of CV_8U or CV_32F depth and CV_32F or CV_16F blobs, channel swapping, mean subtraction,
+     *  scaling and layout conversion are done in a single parallel pass which writes the blob directly.
+     *  Set Image2BlobParams::fusedResize to include resizing into this pass.
+     *
      *  @param image input image (all with 1-, 3- or 4-channels).
      *  @param param struct of Image2BlobParams, contains all parameters needed by processing of image to blob.
      *  @return 4-dimensional Mat.
@@ -1932,6 +2118,71 @@ public:
     CV_WRAP int getMaxCandidates() const;
 };
 
+/** @brief Dynamic batching front-end for a network.
+ *
+ * Collects single-sample inference requests submitted by multiple threads into batches
+ * and runs one forward pass per batch in a dedicated worker thread. A batch is launched
+ * when it has @ref Params::maxBatchSize requests or when the oldest request in the queue
+ * waited for @ref Params::maxDelayUs microseconds. Results are scattered back through
+ * AsyncArray objects.
+ *
+ * Partial batches are padded up to the next power of two (or to the maximal batch size), so the network
+ * is reinitialized for a few batch sizes only and a lone request doesn't pay for the whole batch.
+ * The executor takes ownership of the network: it must not be used by other threads meanwhile.
+ */
+class CV_EXPORTS BatchingExecutor
+{
+public:
+    struct CV_EXPORTS Params
+    {
+        Params();
+
+        int maxBatchSize;    //!< maximal number of requests in a batch
+        int64 maxDelayUs;    //!< maximal time (in microseconds) the first request of a batch waits for other ones
+        String outputName;   //!< name of the output layer, the last layer by default
+    };
+
+    struct CV_EXPORTS Statistics
+    {
+        Statistics();
+
+        int64 numRequests;   //!< number of processed requests
+        int64 numBatches;    //!< number of forward passes
+        /** Batch fill histogram: element i is the number of batches with i + 1 requests */
+        std::vector<int64> batchFill;
+        /** Queue latency histogram: element i is the number of requests waited for
+         *  [2^i, 2^(i+1)) microseconds before the forward pass (the first bin includes shorter waits) */
+        std::vector<int64> queueLatency;
+        double totalQueueLatencyMs;  //!< sum of queue latencies of all the requests
+        double totalForwardMs;       //!< sum of forward pass times of all the batches
+    };
+
+    /** @brief Starts the worker thread.
+     *  @param[in] network network with a single input. Batch is the first dimension of its input and output.
+     *  @param[in] params batching parameters.
+     */
+    BatchingExecutor(const Net& network, const Params& params = Params());
+
+    /** @brief Processes pending requests and stops the worker thread. */
+    ~BatchingExecutor();
+
+    /** @brief Enqueues a single-sample request.
+     *  @param[in] blob input blob with batch dimension equal to 1 (for example, from blobFromImage()).
+     *  @returns asynchronous result with the corresponding slice of the network output.
+     */
+    AsyncArray submit(InputArray blob);
+
+    /** @brief Returns statistics collected since the construction or the last resetStatistics() call. */
+    Statistics getStatistics() const;
+
+    /** @brief Clears the collected statistics. Requests which are being processed are counted in the new statistics. */
+    void resetStatistics();
+
+    struct Impl;
+protected:
+    Ptr<Impl> impl;
+};
+
 //! @}
 CV__DNN_INLINE_NS_END
 }
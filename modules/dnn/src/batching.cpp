@@ -0,0 +1,270 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include <opencv2/core/detail/async_promise.hpp>
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <deque>
+#endif
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+
+BatchingExecutor::Params::Params()
+    : maxBatchSize(8)
+    , maxDelayUs(1000)
+{
+    // nothing
+}
+
+BatchingExecutor::Statistics::Statistics()
+    : numRequests(0)
+    , numBatches(0)
+    , totalQueueLatencyMs(0)
+    , totalForwardMs(0)
+{
+    // nothing
+}
+
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+
+struct BatchingExecutor::Impl
+{
+    typedef std::chrono::steady_clock Clock;
+
+    struct Request
+    {
+        Mat blob;
+        AsyncPromise promise;
+        Clock::time_point enqueueTime;
+    };
+
+    Net net;
+    Params params;
+
+    mutable std::mutex mtx;
+    std::condition_variable cond;
+    std::deque<Request> queue;
+    bool stopping;
+    Statistics stats;
+
+    std::thread worker;
+
+    Impl(const Net& network, const Params& params_)
+        : net(network)
+        , params(params_)
+        , stopping(false)
+    {
+        CV_CheckGE(params.maxBatchSize, 1, "");
+        CV_Assert(params.maxDelayUs >= 0);
+        clearStatistics();
+        worker = std::thread(&Impl::run, this);
+    }
+
+    ~Impl()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cond.notify_all();
+        if (worker.joinable())
+            worker.join();
+    }
+
+    AsyncArray submit(InputArray blob)
+    {
+        Request request;
+        blob.getMat().copyTo(request.blob);
+        CV_CheckGE(request.blob.dims, 2, "DNN/Batching: input blob must have batch dimension");
+        CV_CheckEQ(request.blob.size[0], 1, "DNN/Batching: input blob must contain a single sample");
+        AsyncArray result = request.promise.getArrayResult();
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            CV_Assert(!stopping);
+            request.enqueueTime = Clock::now();
+            queue.push_back(std::move(request));
+        }
+        cond.notify_one();
+        return result;
+    }
+
+    Statistics getStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        return stats;
+    }
+
+    void resetStatistics()
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        clearStatistics();
+    }
+
+    void clearStatistics()
+    {
+        stats = Statistics();
+        stats.batchFill.assign(params.maxBatchSize, 0);
+        stats.queueLatency.assign(32, 0);
+    }
+
+    // Takes requests of the same shape from the queue head. Waits until the batch is full
+    // or the first request is too old. Returns an empty batch when stopped.
+    void collectBatch(std::vector<Request>& batch)
+    {
+        batch.clear();
+        std::unique_lock<std::mutex> lock(mtx);
+        cond.wait(lock, [&]() { return stopping || !queue.empty(); });
+        if (queue.empty())
+            return;
+
+        const Clock::time_point deadline = queue.front().enqueueTime + std::chrono::microseconds(params.maxDelayUs);
+        cond.wait_until(lock, deadline, [&]() { return stopping || (int)queue.size() >= params.maxBatchSize; });
+
+        const MatShape sampleShape = shape(queue.front().blob);
+        const int sampleType = queue.front().blob.type();
+        while (!queue.empty() && (int)batch.size() < params.maxBatchSize &&
+               shape(queue.front().blob) == sampleShape && queue.front().blob.type() == sampleType)
+        {
+            batch.push_back(std::move(queue.front()));
+            queue.pop_front();
+        }
+    }
+
+    void processBatch(std::vector<Request>& batch)
+    {
+        CV_TRACE_FUNCTION();
+
+        const Clock::time_point startTime = Clock::now();
+        const Mat& first = batch[0].blob;
+        MatShape batchShape = shape(first);
+        // partial batches are padded to a power of two: a few batch sizes cause network reinitialization
+        int batchSize = 1;
+        while (batchSize < (int)batch.size())
+            batchSize *= 2;
+        batchSize = std::min(batchSize, params.maxBatchSize);
+        batchShape[0] = batchSize;
+
+        Mat input(batchShape, first.type());
+        const size_t sampleSize = first.total() * first.elemSize();
+        for (size_t i = 0; i < batch.size(); i++)
+            std::memcpy(input.ptr() + i * sampleSize, batch[i].blob.ptr(), sampleSize);
+        std::memset(input.ptr() + batch.size() * sampleSize, 0, (batchSize - batch.size()) * sampleSize);
+
+        try
+        {
+            net.setInput(input);
+            Mat output = net.forward(params.outputName);
+            CV_CheckEQ(output.size[0], batchSize, "DNN/Batching: output blob must keep the batch dimension");
+
+            MatShape sampleShape = shape(output);
+            sampleShape[0] = 1;
+            const size_t outSampleSize = total(sampleShape) * output.elemSize();
+            for (size_t i = 0; i < batch.size(); i++)
+            {
+                Mat sample(sampleShape, output.type());
+                std::memcpy(sample.ptr(), output.ptr() + i * outSampleSize, outSampleSize);
+                batch[i].promise.setValue(sample);
+            }
+        }
+        catch (const cv::Exception& e)
+        {
+            for (size_t i = 0; i < batch.size(); i++)
+                batch[i].promise.setException(e);
+        }
+        catch (const std::exception& e)
+        {
+            cv::Exception cvException(Error::StsError, e.what(), CV_Func, __FILE__, __LINE__);
+            for (size_t i = 0; i < batch.size(); i++)
+                batch[i].promise.setException(cvException);
+        }
+
+        const Clock::time_point endTime = Clock::now();
+        std::lock_guard<std::mutex> lock(mtx);
+        stats.numBatches++;
+        stats.numRequests += batch.size();
+        stats.batchFill[batch.size() - 1]++;
+        stats.totalForwardMs += std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+            const int64 waitUs = std::chrono::duration_cast<std::chrono::microseconds>(startTime - batch[i].enqueueTime).count();
+            int bin = 0;
+            while (bin + 1 < (int)stats.queueLatency.size() && (waitUs >> (bin + 1)) > 0)
+                bin++;
+            stats.queueLatency[bin]++;
+            stats.totalQueueLatencyMs += waitUs * 1e-3;
+        }
+    }
+
+    void run()
+    {
+        std::vector<Request> batch;
+        for (;;)
+        {
+            collectBatch(batch);
+            if (batch.empty())
+                break;
+            processBatch(batch);
+        }
+    }
+};
+
+#else  // OPENCV_DISABLE_THREAD_SUPPORT
+
+struct BatchingExecutor::Impl
+{
+    Impl(const Net&, const Params&)
+    {
+        CV_Error(Error::StsNotImplemented, "DNN/Batching: OpenCV is built without threading support");
+    }
+    AsyncArray submit(InputArray) { return AsyncArray(); }
+    Statistics getStatistics() const { return Statistics(); }
+    void resetStatistics() {}
+};
+
+#endif  // OPENCV_DISABLE_THREAD_SUPPORT
+
+
+BatchingExecutor::BatchingExecutor(const Net& network, const Params& params)
+    : impl(makePtr<Impl>(network, params))
+{
+    // nothing
+}
+
+BatchingExecutor::~BatchingExecutor()
+{
+    // nothing
+}
+
+AsyncArray BatchingExecutor::submit(InputArray blob)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->submit(blob);
+}
+
+BatchingExecutor::Statistics BatchingExecutor::getStatistics() const
+{
+    CV_Assert(impl);
+    return impl->getStatistics();
+}
+
+void BatchingExecutor::resetStatistics()
+{
+    CV_Assert(impl);
+    impl->resetStatistics();
+}
+
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
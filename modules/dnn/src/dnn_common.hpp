@@ -31,6 +31,15 @@ size_t getParam_DNN_NETWORK_DUMP();
 /// This parameter is useful to run with valgrind memory errors detection
 bool getParam_DNN_DISABLE_MEMORY_OPTIMIZATIONS();
 
+/// Enables static memory planning of intermediate blobs by default
+bool getParam_DNN_MEMORY_PLANNER();
+
+/// Default directory of the persistent cache of packed weights
+std::string getParam_DNN_PACKED_WEIGHTS_CACHE_DIR();
+
+/// Layers with more FLOPs are not computed concurrently with other layers by the inter-op scheduler
+size_t getParam_DNN_INTEROP_HEAVY_LAYER_FLOPS();
+
 #ifdef HAVE_OPENCL
 bool getParam_DNN_OPENCL_ALLOW_ALL_DEVICES();
 #endif
@@ -107,6 +116,38 @@ private:
     std::unordered_map<std::string, std::unordered_set<std::string>> layers;
 };
 
+// Optional interface of layers which report implementation selected for the current configuration
+// (used by per-layer profiling, see Net::getLayersProfile())
+class LayerKernelInfo
+{
+public:
+    virtual ~LayerKernelInfo() {}
+    virtual std::string getKernelName() const = 0;
+};
+
+// Optional interface of layers which initialize data (e.g. packed weights) on the first forward() call.
+// It is called before the layer instance is shared by execution contexts (see Net::createExecutionContext()),
+// so forward() doesn't modify the layer instance anymore.
+class LazyInitializedLayer
+{
+public:
+    virtual ~LazyInitializedLayer() {}
+    virtual void initForward(const std::vector<Mat>& inputs, const std::vector<Mat>& outputs) = 0;
+};
+
+// Optional interface of layers which keep state between forward() calls in streaming mode
+// (recurrent layers, see Net::enableStreaming())
+class StatefulLayer
+{
+public:
+    virtual ~StatefulLayer() {}
+    virtual void setStreaming(bool streaming) = 0;
+    virtual int getNumStates() const = 0;
+    virtual void resetState() = 0;
+    virtual void getState(std::vector<Mat>& states) const = 0;  // appends getNumStates() copies of states
+    virtual void setState(const Mat* states) = 0;  // getNumStates() states, empty ones reset state
+};
+
 struct NetImplBase
 {
     const int networkId;  // network global identifier
@@ -25,6 +25,24 @@ bool getParam_DNN_DISABLE_MEMORY_OPTIMIZATIONS()
     return DNN_DISABLE_MEMORY_OPTIMIZATIONS;
 }
 
+bool getParam_DNN_MEMORY_PLANNER()
+{
+    static bool DNN_MEMORY_PLANNER = utils::getConfigurationParameterBool("OPENCV_DNN_MEMORY_PLANNER", false);
+    return DNN_MEMORY_PLANNER;
+}
+
+size_t getParam_DNN_INTEROP_HEAVY_LAYER_FLOPS()
+{
+    static size_t DNN_INTEROP_HEAVY_LAYER_FLOPS = utils::getConfigurationParameterSizeT("OPENCV_DNN_INTEROP_HEAVY_LAYER_FLOPS", 20000000);
+    return DNN_INTEROP_HEAVY_LAYER_FLOPS;
+}
+
+std::string getParam_DNN_PACKED_WEIGHTS_CACHE_DIR()
+{
+    static std::string DNN_PACKED_WEIGHTS_CACHE_DIR = utils::getConfigurationParameterString("OPENCV_DNN_PACKED_WEIGHTS_CACHE_DIR", "");
+    return DNN_PACKED_WEIGHTS_CACHE_DIR;
+}
+
 #ifdef HAVE_OPENCL
 bool getParam_DNN_OPENCL_ALLOW_ALL_DEVICES()
 {
@@ -5,6 +5,7 @@
 #include "precomp.hpp"
 
 #include <opencv2/imgproc.hpp>
+#include <opencv2/core/hal/intrin.hpp>
 #include <opencv2/core/utils/logger.hpp>
 
 
@@ -13,13 +14,13 @@ namespace dnn {
 CV__DNN_INLINE_NS_BEGIN
 
 Image2BlobParams::Image2BlobParams():scalefactor(Scalar::all(1.0)), size(Size()), mean(Scalar()), swapRB(false), ddepth(CV_32F),
-                           datalayout(DNN_LAYOUT_NCHW), paddingmode(DNN_PMODE_NULL)
+                           datalayout(DNN_LAYOUT_NCHW), paddingmode(DNN_PMODE_NULL), fusedResize(false)
 {}
 
 Image2BlobParams::Image2BlobParams(const Scalar& scalefactor_, const Size& size_, const Scalar& mean_, bool swapRB_,
     int ddepth_, DataLayout datalayout_, ImagePaddingMode mode_, Scalar borderValue_):
     scalefactor(scalefactor_), size(size_), mean(mean_), swapRB(swapRB_), ddepth(ddepth_),
-    datalayout(datalayout_), paddingmode(mode_), borderValue(borderValue_)
+    datalayout(datalayout_), paddingmode(mode_), borderValue(borderValue_), fusedResize(false)
 {}
 
 void getVector(InputArrayOfArrays images_, std::vector<Mat>& images) {
@@ -64,6 +65,457 @@ void getChannelFromBlob(UMat& m, InputArray blob, int i, int j, int rows, int co
     m = roi.reshape(CV_MAT_CN(type), rows);
 }
 
+namespace {
+
+/** Image of the batch prepared for the fused pass of blobFromImagesWithParams() */
+struct Image2BlobTask
+{
+    Mat src;       // source image, a resized copy or its ROI
+    Rect roi;      // area of the blob covered by the image, the rest is filled with the border value
+    bool resize;   // src is resized within the pass, see the tables below
+    std::vector<int> xofs0, xofs1, yofs0, yofs1;  // source pixels which are interpolated (in elements for x)
+    std::vector<float> alpha, beta;               // weights of xofs1 and yofs1
+};
+
+/** Coefficients of INTER_LINEAR resize with the same pixel mapping as cv::resize().
+    `offset` is the position of the first computed pixel in the resized image. */
+static void computeLinearTab(int ssize, int dsize, int offset, double scale, int cn,
+                             std::vector<int>& ofs0, std::vector<int>& ofs1, std::vector<float>& coef)
+{
+    ofs0.resize(dsize);
+    ofs1.resize(dsize);
+    coef.resize(dsize);
+    for (int d = 0; d < dsize; d++)
+    {
+        float f = (float)((d + offset + 0.5) * scale - 0.5);
+        int s = cvFloor(f);
+        f -= s;
+        if (s < 0)
+            s = 0, f = 0.f;
+        if (s >= ssize - 1)
+            s = ssize - 1, f = 0.f;
+        ofs0[d] = s * cn;
+        ofs1[d] = std::min(s + 1, ssize - 1) * cn;
+        coef[d] = f;
+    }
+}
+
+template<typename ST>
+static void hresizeLinear(const ST* src, const Image2BlobTask& task, float* dst, int cn)
+{
+    const int width = task.roi.width;
+    for (int dx = 0; dx < width; dx++, dst += cn)
+    {
+        const ST* s0 = src + task.xofs0[dx];
+        const ST* s1 = src + task.xofs1[dx];
+        const float a1 = task.alpha[dx], a0 = 1.f - a1;
+        for (int c = 0; c < cn; c++)
+            dst[c] = s0[c] * a0 + s1[c] * a1;
+    }
+}
+
+static void vresizeLinear(const float* src0, const float* src1, float beta, float* dst, int len)
+{
+    const float b0 = 1.f - beta, b1 = beta;
+    int x = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int VECSZ = VTraits<v_float32>::vlanes();
+    v_float32 vb0 = vx_setall_f32(b0), vb1 = vx_setall_f32(b1);
+    for (; x <= len - VECSZ; x += VECSZ)
+        v_store(dst + x, v_muladd(vx_load(src0 + x), vb0, v_mul(vx_load(src1 + x), vb1)));
+#endif
+    for (; x < len; x++)
+        dst[x] = src0[x] * b0 + src1[x] * b1;
+}
+
+static void convertLine(const uchar* src, float* dst, int len)
+{
+    int x = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int VECSZ = VTraits<v_float32>::vlanes();
+    for (; x <= len - VECSZ; x += VECSZ)
+        v_store(dst + x, v_cvt_f32(v_reinterpret_as_s32(vx_load_expand_q(src + x))));
+#endif
+    for (; x < len; x++)
+        dst[x] = (float)src[x];
+}
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+static inline void v_store_as(float* ptr, const v_float32& v) { v_store(ptr, v); }
+static inline void v_store_as(hfloat* ptr, const v_float32& v) { v_pack_store(ptr, v); }
+#endif
+
+/** Normalizes pixels of the fused pass and writes them to the blob: (src[srcChannel[j]] - mean[j]) * scale[j] */
+template<typename T>
+class Image2BlobInvoker CV_FINAL : public ParallelLoopBody
+{
+public:
+    Image2BlobInvoker(const std::vector<Image2BlobTask>& tasks_, Mat& blob_, int cn_, bool nhwc_,
+                      const int* srcChannel_, const float* mean_, const float* scale_, const float* border_)
+        : tasks(tasks_), blob(blob_), cn(cn_), nhwc(nhwc_)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            srcChannel[j] = srcChannel_[j];
+            mean[j] = mean_[j];
+            scale[j] = scale_[j];
+            border[j] = border_[j];
+        }
+        height = nhwc ? blob.size[1] : blob.size[2];
+        width = nhwc ? blob.size[2] : blob.size[3];
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        const int lineSize = width * cn;
+        AutoBuffer<float> _buf(lineSize * 4);
+        float* lineBuf = _buf.data();
+        float* tmpBuf = lineBuf + lineSize;
+        // horizontally resized source rows, they are shared by the neighbour rows of the stripe
+        float* hbuf[2] = { lineBuf + lineSize * 2, lineBuf + lineSize * 3 };
+        int hrow[2] = { -1, -1 }, htask = -1;
+
+        for (int i = range.start; i < range.end; i++)
+        {
+            const int n = i / height, y = i - n * height;
+            const Image2BlobTask& task = tasks[n];
+            const Rect& roi = task.roi;
+            T* dst[4] = {};
+            if (nhwc)
+                dst[0] = blob.ptr<T>(n, y);
+            else
+                for (int j = 0; j < cn; j++)
+                    dst[j] = blob.ptr<T>(n, j) + (size_t)y * width;
+
+            if (y < roi.y || y >= roi.y + roi.height)
+            {
+                fillBorder(dst, 0, width);
+                continue;
+            }
+            fillBorder(dst, 0, roi.x);
+            fillBorder(dst, roi.x + roi.width, width);
+
+            const int sy = y - roi.y, len = roi.width * cn;
+            const float* line = lineBuf;
+            if (!task.resize)
+            {
+                if (task.src.depth() == CV_32F)
+                    line = task.src.ptr<float>(sy);
+                else
+                    convertLine(task.src.ptr<uchar>(sy), lineBuf, len);
+            }
+            else
+            {
+                if (htask != n)
+                {
+                    hrow[0] = hrow[1] = -1;
+                    htask = n;
+                }
+                const int sy0 = task.yofs0[sy], sy1 = task.yofs1[sy];
+                if (hrow[0] != sy0)
+                {
+                    if (hrow[1] == sy0)
+                    {
+                        std::swap(hbuf[0], hbuf[1]);
+                        std::swap(hrow[0], hrow[1]);
+                    }
+                    else
+                    {
+                        hresize(task, sy0, hbuf[0]);
+                        hrow[0] = sy0;
+                    }
+                }
+                const float beta = task.beta[sy];
+                if (sy1 == sy0 || beta == 0.f)
+                    line = hbuf[0];
+                else
+                {
+                    if (hrow[1] != sy1)
+                    {
+                        hresize(task, sy1, hbuf[1]);
+                        hrow[1] = sy1;
+                    }
+                    vresizeLinear(hbuf[0], hbuf[1], beta, lineBuf, len);
+                }
+            }
+
+            if (!nhwc)
+            {
+                T* planes[4] = {};
+                for (int j = 0; j < cn; j++)
+                    planes[j] = dst[j] + roi.x;
+                normalizePlanar(line, planes, roi.width);
+            }
+            else if (std::is_same<T, float>::value)
+                normalizeInterleaved(line, (float*)(void*)(dst[0] + roi.x * cn), roi.width);
+            else
+            {
+                normalizeInterleaved(line, tmpBuf, roi.width);
+                storeLine(tmpBuf, dst[0] + roi.x * cn, len);
+            }
+        }
+    }
+
+protected:
+    void hresize(const Image2BlobTask& task, int sy, float* dst) const
+    {
+        if (task.src.depth() == CV_32F)
+            hresizeLinear(task.src.ptr<float>(sy), task, dst, cn);
+        else
+            hresizeLinear(task.src.ptr<uchar>(sy), task, dst, cn);
+    }
+
+    void fillBorder(T** dst, int x0, int x1) const
+    {
+        for (int x = x0; x < x1; x++)
+            for (int j = 0; j < cn; j++)
+            {
+                if (nhwc)
+                    dst[0][x * cn + j] = T(border[j]);
+                else
+                    dst[j][x] = T(border[j]);
+            }
+    }
+
+    void normalizePlanar(const float* src, T** dst, int len) const
+    {
+        int x = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        const int VECSZ = VTraits<v_float32>::vlanes();
+        const bool swapRB = srcChannel[0] != 0;
+        v_float32 vm0 = vx_setall_f32(mean[0]), vm1 = vx_setall_f32(mean[1]);
+        v_float32 vm2 = vx_setall_f32(mean[2]), vm3 = vx_setall_f32(mean[3]);
+        v_float32 vs0 = vx_setall_f32(scale[0]), vs1 = vx_setall_f32(scale[1]);
+        v_float32 vs2 = vx_setall_f32(scale[2]), vs3 = vx_setall_f32(scale[3]);
+        if (cn == 1)
+        {
+            for (; x <= len - VECSZ; x += VECSZ)
+                v_store_as(dst[0] + x, v_mul(v_sub(vx_load(src + x), vm0), vs0));
+        }
+        else if (cn == 3)
+        {
+            for (; x <= len - VECSZ; x += VECSZ)
+            {
+                v_float32 v0, v1, v2;
+                v_load_deinterleave(src + x * 3, v0, v1, v2);
+                v_store_as(dst[0] + x, v_mul(v_sub(swapRB ? v2 : v0, vm0), vs0));
+                v_store_as(dst[1] + x, v_mul(v_sub(v1, vm1), vs1));
+                v_store_as(dst[2] + x, v_mul(v_sub(swapRB ? v0 : v2, vm2), vs2));
+            }
+        }
+        else
+        {
+            for (; x <= len - VECSZ; x += VECSZ)
+            {
+                v_float32 v0, v1, v2, v3;
+                v_load_deinterleave(src + x * 4, v0, v1, v2, v3);
+                v_store_as(dst[0] + x, v_mul(v_sub(swapRB ? v2 : v0, vm0), vs0));
+                v_store_as(dst[1] + x, v_mul(v_sub(v1, vm1), vs1));
+                v_store_as(dst[2] + x, v_mul(v_sub(swapRB ? v0 : v2, vm2), vs2));
+                v_store_as(dst[3] + x, v_mul(v_sub(v3, vm3), vs3));
+            }
+        }
+#endif
+        for (; x < len; x++)
+            for (int j = 0; j < cn; j++)
+                dst[j][x] = T((src[x * cn + srcChannel[j]] - mean[j]) * scale[j]);
+    }
+
+    void normalizeInterleaved(const float* src, float* dst, int len) const
+    {
+        int x = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        const int VECSZ = VTraits<v_float32>::vlanes();
+        const bool swapRB = srcChannel[0] != 0;
+        v_float32 vm0 = vx_setall_f32(mean[0]), vm1 = vx_setall_f32(mean[1]);
+        v_float32 vm2 = vx_setall_f32(mean[2]), vm3 = vx_setall_f32(mean[3]);
+        v_float32 vs0 = vx_setall_f32(scale[0]), vs1 = vx_setall_f32(scale[1]);
+        v_float32 vs2 = vx_setall_f32(scale[2]), vs3 = vx_setall_f32(scale[3]);
+        if (cn == 1)
+        {
+            for (; x <= len - VECSZ; x += VECSZ)
+                v_store(dst + x, v_mul(v_sub(vx_load(src + x), vm0), vs0));
+        }
+        else if (cn == 2)
+        {
+            for (; x <= len - VECSZ; x += VECSZ)
+            {
+                v_float32 v0, v1;
+                v_load_deinterleave(src + x * 2, v0, v1);
+                v_store_interleave(dst + x * 2, v_mul(v_sub(v0, vm0), vs0), v_mul(v_sub(v1, vm1), vs1));
+            }
+        }
+        else if (cn == 3)
+        {
+            for (; x <= len - VECSZ; x += VECSZ)
+            {
+                v_float32 v0, v1, v2;
+                v_load_deinterleave(src + x * 3, v0, v1, v2);
+                v_store_interleave(dst + x * 3, v_mul(v_sub(swapRB ? v2 : v0, vm0), vs0),
+                                   v_mul(v_sub(v1, vm1), vs1), v_mul(v_sub(swapRB ? v0 : v2, vm2), vs2));
+            }
+        }
+        else
+        {
+            for (; x <= len - VECSZ; x += VECSZ)
+            {
+                v_float32 v0, v1, v2, v3;
+                v_load_deinterleave(src + x * 4, v0, v1, v2, v3);
+                v_store_interleave(dst + x * 4, v_mul(v_sub(swapRB ? v2 : v0, vm0), vs0),
+                                   v_mul(v_sub(v1, vm1), vs1), v_mul(v_sub(swapRB ? v0 : v2, vm2), vs2),
+                                   v_mul(v_sub(v3, vm3), vs3));
+            }
+        }
+#endif
+        for (; x < len; x++)
+            for (int j = 0; j < cn; j++)
+                dst[x * cn + j] = (src[x * cn + srcChannel[j]] - mean[j]) * scale[j];
+    }
+
+    static void storeLine(const float* src, T* dst, int len)
+    {
+        int x = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        const int VECSZ = VTraits<v_float32>::vlanes();
+        for (; x <= len - VECSZ; x += VECSZ)
+            v_store_as(dst + x, vx_load(src + x));
+#endif
+        for (; x < len; x++)
+            dst[x] = T(src[x]);
+    }
+
+    const std::vector<Image2BlobTask>& tasks;
+    Mat& blob;
+    int cn;
+    bool nhwc;
+    int height, width;
+    int srcChannel[4];
+    float mean[4], scale[4], border[4];
+};
+
+/** Single pass of blobFromImagesWithParams() for Mat images and CV_32F / CV_16F blobs.
+
+Each row of the blob is computed from the source rows (or from the rows of the resized image
+if Image2BlobParams::fusedResize is not set) at once: conversion to float, swapping of channels,
+mean subtraction, scaling and planar layout don't require intermediate images.
+Returns false if the parameters are not supported, the generic implementation is used then.
+*/
+static bool blobFromImagesFused(const std::vector<Mat>& images, Mat& blob, const Image2BlobParams& param)
+{
+    if (param.ddepth != CV_32F && param.ddepth != CV_16F)
+        return false;
+    if (param.datalayout != DNN_LAYOUT_NCHW && param.datalayout != DNN_LAYOUT_NHWC)
+        return false;
+    const bool nhwc = param.datalayout == DNN_LAYOUT_NHWC;
+    const int nch = images[0].channels();
+    if (nhwc ? nch > 4 : (nch != 1 && nch != 3 && nch != 4))
+        return false;
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        const Mat& image = images[i];
+        if (image.dims != 2 || image.empty() || image.channels() != nch ||
+            (image.depth() != CV_8U && image.depth() != CV_32F))
+            return false;
+    }
+
+    int srcChannel[4] = { 0, 1, 2, 3 };
+    float mean[4] = {}, scale[4] = {}, border[4] = {};
+    if (param.swapRB)
+    {
+        if (nch > 2)
+            std::swap(srcChannel[0], srcChannel[2]);
+        else
+            CV_LOG_WARNING(NULL, "Red/blue color swapping requires at least three image channels.");
+    }
+    for (int j = 0; j < nch; j++)
+    {
+        mean[j] = saturate_cast<float>(param.mean[j]);
+        scale[j] = saturate_cast<float>(param.scalefactor[j]);
+        // the padding is applied to the source image, so the value is rounded to its depth
+        const double value = param.borderValue[srcChannel[j]];
+        border[j] = images[0].depth() == CV_8U ? (float)saturate_cast<uchar>(value) : saturate_cast<float>(value);
+        border[j] = (border[j] - mean[j]) * scale[j];
+    }
+
+    Size size = param.size;
+    if (size == Size())
+        size = images[0].size();
+
+    std::vector<Image2BlobTask> tasks(images.size());
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        Image2BlobTask& task = tasks[i];
+        const Mat& image = images[i];
+        const Size imgSize = image.size();
+        task.src = image;
+        task.roi = Rect(Point(), size);
+        task.resize = false;
+        if (imgSize == size)
+            continue;
+
+        Size dsize;       // size of the resized image
+        double inv_scale_x = 0, inv_scale_y = 0;
+        Point ofs;        // position of the blob in the resized image
+        if (param.paddingmode == DNN_PMODE_CROP_CENTER)
+        {
+            float resizeFactor = std::max(size.width / (float)imgSize.width,
+                                          size.height / (float)imgSize.height);
+            inv_scale_x = inv_scale_y = resizeFactor;
+            dsize = Size(saturate_cast<int>(imgSize.width * inv_scale_x),
+                         saturate_cast<int>(imgSize.height * inv_scale_y));
+            ofs = Point((int)(0.5 * (dsize.width - size.width)), (int)(0.5 * (dsize.height - size.height)));
+        }
+        else if (param.paddingmode == DNN_PMODE_LETTERBOX)
+        {
+            float resizeFactor = std::min(size.width / (float)imgSize.width,
+                                          size.height / (float)imgSize.height);
+            dsize = Size(int(imgSize.width * resizeFactor), int(imgSize.height * resizeFactor));
+            task.roi = Rect((size.width - dsize.width) / 2, (size.height - dsize.height) / 2, dsize.width, dsize.height);
+        }
+        else
+            dsize = size;
+        if (inv_scale_x == 0 || dsize == imgSize)
+        {
+            inv_scale_x = (double)dsize.width / imgSize.width;
+            inv_scale_y = (double)dsize.height / imgSize.height;
+        }
+
+        if (!param.fusedResize)
+        {
+            if (dsize != imgSize)
+                resize(image, task.src, param.paddingmode == DNN_PMODE_CROP_CENTER ? Size() : dsize,
+                       inv_scale_x, inv_scale_y, INTER_LINEAR);
+            task.src = task.src(Rect(ofs, task.roi.size()));
+            continue;
+        }
+        task.resize = true;
+        computeLinearTab(imgSize.width, task.roi.width, ofs.x, 1. / inv_scale_x, nch, task.xofs0, task.xofs1, task.alpha);
+        computeLinearTab(imgSize.height, task.roi.height, ofs.y, 1. / inv_scale_y, 1, task.yofs0, task.yofs1, task.beta);
+    }
+
+    const int nimages = (int)images.size();
+    if (nhwc)
+    {
+        int sz[] = { nimages, size.height, size.width, nch };
+        blob.create(4, sz, param.ddepth);
+    }
+    else
+    {
+        int sz[] = { nimages, nch, size.height, size.width };
+        blob.create(4, sz, param.ddepth);
+    }
+
+    const Range range(0, nimages * size.height);
+    const double nstripes = (double)blob.total() / (1 << 16);
+    if (param.ddepth == CV_32F)
+        parallel_for_(range, Image2BlobInvoker<float>(tasks, blob, nch, nhwc, srcChannel, mean, scale, border), nstripes);
+    else
+        parallel_for_(range, Image2BlobInvoker<hfloat>(tasks, blob, nch, nhwc, srcChannel, mean, scale, border), nstripes);
+    return true;
+}
+
+}  // namespace
+
 Mat blobFromImage(InputArray image, const double scalefactor, const Size& size,
         const Scalar& mean, bool swapRB, bool crop, int ddepth)
 {
@@ -135,8 +587,8 @@ void blobFromImagesWithParamsImpl(InputArrayOfArrays images_, Tmat& blob_, const
         CV_Error(Error::StsBadArg, error_message);
     }
 
-    CV_CheckType(param.ddepth, param.ddepth == CV_32F || param.ddepth == CV_8U,
-                 "Blob depth should be CV_32F or CV_8U");
+    CV_CheckType(param.ddepth, param.ddepth == CV_32F || param.ddepth == CV_16F || param.ddepth == CV_8U,
+                 "Blob depth should be CV_32F, CV_16F or CV_8U");
     Size size = param.size;
 
     std::vector<Tmat> images;
@@ -144,6 +596,16 @@ void blobFromImagesWithParamsImpl(InputArrayOfArrays images_, Tmat& blob_, const
 
     CV_Assert(!images.empty());
 
+    if (param.ddepth == CV_16F)
+    {
+        Image2BlobParams param32f = param;
+        param32f.ddepth = CV_32F;
+        Tmat blob32f;
+        blobFromImagesWithParamsImpl<Tmat>(images, blob32f, param32f);
+        blob32f.convertTo(blob_, CV_16F);
+        return;
+    }
+
     if (param.ddepth == CV_8U)
     {
         CV_Assert(param.scalefactor == Scalar::all(1.0) && "Scaling is not supported for CV_8U blob depth");
@@ -307,14 +769,18 @@ void blobFromImagesWithParams(InputArrayOfArrays images, OutputArray blob, const
             return;
         }
     } else if (images.kind() == _InputArray::STD_VECTOR_MAT) {
+        std::vector<Mat> mats;
+        images.getMatVector(mats);
         if(blob.kind() == _InputArray::UMAT) {
             Mat m = blob.getUMatRef().getMat(ACCESS_WRITE);
-            blobFromImagesWithParamsImpl<cv::Mat>(images, m, param);
+            if (mats.empty() || !blobFromImagesFused(mats, m, param))
+                blobFromImagesWithParamsImpl<cv::Mat>(images, m, param);
             m.copyTo(blob);
             return;
         } else if(blob.kind() == _InputArray::MAT) {
             Mat& m = blob.getMatRef();
-            blobFromImagesWithParamsImpl<cv::Mat>(images, m, param);
+            if (mats.empty() || !blobFromImagesFused(mats, m, param))
+                blobFromImagesWithParamsImpl<cv::Mat>(images, m, param);
             return;
         }
     }
@@ -343,13 +809,15 @@ void blobFromImageWithParams(InputArray image, OutputArray blob, const Image2Blo
         if(blob.kind() == _InputArray::UMAT) {
             Mat m = blob.getUMatRef().getMat(ACCESS_RW);
             std::vector<Mat> images(1, image.getMat());
-            blobFromImagesWithParamsImpl<cv::Mat>(images, m, param);
+            if (!blobFromImagesFused(images, m, param))
+                blobFromImagesWithParamsImpl<cv::Mat>(images, m, param);
             m.copyTo(blob);
             return;
         } else if(blob.kind() == _InputArray::MAT) {
             Mat& m = blob.getMatRef();
             std::vector<Mat> images(1, image.getMat());
-            blobFromImagesWithParamsImpl<cv::Mat>(images, m, param);
+            if (!blobFromImagesFused(images, m, param))
+                blobFromImagesWithParamsImpl<cv::Mat>(images, m, param);
             return;
         }
     }
@@ -243,7 +243,7 @@ public:
 
 
 //TODO: simultaneously convolution and bias addition for cache optimization
-class ConvolutionLayerImpl CV_FINAL : public BaseConvolutionLayerImpl
+class ConvolutionLayerImpl CV_FINAL : public BaseConvolutionLayerImpl, public LayerKernelInfo, public LazyInitializedLayer
 {
 public:
     enum { VEC_ALIGN = 8, DFT_TYPE = CV_32F };
@@ -281,6 +281,26 @@ public:
         cudaFusionMode = cuda4dnn::ConvolutionConfiguration::FusionMode::NONE;
         cudaActType = cuda4dnn::ConvolutionConfiguration::ActivationType::IDENTITY;
 #endif
+        weightsType = params.get<int>("weights_type", weightsType);
+    }
+
+    std::string getKernelName() const CV_OVERRIDE
+    {
+        if (!fastConvImpl)
+            return std::string();
+        std::string name;
+        switch (fastConvImpl->conv_type)
+        {
+        case CONV_TYPE_WINOGRAD3X3: name = "winograd_f63"; break;
+        case CONV_TYPE_DEPTHWISE: name = "depthwise_3x3"; break;
+        case CONV_TYPE_DEPTHWISE_REMAIN: name = "depthwise"; break;
+        default: name = "im2col_generic"; break;
+        }
+        if (fastConvImpl->useFP16)
+            name += "_fp16";
+        else if (fastConvImpl->useWeights16)
+            name += fastConvImpl->weightsType == DNN_WEIGHTS_BF16 ? "_w_bf16" : "_w_fp16";
+        return name;
     }
 
     MatShape computeColRowShape(const MatShape &inpShape, const MatShape &outShape) const CV_OVERRIDE
@@ -1215,41 +1235,6 @@ public:
         outputs_arr.getMatVector(outputs);
 
         int outCn = blobs.empty() ? inputs[1].size[0] : blobs[0].size[0];
-        // Need to align non-const blobs
-        bool variableWeight = false;
-        if (blobs.empty())
-        {
-            variableWeight = true;
-            Mat wm = inputs[1].reshape(1, outCn);
-            if (wm.data != weightsMat.data)
-            {
-                int newcols = (int)alignSize(wm.step1(), VEC_ALIGN);
-                Mat wm_buffer = Mat(numOutput, newcols, wm.type());
-                Mat wm_padding = wm_buffer.colRange(wm.cols, newcols);
-                wm_padding.setTo(Scalar::all(0.));
-                weightsMat = wm_buffer.colRange(0, wm.cols);
-
-                wm.copyTo((const Mat&)weightsMat);
-                if (inputs.size() > 2)
-                {
-                    Mat biasMat = inputs[2].reshape(1, outCn);
-                    biasMat.col(0).copyTo(biasvec);
-                }
-                biasvec.resize(outCn + 2, 0);
-            }
-        }
-        /*if (inputs[0].dims > 3) {
-            printf("conv %s: input (%d x %d x %d x %d), kernel (%d x %d), pad (%d x %d), stride (%d x %d), dilation (%d x %d)\n",
-                   name.c_str(), inputs[0].size[0], inputs[0].size[1], inputs[0].size[2], inputs[0].size[3],
-                   kernel.width, kernel.height, pad.width, pad.height,
-                   stride.width, stride.height, dilation.width, dilation.height);
-        }
-        else {
-            printf("conv %s: input (%d x %d x %d), kernel (%d x %d), pad (%d x %d), stride (%d x %d), dilation (%d x %d)\n",
-                   name.c_str(), inputs[0].size[0], inputs[0].size[1], inputs[0].size[2],
-                   kernel.width, kernel.height, pad.width, pad.height,
-                   stride.width, stride.height, dilation.width, dilation.height);
-        }*/
         int inpGroupCn = blobs.empty() ? inputs[1].size[1] : blobs[0].size[1];
         CV_Assert_N(inputs.size() >= (size_t)1, inputs[0].size[1] % inpGroupCn == 0,
                     outputs.size() == 1, inputs[0].data != outputs[0].data);
@@ -1257,13 +1242,15 @@ public:
         int ngroups = inputs[0].size[1] / inpGroupCn;
         CV_Assert(outputs[0].size[1] % ngroups == 0);
 
-        reluslope.clear();
+        // Layer instance may be shared by execution contexts (see Net::createExecutionContext()):
+        // per-call data is kept in local variables
+        std::vector<float> activSlope;
         if( activ )
         {
             Ptr<ReLULayer> activ_relu = activ.dynamicCast<ReLULayer>();
             if( !activ_relu.empty() )
             {
-                reluslope.assign(outCn+2, activ_relu->negativeSlope);
+                activSlope.assign(outCn+2, activ_relu->negativeSlope);
             }
 
             Ptr<ChannelsPReLULayer> activ_chprelu = activ.dynamicCast<ChannelsPReLULayer>();
@@ -1272,41 +1259,79 @@ public:
                 const Mat& m = activ_chprelu->blobs[0];
                 CV_Assert(m.isContinuous() && m.type() == CV_32F && (int)m.total() == outCn);
                 const float* mdata = m.ptr<float>();
-                reluslope.resize(outCn+2);
-                std::copy(mdata, mdata + outCn, reluslope.begin());
-                reluslope[outCn] = reluslope[outCn+1] = reluslope[outCn-1];
+                activSlope.resize(outCn+2);
+                std::copy(mdata, mdata + outCn, activSlope.begin());
+                activSlope[outCn] = activSlope[outCn+1] = activSlope[outCn-1];
             }
         }
 
+        Ptr<FastConv> conv = fastConvImpl;
+        if (blobs.empty())
         {
-            int nstripes = std::max(getNumThreads(), 1);
-            int conv_dim = CONV_2D;
-            if (inputs[0].dims == 3)
-                conv_dim = CONV_1D;
-            if (inputs[0].dims == 5)
-                conv_dim = CONV_3D;
-
-            // Initialization of FastCovn2d, pack weight.
-            if (!fastConvImpl || variableWeight)
+            // Non-const weights (and bias) are packed for this call only. Rows are aligned
+            // to use vectorized loops without tail processing
+            Mat wm = inputs[1].reshape(1, outCn);
+            int newcols = (int)alignSize(wm.step1(), VEC_ALIGN);
+            Mat wm_buffer = Mat(outCn, newcols, wm.type());
+            Mat wm_padding = wm_buffer.colRange(wm.cols, newcols);
+            wm_padding.setTo(Scalar::all(0.));
+            Mat wm_aligned = wm_buffer.colRange(0, wm.cols);
+            wm.copyTo(wm_aligned);
+
+            std::vector<float> bias(outCn + 2, 0.f);
+            if (inputs.size() > 2)
             {
-                int K = outputs[0].size[1];
-                int C = inputs[0].size[1];
-
-                // Winograd only works when input h and w >= 12.
-                bool canUseWinograd = useWinograd && conv_dim == CONV_2D && inputs[0].size[2] >= 12 && inputs[0].size[3] >= 12;
-
-                CV_Assert(outputs[0].size[1] % ngroups == 0);
-                fastConvImpl = initFastConv(weightsMat, &biasvec[0], ngroups, K, C, kernel_size, strides,
-                                            dilations, pads_begin, pads_end, conv_dim,
-                                            preferableTarget == DNN_TARGET_CPU_FP16, canUseWinograd);
-                // This is legal to release weightsMat here as this is not used anymore for
-                // OpenCV inference. If network needs to be reinitialized (new shape, new backend)
-                // a new version of weightsMat is created at .finalize() from original weights
-                weightsMat.release();
+                Mat biasMat = inputs[2].reshape(1, outCn);
+                for (int i = 0; i < outCn; i++)
+                    bias[i] = biasMat.at<float>(i, 0);
             }
-
-            runFastConv(inputs[0], outputs[0], fastConvImpl, nstripes, activ, reluslope, fusedAdd);
+            conv = createFastConv(inputs[0], outputs[0], wm_aligned, bias, ngroups, false);
+        }
+        else if (!fastConvImpl || (fastConvImpl->weightsType != weightsType && !weightsMat.empty()))
+        {
+            initForward(inputs, outputs);
+            conv = fastConvImpl;
         }
+
+        int nstripes = std::max(getNumThreads(), 1);
+        runFastConv(inputs[0], outputs[0], conv, nstripes, activ, activSlope, fusedAdd);
+    }
+
+    // Initialization of FastConv, packs constant weights.
+    virtual void initForward(const std::vector<Mat>& inputs, const std::vector<Mat>& outputs) CV_OVERRIDE
+    {
+        if (blobs.empty() || weightsMat.empty())
+            return;
+        if (fastConvImpl && fastConvImpl->weightsType == weightsType)
+            return;
+
+        int ngroups = inputs[0].size[1] / blobs[0].size[1];
+        fastConvImpl = createFastConv(inputs[0], outputs[0], weightsMat, biasvec, ngroups, true);
+        // This is legal to release weightsMat here as this is not used anymore for
+        // OpenCV inference. If network needs to be reinitialized (new shape, new backend)
+        // a new version of weightsMat is created at .finalize() from original weights
+        weightsMat.release();
+    }
+
+    Ptr<FastConv> createFastConv(const Mat& input, const Mat& output, const Mat& weights,
+                                 std::vector<float>& bias, int ngroups, bool constWeights) const
+    {
+        int conv_dim = CONV_2D;
+        if (input.dims == 3)
+            conv_dim = CONV_1D;
+        if (input.dims == 5)
+            conv_dim = CONV_3D;
+
+        int K = output.size[1];
+        int C = input.size[1];
+
+        // Winograd only works when input h and w >= 12.
+        bool canUseWinograd = useWinograd && conv_dim == CONV_2D && input.size[2] >= 12 && input.size[3] >= 12;
+
+        return initFastConv(weights, &bias[0], ngroups, K, C, kernel_size, strides,
+                            dilations, pads_begin, pads_end, conv_dim,
+                            preferableTarget == DNN_TARGET_CPU_FP16, weightsType, canUseWinograd,
+                            constWeights);
     }
 
 #ifdef HAVE_CUDA
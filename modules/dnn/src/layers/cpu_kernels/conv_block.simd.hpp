@@ -18,6 +18,10 @@ void convBlock_F16(int np, const char * _a, const char * _b, char * _c, int ldc,
 void convBlockMR1_F16(int np, const char* _a, const char* _b, float *c, const float _bias, bool init_c,
                        const float minval, const float maxval, bool ifMinMaxAct, const int width, const int convNR_FP16);
 
+// FP32 branch with FP16 or BF16 packed weights, converted to FP32 in registers (x86 AVX2 only).
+void convBlock_F32W16(int np, const ushort* a, const float* b, float* c, int ldc, bool init_c, int width,
+                      const int convMR, const int convNR, bool bf16);
+
 #if !defined(CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY)
 
 #if CV_AVX
@@ -131,6 +135,91 @@ void convBlock_F32(int np, const float* a, const float* b, float* c, int ldc, bo
     _mm256_zeroupper();
 }
 
+#if CV_AVX2 // F16C is implied by AVX2 dispatch
+
+template<bool bf16>
+static inline __m128 convLoadWeights4(const ushort* a)
+{
+    __m128i w = _mm_loadl_epi64((const __m128i*)a);
+    if (bf16)
+        return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), w)); // bf16 are the upper halves of fp32
+    return _mm_cvtph_ps(w);
+}
+
+template<bool bf16>
+static void convBlock_F32W16_(int np, const ushort* a, const float* b, float* c, int ldc, bool init_c)
+{
+    __m256 c00 = _mm256_set1_ps(0.f), c01 = c00, c02 = c00;
+    __m256 c10 = c00, c11 = c00, c12 = c00;
+    __m256 c20 = c00, c21 = c00, c22 = c00;
+    __m256 c30 = c00, c31 = c00, c32 = c00;
+    float CV_DECL_ALIGNED(16) aw[4];
+
+    // The whole block is always computed: both b and c rows have convNR elements.
+    for (int p = 0; p < np; p++, a += 4, b += 24)
+    {
+        _mm_store_ps(aw, convLoadWeights4<bf16>(a));
+        __m256 b0 = _mm256_load_ps(b), b1 = _mm256_load_ps(b + 8), b2 = _mm256_load_ps(b + 16);
+        __m256 a0 = _mm256_broadcast_ss(aw), a1 = _mm256_broadcast_ss(aw + 1);
+
+        c00 = _mm256_fmadd_ps(b0, a0, c00);
+        c01 = _mm256_fmadd_ps(b1, a0, c01);
+        c02 = _mm256_fmadd_ps(b2, a0, c02);
+
+        c10 = _mm256_fmadd_ps(b0, a1, c10);
+        c11 = _mm256_fmadd_ps(b1, a1, c11);
+        c12 = _mm256_fmadd_ps(b2, a1, c12);
+
+        a0 = _mm256_broadcast_ss(aw + 2), a1 = _mm256_broadcast_ss(aw + 3);
+
+        c20 = _mm256_fmadd_ps(b0, a0, c20);
+        c21 = _mm256_fmadd_ps(b1, a0, c21);
+        c22 = _mm256_fmadd_ps(b2, a0, c22);
+
+        c30 = _mm256_fmadd_ps(b0, a1, c30);
+        c31 = _mm256_fmadd_ps(b1, a1, c31);
+        c32 = _mm256_fmadd_ps(b2, a1, c32);
+    }
+
+    if (!init_c)
+    {
+        c00 = _mm256_add_ps(c00, _mm256_load_ps(c));
+        c01 = _mm256_add_ps(c01, _mm256_load_ps(c + 8));
+        c02 = _mm256_add_ps(c02, _mm256_load_ps(c + 16));
+
+        c10 = _mm256_add_ps(c10, _mm256_load_ps(c + ldc));
+        c11 = _mm256_add_ps(c11, _mm256_load_ps(c + ldc + 8));
+        c12 = _mm256_add_ps(c12, _mm256_load_ps(c + ldc + 16));
+
+        c20 = _mm256_add_ps(c20, _mm256_load_ps(c + ldc*2));
+        c21 = _mm256_add_ps(c21, _mm256_load_ps(c + ldc*2 + 8));
+        c22 = _mm256_add_ps(c22, _mm256_load_ps(c + ldc*2 + 16));
+
+        c30 = _mm256_add_ps(c30, _mm256_load_ps(c + ldc*3));
+        c31 = _mm256_add_ps(c31, _mm256_load_ps(c + ldc*3 + 8));
+        c32 = _mm256_add_ps(c32, _mm256_load_ps(c + ldc*3 + 16));
+    }
+
+    _mm256_storeu_ps(c, c00), _mm256_storeu_ps(c+8, c01), _mm256_storeu_ps(c+16, c02);
+    _mm256_storeu_ps(c + ldc, c10), _mm256_storeu_ps(c + ldc + 8, c11), _mm256_storeu_ps(c + ldc + 16, c12);
+    _mm256_storeu_ps(c + ldc*2, c20), _mm256_storeu_ps(c + ldc*2 + 8, c21), _mm256_storeu_ps(c + ldc*2 + 16, c22);
+    _mm256_storeu_ps(c + ldc*3, c30), _mm256_storeu_ps(c + ldc*3 + 8, c31), _mm256_storeu_ps(c + ldc*3 + 16, c32);
+    _mm256_zeroupper();
+}
+
+void convBlock_F32W16(int np, const ushort* a, const float* b, float* c, int ldc, bool init_c, int width,
+                      const int convMR, const int convNR, bool bf16)
+{
+    CV_UNUSED(width);
+    CV_Assert(convMR == 4 && convNR == 24);
+    if (bf16)
+        convBlock_F32W16_<true>(np, a, b, c, ldc, init_c);
+    else
+        convBlock_F32W16_<false>(np, a, b, c, ldc, init_c);
+}
+
+#endif // CV_AVX2
+
 #endif
 
 #if CV_NEON
@@ -11,6 +11,7 @@
 
 #include "../../precomp.hpp"
 #include "convolution.hpp"
+#include "packed_weights_cache.hpp"
 
 #include "conv_block.simd.hpp"
 #include "layers/cpu_kernels/conv_block.simd_declarations.hpp" // defines CV_CPU_DISPATCH_MODES_ALL=AVX2,...,BASELINE based on CMakeLists.txt content
@@ -84,6 +85,114 @@ hfloat* FastConv::getWeightsWinoFP16()
     return alignPtr(weightsWinoBuf_FP16.data(), VEC_ALIGN);
 }
 
+ushort* FastConv::getWeights16()
+{
+    return alignPtr(weightsBuf_16.data(), VEC_ALIGN);
+}
+
+// Convert float 32 to the bits of float16 or bfloat16 (round to nearest even)
+static inline ushort _cvt32f16bits(float v, bool bf16)
+{
+    if (!bf16)
+    {
+        hfloat h(v);
+        ushort w;
+        memcpy(&w, &h, sizeof(w));
+        return w;
+    }
+    Cv32suf u;
+    u.f = v;
+    if ((u.u & 0x7fffffff) > 0x7f800000) // keep NaN
+        return (ushort)((u.u >> 16) | 0x40);
+    return (ushort)((u.u + 0x7fff + ((u.u >> 16) & 1)) >> 16);
+}
+
+// Packed weights are kept in the persistent cache without the alignment gap.
+template<typename T>
+static std::pair<const void*, size_t> packedWeightsData(std::vector<T>& buf)
+{
+    if (buf.empty())
+        return std::make_pair((const void*)0, (size_t)0);
+    return std::make_pair((const void*)alignPtr(buf.data(), VEC_ALIGN), (buf.size() - VEC_ALIGN) * sizeof(T));
+}
+
+template<typename T>
+static void restorePackedWeights(std::vector<T>& buf, const std::vector<uchar>& data)
+{
+    buf.clear();
+    if (data.empty())
+        return;
+    buf.resize(data.size() / sizeof(T) + VEC_ALIGN);
+    memcpy(alignPtr(buf.data(), VEC_ALIGN), data.data(), data.size());
+}
+
+// Sizes in bytes of the packed buffers stored in the persistent cache, see storePackedConvWeights().
+// Must be in sync with the packing code of initFastConv().
+static void getPackedConvWeightsSizes(const FastConv& conv, size_t sizes[5])
+{
+    std::fill(sizes, sizes + 5, (size_t)0);
+    int Kg = conv.K/conv.ngroups, Cg = max(conv.C/conv.ngroups, 1);
+    if (conv.conv_type == CONV_TYPE_WINOGRAD3X3)
+    {
+        const int CONV_WINO_KBLOCK = 4;
+        size_t nweights = (size_t)conv.ngroups*((Kg + CONV_WINO_KBLOCK - 1)/CONV_WINO_KBLOCK)*(conv.C/conv.ngroups)*
+                          CONV_WINO_KBLOCK*CONV_WINO_AREA;
+#ifdef CONV_ARM_FP16
+        if (conv.useFP16)
+            sizes[3] = nweights*sizeof(conv.weightsWinoBuf_FP16[0]);
+        else
+#endif
+            sizes[1] = nweights*sizeof(conv.weightsWinoBuf[0]);
+    }
+    else if (conv.conv_type == CONV_TYPE_GENERIC)
+    {
+        size_t DkHkWkCg = (size_t)conv.Dk*conv.Hk*conv.Wk*Cg;
+#ifdef CONV_ARM_FP16
+        if (conv.useFP16)
+            sizes[2] = (size_t)conv.ngroups*((Kg + CONV_MR_FP16 - 1)/CONV_MR_FP16*CONV_MR_FP16)*DkHkWkCg*sizeof(conv.weightsBuf_FP16[0]);
+        else
+#endif
+        if (conv.useWeights16)
+            sizes[4] = (size_t)conv.ngroups*((Kg + CONV_MR_FP32 - 1)/CONV_MR_FP32*CONV_MR_FP32)*DkHkWkCg*sizeof(conv.weightsBuf_16[0]);
+        else
+            sizes[0] = (size_t)conv.ngroups*((Kg + CONV_MR_FP32 - 1)/CONV_MR_FP32*CONV_MR_FP32)*DkHkWkCg*sizeof(conv.weightsBuf[0]);
+    }
+}
+
+static bool loadPackedConvWeights(FastConv& conv, const PackedWeightsKey& key)
+{
+    std::vector<std::vector<uchar> > buffers;
+    if (!loadPackedWeights(key, buffers) || buffers.size() != 5)
+        return false;
+    size_t sizes[5];
+    getPackedConvWeightsSizes(conv, sizes);
+    for (int i = 0; i < 5; i++)
+    {
+        if (buffers[i].size() != sizes[i])
+        {
+            CV_LOG_WARNING(NULL, "DNN: packed convolution weights from cache have unexpected size, repacking");
+            return false;
+        }
+    }
+    restorePackedWeights(conv.weightsBuf, buffers[0]);
+    restorePackedWeights(conv.weightsWinoBuf, buffers[1]);
+    restorePackedWeights(conv.weightsBuf_FP16, buffers[2]);
+    restorePackedWeights(conv.weightsWinoBuf_FP16, buffers[3]);
+    restorePackedWeights(conv.weightsBuf_16, buffers[4]);
+    return true;
+}
+
+static void storePackedConvWeights(FastConv& conv, const PackedWeightsKey& key)
+{
+    std::vector<std::pair<const void*, size_t> > buffers;
+    buffers.push_back(packedWeightsData(conv.weightsBuf));
+    buffers.push_back(packedWeightsData(conv.weightsWinoBuf));
+    buffers.push_back(packedWeightsData(conv.weightsBuf_FP16));
+    buffers.push_back(packedWeightsData(conv.weightsWinoBuf_FP16));
+    buffers.push_back(packedWeightsData(conv.weightsBuf_16));
+    storePackedWeights(key, buffers);
+}
+
 Ptr<FastConv> initFastConv(
         InputArray _weightsMat,
         float* srcBias,
@@ -96,7 +205,9 @@ Ptr<FastConv> initFastConv(
         const std::vector<size_t>& pads_end,
         int conv_dim,
         const bool _useFP16,
-        bool useWinograd)
+        int weightsType,
+        bool useWinograd,
+        bool constWeights)
 {
     Ptr<FastConv> conv = makePtr<FastConv>();
     CV_Assert(ngroups > 0 && K > 0 && C > 0 && K % ngroups == 0);
@@ -192,8 +303,34 @@ Ptr<FastConv> initFastConv(
     }
 #endif
 
+    // Reduced precision weights storage, computations are done in FP32.
+    conv->weightsType = weightsType;
+    conv->useWeights16 = false;
+    if (weightsType != DNN_WEIGHTS_FP32 && !conv->useFP16 && conv->conv_type == CONV_TYPE_GENERIC)
+    {
+#if CV_TRY_AVX2
+        conv->useWeights16 = conv->useAVX2 && CONV_MR_FP32 == 4 && CONV_NR_FP32 == 24;
+#endif
+        if (!conv->useWeights16)
+            CV_LOG_ONCE_WARNING(NULL, "DNN: FP16 and BF16 convolution weights require AVX2, fallback to FP32 weights.");
+    }
+
+    // Depth-wise weights are copied as is, other layouts are worth caching.
+    // Non-constant weights are packed on every forward() call and never cached.
+    const bool useCache = constWeights && conv->conv_type != CONV_TYPE_DEPTHWISE &&
+                          conv->conv_type != CONV_TYPE_DEPTHWISE_REMAIN && isPackedWeightsCacheEnabled();
+    PackedWeightsKey cacheKey("conv");
+    if (useCache)
+        cacheKey << conv->conv_type << ngroups << K << C << Dk << Hk << Wk << conv->useFP16 << conv->useWeights16
+                 << weightsType << conv->useAVX << conv->useAVX2 << conv->useNEON << weightsMat;
+    const bool loadedFromCache = useCache && loadPackedConvWeights(*conv, cacheKey);
+
     float *srcWeights = (float *)weightsMat.data;
-    if (conv->conv_type == CONV_TYPE_DEPTHWISE || conv->conv_type == CONV_TYPE_DEPTHWISE_REMAIN)
+    if (loadedFromCache)
+    {
+        // packed weights are restored from the persistent cache
+    }
+    else if (conv->conv_type == CONV_TYPE_DEPTHWISE || conv->conv_type == CONV_TYPE_DEPTHWISE_REMAIN)
     {
         // Handle the Conv1D, Conv2D and Conv3D depth-wise.
         // for depth-wise convolutions on NCHW data we just preserve the weights in KCHW layout,
@@ -362,6 +499,7 @@ Ptr<FastConv> initFastConv(
         int Kg_aligned = numStripsMR * CONV_MR_FP32;
         size_t nweights = ngroups*Kg_aligned*DkHkWkCg;
         float* weightsPtr = nullptr;
+        ushort* weightsPtr_16 = nullptr;
 
 #ifdef CONV_ARM_FP16
         int numStripsMR_FP16 = (Kg + CONV_MR_FP16 - 1) / CONV_MR_FP16;
@@ -376,6 +514,12 @@ Ptr<FastConv> initFastConv(
         }
         else
 #endif
+        if (conv->useWeights16)
+        {
+            conv->weightsBuf_16.resize(nweights + VEC_ALIGN);
+            weightsPtr_16 = conv->getWeights16();
+        }
+        else
         {
             conv->weightsBuf.resize(nweights + VEC_ALIGN);
             weightsPtr = conv->getWeights();
@@ -414,6 +558,37 @@ Ptr<FastConv> initFastConv(
         }
         else
 #endif
+        if (conv->useWeights16)
+        {
+            const bool bf16 = weightsType == DNN_WEIGHTS_BF16;
+            parallel_for_(Range(0, ngroups * numStripsMR), [&](const Range& r0){
+            for (int gsi = r0.start; gsi < r0.end; gsi++)
+            {
+                int g = gsi / numStripsMR;
+                int si = gsi - g * numStripsMR;
+
+                int startK = si * CONV_MR_FP32;
+                CV_Assert(startK < Kg_aligned);
+
+                ushort* packed_wptr = weightsPtr_16 + DkHkWkCg * (startK + g * Kg_aligned);
+                int dk = Kg - startK < CONV_MR_FP32 ? Kg - startK : CONV_MR_FP32; // check if we need zero padding.
+
+                int k_idx = g*Kg + startK;
+                for(int hwd = 0; hwd < Hk*Wk*Dk; hwd++)
+                {
+                    for(int c = 0; c < Cg; c++, packed_wptr += CONV_MR_FP32)
+                    {
+                        const float* wptr = srcWeights + wstep * k_idx + c*Hk*Wk*Dk + hwd;
+                        int k = 0;
+                        for(; k < dk; k++, wptr += wstep)
+                            packed_wptr[k] = _cvt32f16bits(*wptr, bf16);
+                        for(; k < CONV_MR_FP32; k++)
+                            packed_wptr[k] = 0;
+                    }
+                }
+            }});
+        }
+        else
         {
             parallel_for_(Range(0, ngroups * numStripsMR), [&](const Range& r0){
             for (int gsi = r0.start; gsi < r0.end; gsi++)
@@ -446,6 +621,9 @@ Ptr<FastConv> initFastConv(
     else
         CV_Error(cv::Error::StsUnsupportedFormat, "Unknown convolution type.");
 
+    if (useCache && !loadedFromCache)
+        storePackedConvWeights(*conv, cacheKey);
+
     // store bias; append some zero's to make sure that
     // we can always read MR elements starting from any valid index
     {
@@ -1111,6 +1289,8 @@ void runFastConv(InputArray _input, OutputArray _output, const Ptr<FastConv>& co
                 output.isContinuous());
 
     const bool useFP16 = conv->useFP16;
+    const bool useWeights16 = conv->useWeights16;
+    const bool useBF16 = conv->weightsType == DNN_WEIGHTS_BF16;
     Mat fusedAddMat;
     if (fusedAdd)
     {
@@ -1260,6 +1440,7 @@ void runFastConv(InputArray _input, OutputArray _output, const Ptr<FastConv>& co
         esz = sizeof(__fp16);
     }
 #endif
+    const int wesz = useWeights16 ? (int)sizeof(ushort) : esz; // element size of packed weights
 
     int MAX_STRIPES = conv->conv_type == CONV_TYPE_DEPTHWISE_REMAIN ? 1 : (56 + CONV_NR - 1)/CONV_NR;
 
@@ -1432,6 +1613,12 @@ void runFastConv(InputArray _input, OutputArray _output, const Ptr<FastConv>& co
                 }
                 else
 #endif
+                if (useWeights16)
+                {
+                    CV_Assert(!conv->weightsBuf_16.empty());
+                    weights = (char *)conv->getWeights16();
+                }
+                else
                 {
                     CV_Assert(!conv->weightsBuf.empty());
                     weights = (char *)conv->getWeights();
@@ -1489,7 +1676,7 @@ void runFastConv(InputArray _input, OutputArray _output, const Ptr<FastConv>& co
                 }
 
                 CV_Assert(weights);
-                weights += g * Kg_aligned * DkHkWkCg * esz;
+                weights += g * Kg_aligned * DkHkWkCg * wesz;
 
                 const float *biasptr = conv->biasBuf.data() + Kg * g;
                 int ldc = nstripes * CONV_NR;
@@ -1509,14 +1696,16 @@ void runFastConv(InputArray _input, OutputArray _output, const Ptr<FastConv>& co
                         {
                             const int outLen = std::min(out_width - stripe * CONV_NR, CONV_NR);
 
-                            char *wptr = weights + (k0_block * DkHkWkCg + c0 * CONV_MR) * esz;
+                            char *wptr = weights + (k0_block * DkHkWkCg + c0 * CONV_MR) * wesz;
                             float *cptr = cbuf_task + stripe * CONV_NR;
                             hfloat* cptr_f16 = (hfloat*)cbuf_task + stripe*CONV_NR;
                             for (int k = k0_block; k < k1_block; k += CONV_MR,
-                                    wptr += DkHkWkCg * CONV_MR * esz, cptr += CONV_MR * ldc, cptr_f16 += CONV_MR * ldc)
+                                    wptr += DkHkWkCg * CONV_MR * wesz, cptr += CONV_MR * ldc, cptr_f16 += CONV_MR * ldc)
                             {
 #if CV_TRY_AVX2
-                                if (conv->useAVX2)
+                                if (useWeights16)
+                                    opt_AVX2::convBlock_F32W16(c1 - c0, (const ushort *)wptr, (const float *)inptr, cptr, ldc, c0 == 0, outLen, CONV_MR, CONV_NR, useBF16);
+                                else if (conv->useAVX2)
                                     opt_AVX2::convBlock_F32(c1 - c0, (const float *)wptr, (const float *)inptr, cptr, ldc, c0 == 0, outLen, CONV_MR, CONV_NR);
                                 else
 #endif
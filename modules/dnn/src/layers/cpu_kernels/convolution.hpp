@@ -67,9 +67,14 @@ struct FastConv
     hfloat* getWeightsFP16();
     hfloat* getWeightsWinoFP16();
 
+    std::vector<ushort> weightsBuf_16; // For generic Conv 2D with FP16 or BF16 weights on x86.
+    ushort* getWeights16();
+
     int conv_type;
     int conv_dim;  // Flag for conv1d, conv2d, or conv3d.
     bool useFP16 = false; // Only ARMv8 is supported.
+    int weightsType = DNN_WEIGHTS_FP32; // Requested storage of weights.
+    bool useWeights16 = false; // Generic Conv weights are stored as FP16 or BF16, x86 with AVX2 only.
 #if CV_SIMD128
     bool useSIMD128 = true;
 #else
@@ -100,7 +105,9 @@ Ptr<FastConv> initFastConv(
         const std::vector<size_t>& pads_end,
         int conv_dim,
         const bool useFP16,
-        bool useWinograd);
+        int weightsType,
+        bool useWinograd,
+        bool constWeights);
 
 // It contains different computing branches, like winograd, 1x1 conv.
 void runFastConv(InputArray _input, OutputArray _output, const Ptr<FastConv>& conv, int ntasks,
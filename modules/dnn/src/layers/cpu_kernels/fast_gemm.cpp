@@ -11,6 +11,7 @@
 
 #include "../../precomp.hpp"
 #include "fast_gemm.hpp"
+#include "packed_weights_cache.hpp"
 
 #define CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
 #include "fast_gemm_kernels.simd.hpp"
@@ -57,6 +58,19 @@ void fastGemmPackB(const Mat &B, std::vector<float> &packed_B, bool trans, FastG
         std::swap(ldb0, ldb1);
     }
 
+    const bool useCache = isPackedWeightsCacheEnabled();
+    PackedWeightsKey cacheKey("gemm");
+    if (useCache) {
+        cacheKey << trans << opt.use_neon << opt.use_avx2 << opt.use_avx << opt.use_lasx << B;
+        std::vector<std::vector<uchar> > buffers;
+        const size_t packedSize = fastGemmPackBSize(N, K, opt) * batch * sizeof(float);
+        if (loadPackedWeights(cacheKey, buffers) && buffers.size() == 1 && buffers[0].size() == packedSize) {
+            packed_B.resize(buffers[0].size() / sizeof(float));
+            std::memcpy(packed_B.data(), buffers[0].data(), buffers[0].size());
+            return;
+        }
+    }
+
     const auto *b = B.ptr<const char>();
     int esz = B.elemSize();
 
@@ -118,6 +132,11 @@ void fastGemmPackB(const Mat &B, std::vector<float> &packed_B, bool trans, FastG
             packed_b += size_packed_B * esz;
         }
     }
+
+    if (useCache) {
+        std::vector<std::pair<const void*, size_t> > buffers(1, std::make_pair((const void*)packed_B.data(), packed_B.size() * sizeof(float)));
+        storePackedWeights(cacheKey, buffers);
+    }
 }
 
 void fastGemmPackB(bool trans, size_t N, size_t K, const float *B, size_t ldb, float *packed_B, const FastGemmOpt &opt) {
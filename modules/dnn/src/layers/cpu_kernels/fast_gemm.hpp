@@ -176,6 +176,24 @@ void fastGemmBatch(size_t batch, const size_t *A_offsets, const size_t *B_offset
 void fastGemmBatch(bool trans_a, bool trans_b, float alpha, const Mat &A,
                    const Mat &B, float beta, Mat &C, FastGemmOpt &opt);
 
+// Dynamically quantized GEMM: constant B is quantized to int8 per output channel once,
+// A is quantized per row on every call. Both use symmetric quantization.
+struct FastGemmInt8Weights {
+    int N = 0, K = 0;
+    int Kstep = 0;              // row step of quantized data, multiple of the widest SIMD register
+    std::vector<int8_t> data;   // N x Kstep, transposed B
+    std::vector<float> scales;  // N
+
+    bool empty() const { return data.empty(); }
+};
+
+void fastGemmQuantizeB(const Mat &B, bool trans_b, FastGemmInt8Weights &weights);
+
+// C = alpha * A * B + beta * C, A is a float (M x K) matrix with row step lda
+void fastGemmInt8(int M, float alpha, const float *A, int lda,
+                  const FastGemmInt8Weights &weights, float beta,
+                  float *C, int ldc, const FastGemmOpt &opt);
+
 }} // cv::dnn
 
 #endif // OPENCV_DNN_FAST_GEMM_HPP
@@ -0,0 +1,91 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../../precomp.hpp"
+#include "fast_gemm.hpp"
+
+#include "fast_gemm_int8.simd.hpp"
+#include "layers/cpu_kernels/fast_gemm_int8.simd_declarations.hpp"
+
+#define FAST_GEMM_INT8_ALIGN 64  // bytes, the widest SIMD register
+#define FAST_GEMM_INT8_MC 32
+#define FAST_GEMM_INT8_NC 64
+
+namespace cv { namespace dnn {
+
+// Symmetric quantization of a float vector, returns the scale
+static float quantizeInt8(const float *src, int K, int8_t *dst) {
+    Mat src_(1, K, CV_32F, (void*)src), dst_(1, K, CV_8S, dst);
+    const double maxval = norm(src_, NORM_INF);
+    if (maxval == 0.) {
+        dst_.setTo(0);
+        return 0.f;
+    }
+    const double scale = maxval / 127.;
+    src_.convertTo(dst_, CV_8S, 1. / scale);
+    return static_cast<float>(scale);
+}
+
+void fastGemmQuantizeB(const Mat &B, bool trans_b, FastGemmInt8Weights &weights) {
+    CV_CheckEQ(B.dims, 2, "DNN/Gemm/Int8: B must be a 2D matrix");
+    CV_CheckTypeEQ(B.type(), CV_32F, "DNN/Gemm/Int8: B must be FP32");
+
+    // quantized rows correspond to output channels
+    Mat Bt = trans_b ? B : B.t();
+    if (!Bt.isContinuous())
+        Bt = Bt.clone();
+
+    weights.N = Bt.rows;
+    weights.K = Bt.cols;
+    weights.Kstep = static_cast<int>(alignSize(weights.K, FAST_GEMM_INT8_ALIGN));
+    weights.data.assign((size_t)weights.N * weights.Kstep, 0);
+    weights.scales.resize(weights.N);
+    for (int n = 0; n < weights.N; n++)
+        weights.scales[n] = quantizeInt8(Bt.ptr<float>(n), weights.K, weights.data.data() + (size_t)n * weights.Kstep);
+}
+
+void fastGemmInt8(int M, float alpha, const float *A, int lda,
+                  const FastGemmInt8Weights &weights, float beta,
+                  float *C, int ldc, const FastGemmOpt &opt) {
+    CV_Assert(!weights.empty());
+    const int N = weights.N, K = weights.K, Kstep = weights.Kstep;
+    if (M <= 0)
+        return;
+
+    AutoBuffer<int8_t> qA_buf((size_t)M * Kstep);
+    AutoBuffer<float> scalesA_buf(M);
+    int8_t *qA = qA_buf.data();
+    float *scalesA = scalesA_buf.data();
+
+    auto quantize = [&](const Range &r) {
+        for (int m = r.start; m < r.end; m++) {
+            int8_t *qa = qA + (size_t)m * Kstep;
+            scalesA[m] = quantizeInt8(A + (size_t)m * lda, K, qa);
+            std::memset(qa + K, 0, Kstep - K);
+        }
+    };
+
+    const int mtiles = (M + FAST_GEMM_INT8_MC - 1) / FAST_GEMM_INT8_MC;
+    const int ntiles = (N + FAST_GEMM_INT8_NC - 1) / FAST_GEMM_INT8_NC;
+    auto gemm = [&](const Range &r) {
+        for (int tile = r.start; tile < r.end; tile++) {
+            const int m0 = (tile / ntiles) * FAST_GEMM_INT8_MC, n0 = (tile % ntiles) * FAST_GEMM_INT8_NC;
+            const int mc = std::min(M - m0, FAST_GEMM_INT8_MC), nc = std::min(N - n0, FAST_GEMM_INT8_NC);
+            CV_CPU_DISPATCH(fastGemmInt8Kernel, (mc, nc, Kstep, qA + (size_t)m0 * Kstep, scalesA + m0,
+                                                 weights.data.data() + (size_t)n0 * Kstep, weights.scales.data() + n0,
+                                                 alpha, beta, C + (size_t)m0 * ldc + n0, ldc),
+                            CV_CPU_DISPATCH_MODES_ALL);
+        }
+    };
+
+    if (opt.multi_thread) {
+        parallel_for_(Range(0, M), quantize, (size_t)M * K * (1 / 65536.0));
+        parallel_for_(Range(0, mtiles * ntiles), gemm, (size_t)M * N * Kstep * (1 / 1048576.0));
+    } else {
+        quantize(Range(0, M));
+        gemm(Range(0, mtiles * ntiles));
+    }
+}
+
+}} // cv::dnn
@@ -0,0 +1,111 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include <opencv2/core/hal/intrin.hpp>
+
+namespace cv { namespace dnn {
+CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+
+// C[m, n] = alpha * scalesA[m] * scalesB[n] * dot(A[m, :], B[n, :]) + beta * C[m, n]
+// A (M x K) and B (N x K) are int8 matrices with row step Kstep; padding is zero.
+void fastGemmInt8Kernel(int M, int N, int Kstep,
+                        const int8_t* A, const float* scalesA,
+                        const int8_t* B, const float* scalesB,
+                        float alpha, float beta, float* C, int ldc);
+
+#ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+static inline void fastGemmInt8Store(float* c, int dot, float scale, float beta)
+{
+    *c = beta == 0.f ? dot * scale : dot * scale + beta * (*c);
+}
+
+void fastGemmInt8Kernel(int M, int N, int Kstep,
+                        const int8_t* A, const float* scalesA,
+                        const int8_t* B, const float* scalesB,
+                        float alpha, float beta, float* C, int ldc)
+{
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int vlanes = VTraits<v_int8>::vlanes();
+#endif
+
+    int m = 0;
+    for (; m < M; m += 2)
+    {
+        // two rows of A share loads of B, the last odd row is processed twice
+        const int m1 = std::min(m + 1, M - 1);
+        const int8_t* a0 = A + (size_t)m * Kstep;
+        const int8_t* a1 = A + (size_t)m1 * Kstep;
+        float* c0 = C + (size_t)m * ldc;
+        float* c1 = C + (size_t)m1 * ldc;
+        const float sa0 = alpha * scalesA[m], sa1 = alpha * scalesA[m1];
+
+        int n = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        for (; n <= N - 4; n += 4)
+        {
+            const int8_t* b0 = B + (size_t)n * Kstep;
+            const int8_t* b1 = b0 + Kstep;
+            const int8_t* b2 = b1 + Kstep;
+            const int8_t* b3 = b2 + Kstep;
+            v_int32 s00 = vx_setzero_s32(), s01 = vx_setzero_s32(), s02 = vx_setzero_s32(), s03 = vx_setzero_s32();
+            v_int32 s10 = vx_setzero_s32(), s11 = vx_setzero_s32(), s12 = vx_setzero_s32(), s13 = vx_setzero_s32();
+            int k = 0;
+            for (; k <= Kstep - vlanes; k += vlanes)
+            {
+                v_int8 va0 = vx_load(a0 + k), va1 = vx_load(a1 + k);
+                v_int8 vb = vx_load(b0 + k);
+                s00 = v_dotprod_expand_fast(va0, vb, s00);
+                s10 = v_dotprod_expand_fast(va1, vb, s10);
+                vb = vx_load(b1 + k);
+                s01 = v_dotprod_expand_fast(va0, vb, s01);
+                s11 = v_dotprod_expand_fast(va1, vb, s11);
+                vb = vx_load(b2 + k);
+                s02 = v_dotprod_expand_fast(va0, vb, s02);
+                s12 = v_dotprod_expand_fast(va1, vb, s12);
+                vb = vx_load(b3 + k);
+                s03 = v_dotprod_expand_fast(va0, vb, s03);
+                s13 = v_dotprod_expand_fast(va1, vb, s13);
+            }
+            int d00 = v_reduce_sum(s00), d01 = v_reduce_sum(s01), d02 = v_reduce_sum(s02), d03 = v_reduce_sum(s03);
+            int d10 = v_reduce_sum(s10), d11 = v_reduce_sum(s11), d12 = v_reduce_sum(s12), d13 = v_reduce_sum(s13);
+            for (; k < Kstep; k++)
+            {
+                const int x0 = a0[k], x1 = a1[k];
+                d00 += x0 * b0[k]; d01 += x0 * b1[k]; d02 += x0 * b2[k]; d03 += x0 * b3[k];
+                d10 += x1 * b0[k]; d11 += x1 * b1[k]; d12 += x1 * b2[k]; d13 += x1 * b3[k];
+            }
+            if (m1 != m)
+            {
+                fastGemmInt8Store(c1 + n, d10, sa1 * scalesB[n], beta);
+                fastGemmInt8Store(c1 + n + 1, d11, sa1 * scalesB[n + 1], beta);
+                fastGemmInt8Store(c1 + n + 2, d12, sa1 * scalesB[n + 2], beta);
+                fastGemmInt8Store(c1 + n + 3, d13, sa1 * scalesB[n + 3], beta);
+            }
+            fastGemmInt8Store(c0 + n, d00, sa0 * scalesB[n], beta);
+            fastGemmInt8Store(c0 + n + 1, d01, sa0 * scalesB[n + 1], beta);
+            fastGemmInt8Store(c0 + n + 2, d02, sa0 * scalesB[n + 2], beta);
+            fastGemmInt8Store(c0 + n + 3, d03, sa0 * scalesB[n + 3], beta);
+        }
+#endif
+        for (; n < N; n++)
+        {
+            const int8_t* b = B + (size_t)n * Kstep;
+            int d0 = 0, d1 = 0;
+            for (int k = 0; k < Kstep; k++)
+            {
+                d0 += a0[k] * b[k];
+                d1 += a1[k] * b[k];
+            }
+            if (m1 != m)
+                fastGemmInt8Store(c1 + n, d1, sa1 * scalesB[n], beta);
+            fastGemmInt8Store(c0 + n, d0, sa0 * scalesB[n], beta);
+        }
+    }
+}
+
+#endif  // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+CV_CPU_OPTIMIZATION_NAMESPACE_END
+}}  // namespace cv::dnn
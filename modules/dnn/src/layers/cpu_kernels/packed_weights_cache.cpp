@@ -0,0 +1,254 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../../precomp.hpp"
+#include "packed_weights_cache.hpp"
+
+#include <fstream>
+
+#include <opencv2/core/utils/filesystem.hpp>
+#include <opencv2/core/utils/logger.hpp>
+
+namespace cv {
+namespace dnn {
+
+static const char PACKED_WEIGHTS_MAGIC[8] = {'O', 'C', 'V', 'D', 'N', 'N', 'P', 'W'};
+static const uint32_t PACKED_WEIGHTS_VERSION = 1;
+
+static Mutex& getPackedWeightsCacheMutex()
+{
+    static Mutex mtx;
+    return mtx;
+}
+
+static String& getPackedWeightsCacheDirRef()
+{
+    static String dir = getParam_DNN_PACKED_WEIGHTS_CACHE_DIR();
+    return dir;
+}
+
+static inline uint64 mixHash(uint64 h, uint64 v, uint64 mul)
+{
+    h ^= v * mul;
+    h = (h << 31) | (h >> 33);
+    return h * 0x9E3779B97F4A7C15ULL;
+}
+
+PackedWeightsKey::PackedWeightsKey(const char* kind)
+    : h0(0x243F6A8885A308D3ULL), h1(0x13198A2E03707344ULL)
+{
+    // Library version and CPU features: packed layouts depend on both
+    static const String features = []() {
+        String s = CV_VERSION;
+        s += getCPUFeaturesLine();
+        for (int i = 1; i < CPU_MAX_FEATURE; i++)
+            s += checkHardwareSupport(i) ? '1' : '0';
+        return s;
+    }();
+    update(features.data(), features.size());
+    update(kind, strlen(kind));
+}
+
+static void updateHash(uint64& h0, uint64& h1, const void* data_, size_t size)
+{
+    const uchar* data = (const uchar*)data_;
+    size_t i = 0;
+    for (; i + sizeof(uint64) <= size; i += sizeof(uint64))
+    {
+        uint64 v;
+        memcpy(&v, data + i, sizeof(v));
+        h0 = mixHash(h0, v, 0xBF58476D1CE4E5B9ULL);
+        h1 = mixHash(h1, v, 0x94D049BB133111EBULL);
+    }
+    uint64 v = size;
+    for (int shift = 8; i < size; i++, shift += 8)
+        v ^= (uint64)data[i] << (shift & 63);
+    h0 = mixHash(h0, v, 0xBF58476D1CE4E5B9ULL);
+    h1 = mixHash(h1, v, 0x94D049BB133111EBULL);
+}
+
+void PackedWeightsKey::update(const void* data, size_t size)
+{
+    updateHash(h0, h1, data, size);
+}
+
+PackedWeightsKey& PackedWeightsKey::operator<<(int64 value)
+{
+    update(&value, sizeof(value));
+    return *this;
+}
+
+PackedWeightsKey& PackedWeightsKey::operator<<(const Mat& src)
+{
+    *this << (int64)src.type() << (int64)src.dims;
+    for (int i = 0; i < src.dims; i++)
+        *this << (int64)src.size[i];
+    CV_Assert(src.isContinuous() || src.dims == 2);
+
+    // Weights are hashed by blocks in parallel, the key is the hash of the block hashes.
+    // Rows of non-continuous matrices are the blocks.
+    const size_t blockSize = 1 << 20;
+    const size_t rowSize = src.cols * src.elemSize();
+    const size_t dataSize = src.isContinuous() ? src.total() * src.elemSize() : 0;
+    const int nblocks = src.isContinuous() ? (int)((dataSize + blockSize - 1) / blockSize) : src.rows;
+    std::vector<uint64> blockHashes(nblocks * 2);
+    parallel_for_(Range(0, nblocks), [&](const Range& r) {
+        for (int i = r.start; i < r.end; i++)
+        {
+            uint64 b0 = 0x243F6A8885A308D3ULL, b1 = 0x13198A2E03707344ULL;
+            if (src.isContinuous())
+                updateHash(b0, b1, src.data + i * blockSize, std::min(blockSize, dataSize - i * blockSize));
+            else
+                updateHash(b0, b1, src.ptr(i), rowSize);
+            blockHashes[i * 2] = b0;
+            blockHashes[i * 2 + 1] = b1;
+        }
+    });
+    update(blockHashes.data(), blockHashes.size() * sizeof(uint64));
+    return *this;
+}
+
+String PackedWeightsKey::toString() const
+{
+    return format("%016llx%016llx", (unsigned long long)h0, (unsigned long long)h1);
+}
+
+bool isPackedWeightsCacheEnabled()
+{
+    AutoLock lock(getPackedWeightsCacheMutex());
+    return !getPackedWeightsCacheDirRef().empty();
+}
+
+bool loadPackedWeights(const PackedWeightsKey& key, std::vector<std::vector<uchar> >& buffers)
+{
+    buffers.clear();
+    String dir;
+    {
+        AutoLock lock(getPackedWeightsCacheMutex());
+        dir = getPackedWeightsCacheDirRef();
+    }
+    if (dir.empty())
+        return false;
+
+    const String keyStr = key.toString();
+    const String path = utils::fs::join(dir, keyStr + ".bin");
+    std::ifstream f(path.c_str(), std::ios::binary);
+    if (!f.is_open())
+    {
+        CV_LOG_DEBUG(NULL, "DNN: packed weights are not cached: " << path);
+        return false;
+    }
+
+    char magic[sizeof(PACKED_WEIGHTS_MAGIC)] = {};
+    uint32_t version = 0, count = 0;
+    char storedKey[32] = {};
+    f.read(magic, sizeof(magic));
+    f.read((char*)&version, sizeof(version));
+    f.read(storedKey, sizeof(storedKey));
+    f.read((char*)&count, sizeof(count));
+    if (!f || memcmp(magic, PACKED_WEIGHTS_MAGIC, sizeof(magic)) != 0 || version != PACKED_WEIGHTS_VERSION || count > 64 ||
+        keyStr.compare(0, keyStr.size(), storedKey, sizeof(storedKey)) != 0)
+    {
+        CV_LOG_WARNING(NULL, "DNN: invalid packed weights cache entry: " << path);
+        return false;
+    }
+
+    buffers.resize(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint64 size = 0;
+        f.read((char*)&size, sizeof(size));
+        if (!f)
+            break;
+        if (size > (uint64)INT_MAX * 16)
+        {
+            CV_LOG_WARNING(NULL, "DNN: invalid packed weights cache entry: " << path);
+            buffers.clear();
+            return false;
+        }
+        buffers[i].resize((size_t)size);
+        if (size > 0)
+            f.read((char*)buffers[i].data(), (std::streamsize)size);
+    }
+    if (!f)
+    {
+        CV_LOG_WARNING(NULL, "DNN: truncated packed weights cache entry: " << path);
+        buffers.clear();
+        return false;
+    }
+    CV_LOG_DEBUG(NULL, "DNN: packed weights are loaded from cache: " << path);
+    return true;
+}
+
+void storePackedWeights(const PackedWeightsKey& key, const std::vector<std::pair<const void*, size_t> >& buffers)
+{
+    String dir;
+    {
+        AutoLock lock(getPackedWeightsCacheMutex());
+        dir = getPackedWeightsCacheDirRef();
+    }
+    if (dir.empty())
+        return;
+
+    const String keyStr = key.toString();
+    const String path = utils::fs::join(dir, keyStr + ".bin");
+    // Write to a temporary file first: several processes may share the cache directory
+    const String tmpPath = path + format(".%llx.tmp", (unsigned long long)getTickCount() ^ (unsigned long long)(size_t)&buffers);
+    {
+        if (!utils::fs::isDirectory(dir))
+            utils::fs::createDirectories(dir);
+
+        std::ofstream f(tmpPath.c_str(), std::ios::binary);
+        if (!f.is_open())
+        {
+            CV_LOG_ONCE_WARNING(NULL, "DNN: can't write packed weights cache entry: " << tmpPath);
+            return;
+        }
+        const uint32_t version = PACKED_WEIGHTS_VERSION, count = (uint32_t)buffers.size();
+        f.write(PACKED_WEIGHTS_MAGIC, sizeof(PACKED_WEIGHTS_MAGIC));
+        f.write((const char*)&version, sizeof(version));
+        CV_Assert(keyStr.size() == 32);
+        f.write(keyStr.c_str(), keyStr.size());
+        f.write((const char*)&count, sizeof(count));
+        for (size_t i = 0; i < buffers.size(); i++)
+        {
+            const uint64 size = buffers[i].second;
+            f.write((const char*)&size, sizeof(size));
+            if (size > 0)
+                f.write((const char*)buffers[i].first, (std::streamsize)size);
+        }
+        if (!f)
+        {
+            f.close();
+            std::remove(tmpPath.c_str());
+            CV_LOG_ONCE_WARNING(NULL, "DNN: can't write packed weights cache entry: " << tmpPath);
+            return;
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tmpPath.c_str());  // concurrent writer has already created the entry
+        return;
+    }
+    CV_LOG_DEBUG(NULL, "DNN: packed weights are stored to cache: " << path);
+}
+
+
+CV__DNN_INLINE_NS_BEGIN
+
+void setPackedWeightsCacheDir(const String& path)
+{
+    AutoLock lock(getPackedWeightsCacheMutex());
+    getPackedWeightsCacheDirRef() = path;
+}
+
+String getPackedWeightsCacheDir()
+{
+    AutoLock lock(getPackedWeightsCacheMutex());
+    return getPackedWeightsCacheDirRef();
+}
+
+CV__DNN_INLINE_NS_END
+} // namespace dnn
+} // namespace cv
@@ -0,0 +1,42 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_DNN_PACKED_WEIGHTS_CACHE_HPP
+#define OPENCV_DNN_PACKED_WEIGHTS_CACHE_HPP
+
+#include <opencv2/core.hpp>
+
+namespace cv {
+namespace dnn {
+
+// Key of packed weights in the persistent cache: hash of the packing kind and parameters,
+// library version, CPU features and the source weights.
+class PackedWeightsKey
+{
+public:
+    explicit PackedWeightsKey(const char* kind);
+
+    PackedWeightsKey& operator<<(int64 value);
+    PackedWeightsKey& operator<<(const Mat& src);
+
+    String toString() const;
+
+private:
+    void update(const void* data, size_t size);
+
+    uint64 h0, h1;
+};
+
+// Persistent cache of packed weights, see setPackedWeightsCacheDir().
+// An entry is a sequence of buffers which are loaded in the order they were stored.
+bool isPackedWeightsCacheEnabled();
+
+bool loadPackedWeights(const PackedWeightsKey& key, std::vector<std::vector<uchar> >& buffers);
+
+void storePackedWeights(const PackedWeightsKey& key, const std::vector<std::pair<const void*, size_t> >& buffers);
+
+} // namespace dnn
+} // namespace cv
+
+#endif // OPENCV_DNN_PACKED_WEIGHTS_CACHE_HPP
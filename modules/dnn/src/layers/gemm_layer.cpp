@@ -20,7 +20,7 @@ using namespace cv::dnn::cuda4dnn;
 
 namespace cv { namespace dnn {
 
-class GemmLayerImpl CV_FINAL : public GemmLayer {
+class GemmLayerImpl CV_FINAL : public GemmLayer, public LayerKernelInfo {
 public:
     GemmLayerImpl(const LayerParams& params) {
         setParamsFrom(params);
@@ -35,6 +35,13 @@ public:
         have_bias = params.get<bool>("have_bias", false); // NOTE: have_bias being true does not mean bias is constant
 
         real_ndims_C = params.get<int>("real_ndims_C", -1);
+        dynamicQuantization = params.get<bool>("dynamic_quantization", false);
+    }
+
+    std::string getKernelName() const CV_OVERRIDE {
+        if (!int8_B.empty())
+            return "fast_gemm_int8";
+        return const_B ? "fast_gemm_packed_b" : "fast_gemm";
     }
 
     virtual bool supportBackend(int backendId) CV_OVERRIDE {
@@ -101,12 +108,22 @@ public:
         return false;
     }
 
+    virtual bool setActivation(const Ptr<ActivationLayer>& layer) CV_OVERRIDE {
+        // CPU only, element-wise activations only
+        if (!activ.empty() || layer.empty() || !layer->blobs.empty() ||
+            (preferableTarget != DNN_TARGET_CPU && preferableTarget != DNN_TARGET_CPU_FP16))
+            return false;
+        activ = layer;
+        fusedActivation = true;
+        return true;
+    }
+
     // TODO: replace with cv::broadcast() once 1d mat is supported
     // FIXME: fix if conditions if 1d mat is supported properly
-    void broadcastCWtihBeta(int M, int N, const Mat &C) {
+    void broadcastCWtihBeta(int M, int N, const Mat &C, std::vector<float> &dst) const {
         if (beta != 0 && !C.empty()) {
-            broadcast_C.clear();
-            broadcast_C.resize(M * N, 0.f);
+            dst.clear();
+            dst.resize(M * N, 0.f);
 
             const float *ptr_c = C.ptr<const float>();
             const auto shape_C = shape(C);
@@ -116,7 +133,7 @@ public:
                 float c = *ptr_c;
                 int total = M * N;
                 for (int i = 0; i < total; ++i) {
-                    broadcast_C[i] = beta * c;
+                    dst[i] = beta * c;
                 }
             } else if ((real_ndims_C == 1 && shape_C[0] == N) ||
                        (real_ndims_C == 2 && shape_C[0] == 1 && shape_C[1] == N)) {
@@ -124,7 +141,7 @@ public:
                 for (int i = 0; i < M; ++i) {
                     int step = i * N;
                     for (int j = 0; j < N; ++j) {
-                        broadcast_C[step + j] = beta * ptr_c[j];
+                        dst[step + j] = beta * ptr_c[j];
                     }
                 }
             } else if (real_ndims_C == 2 && shape_C[0] == M && shape_C[1] == 1) {
@@ -132,12 +149,12 @@ public:
                 for (int i = 0; i < M; ++i) {
                     int step = i * N;
                     for (int j = 0; j < N; ++j) {
-                        broadcast_C[step + j] = beta * ptr_c[i];
+                        dst[step + j] = beta * ptr_c[i];
                     }
                 }
             } else {
                 // (M, N)
-                std::transform(ptr_c, ptr_c + M * N, broadcast_C.begin(), [this] (const float &c) {
+                std::transform(ptr_c, ptr_c + M * N, dst.begin(), [this] (const float &c) {
                     return this->beta * c; });
             }
         }
@@ -147,7 +164,11 @@ public:
         opt.init();
 
         // pack B if it is const
-        if (const_B) {
+        int8_B = FastGemmInt8Weights();
+        packed_B.clear();
+        if (const_B && dynamicQuantization && !trans_a && preferableTarget == DNN_TARGET_CPU) {
+            fastGemmQuantizeB(blobs[0], trans_b, int8_B);
+        } else if (const_B) {
             fastGemmPackB(blobs[0], packed_B, trans_b, opt);
         }
 
@@ -163,7 +184,7 @@ public:
             int M = shape_Y[dims_Y - 2], N = shape_Y[dims_Y - 1];
 
             // broadcast
-            broadcastCWtihBeta(M, N, C);
+            broadcastCWtihBeta(M, N, C, broadcast_C);
         }
     }
 
@@ -194,25 +215,38 @@ public:
 
         // broadcast C and copy C to output
         if (have_bias) {
+            // non-const C is broadcast to a local buffer: layer instance may be shared by execution contexts
+            std::vector<float> input_C;
             if (!const_C) {
-                broadcastCWtihBeta(M, N, inputs.back());
+                broadcastCWtihBeta(M, N, inputs.back(), input_C);
             }
+            const std::vector<float> &C = const_C ? broadcast_C : input_C;
             int step = M * N;
-            CV_CheckEQ(broadcast_C.size(), static_cast<size_t>(step), "DNN/Gemm: C is not broadcast properly");
+            CV_CheckEQ(C.size(), static_cast<size_t>(step), "DNN/Gemm: C is not broadcast properly");
             float *ptr_y = Y.ptr<float>();
-            std::memcpy(ptr_y, broadcast_C.data(), step * sizeof(float));
-        } else { // initialization
+            if (fusedAdd) { // output holds residual
+                Y += Mat(M, N, CV_32F, (void*)C.data());
+            } else {
+                std::memcpy(ptr_y, C.data(), step * sizeof(float));
+            }
+        } else if (!fusedAdd) { // initialization
             float *ptr_y = Y.ptr<float>();
             size_t total = Y.total();
             std::memset(ptr_y, 0, total * sizeof(float));
         }
 
-        if (const_B) {
+        if (!int8_B.empty()) {
+            fastGemmInt8(M, alpha, A.ptr<const float>(), na, int8_B, 1.f, Y.ptr<float>(), N, opt);
+        } else if (const_B) {
             CV_CheckGT(packed_B.size(), static_cast<size_t>(0), "DNN/Gemm: constant B is not pre-packed");
             fastGemm(trans_a, M, N, K, alpha, A.ptr<const float>(), na, packed_B.data(), 1.f, Y.ptr<float>(), N, opt);
         } else {
             fastGemmBatch(trans_a, trans_b, alpha, A, inputs[1], 1.f, Y, opt);
         }
+
+        if (activ) {
+            applyFusedActivation(Y, activ.get());
+        }
     }
 
 #ifdef HAVE_CUDA
@@ -369,9 +403,11 @@ private:
     bool const_C;
     bool have_bias;
     std::vector<float> packed_B;
+    FastGemmInt8Weights int8_B;
     std::vector<float> broadcast_C;
     int real_ndims_C;
     FastGemmOpt opt;
+    Ptr<ActivationLayer> activ;
 };
 
 Ptr<GemmLayer> GemmLayer::create(const LayerParams& params) {
@@ -264,5 +264,24 @@ double getWeightScale(const Mat& weightsMat)
     return (realMax == realMin) ? 1.0 : std::max(-realMin, realMax)/127;
 }
 
+void applyFusedActivation(Mat& dst, const ActivationLayer* activ)
+{
+    CV_Assert(activ && dst.isContinuous() && dst.type() == CV_32F);
+    CV_Assert(activ->blobs.empty());  // channel-wise activations are not fused
+
+    float* data = dst.ptr<float>();
+    const size_t total = dst.total();
+    const size_t blockSize = 1 << 14;
+    const int nblocks = (int)((total + blockSize - 1) / blockSize);
+    parallel_for_(Range(0, nblocks), [&](const Range& r) {
+        for (int i = r.start; i < r.end; i++)
+        {
+            const size_t start = i * blockSize;
+            const int len = (int)(std::min(total, start + blockSize) - start);
+            activ->forwardSlice(data + start, data + start, len, len, 0, 1);
+        }
+    });
+}
+
 }
 }
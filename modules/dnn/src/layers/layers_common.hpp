@@ -43,6 +43,7 @@
 #ifndef __OPENCV_DNN_LAYERS_LAYERS_COMMON_HPP__
 #define __OPENCV_DNN_LAYERS_LAYERS_COMMON_HPP__
 #include <opencv2/dnn.hpp>
+#include <opencv2/dnn/all_layers.hpp>
 #include <opencv2/dnn/shape_utils.hpp>
 
 #define CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
@@ -76,6 +77,9 @@ void getConvPoolPaddings(const std::vector<int>& inp, const std::vector<size_t>&
 
 // Used in quantized model. It will return the (Max_element - Min_element)/127.
 double getWeightScale(const Mat& weightsMat);
+
+// Applies fused element-wise activation in-place (epilogue of GEMM-like layers).
+void applyFusedActivation(Mat& dst, const ActivationLayer* activ);
 }
 }
 
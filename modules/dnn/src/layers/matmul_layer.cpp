@@ -5,6 +5,7 @@
 #include "../precomp.hpp"
 
 #include <opencv2/dnn/shape_utils.hpp>
+#include "layers_common.hpp"
 #include "cpu_kernels/fast_gemm.hpp"
 
 // OpenVINO backend
@@ -25,7 +26,7 @@ using namespace cv::dnn::cuda4dnn;
 
 namespace cv { namespace dnn {
 
-class MatMulLayerImpl CV_FINAL : public MatMulLayer {
+class MatMulLayerImpl CV_FINAL : public MatMulLayer, public LayerKernelInfo {
 #ifdef HAVE_OPENCL
     UMat weight_umat, bias_umat;
 #endif
@@ -40,6 +41,13 @@ class MatMulLayerImpl CV_FINAL : public MatMulLayer {
         beta = params.get<float>("beta", 1.f);
 
         real_ndims_C = params.get<int>("real_ndims_C", -1);
+        dynamicQuantization = params.get<bool>("dynamic_quantization", false);
+    }
+
+    std::string getKernelName() const CV_OVERRIDE {
+        if (!int8_input_B.empty())
+            return "fast_gemm_int8";
+        return blobs.empty() ? "fast_gemm_batch" : "fast_gemm_batch_packed_b";
     }
 
     virtual bool supportBackend(int backendId) CV_OVERRIDE {
@@ -118,6 +126,16 @@ class MatMulLayerImpl CV_FINAL : public MatMulLayer {
         return false;
     }
 
+    virtual bool setActivation(const Ptr<ActivationLayer>& layer) CV_OVERRIDE {
+        // CPU only, element-wise activations only
+        if (!activ.empty() || layer.empty() || !layer->blobs.empty() ||
+            (preferableTarget != DNN_TARGET_CPU && preferableTarget != DNN_TARGET_CPU_FP16))
+            return false;
+        activ = layer;
+        fusedActivation = true;
+        return true;
+    }
+
     virtual void finalize(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr) CV_OVERRIDE {
         opt.init();
 
@@ -130,7 +148,12 @@ class MatMulLayerImpl CV_FINAL : public MatMulLayer {
                    C_shape = shape(outputs[0]);
         helper.compute(trans_a, trans_b, A_shape, B_shape, C_shape);
 
-        if (!blobs.empty()) {
+        int8_input_B = FastGemmInt8Weights();
+        packed_input_B.clear();
+        if (!blobs.empty() && dynamicQuantization && blobs[0].dims == 2 && !trans_a && preferableTarget == DNN_TARGET_CPU) {
+            // rows of all the batches are multiplied by the same B
+            fastGemmQuantizeB(blobs[0], trans_b, int8_input_B);
+        } else if (!blobs.empty()) {
             fastGemmPackB(blobs[0], packed_input_B, trans_b, opt);
             helper.updatePackedBOffsets(packed_input_B.size());
         }
@@ -198,7 +221,14 @@ class MatMulLayerImpl CV_FINAL : public MatMulLayer {
         const auto *a = A.ptr<const float>();
         auto *y = Y.ptr<float>();
         // add bias if existed
-        if ((inputs.size() + blobs.size()) >= 3) {
+        if (fusedAdd) { // output holds residual: bias is accumulated to it
+            if ((inputs.size() + blobs.size()) >= 3) {
+                // bias is constant for the fused layer (see Net::Impl::fuseLayers()), keep beta applied twice
+                // as in the non-fused path
+                CV_Assert(blobs.size() >= 2);
+                scaleAdd(broadcast_bias.reshape(1, Y.dims, Y.size.p), beta, Y, Y);
+            }
+        } else if ((inputs.size() + blobs.size()) >= 3) {
             const auto &shape_Y = shape(Y);
             if (blobs.empty()) { // bias from input
                 const auto &bias_mat = inputs.back();
@@ -230,16 +260,24 @@ class MatMulLayerImpl CV_FINAL : public MatMulLayer {
             std::memset(y, 0, Y.total() * sizeof(float));
         }
 
-        if (blobs.empty()) {
+        const float gemm_beta = fusedAdd ? 1.f : beta;
+        if (!int8_input_B.empty()) {
+            const int K = int8_input_B.K, N = int8_input_B.N;
+            fastGemmInt8(static_cast<int>(A.total() / K), alpha, a, K, int8_input_B, gemm_beta, y, N, opt);
+        } else if (blobs.empty()) {
             const auto &B = inputs[1];
             const auto *b = B.ptr<const float>();
             fastGemmBatch(helper.batch, helper.A_offsets.data(), helper.B_offsets.data(), helper.C_offsets.data(),
                           helper.M, helper.N, helper.K, alpha, a, helper.lda0, helper.lda1,
-                          b, helper.ldb0, helper.ldb1, beta, y, helper.ldc, opt);
+                          b, helper.ldb0, helper.ldb1, gemm_beta, y, helper.ldc, opt);
         } else {
             fastGemmBatch(helper.batch, helper.A_offsets.data(), helper.packed_B_offsets.data(), helper.C_offsets.data(),
                           helper.M, helper.N, helper.K, alpha, a, helper.lda0, helper.lda1,
-                          packed_input_B.data(), beta, y, helper.ldc, opt);
+                          packed_input_B.data(), gemm_beta, y, helper.ldc, opt);
+        }
+
+        if (activ) {
+            applyFusedActivation(Y, activ.get());
         }
     }
 
@@ -472,10 +510,12 @@ class MatMulLayerImpl CV_FINAL : public MatMulLayer {
     int real_ndims_C;
 
     std::vector<float> packed_input_B;
+    FastGemmInt8Weights int8_input_B;
     Mat broadcast_bias;
 
     FastGemmOpt opt;
     MatMulHelper helper;
+    Ptr<ActivationLayer> activ;
 };
 
 Ptr<MatMulLayer> MatMulLayer::create(const LayerParams& params)
@@ -105,7 +105,7 @@ static ActivationFunction get_activation_function(const String& activation) {
     }
 }
 
-class LSTMLayerImpl CV_FINAL : public LSTMLayer
+class LSTMLayerImpl CV_FINAL : public LSTMLayer, public StatefulLayer
 {
     int numTimeStamps, numSamples, numHidden;
     bool allocated;
@@ -143,6 +143,10 @@ class LSTMLayerImpl CV_FINAL : public LSTMLayer
     // in ONNXImporter are destructive, so we keep a copy.
     std::vector<Mat> originalBlobs;
 
+    // Streaming mode: final states of the previous forward() call are initial states of the next one
+    bool streaming;
+    Mat streamH, streamC;
+
 public:
 
     LSTMLayerImpl(const LayerParams& params)
@@ -215,6 +219,9 @@ public:
         reverse = params.get<bool>("reverse", false);
         numHidden = params.get<int>("hidden_size", 1);
         CV_Assert(!reverse || !bidirectional);
+        streaming = false;
+        if (params.get<bool>("streaming", false))
+            setStreaming(true);
 
         // read activations
         DictValue activations = params.get<DictValue>("activations", DictValue(String()));
@@ -238,6 +245,46 @@ public:
         outTailShape.clear();
     }
 
+    void setStreaming(bool streaming_) CV_OVERRIDE
+    {
+        if (streaming_)
+            CV_CheckFalse(bidirectional || reverse, "DNN/LSTM: streaming mode is not supported by bidirectional and reversed LSTM");
+        streaming = streaming_;
+        resetState();
+    }
+
+    int getNumStates() const CV_OVERRIDE
+    {
+        return 2;
+    }
+
+    void resetState() CV_OVERRIDE
+    {
+        streamH.release();
+        streamC.release();
+    }
+
+    void getState(std::vector<Mat>& states) const CV_OVERRIDE
+    {
+        states.push_back(streamH.clone());
+        states.push_back(streamC.clone());
+    }
+
+    void setState(const Mat* states) CV_OVERRIDE
+    {
+        if (states[0].empty() || states[1].empty())
+        {
+            resetState();
+            return;
+        }
+        CV_CheckEQ(states[0].dims, 2, "DNN/LSTM: state must be a [batch, hidden] matrix");
+        CV_CheckTypeEQ(states[0].type(), CV_32F, "");
+        CV_CheckEQ(states[0].cols, blobs[0].cols, "DNN/LSTM: unexpected size of hidden state");
+        CV_Assert(states[1].size == states[0].size && states[1].type() == states[0].type());
+        streamH = states[0].clone();
+        streamC = states[1].clone();
+    }
+
     void setUseTimstampsDim(bool use) CV_OVERRIDE
     {
         CV_Assert(!allocated);
@@ -429,6 +476,12 @@ public:
             // Handle h_0 and c_0 based on input size
             h_0 = (input.size() >= 2) ? input[1].reshape(1, input[1].size[0] * input[1].size[1]) : blobs[3];
             c_0 = (input.size() == 3) ? input[2].reshape(1, input[2].size[0] * input[2].size[1]) : blobs[4];
+            if (streaming && input.size() < 2 && !streamH.empty())
+            {
+                CV_CheckEQ(streamH.rows, numSamples, "DNN/LSTM: batch size can't be changed in streaming mode, reset states first");
+                h_0 = streamH;
+                c_0 = streamC;
+            }
 
             // Perform checks if input size is 2 or 3
             if (input.size() >= 2) {
@@ -631,6 +684,11 @@ public:
                 if (produceCellOutput)
                     cInternal.copyTo(cOutTs.rowRange(curRowRange));
             }
+            if (streaming)
+            {
+                hInternal.copyTo(streamH);
+                cInternal.copyTo(streamC);
+            }
         }
         // transpose to match batch first output
         if (layout == BATCH_SEQ_HID){
@@ -953,7 +1011,7 @@ CV_EXPORTS_W Ptr<RNNLayer> RNNLayer::create(const LayerParams& params)
     return Ptr<RNNLayer>(new RNNLayerImpl(params));
 }
 
-class GRULayerImpl CV_FINAL : public GRULayer
+class GRULayerImpl CV_FINAL : public GRULayer, public StatefulLayer
 {
     int numTimeStamps, numSamples;
     bool allocated;
@@ -961,6 +1019,8 @@ class GRULayerImpl CV_FINAL : public GRULayer
     MatShape outTailShape;  //shape of single output sample
     MatShape outTsShape;    //shape of N output samples
     bool bidirectional;     // If true, produces both forward and reversed directions along time axis
+    bool streaming;         // If true, final state of the previous forward() call is initial state of the next one
+    Mat streamH;
 
 public:
 
@@ -989,10 +1049,50 @@ public:
             CV_CheckTypeEQ(Wx.type(), bias.type(), "");
         }
 
+        streaming = false;
+        if (params.get<bool>("streaming", false))
+            setStreaming(true);
+
         allocated = false;
         outTailShape.clear();
     }
 
+    void setStreaming(bool streaming_) CV_OVERRIDE
+    {
+        if (streaming_)
+            CV_CheckFalse(bidirectional, "DNN/GRU: streaming mode is not supported by bidirectional GRU");
+        streaming = streaming_;
+        resetState();
+    }
+
+    int getNumStates() const CV_OVERRIDE
+    {
+        return 1;
+    }
+
+    void resetState() CV_OVERRIDE
+    {
+        streamH.release();
+    }
+
+    void getState(std::vector<Mat>& states) const CV_OVERRIDE
+    {
+        states.push_back(streamH.clone());
+    }
+
+    void setState(const Mat* states) CV_OVERRIDE
+    {
+        if (states[0].empty())
+        {
+            resetState();
+            return;
+        }
+        CV_CheckEQ(states[0].dims, 2, "DNN/GRU: state must be a [batch, hidden] matrix");
+        CV_CheckTypeEQ(states[0].type(), CV_32F, "");
+        CV_CheckEQ(states[0].cols, blobs[0].cols, "DNN/GRU: unexpected size of hidden state");
+        streamH = states[0].clone();
+    }
+
     bool getMemoryShapes(const std::vector<MatShape> &inputs,
                          const int requiredOutputs,
                          std::vector<MatShape> &outputs,
@@ -1083,7 +1183,12 @@ public:
             const Mat &Wh = blobs[0].rowRange(i * blobs[0].rows / numDirs, (i + 1) * blobs[0].rows / numDirs);
             const Mat &Wx = blobs[1].rowRange(i * blobs[1].rows / numDirs, (i + 1) * blobs[1].rows / numDirs);
             const Mat &bias = blobs[2].colRange(i * blobs[2].cols / numDirs, (i + 1) * blobs[2].cols / numDirs);
-            const Mat &h_0 = blobs[3].rowRange(i * blobs[3].rows / numDirs, (i + 1) * blobs[3].rows / numDirs);
+            Mat h_0 = blobs[3].rowRange(i * blobs[3].rows / numDirs, (i + 1) * blobs[3].rows / numDirs);
+            if (streaming && !streamH.empty())
+            {
+                CV_CheckEQ(streamH.rows, numSamples, "DNN/GRU: batch size can't be changed in streaming mode, reset states first");
+                h_0 = streamH;
+            }
 
             const Mat &bx = bias.colRange(0, bias.cols / 2);
             const Mat &bh = bias.colRange(bias.cols / 2, bias.cols);
@@ -1154,6 +1259,8 @@ public:
                 //save results in output blobs
                 hInternal.copyTo(hOutTs.rowRange(curRowRange));
             }
+            if (streaming)
+                hInternal.copyTo(streamH);
         }
     }
 };
@@ -109,6 +109,17 @@ private:
 struct BlobManager
 {
 public:
+    // Intermediate blob with a known lifetime (in terms of layers allocation steps).
+    struct MemoryBlock
+    {
+        size_t total;   // number of elements
+        int dtype;
+        int first, last;
+        size_t offset;  // in elements, inside the arena of blob's type
+    };
+
+    BlobManager() : currentStep(0), plannedBytes(0), naiveBytes(0) {}
+
     // Increase references counter to layer output.
     void addReference(const LayerPin& lp)
     {
@@ -170,6 +181,14 @@ public:
         CV_Assert(refIt != refCounter.end());
         CV_Assert(refIt->second > 0);
         refIt->second -= 1;
+
+        if (refIt->second == 0)
+        {
+            // memory planning: blob's lifetime ends at the current step
+            std::map<LayerPin, MemoryBlock>::iterator blockIt = memBlocks.find(refIt->first);
+            if (blockIt != memBlocks.end())
+                blockIt->second.last = currentStep;
+        }
     }
 
     void releaseReferences(const std::vector<LayerPin>& pins)
@@ -182,6 +201,19 @@ public:
 
     void reuseOrCreate(const MatShape& shape, const LayerPin& lp, Mat& dst, const int& dtype)
     {
+        std::map<LayerPin, MemoryBlock>::const_iterator plannedIt = plannedBlocks.find(lp);
+        if (plannedIt != plannedBlocks.end())
+        {
+            const MemoryBlock& block = plannedIt->second;
+            std::map<int, Mat>::const_iterator arenaIt = arenas.find(dtype);
+            CV_Assert(block.dtype == dtype && block.total == (size_t)total(shape));
+            CV_Assert(arenaIt != arenas.end());
+            const Mat& arena = arenaIt->second;
+            dst = arena.colRange((int)block.offset, (int)(block.offset + block.total)).reshape(1, shape);
+            addHost(lp, dst);
+            return;
+        }
+
         if (!getParam_DNN_DISABLE_MEMORY_OPTIMIZATIONS())
         {
             Mat bestBlob;
@@ -303,6 +335,160 @@ public:
         }
     }
 
+    // Mirrors allocateBlobsForLayer() without touching any memory.
+    // Every blob which would get its own memory is registered as a block
+    // whose lifetime starts at the current step. The lifetime ends when
+    // the last reference to the block is released (see releaseReference()).
+    void simulateBlobsForLayer(const LayerData& ld, const LayerShapes& layerShapes,
+            std::vector<LayerPin>& pinsForInternalBlobs)
+    {
+        CV_TRACE_FUNCTION();
+
+        pinsForInternalBlobs.clear();
+
+        const ShapesVec &outShapes = layerShapes.out,
+                        internalShapes = layerShapes.internal;
+        const size_t numOutputs = std::max((size_t)1, outShapes.size());
+
+        bool inPlace = false;
+        if (layerShapes.supportInPlace && ld.inputBlobsId.size() == 1)
+            inPlace = numReferences(ld.inputBlobsId[0]) == 1;
+
+        ShapesVec shapes(outShapes);
+        shapes.insert(shapes.end(), internalShapes.begin(), internalShapes.end());
+        for (size_t i = 0; i < internalShapes.size(); i++)
+        {
+            if (total(internalShapes[i]))
+                pinsForInternalBlobs.push_back(LayerPin(ld.id, (int)(numOutputs + i)));
+        }
+
+        addReferences(pinsForInternalBlobs);
+
+        for (int index = 0; index < (int)shapes.size(); index++)
+        {
+            if (!total(shapes[index]))
+                continue;
+            LayerPin blobPin(ld.id, index);
+            if (index < (int)outShapes.size() && inPlace)
+            {
+                reuse(ld.inputBlobsId[0], blobPin);
+                continue;
+            }
+            addHost(blobPin, Mat());
+            // Network inputs are owned by the user
+            if (ld.id == 0)
+                continue;
+            MemoryBlock block;
+            block.total = total(shapes[index]);
+            block.dtype = ld.dtype;
+            block.first = currentStep;
+            block.last = INT_MAX;  // kept until somebody releases it
+            block.offset = 0;
+            memBlocks[blobPin] = block;
+        }
+    }
+
+    // Assigns an offset inside an arena to every block registered by
+    // simulateBlobsForLayer(). Blocks with intersecting lifetimes never
+    // overlap in memory. Placement is greedy: the biggest blocks go first,
+    // each one into the smallest suitable gap between already placed blocks.
+    // Returns the number of bytes required by all the arenas.
+    size_t planBlocks(std::map<LayerPin, MemoryBlock>& blocks) const
+    {
+        CV_TRACE_FUNCTION();
+
+        std::map<int, std::vector<MemoryBlock*> > blocksByType;
+        for (std::map<LayerPin, MemoryBlock>::iterator it = blocks.begin(); it != blocks.end(); ++it)
+            blocksByType[it->second.dtype].push_back(&it->second);
+
+        size_t arenasBytes = 0;
+        for (std::map<int, std::vector<MemoryBlock*> >::iterator it = blocksByType.begin(); it != blocksByType.end(); ++it)
+        {
+            std::vector<MemoryBlock*>& group = it->second;
+            const size_t elemSize = CV_ELEM_SIZE(it->first);
+            const size_t alignment = std::max((size_t)1, (size_t)64 / elemSize);  // cache line
+
+            std::stable_sort(group.begin(), group.end(),
+                    [](const MemoryBlock* a, const MemoryBlock* b) { return a->total > b->total; });
+
+            std::vector<MemoryBlock*> placed;
+            size_t arenaSize = 0;
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                MemoryBlock* block = group[i];
+                const size_t size = alignSize(block->total, (int)alignment);
+
+                std::vector<MemoryBlock*> alive;
+                for (size_t j = 0; j < placed.size(); j++)
+                {
+                    if (placed[j]->first <= block->last && block->first <= placed[j]->last)
+                        alive.push_back(placed[j]);
+                }
+                std::sort(alive.begin(), alive.end(),
+                        [](const MemoryBlock* a, const MemoryBlock* b) { return a->offset < b->offset; });
+
+                size_t bestOffset = 0, bestGap = SIZE_MAX, prevEnd = 0;
+                bool found = false;
+                for (size_t j = 0; j < alive.size(); j++)
+                {
+                    if (alive[j]->offset >= prevEnd)
+                    {
+                        size_t gap = alive[j]->offset - prevEnd;
+                        if (gap >= size && gap < bestGap)
+                        {
+                            bestOffset = prevEnd;
+                            bestGap = gap;
+                            found = true;
+                        }
+                    }
+                    prevEnd = std::max(prevEnd, alive[j]->offset + alignSize(alive[j]->total, (int)alignment));
+                }
+                block->offset = found ? bestOffset : prevEnd;
+                arenaSize = std::max(arenaSize, block->offset + size);
+                placed.push_back(block);
+            }
+            arenasBytes += arenaSize * elemSize;
+        }
+        return arenasBytes;
+    }
+
+    // Applies a memory plan computed by planBlocks(). The following calls of
+    // allocateBlobsForLayer() return views of the arenas for planned blobs.
+    void setMemoryPlan(const std::map<LayerPin, MemoryBlock>& blocks)
+    {
+        CV_TRACE_FUNCTION();
+
+        plannedBlocks = blocks;
+        arenas.clear();
+        plannedBytes = naiveBytes = 0;
+
+        std::map<int, size_t> arenaSizes;
+        for (std::map<LayerPin, MemoryBlock>::const_iterator it = blocks.begin(); it != blocks.end(); ++it)
+        {
+            const MemoryBlock& block = it->second;
+            size_t& arenaSize = arenaSizes[block.dtype];
+            arenaSize = std::max(arenaSize, block.offset + block.total);
+            naiveBytes += block.total * CV_ELEM_SIZE(block.dtype);
+        }
+        for (std::map<int, size_t>::const_iterator it = arenaSizes.begin(); it != arenaSizes.end(); ++it)
+        {
+            CV_Assert(it->second <= (size_t)INT_MAX);
+            arenas[it->first].create(1, (int)it->second, it->first);
+            plannedBytes += it->second * CV_ELEM_SIZE(it->first);
+        }
+    }
+
+    void getMemoryPlanStatistics(size_t& plannedBytes_, size_t& naiveBytes_) const
+    {
+        plannedBytes_ = plannedBytes;
+        naiveBytes_ = naiveBytes;
+    }
+
+    // Switches simulation to the next layer.
+    void nextStep() { currentStep++; }
+
+    const std::map<LayerPin, MemoryBlock>& getMemoryBlocks() const { return memBlocks; }
+
     // Clear internal state. Calls before an every reallocation.
     void reset()
     {
@@ -311,6 +497,11 @@ public:
         refCounter.clear();
         reuseMap.clear();
         memHosts.clear();
+        memBlocks.clear();
+        plannedBlocks.clear();
+        arenas.clear();
+        currentStep = 0;
+        plannedBytes = naiveBytes = 0;
     }
 
 private:
@@ -327,6 +518,13 @@ private:
     // For origin blobs key == value.
     std::map<LayerPin, LayerPin> reuseMap;
     std::map<LayerPin, Mat> memHosts;
+
+    // Memory planning
+    int currentStep;
+    std::map<LayerPin, MemoryBlock> memBlocks;  // collected by simulation
+    std::map<LayerPin, MemoryBlock> plannedBlocks;
+    std::map<int, Mat> arenas;  // one arena per data type
+    size_t plannedBytes, naiveBytes;
 };  // BlobManager
 
 
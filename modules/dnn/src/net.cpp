@@ -158,6 +158,22 @@ void Net::setPreferableTarget(int targetId)
     return impl->setPreferableTarget(targetId);
 }
 
+void Net::setPreferableWeightsType(int weightsType)
+{
+    CV_TRACE_FUNCTION();
+    CV_TRACE_ARG(weightsType);
+    CV_Assert(impl);
+    return impl->setPreferableWeightsType(weightsType);
+}
+
+void Net::setNumInterOpThreads(int nthreads)
+{
+    CV_TRACE_FUNCTION();
+    CV_TRACE_ARG(nthreads);
+    CV_Assert(impl);
+    return impl->setNumInterOpThreads(nthreads);
+}
+
 void Net::setInputsNames(const std::vector<String>& inputBlobNames)
 {
     CV_TRACE_FUNCTION();
@@ -413,6 +429,64 @@ void Net::enableWinograd(bool useWinograd)
     return impl->enableWinograd(useWinograd);
 }
 
+void Net::enableDynamicQuantization(bool enable)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->enableDynamicQuantization(enable);
+}
+
+void Net::enableStreaming(bool enable)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->enableStreaming(enable);
+}
+
+void Net::resetStates()
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->resetStates();
+}
+
+void Net::getStates(std::vector<Mat>& states) const
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->getStates(states);
+}
+
+void Net::setStates(const std::vector<Mat>& states)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->setStates(states);
+}
+
+Net Net::createExecutionContext()
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    Net context;
+    context.impl = impl->createExecutionContext();
+    return context;
+}
+
+void Net::enableMemoryPlanner(bool enable)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->enableMemoryPlanner(enable);
+}
+
+void Net::getMemoryPlanStatistics(size_t& plannedBytes, size_t& naiveBytes) const
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->getMemoryPlanStatistics(plannedBytes, naiveBytes);
+}
+
 void Net::setHalideScheduler(const String& scheduler)
 {
     CV_TRACE_FUNCTION();
@@ -428,5 +502,26 @@ int64 Net::getPerfProfile(std::vector<double>& timings)
     return impl->getPerfProfile(timings);
 }
 
+void Net::getLayersProfile(std::vector<LayerProfile>& profile) const
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->getLayersProfile(profile);
+}
+
+String Net::dumpProfile() const
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->dumpProfile();
+}
+
+String Net::dumpProfileChromeTrace() const
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->dumpProfileChromeTrace();
+}
+
 CV__DNN_INLINE_NS_END
 }}  // namespace cv::dnn
@@ -59,6 +59,12 @@ Net::Impl::Impl()
     preferableTarget = DNN_TARGET_CPU;
     hasDynamicShapes = false;
     useWinograd = true;
+    useDynamicQuantization = false;
+    useStreaming = false;
+    numInterOpThreads = 0;
+    useMemoryPlanner = getParam_DNN_MEMORY_PLANNER();
+    weightsType = DNN_WEIGHTS_FP32;
+    executionContext = false;
 }
 
 
@@ -92,6 +98,10 @@ void Net::Impl::clear()
     }
     netWasAllocated = false;
     layersTimings.clear();
+    layersStartTicks.clear();
+    layersThreads.clear();
+    layersWorkers.clear();
+    interOpGraph.clear();
 }
 
 
@@ -137,6 +147,11 @@ void Net::Impl::setUpNet(const std::vector<LayerPin>& blobsToKeep_)
 
     if (!netWasAllocated || this->blobsToKeep != blobsToKeep_)
     {
+        // Layer instances are shared and can't be finalized again
+        if (executionContext)
+            CV_Error(Error::StsError, "DNN: execution context can't be reallocated. "
+                                      "Use the same input shapes and outputs as in the base network");
+
         if (preferableBackend == DNN_BACKEND_OPENCV && IS_DNN_OPENCL_TARGET(preferableTarget))
 #ifndef HAVE_OPENCL
         {
@@ -590,28 +605,125 @@ void Net::Impl::allocateLayers(const std::vector<LayerPin>& blobsToKeep_)
         ld.internalBlobsWrappers.clear();
     }
 
+    if (useMemoryPlanner && !getParam_DNN_DISABLE_MEMORY_OPTIMIZATIONS() &&
+        preferableBackend == DNN_BACKEND_OPENCV && IS_DNN_CPU_TARGET(preferableTarget))
+    {
+        planMemory(layersShapes, blobsToKeep_);
+    }
+
+    initBlobReferences(blobManager, blobsToKeep_);
+
+    for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); it++)
+    {
+        int lid = it->first;
+        allocateLayer(lid, layersShapes);
+    }
+
+    layersTimings.resize(lastLayerId + 1, 0);
+    layersStartTicks.resize(lastLayerId + 1, 0);
+    layersThreads.resize(lastLayerId + 1, 0);
+    layersWorkers.resize(lastLayerId + 1, 0);
+    fuseLayers(blobsToKeep_);
+    interOpGraph.clear();
+}
+
+
+void Net::Impl::initBlobReferences(BlobManager& manager, const std::vector<LayerPin>& blobsToKeep_) const
+{
     // Fake references to input blobs.
-    for (int i = 0; i < layers[0].outputBlobs.size(); ++i)
-        blobManager.addReference(LayerPin(0, i));
+    for (int i = 0; i < layers.at(0).outputBlobs.size(); ++i)
+        manager.addReference(LayerPin(0, i));
     for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); ++it)
     {
         const LayerData& ld = it->second;
-        blobManager.addReferences(ld.inputBlobsId);
+        manager.addReferences(ld.inputBlobsId);
     }
 
     for (int i = 0; i < blobsToKeep_.size(); i++)
     {
-        blobManager.addReference(blobsToKeep_[i]);
+        manager.addReference(blobsToKeep_[i]);
     }
+}
 
-    for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); it++)
+
+// Computes lifetimes of all the intermediate blobs by replaying allocateLayers()
+// on shapes only and packs them into per-type arenas. Layers are visited in
+// the same order as allocateLayer() does: parents first, then by id.
+void Net::Impl::planMemory(const LayersShapesMap& layersShapes, const std::vector<LayerPin>& blobsToKeep_)
+{
+    CV_TRACE_FUNCTION();
+
+    BlobManager simulation;
+    initBlobReferences(simulation, blobsToKeep_);
+
+    std::set<int> visited;
+    std::vector<int> stack;
+    for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); ++it)
     {
-        int lid = it->first;
-        allocateLayer(lid, layersShapes);
+        stack.push_back(it->first);
+        while (!stack.empty())
+        {
+            int lid = stack.back();
+            if (visited.count(lid))
+            {
+                stack.pop_back();
+                continue;
+            }
+            const LayerData& ld = layers[lid];
+
+            bool parentsReady = true;
+            std::set<int> parents;
+            for (size_t i = 0; i < ld.inputBlobsId.size(); i++)
+                parents.insert(ld.inputBlobsId[i].lid);
+            // push in reverse order to visit parents in ascending order
+            for (std::set<int>::const_reverse_iterator p = parents.rbegin(); p != parents.rend(); ++p)
+            {
+                if (!visited.count(*p))
+                {
+                    stack.push_back(*p);
+                    parentsReady = false;
+                }
+            }
+            if (!parentsReady)
+                continue;
+            stack.pop_back();
+            visited.insert(lid);
+
+            LayersShapesMap::const_iterator layerShapesIt = layersShapes.find(lid);
+            CV_Assert(layerShapesIt != layersShapes.end());
+
+            std::vector<LayerPin> pinsForInternalBlobs;
+            simulation.simulateBlobsForLayer(ld, layerShapesIt->second, pinsForInternalBlobs);
+            simulation.releaseReferences(ld.inputBlobsId);
+            simulation.releaseReferences(pinsForInternalBlobs);
+            simulation.nextStep();
+        }
     }
 
-    layersTimings.resize(lastLayerId + 1, 0);
-    fuseLayers(blobsToKeep_);
+    std::map<LayerPin, BlobManager::MemoryBlock> blocks = simulation.getMemoryBlocks();
+    simulation.planBlocks(blocks);
+    blobManager.setMemoryPlan(blocks);
+
+    size_t plannedBytes = 0, naiveBytes = 0;
+    blobManager.getMemoryPlanStatistics(plannedBytes, naiveBytes);
+    CV_LOG_DEBUG(NULL, "DNN: memory plan: " << blocks.size() << " blobs, " << plannedBytes
+            << " bytes (" << naiveBytes << " bytes without reuse)");
+}
+
+
+void Net::Impl::enableMemoryPlanner(bool useMemoryPlanner_)
+{
+    if (useMemoryPlanner != useMemoryPlanner_)
+    {
+        useMemoryPlanner = useMemoryPlanner_;
+        clear();
+    }
+}
+
+
+void Net::Impl::getMemoryPlanStatistics(size_t& plannedBytes, size_t& naiveBytes) const
+{
+    blobManager.getMemoryPlanStatistics(plannedBytes, naiveBytes);
 }
 
 
@@ -623,6 +735,9 @@ void Net::Impl::forwardLayer(LayerData& ld)
 
     if (!ld.skip)
     {
+        layersStartTicks[ld.id] = getTickCount();
+        layersThreads[ld.id] = getNumThreads();
+        layersWorkers[ld.id] = 0;  // set by the inter-op scheduler
         TickMeter tm;
         tm.start();
 
@@ -852,6 +967,9 @@ void Net::Impl::forwardLayer(LayerData& ld)
     else
     {
         layersTimings[ld.id] = 0;
+        layersStartTicks[ld.id] = 0;
+        layersThreads[ld.id] = 0;
+        layersWorkers[ld.id] = 0;
     }
 
     ld.flag = 1;
@@ -872,6 +990,10 @@ void Net::Impl::forwardToLayer(LayerData& ld, bool clearFlags)
     if (ld.flag)
         return;
 
+    // independent branches of the graph are computed in parallel
+    if (forwardInterOp(ld))
+        return;
+
     // forward parents
     for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end() && (it->second.id < ld.id); ++it)
     {
@@ -2343,6 +2465,117 @@ void Net::Impl::enableWinograd(bool useWinograd_)
     }
 }
 
+void Net::Impl::enableDynamicQuantization(bool enable)
+{
+    if (useDynamicQuantization != enable)
+    {
+        useDynamicQuantization = enable;
+
+        for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); it++)
+        {
+            LayerData &ld = it->second;
+            if (ld.type == "Gemm")
+            {
+                ld.params.set("dynamic_quantization", enable);
+                Ptr<GemmLayer> gemmLayer = ld.layerInstance.dynamicCast<GemmLayer>();
+                if (!gemmLayer.empty())
+                    gemmLayer->dynamicQuantization = enable;
+            }
+            else if (ld.type == "MatMul")
+            {
+                ld.params.set("dynamic_quantization", enable);
+                Ptr<MatMulLayer> matmulLayer = ld.layerInstance.dynamicCast<MatMulLayer>();
+                if (!matmulLayer.empty())
+                    matmulLayer->dynamicQuantization = enable;
+            }
+        }
+        clear();  // weights are quantized during the next allocation
+    }
+}
+
+
+void Net::Impl::enableStreaming(bool enable)
+{
+    useStreaming = enable;
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); it++)
+    {
+        LayerData &ld = it->second;
+        if (ld.type == "LSTM" || ld.type == "GRU")
+            ld.params.set("streaming", enable);
+        StatefulLayer* stateful = dynamic_cast<StatefulLayer*>(ld.layerInstance.get());
+        if (stateful)
+            stateful->setStreaming(enable);
+    }
+}
+
+void Net::Impl::resetStates()
+{
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); it++)
+    {
+        StatefulLayer* stateful = dynamic_cast<StatefulLayer*>(getLayerInstance(it->second).get());
+        if (stateful)
+            stateful->resetState();
+    }
+}
+
+void Net::Impl::getStates(std::vector<Mat>& states) const
+{
+    states.clear();
+    for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); it++)
+    {
+        const StatefulLayer* stateful = dynamic_cast<const StatefulLayer*>(getLayerInstance(const_cast<LayerData&>(it->second)).get());
+        if (stateful)
+            stateful->getState(states);
+    }
+}
+
+void Net::Impl::setStates(const std::vector<Mat>& states)
+{
+    size_t numStates = 0;
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); it++)
+    {
+        StatefulLayer* stateful = dynamic_cast<StatefulLayer*>(getLayerInstance(it->second).get());
+        if (stateful)
+            numStates += stateful->getNumStates();
+    }
+    CV_CheckEQ(states.size(), numStates, "DNN: number of states doesn't match getStates()");
+
+    size_t offset = 0;
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); it++)
+    {
+        StatefulLayer* stateful = dynamic_cast<StatefulLayer*>(getLayerInstance(it->second).get());
+        if (stateful)
+        {
+            stateful->setState(states.data() + offset);
+            offset += stateful->getNumStates();
+        }
+    }
+}
+
+
+void Net::Impl::setPreferableWeightsType(int weightsType_)
+{
+    CV_Check(weightsType_, weightsType_ == DNN_WEIGHTS_FP32 || weightsType_ == DNN_WEIGHTS_FP16 || weightsType_ == DNN_WEIGHTS_BF16,
+             "Unknown weights type");
+    if (weightsType != weightsType_)
+    {
+        weightsType = weightsType_;
+
+        for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); it++)
+        {
+            LayerData &ld = it->second;
+            if (ld.type == "Convolution")
+            {
+                ld.params.set("weights_type", weightsType_);
+                Ptr<ConvolutionLayer> convLayer = ld.layerInstance.dynamicCast<ConvolutionLayer>();
+                if (!convLayer.empty())
+                    convLayer->weightsType = weightsType_;
+            }
+        }
+        clear();  // weights are repacked during the next allocation
+    }
+}
+
 
 // TODO drop?
 void Net::Impl::getLayerTypes(std::vector<String>& layersTypes) const
@@ -66,7 +66,29 @@ struct Net::Impl : public detail::NetImplBase
     bool fusion;
     bool isAsync;  // FIXIT: drop
     bool useWinograd;
+    bool useDynamicQuantization;
+    bool useStreaming;
+    bool useMemoryPlanner;
+    int weightsType;
+    bool executionContext;  // layer instances are shared with another network
     std::vector<int64> layersTimings;
+    std::vector<int64> layersStartTicks;  // tick count at the beginning of the layer forward
+    std::vector<int> layersThreads;
+    std::vector<int> layersWorkers;  // inter-op thread index
+
+    // inter-op scheduling (net_impl_scheduler.cpp)
+    struct InterOpNode
+    {
+        std::vector<int> deps;  // layers which must be computed before
+        std::vector<int> consumers;
+        bool exclusive;  // heavy layer, computed without other layers in parallel
+
+        InterOpNode() : exclusive(false) {}
+    };
+    struct InterOpScheduler;
+    int numInterOpThreads;
+    std::vector<InterOpNode> interOpGraph;  // indexed by layer id, built on demand
+    Ptr<InterOpScheduler> interOpScheduler;
 
 
     virtual bool empty() const;
@@ -215,9 +237,26 @@ struct Net::Impl : public detail::NetImplBase
 
     virtual void fuseLayers(const std::vector<LayerPin>& blobsToKeep_);
     void enableWinograd(bool useWinograd_);
+    void enableDynamicQuantization(bool enable);
+    void enableStreaming(bool enable);
+    void resetStates();
+    void getStates(std::vector<Mat>& states) const;
+    void setStates(const std::vector<Mat>& states);
+    void setPreferableWeightsType(int weightsType_);
+    void setNumInterOpThreads(int nthreads);
+    void buildInterOpGraph();
+    int getInterOpWidth() const;
+    bool forwardInterOp(LayerData& ld);
 
     void allocateLayers(const std::vector<LayerPin>& blobsToKeep_);
 
+    Ptr<Impl> createExecutionContext();
+
+    void enableMemoryPlanner(bool useMemoryPlanner_);
+    void getMemoryPlanStatistics(size_t& plannedBytes, size_t& naiveBytes) const;
+    void initBlobReferences(BlobManager& manager, const std::vector<LayerPin>& blobsToKeep_) const;
+    void planMemory(const LayersShapesMap& layersShapes, const std::vector<LayerPin>& blobsToKeep_);
+
     virtual void forwardLayer(LayerData& ld);
 
     void forwardToLayer(LayerData& ld, bool clearFlags = true);
@@ -265,6 +304,9 @@ struct Net::Impl : public detail::NetImplBase
             std::vector<int>& layerIds, std::vector<size_t>& weights,
             std::vector<size_t>& blobs) /*const*/;
     int64 getPerfProfile(std::vector<double>& timings) const;
+    void getLayersProfile(std::vector<LayerProfile>& profile) const;
+    String dumpProfile() const;
+    String dumpProfileChromeTrace() const;
 
     // TODO drop
     LayerPin getLatestLayerPin(const std::vector<LayerPin>& pins) const;
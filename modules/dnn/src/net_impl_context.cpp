@@ -0,0 +1,153 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include "net_impl.hpp"
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+
+namespace {
+
+// Creates private copies of blobs memory while preserving aliasing between blobs:
+// all the views of the same allocation are mapped onto views of a single new buffer.
+class BlobsCloner
+{
+public:
+    Mat operator()(const Mat& m)
+    {
+        if (m.empty())
+            return Mat();
+        if (!m.u || !m.u->data)
+            return m.clone();  // user-owned memory, no aliasing information
+
+        std::map<UMatData*, Mat>::iterator it = buffers.find(m.u);
+        if (it == buffers.end())
+        {
+            CV_Assert(m.u->size <= (size_t)INT_MAX);
+            it = buffers.insert(std::make_pair(m.u, Mat(1, (int)m.u->size, CV_8UC1))).first;
+        }
+        const Mat& buffer = it->second;
+        const size_t offset = m.data - m.u->data;
+        CV_Assert(offset + m.total() * m.elemSize() <= buffer.total());
+
+        Mat view(m.dims, m.size.p, m.type(), buffer.data + offset, m.step.p);
+        // Share ownership of the new buffer: blobs may outlive the context (e.g. returned outputs)
+        view.u = buffer.u;
+        view.addref();
+        return view;
+    }
+
+private:
+    std::map<UMatData*, Mat> buffers;
+};
+
+}  // namespace
+
+
+Ptr<Net::Impl> Net::Impl::createExecutionContext()
+{
+    CV_TRACE_FUNCTION();
+
+    if (preferableBackend != DNN_BACKEND_OPENCV || !IS_DNN_CPU_TARGET(preferableTarget))
+        CV_Error(Error::StsNotImplemented, "DNN: execution contexts are supported by DNN_BACKEND_OPENCV on CPU targets only");
+    if (useStreaming)
+        CV_Error(Error::StsNotImplemented, "DNN: execution contexts can't share states of recurrent layers in streaming mode");
+    if (!netWasAllocated)
+    {
+        // Allocate for the default output as forward() does. Input shapes are taken from setInput()
+        std::vector<String> layerNames = getLayerNames();
+        CV_Assert(!layerNames.empty());
+        setUpNet(std::vector<LayerPin>(1, getPinByAlias(layerNames.back())));
+    }
+
+    // Shared layer instances must not be modified by forward() calls of contexts:
+    // complete lazy initialization (packing of weights) before any context exists
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        LazyInitializedLayer* lazyLayer = dynamic_cast<LazyInitializedLayer*>(ld.layerInstance.get());
+        if (ld.skip || !lazyLayer)
+            continue;
+        std::vector<Mat> inputs(ld.inputBlobs.size());
+        for (size_t i = 0; i < ld.inputBlobs.size(); i++)
+            inputs[i] = *ld.inputBlobs[i];
+        lazyLayer->initForward(inputs, ld.outputBlobs);
+    }
+
+    Ptr<Net::Impl> ctx = makePtr<Net::Impl>();
+
+    // Configuration
+    ctx->blobsToKeep = blobsToKeep;
+    ctx->layerNameToId = layerNameToId;
+    ctx->outputNameToId = outputNameToId;
+    ctx->preferableBackend = preferableBackend;
+    ctx->preferableTarget = preferableTarget;
+    ctx->hasDynamicShapes = hasDynamicShapes;
+    ctx->lastLayerId = lastLayerId;
+    ctx->netWasQuantized = netWasQuantized;
+    ctx->fusion = fusion;
+    ctx->useWinograd = useWinograd;
+    ctx->useDynamicQuantization = useDynamicQuantization;
+    ctx->useMemoryPlanner = useMemoryPlanner;
+    ctx->numInterOpThreads = numInterOpThreads;
+    ctx->weightsType = weightsType;
+    ctx->layersTimings.resize(layersTimings.size(), 0);
+    ctx->layersStartTicks.resize(layersStartTicks.size(), 0);
+    ctx->layersThreads.resize(layersThreads.size(), 0);
+    ctx->layersWorkers.resize(layersWorkers.size(), 0);
+
+    // Network inputs: private input layer with copies of preprocessing parameters
+    Ptr<DataLayer> inputLayer = ctx->netInputLayer;
+    inputLayer->outNames = netInputLayer->outNames;
+    inputLayer->shapes = netInputLayer->shapes;
+    inputLayer->scaleFactors = netInputLayer->scaleFactors;
+    inputLayer->means = netInputLayer->means;
+    inputLayer->skip = netInputLayer->skip;
+
+    BlobsCloner cloneBlob;
+    inputLayer->inputsData.resize(netInputLayer->inputsData.size());
+    for (size_t i = 0; i < netInputLayer->inputsData.size(); i++)
+        inputLayer->inputsData[i] = cloneBlob(netInputLayer->inputsData[i]);
+
+    // Layers share instances (weights and packed buffers) but own blobs
+    ctx->layers = layers;
+    std::map<const Mat*, Mat*> outputsMap;
+    for (MapIdToLayerData::iterator it = ctx->layers.begin(); it != ctx->layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        const LayerData& baseLd = layers[it->first];
+        if (ld.id == 0)
+            ld.layerInstance = inputLayer;
+        for (size_t i = 0; i < ld.outputBlobs.size(); i++)
+        {
+            ld.outputBlobs[i] = cloneBlob(baseLd.outputBlobs[i]);
+            outputsMap[&baseLd.outputBlobs[i]] = &ld.outputBlobs[i];
+        }
+        for (size_t i = 0; i < ld.internals.size(); i++)
+            ld.internals[i] = cloneBlob(baseLd.internals[i]);
+        ld.flag = 0;
+    }
+    for (MapIdToLayerData::iterator it = ctx->layers.begin(); it != ctx->layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        for (size_t i = 0; i < ld.inputBlobs.size(); i++)
+        {
+            std::map<const Mat*, Mat*>::const_iterator mapIt = outputsMap.find(ld.inputBlobs[i]);
+            CV_Assert(mapIt != outputsMap.end());
+            ld.inputBlobs[i] = mapIt->second;
+        }
+    }
+
+    ctx->executionContext = true;
+    ctx->netWasAllocated = true;
+    return ctx;
+}
+
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
@@ -187,15 +187,28 @@ void Net::Impl::fuseLayers(const std::vector<LayerPin>& blobsToKeep_)
                     break;
             }
 
-            // CPU: fuse Convolution 2D layer followed by Add + activation.
-            while (nextData && (IS_DNN_CPU_TARGET(preferableTarget)) && ld.layerInstance->type == "Convolution")
+            // CPU: fuse Convolution 2D, Gemm or MatMul layer followed by Add + activation.
+            // Gemm and MatMul are fused to accumulate to the residual in transformer blocks.
+            Ptr<ConvolutionLayer> convLayer = ld.layerInstance->type == "Convolution" ?
+                    ld.layerInstance.dynamicCast<ConvolutionLayer>() : Ptr<ConvolutionLayer>();
+            Ptr<GemmLayer> gemmLayer = ld.layerInstance.dynamicCast<GemmLayer>();
+            Ptr<MatMulLayer> matmulLayer = ld.layerInstance.dynamicCast<MatMulLayer>();
+            while (nextData && (IS_DNN_CPU_TARGET(preferableTarget)) && (convLayer || gemmLayer || matmulLayer))
             {
                 // Note that we can only deal with conv + Add + activ here.
                 // To avoid the order like: conv + activ + add, if we found the conv has been fused with activ, we break.
-                Ptr<ConvolutionLayer> convLayer = ld.layerInstance.dynamicCast<ConvolutionLayer>();
+                bool& fusedActivation = convLayer ? convLayer->fusedActivation :
+                                        gemmLayer ? gemmLayer->fusedActivation : matmulLayer->fusedActivation;
+                bool& fusedAdd = convLayer ? convLayer->fusedAdd :
+                                 gemmLayer ? gemmLayer->fusedAdd : matmulLayer->fusedAdd;
 
-                // Only Convolution layer without fusion Activation supports this fusion, other-wise, we skip.
-                if (convLayer->fusedActivation)
+                // Only layer without fusion Activation supports this fusion, other-wise, we skip.
+                if (fusedActivation)
+                    break;
+
+                // Gemm/MatMul: residual is written to the output before the layer runs, so the layer
+                // must not depend on other (non-constant) blobs
+                if ((gemmLayer || matmulLayer) && ld.inputBlobs.size() != 1)
                     break;
 
                 // For now, there are currently two layers in OpenCV that run the Add operator.
@@ -268,16 +281,36 @@ void Net::Impl::fuseLayers(const std::vector<LayerPin>& blobsToKeep_)
                         break;
 
                     CV_Assert(biasLayerData);
+
+                    // Gemm/MatMul: the residual of transformer blocks is also an input of LayerNorm or attention.
+                    // It may be overwritten if other consumers are computed before [ld] and only read it.
+                    bool canOverwriteBias = biasLayerData->consumers.size() == 1;
+                    if (!canOverwriteBias && (gemmLayer || matmulLayer) &&
+                        biasLayerData->outputBlobs.size() == 1 && pinsToKeep.count(LayerPin(biasLayerData->id, 0)) == 0)
+                    {
+                        canOverwriteBias = true;
+                        for (size_t i = 0; i < biasLayerData->consumers.size() && canOverwriteBias; ++i)
+                        {
+                            const LayerData& consumer = layers[biasLayerData->consumers[i].lid];
+                            if (consumer.id == naryOrEltwiseData->id)
+                                continue;
+                            canOverwriteBias = consumer.id < ld.id;
+                            // in-place consumers modify the residual
+                            for (size_t j = 0; j < consumer.outputBlobs.size() && canOverwriteBias; ++j)
+                                canOverwriteBias = consumer.outputBlobs[j].data != biasLayerData->outputBlobs[0].data;
+                        }
+                    }
+
                     {
                         // fuse naryEltwise layer
                         // bias must already be computed to fuse => bias layer must appear before convolution
-                        if (biasLayerData->id < ld.id && biasLayerData->consumers.size() == 1)
+                        if (biasLayerData->id < ld.id && canOverwriteBias)
                         {
                             // conv + naryEltwise.
                             CV_Assert_N(biasLayerData->outputBlobs.size() == 1, ld.inputBlobs.size() == 1);
                             CV_Assert_N(biasLayerData->outputBlobsWrappers.size() == 1, ld.inputBlobsWrappers.size() == 1);
 
-                            printf_(("\tfused with %s\n", nextNaryEltwiseLayer->name.c_str()));
+                            printf_(("\tfused with %s\n", naryOrEltwiseData->name.c_str()));
                             naryOrEltwiseData->skip = true;
 
 
@@ -314,7 +347,7 @@ void Net::Impl::fuseLayers(const std::vector<LayerPin>& blobsToKeep_)
                             naryOrEltwiseData->outputBlobsWrappers = ld.outputBlobsWrappers;
 
                             // set the fusedAdd flag in [Conv];
-                            convLayer->fusedAdd = true;
+                            fusedAdd = true;
                             LayerData* finalData = naryOrEltwiseData;
                             /* After fused Conv + naryEltwise or eltwise, we can fuse activation if:
                              * => activation layer that follows is the only consumer of eltwise output
@@ -329,9 +362,8 @@ void Net::Impl::fuseLayers(const std::vector<LayerPin>& blobsToKeep_)
                                 if (nextData->outputBlobs.size() == 1)
                                     nextFusabeleActivLayer = nextAct->layerInstance.dynamicCast<ActivationLayer>();
 
-                                if (!nextFusabeleActivLayer.empty())
+                                if (!nextFusabeleActivLayer.empty() && currLayer->setActivation(nextFusabeleActivLayer))
                                 {
-                                    convLayer->setActivation(nextFusabeleActivLayer);
                                     nextAct->skip = true;
 
                                     nextAct->outputBlobs = ld.outputBlobs;
@@ -0,0 +1,215 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include "net_impl.hpp"
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+
+LayerProfile::LayerProfile()
+    : id(-1)
+    , fused(false)
+    , startMs(0)
+    , timeMs(0)
+    , flops(0)
+    , bytesRead(0)
+    , bytesWritten(0)
+    , gflops(0)
+    , gbps(0)
+    , arithmeticIntensity(0)
+    , threads(0)
+    , worker(0)
+{
+    // nothing
+}
+
+
+void Net::Impl::getLayersProfile(std::vector<LayerProfile>& profile) const
+{
+    CV_TRACE_FUNCTION();
+
+    profile.clear();
+    const double ticksToMs = 1000.0 / getTickFrequency();
+    const bool queryKernels = preferableBackend == DNN_BACKEND_OPENCV && IS_DNN_CPU_TARGET(preferableTarget);
+
+    int64 firstTick = 0;
+    for (size_t i = 1; i < layersStartTicks.size(); i++)
+    {
+        if (layersStartTicks[i] != 0 && (firstTick == 0 || layersStartTicks[i] < firstTick))
+            firstTick = layersStartTicks[i];
+    }
+
+    for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        const LayerData& ld = it->second;
+        if (ld.id == 0)
+            continue;  // network input
+
+        LayerProfile p;
+        p.id = ld.id;
+        p.name = ld.name;
+        p.type = ld.type;
+        p.fused = ld.skip;
+        if ((size_t)ld.id < layersTimings.size())
+        {
+            p.timeMs = layersTimings[ld.id] * ticksToMs;
+            if (layersStartTicks[ld.id] != 0)
+                p.startMs = (layersStartTicks[ld.id] - firstTick) * ticksToMs;
+            p.threads = layersThreads[ld.id];
+            p.worker = layersWorkers[ld.id];
+        }
+
+        std::vector<MatShape> inputShapes, outputShapes;
+        for (size_t i = 0; i < ld.inputBlobs.size(); i++)
+        {
+            if (!ld.inputBlobs[i])
+                continue;
+            const Mat& m = *ld.inputBlobs[i];
+            inputShapes.push_back(shape(m));
+            p.bytesRead += (int64)(m.total() * m.elemSize());
+        }
+        for (size_t i = 0; i < ld.outputBlobs.size(); i++)
+        {
+            const Mat& m = ld.outputBlobs[i];
+            outputShapes.push_back(shape(m));
+            p.bytesWritten += (int64)(m.total() * m.elemSize());
+        }
+
+        const Ptr<Layer>& layer = ld.layerInstance;
+        if (layer)
+        {
+            for (size_t i = 0; i < layer->blobs.size(); i++)
+                p.bytesRead += (int64)(layer->blobs[i].total() * layer->blobs[i].elemSize());
+            if (!inputShapes.empty() && !outputShapes.empty())
+                p.flops = layer->getFLOPS(inputShapes, outputShapes);
+            const LayerKernelInfo* kernelInfo = dynamic_cast<const LayerKernelInfo*>(layer.get());
+            if (queryKernels && kernelInfo && !p.fused)
+                p.kernel = kernelInfo->getKernelName();
+        }
+
+        if (p.fused)
+        {
+            // computed as a part of another layer without separate memory traffic
+            p.bytesRead = p.bytesWritten = 0;
+        }
+        const int64 bytes = p.bytesRead + p.bytesWritten;
+        if (bytes > 0)
+            p.arithmeticIntensity = (double)p.flops / bytes;
+        if (p.timeMs > 0)
+        {
+            p.gflops = p.flops / (p.timeMs * 1e6);
+            p.gbps = bytes / (p.timeMs * 1e6);
+        }
+        profile.push_back(p);
+    }
+}
+
+
+static std::string jsonEscape(const std::string& s)
+{
+    std::string res;
+    res.reserve(s.size());
+    for (size_t i = 0; i < s.size(); i++)
+    {
+        const char c = s[i];
+        if (c == '"' || c == '\\')
+        {
+            res += '\\';
+            res += c;
+        }
+        else if ((uchar)c < 0x20)
+        {
+            res += format("\\u%04x", (int)(uchar)c);
+        }
+        else
+        {
+            res += c;
+        }
+    }
+    return res;
+}
+
+static void dumpLayerProfileFields(std::ostringstream& out, const LayerProfile& p)
+{
+    out << "\"id\": " << p.id
+        << ", \"name\": \"" << jsonEscape(p.name) << "\""
+        << ", \"type\": \"" << jsonEscape(p.type) << "\""
+        << ", \"fused\": " << (p.fused ? "true" : "false")
+        << ", \"start_ms\": " << format("%.6f", p.startMs)
+        << ", \"time_ms\": " << format("%.6f", p.timeMs)
+        << ", \"flops\": " << p.flops
+        << ", \"bytes_read\": " << p.bytesRead
+        << ", \"bytes_written\": " << p.bytesWritten
+        << ", \"gflops\": " << format("%.4f", p.gflops)
+        << ", \"gbps\": " << format("%.4f", p.gbps)
+        << ", \"arithmetic_intensity\": " << format("%.4f", p.arithmeticIntensity)
+        << ", \"kernel\": \"" << jsonEscape(p.kernel) << "\""
+        << ", \"threads\": " << p.threads
+        << ", \"worker\": " << p.worker;
+}
+
+String Net::Impl::dumpProfile() const
+{
+    CV_TRACE_FUNCTION();
+
+    std::vector<LayerProfile> profile;
+    getLayersProfile(profile);
+
+    double totalMs = 0;
+    int64 totalFlops = 0;
+    std::ostringstream out;
+    out << "{\n  \"layers\": [";
+    for (size_t i = 0; i < profile.size(); i++)
+    {
+        const LayerProfile& p = profile[i];
+        totalMs += p.timeMs;
+        totalFlops += p.flops;
+        out << (i > 0 ? ",\n" : "\n") << "    {";
+        dumpLayerProfileFields(out, p);
+        out << "}";
+    }
+    out << "\n  ],\n"
+        << "  \"total_ms\": " << format("%.6f", totalMs) << ",\n"
+        << "  \"total_flops\": " << totalFlops << "\n"
+        << "}\n";
+    return out.str();
+}
+
+String Net::Impl::dumpProfileChromeTrace() const
+{
+    CV_TRACE_FUNCTION();
+
+    std::vector<LayerProfile> profile;
+    getLayersProfile(profile);
+
+    std::ostringstream out;
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    for (size_t i = 0; i < profile.size(); i++)
+    {
+        const LayerProfile& p = profile[i];
+        if (p.fused)
+            continue;
+        out << (first ? "\n" : ",\n")
+            << "  {\"name\": \"" << jsonEscape(p.name) << "\""
+            << ", \"cat\": \"" << jsonEscape(p.type) << "\""
+            << ", \"ph\": \"X\", \"pid\": " << networkId << ", \"tid\": " << p.worker
+            << ", \"ts\": " << format("%.3f", p.startMs * 1e3)
+            << ", \"dur\": " << format("%.3f", p.timeMs * 1e3)
+            << ", \"args\": {";
+        dumpLayerProfileFields(out, p);
+        out << "}}";
+        first = false;
+    }
+    out << "\n]}\n";
+    return out.str();
+}
+
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
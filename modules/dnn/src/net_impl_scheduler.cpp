@@ -0,0 +1,360 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include "net_impl.hpp"
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#endif
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+
+// Executes layers of a DAG on a pool of threads. The calling thread participates in computations.
+// Light layers run concurrently, heavy ("exclusive") layers run alone so that their intra-op
+// parallel_for_() gets all the threads of the OpenCV thread pool.
+struct Net::Impl::InterOpScheduler
+{
+    struct Job
+    {
+        Net::Impl* net;
+        std::deque<int> ready, readyExclusive;
+        std::vector<int> numDeps;  // unfinished dependencies
+        std::vector<bool> selected;  // layers to compute
+        int remaining;  // layers to compute
+        int running;
+        bool exclusiveRunning;
+        int activeWorkers;
+        std::exception_ptr error;
+    };
+
+    explicit InterOpScheduler(int numThreads_)
+        : numThreads(numThreads_)
+        , job(NULL)
+        , generation(0)
+        , stopping(false)
+    {
+        for (int i = 1; i < numThreads; i++)
+            workers.push_back(std::thread(&InterOpScheduler::workerLoop, this, i));
+    }
+
+    ~InterOpScheduler()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cond.notify_all();
+        for (size_t i = 0; i < workers.size(); i++)
+            workers[i].join();
+    }
+
+    void run(Net::Impl& net, const std::vector<int>& layerIds)
+    {
+        Job j;
+        j.net = &net;
+        j.numDeps.assign(net.interOpGraph.size(), 0);
+        j.selected.assign(net.interOpGraph.size(), false);
+        j.remaining = (int)layerIds.size();
+        j.running = 0;
+        j.exclusiveRunning = false;
+        j.activeWorkers = 0;
+        for (size_t i = 0; i < layerIds.size(); i++)
+            j.selected[layerIds[i]] = true;
+        for (size_t i = 0; i < layerIds.size(); i++)
+        {
+            const int lid = layerIds[i];
+            const InterOpNode& node = net.interOpGraph[lid];
+            for (size_t k = 0; k < node.deps.size(); k++)
+            {
+                if (j.selected[node.deps[k]])
+                    j.numDeps[lid]++;
+            }
+            if (j.numDeps[lid] == 0)
+                (node.exclusive ? j.readyExclusive : j.ready).push_back(lid);
+        }
+
+        std::unique_lock<std::mutex> lock(mtx);
+        job = &j;
+        generation++;
+        cond.notify_all();
+        process(lock, j, 0);
+        // wait for workers leaving the job
+        cond.wait(lock, [&]() { return j.activeWorkers == 0; });
+        job = NULL;
+        lock.unlock();
+
+        if (j.error)
+            std::rethrow_exception(j.error);
+    }
+
+    // Computes layers of the job while there are any. Called with locked mutex.
+    // The calling thread is worker 0.
+    void process(std::unique_lock<std::mutex>& lock, Job& j, int worker)
+    {
+        for (;;)
+        {
+            int lid = -1;
+            bool exclusive = false;
+            if (j.error || j.remaining == 0)
+                break;
+            if (!j.exclusiveRunning)
+            {
+                if (!j.readyExclusive.empty())
+                {
+                    // heavy layer waits for running light layers, new light layers are not started
+                    if (j.running == 0)
+                    {
+                        lid = j.readyExclusive.front();
+                        j.readyExclusive.pop_front();
+                        exclusive = true;
+                    }
+                }
+                else if (!j.ready.empty())
+                {
+                    lid = j.ready.front();
+                    j.ready.pop_front();
+                }
+            }
+            if (lid < 0)
+            {
+                if (j.running == 0 && j.ready.empty() && j.readyExclusive.empty())
+                    break;  // nothing to wait for (failed job)
+                cond.wait(lock);
+                continue;
+            }
+
+            j.running++;
+            j.exclusiveRunning = exclusive;
+            lock.unlock();
+            try
+            {
+                j.net->forwardLayer(j.net->layers[lid]);
+                j.net->layersWorkers[lid] = worker;
+            }
+            catch (...)
+            {
+                lock.lock();
+                if (!j.error)
+                    j.error = std::current_exception();
+                lock.unlock();
+            }
+            lock.lock();
+            j.running--;
+            j.exclusiveRunning = false;
+            j.remaining--;
+            const InterOpNode& node = j.net->interOpGraph[lid];
+            for (size_t k = 0; k < node.consumers.size(); k++)
+            {
+                const int consumer = node.consumers[k];
+                if (j.selected[consumer] && --j.numDeps[consumer] == 0)
+                    (j.net->interOpGraph[consumer].exclusive ? j.readyExclusive : j.ready).push_back(consumer);
+            }
+            cond.notify_all();
+        }
+    }
+
+    void workerLoop(int worker)
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        // generation of the constructor: the thread may start after the first job is submitted
+        size_t lastGeneration = 0;
+        for (;;)
+        {
+            cond.wait(lock, [&]() { return stopping || (job != NULL && generation != lastGeneration); });
+            if (stopping)
+                break;
+            lastGeneration = generation;
+            Job& j = *job;
+            j.activeWorkers++;
+            process(lock, j, worker);
+            j.activeWorkers--;
+            cond.notify_all();
+        }
+    }
+
+    const int numThreads;
+    std::vector<std::thread> workers;
+    std::mutex mtx;
+    std::condition_variable cond;
+    Job* job;
+    size_t generation;
+    bool stopping;
+};
+
+#else  // OPENCV_DISABLE_THREAD_SUPPORT
+
+struct Net::Impl::InterOpScheduler
+{
+    explicit InterOpScheduler(int numThreads_) : numThreads(numThreads_) {}
+
+    void run(Net::Impl& net, const std::vector<int>& layerIds)
+    {
+        for (size_t i = 0; i < layerIds.size(); i++)
+            net.forwardLayer(net.layers[layerIds[i]]);
+    }
+
+    const int numThreads;
+};
+
+#endif  // OPENCV_DISABLE_THREAD_SUPPORT
+
+
+static void getBlobRange(const Mat& m, std::vector<std::pair<const uchar*, const uchar*> >& ranges)
+{
+    if (m.empty())
+        return;
+    // memory of the view itself: blobs may be slices of a larger buffer (e.g. inputs of Concat computed in-place)
+    size_t span = m.elemSize();
+    for (int i = 0; i < m.dims; i++)
+        span += (size_t)(m.size[i] - 1)*m.step[i];
+    ranges.push_back(std::make_pair((const uchar*)m.data, (const uchar*)m.data + span));
+}
+
+static bool rangesIntersect(const std::vector<std::pair<const uchar*, const uchar*> >& a,
+                            const std::vector<std::pair<const uchar*, const uchar*> >& b)
+{
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        for (size_t k = 0; k < b.size(); k++)
+        {
+            if (a[i].first < b[k].second && b[k].first < a[i].second)
+                return true;
+        }
+    }
+    return false;
+}
+
+void Net::Impl::buildInterOpGraph()
+{
+    CV_TRACE_FUNCTION();
+
+    typedef std::vector<std::pair<const uchar*, const uchar*> > Ranges;
+    const int numLayers = lastLayerId + 1;
+    std::vector<Ranges> reads(numLayers), writes(numLayers);
+    std::vector<bool> present(numLayers, false);
+    interOpGraph.assign(numLayers, InterOpNode());
+
+    const size_t heavyFlops = getParam_DNN_INTEROP_HEAVY_LAYER_FLOPS();
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        CV_Assert(ld.id < numLayers);
+        present[ld.id] = true;
+
+        std::vector<MatShape> inputShapes, outputShapes;
+        for (size_t i = 0; i < ld.inputBlobs.size(); i++)
+        {
+            getBlobRange(*ld.inputBlobs[i], reads[ld.id]);
+            inputShapes.push_back(shape(*ld.inputBlobs[i]));
+        }
+        for (size_t i = 0; i < ld.outputBlobs.size(); i++)
+        {
+            getBlobRange(ld.outputBlobs[i], writes[ld.id]);
+            outputShapes.push_back(shape(ld.outputBlobs[i]));
+        }
+        for (size_t i = 0; i < ld.internals.size(); i++)
+            getBlobRange(ld.internals[i], writes[ld.id]);
+
+        std::set<int> deps;
+        for (size_t i = 0; i < ld.inputBlobsId.size(); i++)
+            deps.insert(ld.inputBlobsId[i].lid);
+        interOpGraph[ld.id].deps.assign(deps.begin(), deps.end());
+
+        if (ld.id != 0 && !ld.skip && !inputShapes.empty() && ld.layerInstance)
+            interOpGraph[ld.id].exclusive = (size_t)ld.layerInstance->getFLOPS(inputShapes, outputShapes) >= heavyFlops;
+    }
+
+    // Blobs memory is reused by layers computed later: add dependencies of writers
+    // on all the previous users of the same memory (and of readers on previous writers).
+    for (int j = 0; j < numLayers; j++)
+    {
+        if (!present[j])
+            continue;
+        std::vector<int>& deps = interOpGraph[j].deps;
+        for (int i = 0; i < j; i++)
+        {
+            if (!present[i] || std::find(deps.begin(), deps.end(), i) != deps.end())
+                continue;
+            if (rangesIntersect(writes[j], reads[i]) || rangesIntersect(writes[j], writes[i]) ||
+                rangesIntersect(reads[j], writes[i]))
+            {
+                deps.push_back(i);
+            }
+        }
+    }
+    for (int j = 0; j < numLayers; j++)
+    {
+        const std::vector<int>& deps = interOpGraph[j].deps;
+        for (size_t k = 0; k < deps.size(); k++)
+            interOpGraph[deps[k]].consumers.push_back(j);
+    }
+}
+
+int Net::Impl::getInterOpWidth() const
+{
+    // Maximal number of light layers which can run concurrently (estimation by levels of the DAG)
+    std::vector<int> level(interOpGraph.size(), 0);
+    std::map<int, int> levelWidth;
+    int width = 1;
+    for (size_t j = 0; j < interOpGraph.size(); j++)
+    {
+        const InterOpNode& node = interOpGraph[j];
+        for (size_t k = 0; k < node.deps.size(); k++)
+            level[j] = std::max(level[j], level[node.deps[k]] + 1);
+        if (!node.exclusive)
+            width = std::max(width, ++levelWidth[level[j]]);
+    }
+    return width;
+}
+
+void Net::Impl::setNumInterOpThreads(int nthreads)
+{
+    CV_CheckGE(nthreads, -1, "");
+    numInterOpThreads = nthreads;
+    interOpScheduler.release();
+}
+
+bool Net::Impl::forwardInterOp(LayerData& ld)
+{
+    if (numInterOpThreads == 0 || numInterOpThreads == 1 || isAsync ||
+        preferableBackend != DNN_BACKEND_OPENCV || !IS_DNN_CPU_TARGET(preferableTarget))
+    {
+        return false;
+    }
+
+    if (interOpGraph.empty())
+        buildInterOpGraph();
+
+    int nthreads = numInterOpThreads;
+    if (nthreads < 0)
+        nthreads = std::min(getInterOpWidth(), std::max(getNumThreads(), 1));
+    if (nthreads <= 1)
+        return false;
+    if (!interOpScheduler || interOpScheduler->numThreads != nthreads)
+        interOpScheduler = makePtr<InterOpScheduler>(nthreads);
+
+    std::vector<int> layerIds;
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end() && it->second.id <= ld.id; ++it)
+    {
+        if (!it->second.flag)
+            layerIds.push_back(it->second.id);
+    }
+    interOpScheduler->run(*this, layerIds);
+    return true;
+}
+
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
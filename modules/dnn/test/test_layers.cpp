@@ -725,6 +725,73 @@ TEST(Layer_LSTM_Test_Accuracy_, Reverse)
 }
 
 
+TEST(Layer_LSTM_Test_Accuracy_, Streaming)
+{
+    const int numInp = 3, numHidden = 4, numSamples = 2, numTimeStamps = 6;
+
+    // LSTM -> GRU
+    Net net;
+    LayerParams lstm;
+    lstm.type = "LSTM";
+    lstm.blobs.push_back(Mat(4 * numHidden, numHidden, CV_32F));  // Wh
+    lstm.blobs.push_back(Mat(4 * numHidden, numInp, CV_32F));  // Wx
+    lstm.blobs.push_back(Mat(1, 4 * numHidden, CV_32F));  // bias
+    lstm.blobs.push_back(Mat(numSamples, numHidden, CV_32F));  // h0
+    lstm.blobs.push_back(Mat(numSamples, numHidden, CV_32F));  // c0
+    for (size_t i = 0; i < lstm.blobs.size(); i++)
+        randu(lstm.blobs[i], -0.5f, 0.5f);
+    net.addLayerToPrev("lstm", lstm.type, lstm);
+
+    LayerParams gru;
+    gru.type = "GRU";
+    gru.blobs.push_back(Mat(3 * numHidden, numHidden, CV_32F));  // Wh
+    gru.blobs.push_back(Mat(3 * numHidden, numHidden, CV_32F));  // Wx
+    gru.blobs.push_back(Mat(1, 6 * numHidden, CV_32F));  // bias
+    gru.blobs.push_back(Mat(numSamples, numHidden, CV_32F));  // h0
+    for (size_t i = 0; i < gru.blobs.size(); i++)
+        randu(gru.blobs[i], -0.5f, 0.5f);
+    net.addLayerToPrev("gru", gru.type, gru);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    Mat input({numTimeStamps, numSamples, numInp}, CV_32F);
+    randu(input, -1.0f, 1.0f);
+    net.setInput(input);
+    Mat ref = net.forward().clone();
+    ASSERT_EQ(shape(numTimeStamps, numSamples, numHidden), shape(ref));
+
+    net.enableStreaming(true);
+    std::vector<Mat> snapshot;
+    for (int t = 0; t < numTimeStamps; t++)
+    {
+        if (t == 3)
+            net.getStates(snapshot);
+        net.setInput(input.row(t));
+        Mat out = net.forward();
+        normAssert(ref.row(t), out, cv::format("t=%d", t).c_str());
+    }
+
+    // restore states of the 3rd timestamp
+    ASSERT_EQ(3u, snapshot.size());
+    EXPECT_EQ(shape(numSamples, numHidden), shape(snapshot[0]));
+    net.setStates(snapshot);
+    net.setInput(input.row(3));
+    normAssert(ref.row(3), net.forward(), "restored");
+
+    // streaming by chunks of several timestamps
+    net.resetStates();
+    net.setInput(input.rowRange(0, 2));
+    normAssert(ref.rowRange(0, 2), net.forward(), "chunk 0");
+    net.setInput(input.rowRange(2, numTimeStamps));
+    normAssert(ref.rowRange(2, numTimeStamps), net.forward(), "chunk 1");
+
+    // states are not kept out of streaming mode
+    net.enableStreaming(false);
+    net.setInput(input.row(0));
+    normAssert(ref.row(0), net.forward(), "non-streaming");
+    net.setInput(input.row(0));
+    normAssert(ref.row(0), net.forward(), "non-streaming 2");
+}
+
 class Layer_RNN_Test : public ::testing::Test
 {
 public:
@@ -2788,4 +2855,177 @@ INSTANTIATE_TEST_CASE_P(TestLayerFusion, ConvolutionActivationEltwiseFusion, Com
                         TestLayerFusion::dnnBackendsAndTargetsForFusionTests()
 ));
 
+typedef TestWithParam<tuple<std::string, std::string, tuple<Backend, Target> > > GemmEltwiseActivationFusion;
+TEST_P(GemmEltwiseActivationFusion, Accuracy)
+{
+    //                 input
+    //                   |
+    //    -------------------------------
+    //    |                             |
+    //    |                     ----------------
+    //    |                     | gemm / matmul |
+    //    |                     ----------------
+    //    |                             |
+    //  ------------------        ----------------
+    //  | gemm / matmul  |        | gemm / matmul |
+    //  ------------------        ----------------
+    //    |                             |
+    //    |       ----------------      |
+    //    --------| eltwise sum  |-------
+    //            ----------------
+    //                   |
+    //           ----------------
+    //           |  activation  |
+    //           ----------------
+    //                   |
+
+    const int rows = 24, cols = 32;
+    Mat input(rows, cols, CV_32F);
+    randu(input, -1.0f, 1.0f);
+
+    std::string gemmType = get<0>(GetParam());
+    std::string actType = get<1>(GetParam());
+    Backend backendId = get<0>(get<2>(GetParam()));
+    Target targetId = get<1>(get<2>(GetParam()));
+
+    std::vector<LayerParams> gemmParams(3);
+    for (size_t i = 0; i < gemmParams.size(); i++)
+    {
+        LayerParams& lp = gemmParams[i];
+        lp.type = gemmType;
+        lp.name = format("gemm%d", (int)i);
+        Mat weights(cols, cols, CV_32F), bias(1, cols, CV_32F);
+        randu(weights, -0.2f, 0.2f);
+        randu(bias, -1.0f, 1.0f);
+        lp.blobs.push_back(weights);
+        lp.blobs.push_back(bias);
+        lp.set("real_ndims_C", 1);
+        if (gemmType == "Gemm")
+        {
+            lp.set("constB", true);
+            lp.set("constC", true);
+            lp.set("have_bias", true);
+        }
+    }
+
+    LayerParams activationParams;
+    TestLayerFusion::makeDefaultTestActivationLayer(activationParams, actType, cols);
+
+    // residual Add of ONNX models
+    LayerParams eltwiseParams;
+    eltwiseParams.type = "NaryEltwise";
+    eltwiseParams.name = "add";
+    eltwiseParams.set("operation", "add");
+
+    Net net;
+    int gemmIds[3];
+    for (int i = 0; i < 3; i++)
+        gemmIds[i] = net.addLayer(gemmParams[i].name, gemmParams[i].type, gemmParams[i]);
+    int eltwiseId = net.addLayer(eltwiseParams.name, eltwiseParams.type, eltwiseParams);
+    int activId = net.addLayer(activationParams.name, activationParams.type, activationParams);
+    net.connect(0, 0, gemmIds[0], 0);
+    net.connect(0, 0, gemmIds[1], 0);
+    net.connect(gemmIds[1], 0, gemmIds[2], 0);
+    net.connect(gemmIds[0], 0, eltwiseId, 0);
+    net.connect(gemmIds[2], 0, eltwiseId, 1);
+    net.connect(eltwiseId, 0, activId, 0);
+
+    std::vector<int> expectedFusedLayers;
+    if (backendId == DNN_BACKEND_OPENCV && (targetId == DNN_TARGET_CPU || targetId == DNN_TARGET_CPU_FP16))
+    {
+        expectedFusedLayers.push_back(eltwiseId);  // residual accumulated by the last gemm
+        expectedFusedLayers.push_back(activId);  // activation applied by the last gemm
+    }
+    TestLayerFusion::test(input, net, backendId, targetId, expectedFusedLayers);
+}
+INSTANTIATE_TEST_CASE_P(TestLayerFusion, GemmEltwiseActivationFusion, Combine(
+/* layer */             Values("Gemm", "MatMul"),
+/* activation */        Values("ReLU", "TanH", "Sigmoid", "Gelu", "Power"),
+                        dnnBackendsAndTargets(false, false, true, false, false, false)  // OCV OpenCL + OCV CPU
+));
+
+typedef TestWithParam<tuple<Backend, Target> > TransformerMLPResidualFusion;
+TEST_P(TransformerMLPResidualFusion, Accuracy)
+{
+    // Pre-LN transformer MLP block, the residual is also consumed by LayerNorm
+    //
+    //  input -> matmul (embedding) -> x -> layer norm -> matmul -> gelu -> matmul
+    //                                 |                                      |
+    //                                 --------------- add --------------------
+    //                                                  |
+    //                                              layer norm
+
+    const int rows = 16, cols = 32, hidden = 64;
+    Mat input(rows, cols, CV_32F);
+    randu(input, -1.0f, 1.0f);
+
+    Backend backendId = get<0>(GetParam());
+    Target targetId = get<1>(GetParam());
+
+    const int matmulShapes[3][2] = {{cols, cols}, {cols, hidden}, {hidden, cols}};
+    std::vector<LayerParams> matmulParams(3);
+    for (size_t i = 0; i < matmulParams.size(); i++)
+    {
+        LayerParams& lp = matmulParams[i];
+        lp.type = "MatMul";
+        lp.name = format("matmul%d", (int)i);
+        Mat weights(matmulShapes[i][0], matmulShapes[i][1], CV_32F), bias(1, matmulShapes[i][1], CV_32F);
+        randu(weights, -0.2f, 0.2f);
+        randu(bias, -1.0f, 1.0f);
+        lp.blobs.push_back(weights);
+        lp.blobs.push_back(bias);
+        lp.set("real_ndims_C", 1);
+    }
+
+    std::vector<LayerParams> normParams(2);
+    for (size_t i = 0; i < normParams.size(); i++)
+    {
+        LayerParams& lp = normParams[i];
+        lp.type = "LayerNormalization";
+        lp.name = format("norm%d", (int)i);
+        lp.set("axis", 1);
+        Mat scale(cols, 1, CV_32F), bias(cols, 1, CV_32F);
+        randu(scale, 0.5f, 1.5f);
+        randu(bias, -0.5f, 0.5f);
+        lp.blobs.push_back(scale);
+        lp.blobs.push_back(bias);
+    }
+
+    LayerParams geluParams;
+    geluParams.type = "Gelu";
+    geluParams.name = "gelu";
+
+    LayerParams addParams;
+    addParams.type = "NaryEltwise";
+    addParams.name = "add";
+    addParams.set("operation", "add");
+
+    Net net;
+    int embedId = net.addLayerToPrev(matmulParams[0].name, matmulParams[0].type, matmulParams[0]);
+    int norm0Id = net.addLayer(normParams[0].name, normParams[0].type, normParams[0]);
+    int fc1Id = net.addLayer(matmulParams[1].name, matmulParams[1].type, matmulParams[1]);
+    int geluId = net.addLayer(geluParams.name, geluParams.type, geluParams);
+    int fc2Id = net.addLayer(matmulParams[2].name, matmulParams[2].type, matmulParams[2]);
+    int addId = net.addLayer(addParams.name, addParams.type, addParams);
+    int norm1Id = net.addLayer(normParams[1].name, normParams[1].type, normParams[1]);
+    net.connect(embedId, 0, norm0Id, 0);
+    net.connect(norm0Id, 0, fc1Id, 0);
+    net.connect(fc1Id, 0, geluId, 0);
+    net.connect(geluId, 0, fc2Id, 0);
+    net.connect(embedId, 0, addId, 0);
+    net.connect(fc2Id, 0, addId, 1);
+    net.connect(addId, 0, norm1Id, 0);
+
+    std::vector<int> expectedFusedLayers;
+    if (backendId == DNN_BACKEND_OPENCV && (targetId == DNN_TARGET_CPU || targetId == DNN_TARGET_CPU_FP16))
+    {
+        expectedFusedLayers.push_back(geluId);  // activation applied by the first MLP matmul
+        expectedFusedLayers.push_back(addId);  // residual accumulated by the second MLP matmul
+    }
+    TestLayerFusion::test(input, net, backendId, targetId, expectedFusedLayers);
+}
+INSTANTIATE_TEST_CASE_P(TestLayerFusion, TransformerMLPResidualFusion,
+                        dnnBackendsAndTargets(false, false, true, false, false, false)  // OCV OpenCL + OCV CPU
+);
+
 }} // namespace
@@ -9,7 +9,12 @@
 #include "npy_blob.hpp"
 #include <opencv2/core/ocl.hpp>
 #include <opencv2/core/opencl/ocl_defs.hpp>
+#include <opencv2/core/utils/filesystem.hpp>
 #include <opencv2/dnn/layer.details.hpp>  // CV_DNN_REGISTER_LAYER_CLASS
+#include <opencv2/dnn/shape_utils.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 namespace opencv_test { namespace {
 
@@ -242,6 +247,103 @@ TEST(blobFromImagesWithParams_4ch, multi_image)
     EXPECT_EQ(0, cvtest::norm(2 * blob0, blob1, NORM_INF));
 }
 
+// resize -> cvtColor -> convertTo -> subtract -> multiply -> HWC to CHW
+static Mat blobFromImageReference(const Mat& img, const Image2BlobParams& param)
+{
+    const Size size = param.size, imgSize = img.size();
+    Mat image;
+    if (size == imgSize)
+        image = img.clone();
+    else if (param.paddingmode == DNN_PMODE_CROP_CENTER)
+    {
+        float f = std::max(size.width / (float)imgSize.width, size.height / (float)imgSize.height);
+        resize(img, image, Size(), f, f, INTER_LINEAR);
+        image = image(Rect((image.cols - size.width) / 2, (image.rows - size.height) / 2, size.width, size.height)).clone();
+    }
+    else if (param.paddingmode == DNN_PMODE_LETTERBOX)
+    {
+        float f = std::min(size.width / (float)imgSize.width, size.height / (float)imgSize.height);
+        int rw = int(imgSize.width * f), rh = int(imgSize.height * f);
+        resize(img, image, Size(rw, rh), 0, 0, INTER_LINEAR);
+        int top = (size.height - rh) / 2, left = (size.width - rw) / 2;
+        cv::copyMakeBorder(image, image, top, size.height - top - rh, left, size.width - left - rw,
+                       BORDER_CONSTANT, param.borderValue);
+    }
+    else
+        resize(img, image, size, 0, 0, INTER_LINEAR);
+
+    const int cn = image.channels();
+    if (param.swapRB && cn >= 3)
+        cvtColor(image, image, cn == 3 ? COLOR_BGR2RGB : COLOR_BGRA2RGBA);
+    image.convertTo(image, CV_32F);
+    subtract(image, param.mean, image);
+    cv::multiply(image, param.scalefactor, image);
+
+    Mat blob;
+    if (param.datalayout == DNN_LAYOUT_NHWC)
+    {
+        int sz[] = { 1, image.rows, image.cols, cn };
+        blob = Mat(4, sz, CV_32F, image.data).clone();
+    }
+    else
+    {
+        int sz[] = { 1, cn, image.rows, image.cols };
+        blob.create(4, sz, CV_32F);
+        std::vector<Mat> planes;
+        for (int c = 0; c < cn; c++)
+            planes.push_back(Mat(image.rows, image.cols, CV_32F, blob.ptr(0, c)));
+        split(image, planes);
+    }
+    return blob;
+}
+
+typedef testing::TestWithParam<tuple<MatDepth, int, DataLayout, ImagePaddingMode, MatDepth, bool> > blobFromImagesWithParams_fused;
+TEST_P(blobFromImagesWithParams_fused, accuracy)
+{
+    const int depth = get<0>(GetParam());
+    const int cn = get<1>(GetParam());
+    const DataLayout layout = get<2>(GetParam());
+    const ImagePaddingMode mode = get<3>(GetParam());
+    const int ddepth = get<4>(GetParam());
+    const bool fusedResize = get<5>(GetParam());
+
+    Image2BlobParams param(Scalar(0.5, 0.25, 2, 1), Size(40, 30), Scalar(10, 20, 30, 40), true, ddepth, layout, mode,
+                           Scalar(1, 2, 3, 4));
+    param.fusedResize = fusedResize;
+
+    std::vector<Mat> images(2);
+    images[0].create(37, 53, CV_MAKETYPE(depth, cn));
+    randu(images[0], 0, 255);
+    images[1].create(param.size, CV_MAKETYPE(depth, cn));  // no resize
+    randu(images[1], 0, 255);
+
+    Mat blob = blobFromImagesWithParams(images, param);
+    ASSERT_EQ(ddepth, blob.depth());
+    ASSERT_EQ(2, blob.size[0]);
+
+    // the fused resize doesn't round interpolated pixels to 8 bits, the maximal scale is 2
+    double eps = fusedResize && depth == CV_8U ? 2.0 : 1e-3;
+    if (ddepth == CV_16F)
+        eps += 0.25;  // fp16 precision of values up to 512
+    for (int i = 0; i < 2; i++)
+    {
+        Mat ref = blobFromImageReference(images[i], param);
+        Mat res;
+        blob(Range(i, i + 1), Range::all()).convertTo(res, CV_32F);
+        ASSERT_EQ(ref.size, res.size) << i;
+        EXPECT_LE(cvtest::norm(ref, res, NORM_INF), eps) << i;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, blobFromImagesWithParams_fused, Combine(
+    Values(CV_8U, CV_32F),
+    Values(1, 3, 4),
+    Values(DNN_LAYOUT_NCHW, DNN_LAYOUT_NHWC),
+    Values(DNN_PMODE_NULL, DNN_PMODE_CROP_CENTER, DNN_PMODE_LETTERBOX),
+    Values(CV_32F, CV_16F),
+    testing::Bool()
+));
+
 TEST(readNet, Regression)
 {
     Net net = readNet(findDataFile("dnn/squeezenet_v1.1.prototxt"),
@@ -615,6 +717,762 @@ TEST(Net, forwardAndRetrieve)
     normAssert(outBlobs[0][1], inp.rowRange(2, 4), "second part");
 }
 
+static Net createMemoryPlannerTestNet()
+{
+    // conv -> relu -> conv -> conv -> eltwise(sum with the first relu)
+    //                      \-> conv -> concat(both branches)
+    Net net;
+    LayerParams lp;
+    lp.type = "Convolution";
+    lp.set("kernel_size", 3);
+    lp.set("pad", 1);
+    lp.set("num_output", 4);
+    lp.set("bias_term", false);
+    Mat weights({4, 4, 3, 3}, CV_32F);
+    randu(weights, -0.5f, 0.5f);
+    lp.blobs.push_back(weights);
+
+    lp.name = "conv1";
+    int conv1 = net.addLayerToPrev(lp.name, lp.type, lp);
+    LayerParams reluParams;
+    int relu1 = net.addLayerToPrev("relu1", "ReLU", reluParams);
+    lp.name = "conv2";
+    int conv2 = net.addLayerToPrev(lp.name, lp.type, lp);
+    lp.name = "conv3";
+    int conv3 = net.addLayerToPrev(lp.name, lp.type, lp);
+    lp.name = "conv4";
+    int conv4 = net.addLayer(lp.name, lp.type, lp);
+    net.connect(conv2, 0, conv4, 0);
+
+    LayerParams eltwiseParams;
+    int sum = net.addLayer("sum", "Eltwise", eltwiseParams);
+    net.connect(conv3, 0, sum, 0);
+    net.connect(relu1, 0, sum, 1);
+
+    LayerParams concatParams;
+    concatParams.set("axis", 1);
+    int concat = net.addLayer("concat", "Concat", concatParams);
+    net.connect(sum, 0, concat, 0);
+    net.connect(conv4, 0, concat, 1);
+    CV_UNUSED(conv1);
+    return net;
+}
+
+TEST(Net, memory_planner)
+{
+    Mat input({1, 4, 16, 16}, CV_32F);
+    randu(input, -1.0f, 1.0f);
+
+    Net net = createMemoryPlannerTestNet();
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+    net.enableMemoryPlanner(false);
+    net.setInput(input);
+    Mat ref = net.forward().clone();
+
+    size_t plannedBytes = 0, naiveBytes = 0;
+    net.getMemoryPlanStatistics(plannedBytes, naiveBytes);
+    EXPECT_EQ(0u, plannedBytes);
+
+    net.enableMemoryPlanner(true);
+    net.setInput(input);
+    Mat out = net.forward().clone();
+    normAssert(ref, out, "", 0.0, 0.0);
+
+    net.getMemoryPlanStatistics(plannedBytes, naiveBytes);
+    EXPECT_GT(plannedBytes, 0u);
+    EXPECT_LT(plannedBytes, naiveBytes);
+
+    // reallocation for another input shape
+    Mat input2({2, 4, 8, 8}, CV_32F);
+    randu(input2, -1.0f, 1.0f);
+    net.enableMemoryPlanner(false);
+    net.setInput(input2);
+    ref = net.forward().clone();
+    net.enableMemoryPlanner(true);
+    net.setInput(input2);
+    out = net.forward();
+    normAssert(ref, out, "", 0.0, 0.0);
+}
+
+TEST(Net, execution_context)
+{
+    const int numContexts = 4;
+    std::vector<Mat> inputs(numContexts), refs(numContexts);
+    Net net = createMemoryPlannerTestNet();
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    for (int i = 0; i < numContexts; i++)
+    {
+        inputs[i].create({1, 4, 16, 16}, CV_32F);
+        randu(inputs[i], -1.0f, 1.0f);
+        net.setInput(inputs[i]);
+        refs[i] = net.forward().clone();
+    }
+
+    std::vector<Net> contexts;
+    for (int i = 0; i < numContexts; i++)
+        contexts.push_back(net.createExecutionContext());
+
+    std::vector<Mat> outs(numContexts);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numContexts; i++)
+    {
+        threads.push_back(std::thread([&, i]() {
+            for (int iter = 0; iter < 10; iter++)
+            {
+                contexts[i].setInput(inputs[i]);
+                outs[i] = contexts[i].forward();
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+
+    for (int i = 0; i < numContexts; i++)
+        normAssert(refs[i], outs[i], cv::format("context %d", i).c_str(), 0.0, 0.0);
+
+    // Shapes are fixed for the context
+    Mat otherInput({1, 4, 8, 8}, CV_32F, Scalar(0));
+    contexts[0].setInput(otherInput);
+    EXPECT_ANY_THROW(contexts[0].forward());
+}
+
+TEST(Net, execution_context_without_warmup)
+{
+    // conv -> relu -> flatten -> gemm: packing of weights is lazy in a single network
+    Mat convWeights({8, 4, 3, 3}, CV_32F), gemmWeights(8 * 16 * 16, 10, CV_32F), gemmBias(1, 10, CV_32F);
+    randu(convWeights, -0.5f, 0.5f);
+    randu(gemmWeights, -0.1f, 0.1f);
+    randu(gemmBias, -1.0f, 1.0f);
+    std::vector<LayerParams> params(4);
+    params[0].type = "Convolution";
+    params[0].set("kernel_size", 3);
+    params[0].set("pad", 1);
+    params[0].set("num_output", 8);
+    params[0].set("bias_term", false);
+    params[0].blobs.push_back(convWeights);
+    params[1].type = "ReLU";
+    params[2].type = "Flatten";
+    params[3].type = "Gemm";
+    params[3].set("constB", true);
+    params[3].set("constC", true);
+    params[3].set("have_bias", true);
+    params[3].set("real_ndims_C", 2);
+    params[3].blobs.push_back(gemmWeights);
+    params[3].blobs.push_back(gemmBias);
+
+    const int numContexts = 4;
+    std::vector<Mat> inputs(numContexts), refs(numContexts);
+    std::vector<Net> nets(2);
+    for (size_t n = 0; n < nets.size(); n++)
+    {
+        for (size_t i = 0; i < params.size(); i++)
+        {
+            params[i].name = format("layer%d", (int)i);
+            nets[n].addLayerToPrev(params[i].name, params[i].type, params[i]);
+        }
+        nets[n].setPreferableBackend(DNN_BACKEND_OPENCV);
+    }
+    Net& refNet = nets[0];
+    Net& net = nets[1];
+    for (int i = 0; i < numContexts; i++)
+    {
+        inputs[i].create({1, 4, 16, 16}, CV_32F);
+        randu(inputs[i], -1.0f, 1.0f);
+        refNet.setInput(inputs[i]);
+        refs[i] = refNet.forward().clone();
+    }
+
+    // No forward() call of the base network: contexts are created from the input shapes
+    net.setInput(inputs[0]);
+    std::vector<Net> contexts;
+    for (int i = 0; i < numContexts; i++)
+        contexts.push_back(net.createExecutionContext());
+
+    std::vector<Mat> outs(numContexts);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numContexts; i++)
+    {
+        threads.push_back(std::thread([&, i]() {
+            for (int iter = 0; iter < 5; iter++)
+            {
+                contexts[i].setInput(inputs[i]);
+                outs[i] = contexts[i].forward().clone();
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+
+    for (int i = 0; i < numContexts; i++)
+        normAssert(refs[i], outs[i], cv::format("context %d", i).c_str(), 0.0, 0.0);
+}
+
+TEST(BatchingExecutor, multiple_threads)
+{
+    const int numRequests = 10;
+    std::vector<Mat> inputs(numRequests), refs(numRequests);
+    Net net = createMemoryPlannerTestNet();
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    for (int i = 0; i < numRequests; i++)
+    {
+        inputs[i].create({1, 4, 8, 8}, CV_32F);
+        randu(inputs[i], -1.0f, 1.0f);
+        net.setInput(inputs[i]);
+        refs[i] = net.forward().clone();
+    }
+
+    BatchingExecutor::Params params;
+    params.maxBatchSize = 4;
+    params.maxDelayUs = 100000;
+    BatchingExecutor executor(net, params);
+
+    std::vector<Mat> outs(numRequests);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numRequests; i++)
+    {
+        threads.push_back(std::thread([&, i]() {
+            AsyncArray result = executor.submit(inputs[i]);
+            result.get(outs[i]);
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+
+    for (int i = 0; i < numRequests; i++)
+        normAssert(refs[i], outs[i], cv::format("request %d", i).c_str(), 1e-5, 1e-4);
+
+    BatchingExecutor::Statistics stats = executor.getStatistics();
+    EXPECT_EQ(numRequests, stats.numRequests);
+    ASSERT_EQ((size_t)params.maxBatchSize, stats.batchFill.size());
+    int64 requestsInBatches = 0, batches = 0;
+    for (size_t i = 0; i < stats.batchFill.size(); i++)
+    {
+        requestsInBatches += (i + 1) * stats.batchFill[i];
+        batches += stats.batchFill[i];
+    }
+    EXPECT_EQ(numRequests, requestsInBatches);
+    EXPECT_EQ(stats.numBatches, batches);
+    EXPECT_LT(stats.numBatches, numRequests);
+    int64 latencies = 0;
+    for (size_t i = 0; i < stats.queueLatency.size(); i++)
+        latencies += stats.queueLatency[i];
+    EXPECT_EQ(numRequests, latencies);
+}
+
+TEST(BatchingExecutor, partial_batch)
+{
+    Net net = createMemoryPlannerTestNet();
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    Mat input({1, 4, 8, 8}, CV_32F);
+    randu(input, -1.0f, 1.0f);
+    net.setInput(input);
+    Mat ref = net.forward().clone();
+
+    BatchingExecutor::Params params;
+    params.maxBatchSize = 8;
+    params.maxDelayUs = 0;
+    BatchingExecutor executor(net, params);
+    Mat out;
+    executor.submit(input).get(out);
+    normAssert(ref, out, "", 1e-5, 1e-4);
+
+    // a lone request is computed without padding to the maximal batch size
+    std::vector<LayerProfile> profile;
+    net.getLayersProfile(profile);
+    ASSERT_FALSE(profile.empty());
+    EXPECT_EQ("conv1", profile[0].name);
+    EXPECT_EQ((int64)(input.total() * input.elemSize()), profile[0].bytesWritten);
+}
+
+TEST(Net, weights_type)
+{
+    Net net;
+    LayerParams lp;
+    lp.type = "Convolution";
+    lp.name = "conv";
+    lp.set("kernel_size", 3);
+    lp.set("pad", 1);
+    lp.set("num_output", 30);  // not multiple of packing width
+    lp.set("bias_term", true);
+    Mat weights({30, 16, 3, 3}, CV_32F), bias(1, 30, CV_32F);
+    randu(weights, -0.1f, 0.1f);
+    randu(bias, -1.0f, 1.0f);
+    lp.blobs.push_back(weights);
+    lp.blobs.push_back(bias);
+    net.addLayerToPrev(lp.name, lp.type, lp);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+    net.enableWinograd(false);
+
+    Mat input({1, 16, 20, 23}, CV_32F);
+    randu(input, -1.0f, 1.0f);
+    net.setInput(input);
+    Mat ref = net.forward().clone();
+
+    // reduced precision weights are used by AVX2 kernels only
+    const bool hasWeights16 = checkHardwareSupport(CV_CPU_AVX2);
+    std::vector<LayerProfile> profile;
+    net.getLayersProfile(profile);
+    ASSERT_EQ(1u, profile.size());
+    EXPECT_EQ("im2col_generic", profile[0].kernel);
+
+    net.setPreferableWeightsType(DNN_WEIGHTS_FP16);
+    net.setInput(input);
+    Mat outFP16 = net.forward().clone();
+    normAssert(ref, outFP16, "FP16", 1e-3, 4e-3);
+    net.getLayersProfile(profile);
+    EXPECT_EQ(hasWeights16 ? "im2col_generic_w_fp16" : "im2col_generic", profile[0].kernel);
+
+    net.setPreferableWeightsType(DNN_WEIGHTS_BF16);
+    net.setInput(input);
+    Mat outBF16 = net.forward().clone();
+    normAssert(ref, outBF16, "BF16", 6e-3, 3e-2);
+    net.getLayersProfile(profile);
+    EXPECT_EQ(hasWeights16 ? "im2col_generic_w_bf16" : "im2col_generic", profile[0].kernel);
+
+    net.setPreferableWeightsType(DNN_WEIGHTS_FP32);
+    net.setInput(input);
+    normAssert(ref, net.forward(), "FP32", 0, 0);
+    net.getLayersProfile(profile);
+    EXPECT_EQ("im2col_generic", profile[0].kernel);
+}
+
+static Net createPackedWeightsCacheTestNet()
+{
+    // conv 3x3 (Winograd) -> conv 5x5 (generic) -> matmul with constant B
+    Net net;
+    LayerParams lp;
+    lp.type = "Convolution";
+    lp.set("pad", 1);
+    lp.set("kernel_size", 3);
+    lp.set("num_output", 8);
+    lp.set("bias_term", false);
+    Mat weights({8, 4, 3, 3}, CV_32F);
+    randu(weights, -0.5f, 0.5f);
+    lp.blobs.push_back(weights);
+    net.addLayerToPrev("conv3x3", lp.type, lp);
+
+    lp.set("pad", 2);
+    lp.set("kernel_size", 5);
+    lp.blobs[0] = Mat({8, 8, 5, 5}, CV_32F);
+    randu(lp.blobs[0], -0.1f, 0.1f);
+    net.addLayerToPrev("conv5x5", lp.type, lp);
+
+    LayerParams mm;
+    mm.type = "MatMul";
+    mm.blobs.push_back(Mat(16, 10, CV_32F));
+    randu(mm.blobs[0], -0.5f, 0.5f);
+    net.addLayerToPrev("matmul", mm.type, mm);
+
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+    return net;
+}
+
+static std::vector<char> readFileData(const std::string& path)
+{
+    std::ifstream f(path.c_str(), std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+// Rewrites all buffers of the packed weights cache entry: header is magic[8], version, key[32], count,
+// followed by (uint64 size, data) pairs
+static void corruptPackedWeightsCacheEntry(const std::string& path, bool hugeSize)
+{
+    std::vector<char> data = readFileData(path);
+    const size_t headerSize = 8 + sizeof(uint32_t) + 32 + sizeof(uint32_t);
+    ASSERT_GE(data.size(), headerSize);
+    uint32_t count = 0;
+    memcpy(&count, &data[headerSize - sizeof(count)], sizeof(count));
+
+    std::vector<char> corrupted(data.begin(), data.begin() + headerSize);
+    size_t pos = headerSize;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint64 size = 0;
+        ASSERT_LE(pos + sizeof(size), data.size());
+        memcpy(&size, &data[pos], sizeof(size));
+        pos += sizeof(size);
+        ASSERT_LE(pos + size, data.size());
+        // well-formed entry with truncated buffers or invalid size of the first buffer without data
+        uint64 newSize = size >= 4 ? size - 4 : size;
+        if (hugeSize)
+            newSize = i == 0 ? (uint64)-1 : size;
+        const char* sizePtr = (const char*)&newSize;
+        corrupted.insert(corrupted.end(), sizePtr, sizePtr + sizeof(newSize));
+        if (!hugeSize || i > 0)
+            corrupted.insert(corrupted.end(), data.begin() + pos, data.begin() + pos + newSize);
+        pos += size;
+    }
+    std::ofstream f(path.c_str(), std::ios::binary | std::ios::trunc);
+    f.write(corrupted.data(), corrupted.size());
+}
+
+TEST(Net, packed_weights_cache)
+{
+    const std::string cacheDir = cv::tempfile("dnn_packed_weights");
+    const std::string prevCacheDir = getPackedWeightsCacheDir();
+    setPackedWeightsCacheDir(cacheDir);
+
+    Mat input({1, 4, 16, 16}, CV_32F);
+    randu(input, -1.0f, 1.0f);
+
+    RNG& rng = theRNG();
+    const RNG rngState = rng;
+    Net net = createPackedWeightsCacheTestNet();
+    net.setInput(input);
+    Mat ref = net.forward().clone();
+
+    std::vector<cv::String> entries;
+    utils::fs::glob(cacheDir, "*.bin", entries);
+    EXPECT_EQ(3u, entries.size());
+
+    // the same weights are loaded from the cache
+    rng = rngState;
+    Net net2 = createPackedWeightsCacheTestNet();
+    net2.setInput(input);
+    Mat out = net2.forward();
+
+    entries.clear();
+    utils::fs::glob(cacheDir, "*.bin", entries);
+    EXPECT_EQ(3u, entries.size());
+    normAssert(ref, out, "", 0, 0);
+
+    // corrupted entries are ignored, weights are packed and stored again
+    std::vector<std::vector<char> > entryData(entries.size());
+    for (size_t i = 0; i < entries.size(); i++)
+        entryData[i] = readFileData(entries[i]);
+    for (int hugeSize = 0; hugeSize <= 1; hugeSize++)
+    {
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            corruptPackedWeightsCacheEntry(entries[i], hugeSize != 0);
+            ASSERT_TRUE(entryData[i] != readFileData(entries[i]));
+        }
+        rng = rngState;
+        Net net3 = createPackedWeightsCacheTestNet();
+        net3.setInput(input);
+        out = net3.forward();
+        normAssert(ref, out, hugeSize ? "huge size" : "wrong size", 0, 0);
+        for (size_t i = 0; i < entries.size(); i++)
+            EXPECT_TRUE(entryData[i] == readFileData(entries[i])) << entries[i];
+    }
+
+    setPackedWeightsCacheDir(prevCacheDir);
+    utils::fs::remove_all(cacheDir);
+}
+
+TEST(Net, packed_weights_cache_non_const_weights)
+{
+    const std::string cacheDir = cv::tempfile("dnn_packed_weights");
+    const std::string prevCacheDir = getPackedWeightsCacheDir();
+    setPackedWeightsCacheDir(cacheDir);
+
+    // convolution weights are the second input of the network
+    Net net;
+    LayerParams lp;
+    lp.type = "Convolution";
+    lp.name = "conv";
+    lp.set("pad", 2);
+    lp.set("kernel_size", 5);
+    lp.set("num_output", 8);
+    lp.set("bias_term", false);
+    int id = net.addLayer(lp.name, lp.type, lp);
+    net.connect(0, 0, id, 0);
+    net.connect(0, 1, id, 1);
+    net.setInputsNames({"data", "weights"});
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+
+    Mat input({1, 4, 16, 16}, CV_32F), weights({8, 4, 5, 5}, CV_32F);
+    randu(input, -1.0f, 1.0f);
+    for (int i = 0; i < 2; i++)
+    {
+        randu(weights, -0.5f, 0.5f);
+        net.setInput(input, "data");
+        net.setInput(weights, "weights");
+        net.forward();
+    }
+
+    // weights which may change on each forward() call are not cached
+    std::vector<cv::String> entries;
+    if (utils::fs::isDirectory(cacheDir))
+        utils::fs::glob(cacheDir, "*.bin", entries);
+    EXPECT_EQ(0u, entries.size());
+
+    setPackedWeightsCacheDir(prevCacheDir);
+    utils::fs::remove_all(cacheDir);
+}
+
+TEST(Net, layers_profile)
+{
+    Net net;
+    LayerParams lp;
+    lp.type = "Convolution";
+    lp.set("pad", 1);
+    lp.set("kernel_size", 3);
+    lp.set("num_output", 8);
+    lp.set("bias_term", false);
+    lp.blobs.push_back(Mat({8, 4, 3, 3}, CV_32F));
+    randu(lp.blobs[0], -0.5f, 0.5f);
+    net.addLayerToPrev("conv", lp.type, lp);
+
+    LayerParams relu;
+    relu.type = "ReLU";
+    net.addLayerToPrev("relu", relu.type, relu);
+
+    lp.set("group", 8);
+    lp.blobs[0] = Mat({8, 1, 3, 3}, CV_32F);
+    randu(lp.blobs[0], -0.5f, 0.5f);
+    net.addLayerToPrev("dwconv", lp.type, lp);
+
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+    net.enableWinograd(false);
+
+    Mat input({1, 4, 16, 16}, CV_32F);
+    randu(input, -1.0f, 1.0f);
+    net.setInput(input);
+    net.forward();
+
+    std::vector<LayerProfile> profile;
+    net.getLayersProfile(profile);
+    ASSERT_EQ(3u, profile.size());
+
+    const LayerProfile& conv = profile[0];
+    EXPECT_EQ("conv", conv.name);
+    EXPECT_EQ("Convolution", conv.type);
+    EXPECT_FALSE(conv.fused);
+    EXPECT_EQ("im2col_generic", conv.kernel);
+    EXPECT_EQ(net.getFLOPS(conv.id, shape(input)), conv.flops);
+    EXPECT_EQ((int64)(4 * 16 * 16 + 8 * 4 * 3 * 3) * 4, conv.bytesRead);
+    EXPECT_EQ((int64)(8 * 16 * 16) * 4, conv.bytesWritten);
+    EXPECT_GT(conv.timeMs, 0);
+    EXPECT_GT(conv.gflops, 0);
+    EXPECT_GT(conv.gbps, 0);
+    EXPECT_NEAR((double)conv.flops / (conv.bytesRead + conv.bytesWritten), conv.arithmeticIntensity, 1e-9);
+    EXPECT_EQ(getNumThreads(), conv.threads);
+
+    EXPECT_EQ("relu", profile[1].name);
+    EXPECT_TRUE(profile[1].fused);
+    EXPECT_EQ(0, profile[1].timeMs);
+
+    const LayerProfile& dwconv = profile[2];
+    EXPECT_EQ(0u, dwconv.kernel.find("depthwise")) << dwconv.kernel;
+    EXPECT_GE(dwconv.startMs, conv.startMs + conv.timeMs);
+
+    std::vector<double> timings;
+    net.getPerfProfile(timings);
+    ASSERT_EQ(3u, timings.size());
+    EXPECT_NEAR(timings[0] * 1000.0 / getTickFrequency(), conv.timeMs, 1e-9);
+
+    const std::string json = net.dumpProfile();
+    EXPECT_NE(std::string::npos, json.find("\"name\": \"dwconv\""));
+    EXPECT_NE(std::string::npos, json.find("\"kernel\": \"im2col_generic\""));
+    const std::string trace = net.dumpProfileChromeTrace();
+    EXPECT_NE(std::string::npos, trace.find("\"traceEvents\""));
+    EXPECT_NE(std::string::npos, trace.find("\"ph\": \"X\""));
+    EXPECT_EQ(std::string::npos, trace.find("\"name\": \"relu\""));  // fused layers are not traced
+}
+
+TEST(Net, dynamic_quantization)
+{
+    // Gemm (constant B) -> MatMul (constant transposed B), odd sizes to cover tails of kernels
+    Net net;
+    LayerParams gemm;
+    gemm.type = "Gemm";
+    gemm.set("constB", true);
+    gemm.blobs.push_back(Mat(70, 45, CV_32F));
+    randu(gemm.blobs[0], -1.0f, 1.0f);
+    net.addLayerToPrev("gemm", gemm.type, gemm);
+
+    LayerParams matmul;
+    matmul.type = "MatMul";
+    matmul.set("transB", true);
+    matmul.blobs.push_back(Mat(19, 45, CV_32F));
+    randu(matmul.blobs[0], -1.0f, 1.0f);
+    net.addLayerToPrev("matmul", matmul.type, matmul);
+
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+
+    Mat input(7, 70, CV_32F);
+    randu(input, -1.0f, 1.0f);
+    net.setInput(input);
+    Mat ref = net.forward().clone();
+
+    net.enableDynamicQuantization(true);
+    net.setInput(input);
+    Mat out = net.forward().clone();
+
+    std::vector<LayerProfile> profile;
+    net.getLayersProfile(profile);
+    ASSERT_EQ(2u, profile.size());
+    EXPECT_EQ("fast_gemm_int8", profile[0].kernel);
+    EXPECT_EQ("fast_gemm_int8", profile[1].kernel);
+
+    ASSERT_EQ(shape(ref), shape(out));
+    const double refScale = cvtest::norm(ref, NORM_INF);
+    EXPECT_LE(cvtest::norm(ref, out, NORM_INF), 0.03 * refScale);
+    EXPECT_LE(cvtest::norm(ref, out, NORM_L1) / ref.total(), 0.01 * refScale);
+
+    net.enableDynamicQuantization(false);
+    net.setInput(input);
+    normAssert(ref, net.forward(), "", 0, 0);
+}
+
+TEST(Net, inter_op_scheduler)
+{
+    // input -> 4 branches (Convolution + ReLU, two of them are summed by Eltwise) -> Concat
+    Net net;
+    std::vector<int> branches;
+    for (int i = 0; i < 4; i++)
+    {
+        LayerParams conv;
+        conv.type = "Convolution";
+        conv.set("kernel_size", 3 - 2 * (i % 2));
+        conv.set("pad", 1 - (i % 2));
+        conv.set("num_output", 6);
+        conv.set("bias_term", false);
+        conv.blobs.push_back(Mat({6, 3, 3 - 2 * (i % 2), 3 - 2 * (i % 2)}, CV_32F));
+        randu(conv.blobs[0], -0.5f, 0.5f);
+        const int convId = net.addLayer(format("conv%d", i), conv.type, conv);
+        net.connect(0, 0, convId, 0);
+
+        LayerParams relu;
+        relu.type = "ReLU";
+        const int reluId = net.addLayer(format("relu%d", i), relu.type, relu);
+        net.connect(convId, 0, reluId, 0);
+        branches.push_back(reluId);
+    }
+    LayerParams eltwise;
+    eltwise.type = "Eltwise";
+    const int eltwiseId = net.addLayer("sum", eltwise.type, eltwise);
+    net.connect(branches[2], 0, eltwiseId, 0);
+    net.connect(branches[3], 0, eltwiseId, 1);
+
+    LayerParams concat;
+    concat.type = "Concat";
+    concat.set("axis", 1);
+    const int concatId = net.addLayer("concat", concat.type, concat);
+    net.connect(branches[0], 0, concatId, 0);
+    net.connect(branches[1], 0, concatId, 1);
+    net.connect(eltwiseId, 0, concatId, 2);
+
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+
+    Mat input({2, 3, 20, 20}, CV_32F);
+    randu(input, -1.0f, 1.0f);
+    net.setInput(input);
+    Mat ref = net.forward().clone();
+
+    const int numThreads[] = {4, -1, 2};
+    for (int i = 0; i < 3; i++)
+    {
+        net.setNumInterOpThreads(numThreads[i]);
+        for (int iter = 0; iter < 3; iter++)
+        {
+            net.setInput(input);
+            normAssert(ref, net.forward(), format("threads=%d", numThreads[i]).c_str(), 0, 0);
+        }
+    }
+
+    // intermediate outputs
+    net.setInput(input);
+    std::vector<Mat> outs;
+    net.forward(outs, std::vector<String>(1, "sum"));
+    ASSERT_EQ(1u, outs.size());
+    std::vector<Range> ranges(4, Range::all());
+    ranges[1] = Range(12, 18);
+    normAssert(ref(ranges).clone(), outs[0], "sum", 0, 0);
+
+    net.setNumInterOpThreads(0);
+    net.setInput(input);
+    normAssert(ref, net.forward(), "", 0, 0);
+}
+
+// Copies input to output and waits for the second instance to check that layers run concurrently
+class InterOpRendezvousLayer CV_FINAL : public Layer
+{
+public:
+    InterOpRendezvousLayer(const LayerParams &params) : Layer(params) {}
+
+    static Ptr<Layer> create(LayerParams& params)
+    {
+        return Ptr<Layer>(new InterOpRendezvousLayer(params));
+    }
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays) CV_OVERRIDE
+    {
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+        inputs[0].copyTo(outputs[0]);
+
+        arrived++;
+        const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (arrived < 2 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (arrived >= 2)
+            met++;
+    }
+
+    static std::atomic<int> arrived, met;
+};
+std::atomic<int> InterOpRendezvousLayer::arrived(0);
+std::atomic<int> InterOpRendezvousLayer::met(0);
+
+TEST(Net, inter_op_scheduler_concat_branches)
+{
+    // input -> 2 independent branches -> Concat. With batch 1 the branches write
+    // to slices of the Concat output, which must not serialize them
+    CV_DNN_REGISTER_LAYER_CLASS(InterOpRendezvous, InterOpRendezvousLayer);
+    Net net;
+    LayerParams lp;
+    lp.type = "InterOpRendezvous";
+    const int branch0 = net.addLayer("branch0", lp.type, lp);
+    const int branch1 = net.addLayer("branch1", lp.type, lp);
+    net.connect(0, 0, branch0, 0);
+    net.connect(0, 0, branch1, 0);
+
+    LayerParams concat;
+    concat.type = "Concat";
+    concat.set("axis", 1);
+    const int concatId = net.addLayer("concat", concat.type, concat);
+    net.connect(branch0, 0, concatId, 0);
+    net.connect(branch1, 0, concatId, 1);
+
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+    net.setNumInterOpThreads(2);
+
+    Mat input({1, 3, 8, 8}, CV_32F);
+    randu(input, -1.0f, 1.0f);
+    Mat ref;
+    cv::hconcat(input.reshape(1, 1), input.reshape(1, 1), ref);
+
+    for (int iter = 0; iter < 3; iter++)
+    {
+        InterOpRendezvousLayer::arrived = 0;
+        InterOpRendezvousLayer::met = 0;
+        net.setInput(input);
+        Mat out = net.forward();
+        EXPECT_EQ(2, (int)InterOpRendezvousLayer::met) << "iter=" << iter;
+        normAssert(ref, out.reshape(1, 1), "", 0, 0);
+
+        // concurrent branches are traced on the tracks of different threads
+        std::vector<LayerProfile> profile;
+        net.getLayersProfile(profile);
+        ASSERT_EQ(3u, profile.size());
+        EXPECT_NE(profile[0].worker, profile[1].worker) << "iter=" << iter;
+        const std::string trace = net.dumpProfileChromeTrace();
+        EXPECT_NE(std::string::npos, trace.find("\"tid\": 1")) << "iter=" << iter;
+    }
+    LayerFactory::unregisterLayer("InterOpRendezvous");
+}
+
 #ifdef HAVE_INF_ENGINE
 static const std::chrono::milliseconds async_timeout(10000);
 
@@ -108,10 +108,21 @@ enum ImwriteFlags {
        IMWRITE_TIFF_COMPRESSION    = 259,//!< For TIFF, use to specify the image compression scheme. See cv::ImwriteTiffCompressionFlags. Note, for images whose depth is CV_32F, only libtiff's SGILOG compression scheme is used. For other supported depths, the compression scheme can be specified by this flag; LZW compression is the default.
        IMWRITE_TIFF_ROWSPERSTRIP   = 278,//!< For TIFF, use to specify the number of rows per strip.
        IMWRITE_TIFF_PREDICTOR      = 317,//!< For TIFF, use to specify predictor. See cv::ImwriteTiffPredictorFlags.
+       IMWRITE_TIFF_TILEWIDTH      = 322,//!< For TIFF written by cv::ImageWriter, use to specify the tile width (a multiple of 16). The image is tiled if both tile width and length are set.
+       IMWRITE_TIFF_TILELENGTH     = 323,//!< For TIFF written by cv::ImageWriter, use to specify the tile length (a multiple of 16).
        IMWRITE_JPEG2000_COMPRESSION_X1000 = 272,//!< For JPEG2000, use to specify the target compression rate (multiplied by 1000). The value can be from 0 to 1000. Default is 1000.
        IMWRITE_AVIF_QUALITY        = 512,//!< For AVIF, it can be a quality between 0 and 100 (the higher the better). Default is 95.
        IMWRITE_AVIF_DEPTH          = 513,//!< For AVIF, it can be 8, 10 or 12. If >8, it is stored/read as CV_32F. Default is 8.
-       IMWRITE_AVIF_SPEED          = 514 //!< For AVIF, it is between 0 (slowest) and (fastest). Default is 9.
+       IMWRITE_AVIF_SPEED          = 514,//!< For AVIF, it is between 0 (slowest) and (fastest). Default is 9.
+       IMWRITE_SPEED_PRESET        = 1024 //!< Format-independent trade-off between encoding speed and file size, one of cv::ImwriteSpeedPresetFlags. Supported by JPEG, PNG and TIFF. Format-specific compression parameters take precedence. It also enables parallel chunked compression of large PNG images (see cv::imwrite).
+     };
+
+//! Imwrite values for IMWRITE_SPEED_PRESET parameter key
+enum ImwriteSpeedPresetFlags {
+       IMWRITE_SPEED_PRESET_FASTEST  = 0, //!< PNG: zlib level 1 with RLE strategy and Sub filter (PNG default), TIFF: Deflate level 1, JPEG: fast integer DCT
+       IMWRITE_SPEED_PRESET_FAST     = 1, //!< PNG: zlib level 4 with adaptive filters, TIFF: Deflate level 4
+       IMWRITE_SPEED_PRESET_BALANCED = 2, //!< PNG: zlib level 6 with adaptive filters, TIFF: LZW (TIFF default), JPEG: default
+       IMWRITE_SPEED_PRESET_SMALLEST = 3  //!< PNG: zlib level 9 with adaptive filters, TIFF: Deflate level 9, JPEG: optimized Huffman tables
      };
 
 enum ImwriteJPEGSamplingFactorParams {
@@ -279,6 +290,7 @@ This is an overloaded member function, provided for convenience. It differs from
 @param flags Flag that can take values of cv::ImreadModes
 @note
 The image passing through the img parameter can be pre-allocated. The memory is reused if the shape and the type match with the load image.
+It can be a region of a larger matrix, decoders write the rows with its step and convert colors row by row, so the image is not copied.
  */
 CV_EXPORTS_W void imread( const String& filename, OutputArray dst, int flags = IMREAD_COLOR_BGR );
 
@@ -340,6 +352,11 @@ can be saved using this function, with these exceptions:
 
 If the image format is not supported, the image will be converted to 8-bit unsigned (CV_8U) and saved that way.
 
+Large PNG and TIFF images are compressed by the threads of cv::parallel_for_ (see cv::setNumThreads):
+with IMWRITE_SPEED_PRESET PNG image data of 1Mb or more is deflated by independent chunks of rows (the file
+differs from the one written by libpng and may be slightly larger), TIFF strips are compressed in parallel
+(LZW, Deflate and PackBits compressions).
+
 If the format, depth or channel order is different, use
 Mat::convertTo and cv::cvtColor to convert it before saving. Or, use the universal FileStorage I/O
 functions to save the image to XML or YAML format.
@@ -381,9 +398,79 @@ CV_EXPORTS_W Mat imdecode( InputArray buf, int flags );
 @param dst The optional output placeholder for the decoded matrix. It can save the image
 reallocations when the function is called repeatedly for images of the same size. In case of decoder
 failure the function returns empty cv::Mat object, but does not release user-provided dst buffer.
+If dst has the size and the type of the result, the decoders write into it directly (color conversions are
+done row by row), so dst can be a region of a larger matrix, e.g. a cell of a mosaic or a slot of a batch.
 */
 CV_EXPORTS Mat imdecode( InputArray buf, int flags, Mat* dst);
 
+/** @brief Reads a batch of images from buffers in memory.
+
+The images are decoded in parallel by the threads of cv::parallel_for_. Each thread reuses
+decoder instances for the images of its part of the batch, and the output matrices are reused
+if they have the size and the type of the decoded images, so the same `dst` vector can be passed
+for the consecutive batches without reallocations.
+
+@param bufs Encoded images.
+@param flags The same flags as in cv::imread, see cv::ImreadModes.
+@param dst Decoded images, an image which can't be decoded is empty.
+@return true if all the images are decoded.
+@sa imdecode
+*/
+CV_EXPORTS_W bool imdecodeBatch( const std::vector<Mat>& bufs, int flags, CV_OUT std::vector<Mat>& dst );
+
+/** @overload
+
+Decodes the images into a preallocated 4D tensor, e.g. to use it as an input of cv::dnn::Net.
+
+All the images must have the size and the number of channels of the tensor items.
+Items of NHWC tensor with the depth of the decoded images (CV_8U for 8-bit images) receive
+the pixels directly from the decoders, other tensors are filled with conversion of the depth
+(without scaling) and channels split for NCHW layout. Items of the images which can't be decoded
+or don't match the tensor are filled with zeros.
+
+@param bufs Encoded images.
+@param flags The same flags as in cv::imread, see cv::ImreadModes.
+@param tensor Continuous single-channel 4D matrix: N x H x W x C (NHWC) or N x C x H x W (NCHW) with N equal to the number of buffers.
+@param nchw Layout of the tensor.
+@return true if all the images are decoded.
+*/
+CV_EXPORTS_W bool imdecodeBatch( const std::vector<Mat>& bufs, int flags, CV_IN_OUT Mat& tensor, bool nchw );
+
+/** @brief Loads a region of an image from a file.
+
+The function decodes only the rows and columns needed for the region where the format allows it:
+JPEG (with libjpeg-turbo) skips the rows above the region and crops the decoded scanlines,
+non-interlaced PNG stops decoding after the last row of the region (the rest of image data is still
+inflated if the EXIF orientation is applied and the eXIf chunk is stored after image data),
+tiled and stripped TIFF read only the tiles or strips covering the region (compressed strips are decoded
+from their first row),
+WebP uses the cropping of the decoder. Other formats are decoded completely and cropped.
+
+The region is given in coordinates of the stored image, the EXIF orientation (if any) is applied to
+the decoded region afterwards. For full-resolution decoding the result is the same as
+`imread(filename, flags)(roi)` for images without EXIF orientation or with IMREAD_IGNORE_ORIENTATION.
+With IMREAD_REDUCED_* flags the region is decoded at the reduced scale, JPEG scales it natively
+(DCT scaling), so the decoder doesn't produce the full-resolution pixels at all.
+
+@param filename Name of the file to be loaded.
+@param roi Region in pixel coordinates of the stored full-resolution image (before EXIF orientation),
+it is clipped by the image bounds. With IMREAD_REDUCED_* flags the result has the size of the region
+divided by the scale factor.
+@param flags Flag that can take values of cv::ImreadModes.
+@return the decoded region or empty matrix if the image can't be read or the region is outside of the image.
+@sa imread, imdecodeROI
+*/
+CV_EXPORTS_W Mat imreadROI( const String& filename, const Rect& roi, int flags = IMREAD_COLOR_BGR );
+
+/** @brief Reads a region of an image from a buffer in memory.
+
+See cv::imreadROI for the description of the region decoding.
+@param buf Input array or vector of bytes.
+@param roi Region in pixel coordinates of the stored full-resolution image.
+@param flags The same flags as in cv::imread, see cv::ImreadModes.
+*/
+CV_EXPORTS_W Mat imdecodeROI( InputArray buf, const Rect& roi, int flags = IMREAD_COLOR_BGR );
+
 /** @brief Reads a multi-page image from a buffer in memory.
 
 The function imdecodemulti reads a multi-page image from the specified buffer in the memory. If the buffer is too short or
@@ -505,6 +592,79 @@ protected:
     Ptr<Impl> pImpl;
 };
 
+/** @brief To write large images by parts
+
+The ImageWriter class encodes an image which is passed by horizontal strips of rows or by tiles,
+so the whole image is never held in memory. This allows writing of images that exceed available RAM,
+e.g. results of tile-wise processing of whole-slide or satellite imagery.
+
+Streaming is supported by PNG, JPEG and TIFF encoders. TIFF images are written with strips by default,
+set IMWRITE_TIFF_TILEWIDTH and IMWRITE_TIFF_TILELENGTH parameters to write a tiled TIFF.
+BigTIFF format is used for images with 2Gb or more of pixel data.
+
+@code
+    cv::ImageWriter writer("out.tiff", cv::Size(100000, 80000), CV_8UC3,
+                           {cv::IMWRITE_TIFF_TILEWIDTH, 512, cv::IMWRITE_TIFF_TILELENGTH, 512});
+    for (int y = 0; y < 80000; y += 512)
+        for (int x = 0; x < 100000; x += 512)
+            writer.writeTile(processTile(x, y), cv::Point(x, y));
+    CV_Assert(writer.close());
+@endcode
+*/
+class CV_EXPORTS ImageWriter {
+public:
+    ImageWriter();
+    /** @overload */
+    ImageWriter(const String& filename, Size size, int type, const std::vector<int>& params = std::vector<int>());
+    ~ImageWriter();
+
+    /** @brief Starts writing of the image.
+
+    @param filename Name of the file, the format is chosen by the extension.
+    @param size Size of the whole image.
+    @param type Type of the passed image data, 1, 3 or 4 channels (see cv::imwrite for supported depths).
+    @param params Format-specific parameters, see cv::imwrite and cv::ImwriteFlags.
+    @return false if the format doesn't support streaming or the file can't be written.
+    */
+    bool open(const String& filename, Size size, int type, const std::vector<int>& params = std::vector<int>());
+
+    /** @brief Checks if the image is being written. */
+    bool isOpened() const;
+
+    /** @brief Returns the tile size of the tiled format, or an empty size if the image is written by rows.
+
+    Tiles of this size are passed to the encoder directly and can be written in any order.
+    */
+    Size getTileSize() const;
+
+    /** @brief Writes the next rows of the image.
+
+    @param rows Full-width strip of the image, strips are passed from top to bottom.
+    */
+    bool write(InputArray rows);
+
+    /** @brief Writes a tile of the image.
+
+    For the tiled formats (see getTileSize()) the position must be a multiple of the tile size.
+    Otherwise the tiles are collected into a band of rows which is written when the band is completed,
+    so tiles of a band (with the same `pos.y` and height) must be written before tiles of the next band.
+
+    @param tile Tile of the image.
+    @param pos Position of the tile top-left corner in the image.
+    */
+    bool writeTile(InputArray tile, Point pos);
+
+    /** @brief Finalizes the image and closes the file.
+
+    @return false if the image is incomplete or can't be written, the file is removed in this case.
+    */
+    bool close();
+
+    class Impl;
+protected:
+    Ptr<Impl> pImpl;
+};
+
 //! @} imgcodecs
 
 } // cv
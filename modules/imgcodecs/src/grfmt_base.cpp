@@ -54,6 +54,8 @@ BaseImageDecoder::BaseImageDecoder()
     m_buf_supported = false;
     m_scale_denom = 1;
     m_use_rgb = false;
+    m_read_exif = true;
+    m_step_supported = true;
     m_frame_count = 1;
 }
 
@@ -66,6 +68,7 @@ bool BaseImageDecoder::setSource( const String& filename )
 {
     m_filename = filename;
     m_buf.release();
+    resetSourceState();
     return true;
 }
 
@@ -75,9 +78,17 @@ bool BaseImageDecoder::setSource( const Mat& buf )
         return false;
     m_filename = String();
     m_buf = buf;
+    resetSourceState();
     return true;
 }
 
+void BaseImageDecoder::resetSourceState()
+{
+    // the decoder can be reused for other images, see imdecodeBatch()
+    m_roi = Rect();
+    m_exif = ExifReader();
+}
+
 size_t BaseImageDecoder::signatureLength() const
 {
     return m_signature.size();
@@ -96,11 +107,22 @@ int BaseImageDecoder::setScale( const int& scale_denom )
     return temp;
 }
 
+bool BaseImageDecoder::setROI( const Rect& /*roi*/ )
+{
+    m_roi = Rect();
+    return false;
+}
+
 void BaseImageDecoder::setRGB(bool useRGB)
 {
     m_use_rgb = useRGB;
 }
 
+void BaseImageDecoder::setReadExif(bool readExif)
+{
+    m_read_exif = readExif;
+}
+
 ImageDecoder BaseImageDecoder::newDecoder() const
 {
     return ImageDecoder();
@@ -144,6 +166,26 @@ bool BaseImageEncoder::writemulti(const std::vector<Mat>&, const std::vector<int
     return false;
 }
 
+bool BaseImageEncoder::writeStart(Size, int, const std::vector<int>&)
+{
+    return false;
+}
+
+bool BaseImageEncoder::writeRows(const Mat&)
+{
+    return false;
+}
+
+bool BaseImageEncoder::writeTile(const Mat&, Point)
+{
+    return false;
+}
+
+bool BaseImageEncoder::writeFinish()
+{
+    return false;
+}
+
 ImageEncoder BaseImageEncoder::newEncoder() const
 {
     return ImageEncoder();
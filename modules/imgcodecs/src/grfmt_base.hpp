@@ -92,6 +92,16 @@ public:
      */
     virtual int setScale(const int& scale_denom);
 
+    /**
+     * @brief Request decoding of a region of the image.
+     * Called after readHeader(), the rectangle is given in coordinates of the image reported by readHeader()
+     * (after scaling). If the decoder supports regions, readData() receives an image of the rectangle size.
+     * The default implementation returns false, the caller decodes the whole image then.
+     * @param roi The region to decode, it must be inside of the image.
+     * @return true if the decoder reads the region natively, false otherwise.
+     */
+    virtual bool setROI(const Rect& roi);
+
     /**
      * @brief Read the image header to extract basic properties (width, height, type).
      * This is a pure virtual function that must be implemented by derived classes.
@@ -113,6 +123,20 @@ public:
      */
     virtual void setRGB(bool useRGB);
 
+    /**
+     * @brief Check whether readData() writes rows with the step of the output matrix.
+     * If not, the output must be continuous, the caller decodes a ROI of a larger matrix via a temporary image.
+     * @return true if the output may be a ROI of a larger matrix.
+     */
+    bool isStepSupported() const { return m_step_supported; }
+
+    /**
+     * @brief Set whether EXIF data is needed after readData(), e.g. for the orientation.
+     * Decoders may skip reading metadata stored after the image data if it is not needed.
+     * @param readExif If false, getExifTag() may return no data for such images.
+     */
+    void setReadExif(bool readExif);
+
     /**
      * @brief Advance to the next page or frame of the image, if applicable.
      * The default implementation does nothing and returns false.
@@ -140,15 +164,21 @@ public:
     virtual ImageDecoder newDecoder() const;
 
 protected:
+    /// Resets the state which belongs to the previous source (region, EXIF data).
+    void resetSourceState();
+
     int m_width;          ///< Width of the image (set by readHeader).
     int m_height;         ///< Height of the image (set by readHeader).
     int m_type;           ///< Image type (e.g., color depth, channel order).
     int m_scale_denom;    ///< Scale factor denominator for resizing the image.
+    Rect m_roi;           ///< Region to decode (empty for the whole image), see setROI().
     String m_filename;    ///< Name of the file that is being decoded.
     String m_signature;   ///< Signature for identifying the image format.
     Mat m_buf;            ///< Buffer holding the image data when loaded from memory.
     bool m_buf_supported; ///< Flag indicating whether buffer-based loading is supported.
+    bool m_step_supported; ///< Flag indicating whether readData() honours the step of the output, see isStepSupported().
     bool m_use_rgb;       ///< Flag indicating whether to decode the image in RGB order.
+    bool m_read_exif;     ///< Flag indicating whether EXIF data is needed, see setReadExif().
     ExifReader m_exif;    ///< Object for reading EXIF metadata from the image.
     size_t m_frame_count; ///< Number of frames in the image (for animations and multi-page images).
 };
@@ -215,6 +245,44 @@ public:
      */
     virtual bool writemulti(const std::vector<Mat>& img_vec, const std::vector<int>& params);
 
+    /**
+     * @brief Start streaming encoding of an image which is passed by parts.
+     * By default, this method returns false, indicating that the format does not support streaming.
+     * @param size The size of the whole image.
+     * @param type The type of the image data which is passed to writeRows() or writeTile().
+     * @param params A vector of parameters controlling the encoding process.
+     * @return true if the encoding was started, false otherwise.
+     */
+    virtual bool writeStart(Size size, int type, const std::vector<int>& params);
+
+    /**
+     * @brief Encode the next rows of the image started by writeStart().
+     * @param rows The Mat object containing full-width rows of the image, in order from top to bottom.
+     * @return true if the rows were successfully written, false otherwise.
+     */
+    virtual bool writeRows(const Mat& rows);
+
+    /**
+     * @brief Get the size of the tiles accepted by writeTile().
+     * @return The tile size, or an empty size if the started image is written by rows only.
+     */
+    virtual Size getTileSize() const { return Size(); }
+
+    /**
+     * @brief Encode a tile of the image started by writeStart().
+     * @param tile The Mat object containing the tile data (smaller tiles are accepted at the right and bottom borders).
+     * @param pos The position of the top-left tile corner, a multiple of getTileSize().
+     * @return true if the tile was successfully written, false otherwise.
+     */
+    virtual bool writeTile(const Mat& tile, Point pos);
+
+    /**
+     * @brief Finish the encoding started by writeStart() and release the encoder resources.
+     * The resources are released even if the image is incomplete.
+     * @return true if the encoded image was successfully finalized, false otherwise.
+     */
+    virtual bool writeFinish();
+
     /**
      * @brief Get a description of the image encoder (e.g., the format it supports).
      * @return A string describing the encoder.
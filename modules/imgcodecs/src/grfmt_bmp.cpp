@@ -230,6 +230,9 @@ bool  BmpDecoder::readData( Mat& img )
     int  src_pitch = ((m_width*(m_bpp != 15 ? m_bpp : 16) + 7)/8 + 3) & -4;
     int  nch = color ? 3 : 1;
     int  y, width3 = m_width*nch;
+    // RGB order is produced by the row converters, so the rows are written once
+    const bool swap_rb = m_use_rgb && color && img.channels() == 3;
+    PaletteEntry palette[256];
 
     // FIXIT: use safe pointer arithmetic (avoid 'int'), use size_t, intptr_t, etc
     CV_Assert(((uint64)m_height * m_width * nch < (CV_BIG_UINT(1) << 30)) && "BMP reader implementation doesn't support large images >= 1Gb");
@@ -243,6 +246,13 @@ bool  BmpDecoder::readData( Mat& img )
         step = -step;
     }
 
+    memcpy( palette, m_palette, sizeof(palette) );
+    if( swap_rb )
+    {
+        for( int i = 0; i < 256; i++ )
+            std::swap( palette[i].b, palette[i].r );
+    }
+
     AutoBuffer<uchar> _src, _bgr;
     _src.allocate(src_pitch + 32);
 
@@ -267,7 +277,7 @@ bool  BmpDecoder::readData( Mat& img )
             for( y = 0; y < m_height; y++, data += step )
             {
                 m_strm.getBytes( src, src_pitch );
-                FillColorRow1( color ? data : bgr, src, m_width, m_palette );
+                FillColorRow1( color ? data : bgr, src, m_width, palette );
                 if( !color )
                     icvCvt_BGR2Gray_8u_C3C1R( bgr, 0, data, 0, Size(m_width,1) );
             }
@@ -282,7 +292,7 @@ bool  BmpDecoder::readData( Mat& img )
                 {
                     m_strm.getBytes( src, src_pitch );
                     if( color )
-                        FillColorRow4( data, src, m_width, m_palette );
+                        FillColorRow4( data, src, m_width, palette );
                     else
                         FillGrayRow4( data, src, m_width, gray_palette );
                 }
@@ -304,8 +314,8 @@ bool  BmpDecoder::readData( Mat& img )
                         uchar gray_clr[2];
                         int t = 0;
 
-                        clr[0] = m_palette[code >> 4];
-                        clr[1] = m_palette[code & 15];
+                        clr[0] = palette[code >> 4];
+                        clr[1] = palette[code & 15];
                         gray_clr[0] = gray_palette[code >> 4];
                         gray_clr[1] = gray_palette[code & 15];
 
@@ -328,7 +338,7 @@ bool  BmpDecoder::readData( Mat& img )
                         CV_Assert((size_t)sz < _src.size());
                         m_strm.getBytes(src, sz);
                         if( color )
-                            data = FillColorRow4( data, src, code, m_palette );
+                            data = FillColorRow4( data, src, code, palette );
                         else
                             data = FillGrayRow4( data, src, code, gray_palette );
                     }
@@ -345,7 +355,7 @@ bool  BmpDecoder::readData( Mat& img )
                         if( color )
                             data = FillUniColor( data, line_end, step, width3,
                                                  y, m_height, x_shift3,
-                                                 m_palette[0] );
+                                                 palette[0] );
                         else
                             data = FillUniGray( data, line_end, step, width3,
                                                 y, m_height, x_shift3,
@@ -369,7 +379,7 @@ decode_rle4_bad: ;
                 {
                     m_strm.getBytes( src, src_pitch );
                     if( color )
-                        FillColorRow8( data, src, m_width, m_palette );
+                        FillColorRow8( data, src, m_width, palette );
                     else
                         FillGrayRow8( data, src, m_width, gray_palette );
                 }
@@ -397,7 +407,7 @@ decode_rle4_bad: ;
                         if( color )
                             data = FillUniColor( data, line_end, step, width3,
                                                  y, m_height, len,
-                                                 m_palette[code] );
+                                                 palette[code] );
                         else
                             data = FillUniGray( data, line_end, step, width3,
                                                 y, m_height, len,
@@ -419,7 +429,7 @@ decode_rle4_bad: ;
                         CV_Assert((size_t)sz < _src.size());
                         m_strm.getBytes(src, sz);
                         if( color )
-                            data = FillColorRow8( data, src, code, m_palette );
+                            data = FillColorRow8( data, src, code, palette );
                         else
                             data = FillGrayRow8( data, src, code, gray_palette );
 
@@ -446,7 +456,7 @@ decode_rle4_bad: ;
                             if( color )
                                 data = FillUniColor( data, line_end, step, width3,
                                                      y, m_height, x_shift3,
-                                                     m_palette[0] );
+                                                     palette[0] );
                             else
                                 data = FillUniGray( data, line_end, step, width3,
                                                     y, m_height, x_shift3,
@@ -474,7 +484,11 @@ decode_rle8_bad: ;
                 if( !color )
                     icvCvt_BGR5552Gray_8u_C2C1R( src, 0, data, 0, Size(m_width,1) );
                 else
+                {
                     icvCvt_BGR5552BGR_8u_C2C3R( src, 0, data, 0, Size(m_width,1) );
+                    if( swap_rb )
+                        icvCvt_BGR2RGB_8u_C3R( data, 0, data, 0, Size(m_width,1) );
+                }
             }
             result = true;
             break;
@@ -486,7 +500,11 @@ decode_rle8_bad: ;
                 if( !color )
                     icvCvt_BGR5652Gray_8u_C2C1R( src, 0, data, 0, Size(m_width,1) );
                 else
+                {
                     icvCvt_BGR5652BGR_8u_C2C3R( src, 0, data, 0, Size(m_width,1) );
+                    if( swap_rb )
+                        icvCvt_BGR2RGB_8u_C3R( data, 0, data, 0, Size(m_width,1) );
+                }
             }
             result = true;
             break;
@@ -497,6 +515,8 @@ decode_rle8_bad: ;
                 m_strm.getBytes( src, src_pitch );
                 if(!color)
                     icvCvt_BGR2Gray_8u_C3C1R( src, 0, data, 0, Size(m_width,1) );
+                else if( swap_rb )
+                    icvCvt_BGR2RGB_8u_C3R( src, 0, data, 0, Size(m_width,1) );
                 else
                     memcpy( data, src, m_width*3 );
             }
@@ -520,9 +540,13 @@ decode_rle8_bad: ;
                     else if( img.channels() == 3 )
                     {
                         if ( has_bit_mask )
+                        {
                             maskBGRA(data, src, m_width, false);
+                            if( swap_rb )
+                                icvCvt_BGR2RGB_8u_C3R( data, 0, data, 0, Size(m_width,1) );
+                        }
                         else
-                            icvCvt_BGRA2BGR_8u_C4C3R(src, 0, data, 0, Size(m_width, 1));
+                            icvCvt_BGRA2BGR_8u_C4C3R(src, 0, data, 0, Size(m_width, 1), swap_rb);
                     }
                     else if ( img.channels() == 4 )
                     {
@@ -544,11 +568,6 @@ decode_rle8_bad: ;
         throw;
     }
 
-    if (m_use_rgb && color && img.channels() == 3)
-    {
-        cv::cvtColor(img, img, cv::COLOR_BGR2RGB);
-    }
-
     return result;
 }
 
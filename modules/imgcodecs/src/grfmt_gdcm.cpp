@@ -68,6 +68,7 @@ DICOMDecoder::DICOMDecoder()
     // DICOM preamble is 128 bytes (can have any value, defaults to 0) + 4 bytes magic number (DICM)
     m_signature = String(preamble_skip, (char)'\x0') + getMagic();
     m_buf_supported = false;
+    m_step_supported = false;  // GetBuffer() writes a single block
 }
 
 bool DICOMDecoder::checkSignature( const String& signature ) const
@@ -164,7 +165,8 @@ bool  DICOMDecoder::readHeader()
 
 bool  DICOMDecoder::readData( Mat& csImage )
 {
-    csImage.create(m_width,m_height,m_type);
+    csImage.create(m_height,m_width,m_type);
+    CV_Assert(csImage.isContinuous());
 
     gdcm::ImageReader csImageReader;
     csImageReader.SetFileName(m_filename.c_str());
@@ -263,6 +263,22 @@ bool  JpegDecoder::readHeader()
     return result;
 }
 
+// jpeg_crop_scanline() and jpeg_skip_scanlines() are available since libjpeg-turbo 1.5
+#if defined(LIBJPEG_TURBO_VERSION_NUMBER)
+#define CV_JPEG_HAVE_CROP 1
+#endif
+
+bool  JpegDecoder::setROI( const Rect& roi )
+{
+#ifdef CV_JPEG_HAVE_CROP
+    CV_Assert(roi.x >= 0 && roi.y >= 0 && roi.x + roi.width <= m_width && roi.y + roi.height <= m_height);
+    m_roi = roi == Rect(0, 0, m_width, m_height) ? Rect() : roi;
+    return true;
+#else
+    return BaseImageDecoder::setROI(roi);
+#endif
+}
+
 #ifdef CV_MANUAL_JPEG_STD_HUFF_TABLES
 /***************************************************************************
  * following code is for supporting MJPEG image files
@@ -494,9 +510,29 @@ bool  JpegDecoder::readData( Mat& img )
 
             jpeg_start_decompress( cinfo );
 
+            // region of the output image, the decoder skips rows and columns (iMCU granularity) outside of it
+            const Rect roi = m_roi.empty() ? Rect(0, 0, m_width, m_height) : m_roi;
+            int xskip = 0, bufWidth = m_width;
+            const bool sameLayout = doDirectRead;  // the decoder produces rows in the layout of img
+#ifdef CV_JPEG_HAVE_CROP
+            if( !m_roi.empty() )
+            {
+                // one more column on each side: fancy upsampling of chroma uses the neighbour samples
+                const int x0 = std::max(roi.x - 1, 0), x1 = std::min(roi.x + roi.width + 1, m_width);
+                JDIMENSION xoffset = (JDIMENSION)x0, cropWidth = (JDIMENSION)(x1 - x0);
+                jpeg_crop_scanline( cinfo, &xoffset, &cropWidth );
+                xskip = roi.x - (int)xoffset;
+                bufWidth = (int)cropWidth;
+                if( roi.y > 0 && jpeg_skip_scanlines( cinfo, (JDIMENSION)roi.y ) != (JDIMENSION)roi.y )
+                    return false;
+                doDirectRead = doDirectRead && xskip == 0 && bufWidth == roi.width;
+            }
+#endif
+            CV_Assert( img.cols == roi.width && img.rows == roi.height );
+
             if( doDirectRead)
             {
-                for( int iy = 0 ; iy < m_height; iy ++ )
+                for( int iy = 0 ; iy < roi.height; iy ++ )
                 {
                     uchar* data = img.ptr<uchar>(iy);
                     if (jpeg_read_scanlines( cinfo, &data, 1 ) != 1) return false;
@@ -505,42 +541,49 @@ bool  JpegDecoder::readData( Mat& img )
             else
             {
                 JSAMPARRAY buffer = (*cinfo->mem->alloc_sarray)((j_common_ptr)cinfo,
-                                                                 JPOOL_IMAGE, m_width*4, 1 );
+                                                                 JPOOL_IMAGE, bufWidth*4, 1 );
+                const Size rowSize(roi.width, 1);
 
-                for( int iy = 0 ; iy < m_height; iy ++ )
+                for( int iy = 0 ; iy < roi.height; iy ++ )
                 {
                     uchar* data = img.ptr<uchar>(iy);
                     if (jpeg_read_scanlines( cinfo, buffer, 1 ) != 1) return false;
+                    const uchar* src = buffer[0] + xskip * cinfo->out_color_components;
 
-                    if( color )
+                    if( sameLayout )
+                        memcpy( data, src, roi.width * img.elemSize() );
+                    else if( color )
                     {
                         if (m_use_rgb)
                         {
                             if( cinfo->out_color_components == 3 )
-                                icvCvt_BGR2RGB_8u_C3R( buffer[0], 0, data, 0, Size(m_width,1) );
+                                icvCvt_BGR2RGB_8u_C3R( src, 0, data, 0, rowSize );
                             else
-                                icvCvt_CMYK2RGB_8u_C4C3R( buffer[0], 0, data, 0, Size(m_width,1) );
+                                icvCvt_CMYK2RGB_8u_C4C3R( src, 0, data, 0, rowSize );
                         }
                         else
                         {
                             if( cinfo->out_color_components == 3 )
-                                icvCvt_RGB2BGR_8u_C3R( buffer[0], 0, data, 0, Size(m_width,1) );
+                                icvCvt_RGB2BGR_8u_C3R( src, 0, data, 0, rowSize );
                             else
-                                icvCvt_CMYK2BGR_8u_C4C3R( buffer[0], 0, data, 0, Size(m_width,1) );
+                                icvCvt_CMYK2BGR_8u_C4C3R( src, 0, data, 0, rowSize );
                         }
                     }
                     else
                     {
                         if( cinfo->out_color_components == 1 )
-                            memcpy( data, buffer[0], m_width );
+                            memcpy( data, src, roi.width );
                         else
-                            icvCvt_CMYK2Gray_8u_C4C1R( buffer[0], 0, data, 0, Size(m_width,1) );
+                            icvCvt_CMYK2Gray_8u_C4C1R( src, 0, data, 0, rowSize );
                     }
                 }
             }
 
             result = true;
-            jpeg_finish_decompress( cinfo );
+            if( cinfo->output_scanline < cinfo->output_height )
+                jpeg_abort_decompress( cinfo );  // the rest of the region is not needed
+            else
+                jpeg_finish_decompress( cinfo );
         }
     }
 
@@ -596,15 +639,33 @@ static void jpeg_buffer_dest(j_compress_ptr cinfo, JpegDestination* destination)
 }
 
 
+/** Compressor of the image written by JpegEncoder */
+struct JpegEncoderState
+{
+    JpegEncoderState() : f(0), doDirectWrite(false), channels(0), width(0) {}
+
+    jpeg_compress_struct cinfo; // IJG JPEG codec structure
+    JpegErrorMgr jerr; // error processing manager state
+    JpegDestination dest; // memory buffer destination
+    std::vector<uchar> out_buf;
+    FILE* f;
+    bool doDirectWrite;
+    int channels; // channels of the input image
+    int width;
+    AutoBuffer<uchar> buffer; // converted row for the indirect write
+};
+
 JpegEncoder::JpegEncoder()
 {
     m_description = "JPEG files (*.jpeg;*.jpg;*.jpe)";
     m_buf_supported = true;
+    m_state = 0;
 }
 
 
 JpegEncoder::~JpegEncoder()
 {
+    close(false);
 }
 
 ImageEncoder JpegEncoder::newEncoder() const
@@ -612,84 +673,103 @@ ImageEncoder JpegEncoder::newEncoder() const
     return makePtr<JpegEncoder>();
 }
 
-bool JpegEncoder::write( const Mat& img, const std::vector<int>& params )
+void JpegEncoder::close( bool failed )
 {
-    m_last_error.clear();
-
-    struct fileWrapper
+    JpegEncoderState* state = (JpegEncoderState*)m_state;
+    if( !state )
+        return;
+    if( failed )
     {
-        FILE* f;
+        char jmsg_buf[JMSG_LENGTH_MAX];
+        state->jerr.pub.format_message((j_common_ptr)&state->cinfo, jmsg_buf);
+        m_last_error = jmsg_buf;
+    }
+    jpeg_destroy_compress( &state->cinfo );
+    if( state->f )
+        fclose( state->f );
+    delete state;
+    m_state = 0;
+}
 
-        fileWrapper() : f(0) {}
-        ~fileWrapper() { if(f) fclose(f); }
-    };
-    volatile bool result = false;
-    fileWrapper fw;
-    int width = img.cols, height = img.rows;
+bool JpegEncoder::write( const Mat& img, const std::vector<int>& params )
+{
+    if( !writeStart( img.size(), img.type(), params ) )
+        return false;
+    const bool result = writeRows( img );
+    return writeFinish() && result;
+}
 
-    std::vector<uchar> out_buf(1 << 12);
+bool JpegEncoder::writeStart( Size size, int type, const std::vector<int>& params )
+{
+    m_last_error.clear();
+    close(false);
 
-    struct jpeg_compress_struct cinfo;
-    JpegErrorMgr jerr;
-    JpegDestination dest;
+    JpegEncoderState* state = new JpegEncoderState;
+    m_state = state;
+    volatile bool result = false;
+    int width = size.width, height = size.height;
 
-    cinfo.err = jpeg_std_error(&jerr.pub);
-    jerr.pub.error_exit = error_exit;
-    jpeg_create_compress(&cinfo);
+    state->out_buf.resize(1 << 12);
+    state->cinfo.err = jpeg_std_error(&state->jerr.pub);
+    state->jerr.pub.error_exit = error_exit;
+    jpeg_create_compress(&state->cinfo);
 
     if( !m_buf )
     {
-        fw.f = fopen( m_filename.c_str(), "wb" );
-        if( !fw.f )
-            goto _exit_;
-        jpeg_stdio_dest( &cinfo, fw.f );
+        state->f = fopen( m_filename.c_str(), "wb" );
+        if( !state->f )
+        {
+            close(true);
+            return false;
+        }
+        jpeg_stdio_dest( &state->cinfo, state->f );
     }
     else
     {
-        dest.dst = m_buf;
-        dest.buf = &out_buf;
+        state->dest.dst = m_buf;
+        state->dest.buf = &state->out_buf;
 
-        jpeg_buffer_dest( &cinfo, &dest );
+        jpeg_buffer_dest( &state->cinfo, &state->dest );
 
-        dest.pub.next_output_byte = &out_buf[0];
-        dest.pub.free_in_buffer = out_buf.size();
+        state->dest.pub.next_output_byte = &state->out_buf[0];
+        state->dest.pub.free_in_buffer = state->out_buf.size();
     }
 
-    if( setjmp( jerr.setjmp_buffer ) == 0 )
+    if( setjmp( state->jerr.setjmp_buffer ) == 0 )
     {
-        cinfo.image_width = width;
-        cinfo.image_height = height;
+        state->cinfo.image_width = width;
+        state->cinfo.image_height = height;
 
-        int _channels = img.channels();
+        int _channels = CV_MAT_CN(type);
         int channels = _channels > 1 ? 3 : 1;
 
         bool doDirectWrite = false;
         switch( _channels )
         {
             case 1:
-                cinfo.input_components = 1;
-                cinfo.in_color_space = JCS_GRAYSCALE;
+                state->cinfo.input_components = 1;
+                state->cinfo.in_color_space = JCS_GRAYSCALE;
                 doDirectWrite = true; // GRAY -> GRAY
                 break;
             case 3:
 #ifdef JCS_EXTENSIONS
-                cinfo.input_components = 3;
-                cinfo.in_color_space = JCS_EXT_BGR;
+                state->cinfo.input_components = 3;
+                state->cinfo.in_color_space = JCS_EXT_BGR;
                 doDirectWrite = true; // BGR -> BGR
 #else
-                cinfo.input_components = 3;
-                cinfo.in_color_space = JCS_RGB;
+                state->cinfo.input_components = 3;
+                state->cinfo.in_color_space = JCS_RGB;
                 doDirectWrite = false; // BGR -> RGB
 #endif
                 break;
             case 4:
 #ifdef JCS_EXTENSIONS
-                cinfo.input_components = 4;
-                cinfo.in_color_space = JCS_EXT_BGRX;
+                state->cinfo.input_components = 4;
+                state->cinfo.in_color_space = JCS_EXT_BGRX;
                 doDirectWrite = true; // BGRX -> BGRX
 #else
-                cinfo.input_components = 3;
-                cinfo.in_color_space = JCS_RGB;
+                state->cinfo.input_components = 3;
+                state->cinfo.in_color_space = JCS_RGB;
                 doDirectWrite = false; // BGRA -> RGB
 #endif
                 break;
@@ -697,6 +777,14 @@ bool JpegEncoder::write( const Mat& img, const std::vector<int>& params )
                 CV_Error(cv::Error::StsError, cv::format("Unsupported number of _channels: %06d", _channels) );
                 break;
         }
+        state->doDirectWrite = doDirectWrite;
+        state->channels = _channels;
+        state->width = width;
+        if( !doDirectWrite )
+        {
+            CV_Check(_channels, (_channels == 3) || (_channels == 4), "Unsupported number of channels(indirect write)");
+            state->buffer.allocate(width*channels);
+        }
 
         int quality = 95;
         int progressive = 0;
@@ -705,6 +793,7 @@ bool JpegEncoder::write( const Mat& img, const std::vector<int>& params )
         int luma_quality = -1;
         int chroma_quality = -1;
         uint32_t sampling_factor = 0; // same as 0x221111
+        int speed_preset = -1;
 
         for( size_t i = 0; i < params.size(); i += 2 )
         {
@@ -753,6 +842,11 @@ bool JpegEncoder::write( const Mat& img, const std::vector<int>& params )
                 rst_interval = MIN(MAX(rst_interval, 0), 65535L);
             }
 
+            if( params[i] == IMWRITE_SPEED_PRESET )
+            {
+                speed_preset = params[i+1];
+            }
+
             if( params[i] == IMWRITE_JPEG_SAMPLING_FACTOR )
             {
                 sampling_factor = static_cast<uint32_t>(params[i+1]);
@@ -775,61 +869,78 @@ bool JpegEncoder::write( const Mat& img, const std::vector<int>& params )
             }
         }
 
-        jpeg_set_defaults( &cinfo );
-        cinfo.restart_interval = rst_interval;
+        jpeg_set_defaults( &state->cinfo );
+        state->cinfo.restart_interval = rst_interval;
 
-        jpeg_set_quality( &cinfo, quality,
+        jpeg_set_quality( &state->cinfo, quality,
                           TRUE /* limit to baseline-JPEG values */ );
         if( progressive )
-            jpeg_simple_progression( &cinfo );
-        if( optimize )
-            cinfo.optimize_coding = TRUE;
+            jpeg_simple_progression( &state->cinfo );
+        if( optimize || speed_preset == IMWRITE_SPEED_PRESET_SMALLEST )
+            state->cinfo.optimize_coding = TRUE;
+        if( speed_preset == IMWRITE_SPEED_PRESET_FASTEST )
+            state->cinfo.dct_method = JDCT_IFAST;
 
         if( (channels > 1) && ( sampling_factor != 0 ) )
         {
-            cinfo.comp_info[0].v_samp_factor = (sampling_factor >> 16 ) & 0xF;
-            cinfo.comp_info[0].h_samp_factor = (sampling_factor >> 20 ) & 0xF;
-            cinfo.comp_info[1].v_samp_factor = 1;
-            cinfo.comp_info[1].h_samp_factor = 1;
+            state->cinfo.comp_info[0].v_samp_factor = (sampling_factor >> 16 ) & 0xF;
+            state->cinfo.comp_info[0].h_samp_factor = (sampling_factor >> 20 ) & 0xF;
+            state->cinfo.comp_info[1].v_samp_factor = 1;
+            state->cinfo.comp_info[1].h_samp_factor = 1;
         }
 
         if (luma_quality >= 0 && chroma_quality >= 0)
         {
 #if JPEG_LIB_VERSION >= 70
-            cinfo.q_scale_factor[0] = jpeg_quality_scaling(luma_quality);
-            cinfo.q_scale_factor[1] = jpeg_quality_scaling(chroma_quality);
+            state->cinfo.q_scale_factor[0] = jpeg_quality_scaling(luma_quality);
+            state->cinfo.q_scale_factor[1] = jpeg_quality_scaling(chroma_quality);
             if ( luma_quality != chroma_quality )
             {
                 /* disable subsampling - ref. Libjpeg.txt */
-                cinfo.comp_info[0].v_samp_factor = 1;
-                cinfo.comp_info[0].h_samp_factor = 1;
-                cinfo.comp_info[1].v_samp_factor = 1;
-                cinfo.comp_info[1].h_samp_factor = 1;
+                state->cinfo.comp_info[0].v_samp_factor = 1;
+                state->cinfo.comp_info[0].h_samp_factor = 1;
+                state->cinfo.comp_info[1].v_samp_factor = 1;
+                state->cinfo.comp_info[1].h_samp_factor = 1;
             }
-            jpeg_default_qtables( &cinfo, TRUE );
+            jpeg_default_qtables( &state->cinfo, TRUE );
 #else
             // See https://github.com/opencv/opencv/issues/25646
             CV_LOG_ONCE_WARNING(NULL, cv::format("IMWRITE_JPEG_LUMA/CHROMA_QUALITY are not supported bacause JPEG_LIB_VERSION < 70."));
 #endif // #if JPEG_LIB_VERSION >= 70
         }
 
-        jpeg_start_compress( &cinfo, TRUE );
+        jpeg_start_compress( &state->cinfo, TRUE );
+        result = true;
+    }
+
+    if( !result )
+        close(true);
+    return result;
+}
+
+bool JpegEncoder::writeRows( const Mat& img )
+{
+    JpegEncoderState* state = (JpegEncoderState*)m_state;
+    if( !state )
+        return false;
+    CV_CheckEQ(img.cols, state->width, "");
+    CV_CheckEQ(img.channels(), state->channels, "");
+    volatile bool result = false;
 
-        if( doDirectWrite )
+    if( setjmp( state->jerr.setjmp_buffer ) == 0 )
+    {
+        const int width = img.cols, height = img.rows, _channels = state->channels;
+        if( state->doDirectWrite )
         {
             for( int y = 0; y < height; y++ )
             {
                 uchar *data = const_cast<uchar*>(img.ptr<uchar>(y));
-                jpeg_write_scanlines( &cinfo, &data, 1 );
+                jpeg_write_scanlines( &state->cinfo, &data, 1 );
             }
         }
         else
         {
-            CV_Check(_channels, (_channels == 3) || (_channels == 4), "Unsupported number of channels(indirect write)");
-
-            AutoBuffer<uchar> _buffer;
-            _buffer.allocate(width*channels);
-            uchar *buffer = _buffer.data();
+            uchar *buffer = state->buffer.data();
 
             for( int y = 0; y < height; y++ )
             {
@@ -842,25 +953,31 @@ bool JpegEncoder::write( const Mat& img, const std::vector<int>& params )
                 {
                     icvCvt_BGRA2BGR_8u_C4C3R( data, 0, buffer, 0, Size(width,1), 2 );
                 }
-                jpeg_write_scanlines( &cinfo, &buffer, 1 );
+                jpeg_write_scanlines( &state->cinfo, &buffer, 1 );
             }
         }
-
-        jpeg_finish_compress( &cinfo );
         result = true;
     }
 
-_exit_:
+    if( !result )
+        close(true);
+    return result;
+}
 
-    if(!result)
+bool JpegEncoder::writeFinish()
+{
+    JpegEncoderState* state = (JpegEncoderState*)m_state;
+    if( !state )
+        return false;
+    volatile bool result = false;
+
+    if( setjmp( state->jerr.setjmp_buffer ) == 0 )
     {
-        char jmsg_buf[JMSG_LENGTH_MAX];
-        jerr.pub.format_message((j_common_ptr)&cinfo, jmsg_buf);
-        m_last_error = jmsg_buf;
+        jpeg_finish_compress( &state->cinfo );
+        result = true;
     }
 
-    jpeg_destroy_compress( &cinfo );
-
+    close(!result);
     return result;
 }
 
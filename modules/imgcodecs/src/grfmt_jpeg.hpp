@@ -81,6 +81,7 @@ public:
 
     bool  readData( Mat& img ) CV_OVERRIDE;
     bool  readHeader() CV_OVERRIDE;
+    bool  setROI( const Rect& roi ) CV_OVERRIDE;
     void  close();
 
     ImageDecoder newDecoder() const CV_OVERRIDE;
@@ -103,7 +104,15 @@ public:
     virtual ~JpegEncoder();
 
     bool  write( const Mat& img, const std::vector<int>& params ) CV_OVERRIDE;
+    bool  writeStart( Size size, int type, const std::vector<int>& params ) CV_OVERRIDE;
+    bool  writeRows( const Mat& rows ) CV_OVERRIDE;
+    bool  writeFinish() CV_OVERRIDE;
     ImageEncoder newEncoder() const CV_OVERRIDE;
+
+protected:
+    void  close( bool failed );
+
+    void* m_state;  // JpegEncoderState of the started image
 };
 
 }
@@ -62,6 +62,7 @@
 #include <zlib.h>
 
 #include "grfmt_png.hpp"
+#include <opencv2/core/utils/logger.hpp>
 
 #if defined _MSC_VER && _MSC_VER >= 1200
     // interaction between '_setjmp' and C++ object destruction is non-portable
@@ -214,6 +215,24 @@ bool  PngDecoder::readHeader()
 }
 
 
+bool  PngDecoder::setROI( const Rect& roi )
+{
+    // rows of interlaced images are available after all passes only
+    if( !m_png_ptr || !m_info_ptr ||
+        png_get_interlace_type( (png_structp)m_png_ptr, (png_infop)m_info_ptr ) != PNG_INTERLACE_NONE )
+        return BaseImageDecoder::setROI(roi);
+    CV_Assert(roi.x >= 0 && roi.y >= 0 && roi.x + roi.width <= m_width && roi.y + roi.height <= m_height);
+    m_roi = roi == Rect(0, 0, m_width, m_height) ? Rect() : roi;
+    return true;
+}
+
+// png_read_end() after decoding of a region skips the rest of image data, it is expected
+static void skippedDataPngWarning( png_structp, png_const_charp message )
+{
+    if( !strstr( message, "Too much image data" ) )
+        CV_LOG_WARNING(NULL, "libpng: " << message);
+}
+
 bool  PngDecoder::readData( Mat& img )
 {
     volatile bool result = false;
@@ -271,11 +290,37 @@ bool  PngDecoder::readData( Mat& img )
             png_set_interlace_handling( png_ptr );
             png_read_update_info( png_ptr, info_ptr );
 
-            for( y = 0; y < m_height; y++ )
-                buffer[y] = img.data + y*img.step;
+            if( !m_roi.empty() )
+            {
+                // rows above the region are decoded into the temporary row, rows below are not decoded at all
+                CV_Assert( img.cols == m_roi.width && img.rows == m_roi.height );
+                AutoBuffer<uchar> _row(png_get_rowbytes( png_ptr, info_ptr ));
+                uchar* row = _row.data();
+                const size_t xofs = m_roi.x * img.elemSize(), rowSize = m_roi.width * img.elemSize();
+                for( y = 0; y < m_roi.y + m_roi.height; y++ )
+                {
+                    png_read_row( png_ptr, row, NULL );
+                    if( y >= m_roi.y )
+                        memcpy( img.ptr(y - m_roi.y), row + xofs, rowSize );
+                }
+#ifdef PNG_eXIf_SUPPORTED
+                // eXIf after image data is reached by inflating the rest of it, only if the orientation is needed
+                if( m_read_exif && !png_get_valid( png_ptr, info_ptr, PNG_INFO_eXIf ) )
+                {
+                    png_set_error_fn( png_ptr, png_get_error_ptr( png_ptr ), NULL, (png_error_ptr)skippedDataPngWarning );
+                    png_read_end( png_ptr, end_info );
+                    png_set_error_fn( png_ptr, png_get_error_ptr( png_ptr ), NULL, NULL );
+                }
+#endif
+            }
+            else
+            {
+                for( y = 0; y < m_height; y++ )
+                    buffer[y] = img.data + y*img.step;
 
-            png_read_image( png_ptr, buffer );
-            png_read_end( png_ptr, end_info );
+                png_read_image( png_ptr, buffer );
+                png_read_end( png_ptr, end_info );
+            }
 
 #ifdef PNG_eXIf_SUPPORTED
             png_uint_32 num_exif = 0;
@@ -308,11 +353,25 @@ PngEncoder::PngEncoder()
 {
     m_description = "Portable Network Graphics files (*.png)";
     m_buf_supported = true;
+    m_png_ptr = 0;
+    m_info_ptr = 0;
+    m_f = 0;
+    m_width = 0;
+    m_type = -1;
+    m_rows_left = 0;
+    m_chunked = false;
+    m_bilevel = false;
+    m_level = Z_BEST_SPEED;
+    m_strategy = IMWRITE_PNG_STRATEGY_RLE;
+    m_filter = PNG_FILTER_VALUE_SUB;
+    m_adler = 0;
+    m_idat_started = false;
 }
 
 
 PngEncoder::~PngEncoder()
 {
+    close();
 }
 
 
@@ -327,6 +386,143 @@ ImageEncoder PngEncoder::newEncoder() const
 }
 
 
+// with IMWRITE_SPEED_PRESET, image data of this size and larger is compressed by chunks in parallel
+static const size_t PNG_CHUNKED_MIN_SIZE = 1 << 20;
+// size of the filtered data of a chunk
+static const size_t PNG_CHUNK_SIZE = 1 << 18;
+// deflate window, the tail of the previous data is the dictionary of a chunk
+static const size_t PNG_WINDOW_SIZE = 1 << 15;
+
+/** Converts a row to the layout of PNG file: RGB(A) order, big-endian 16-bit samples, packed bilevel pixels */
+static void pngFileRow( const uchar* src, uchar* dst, int width, int depth, int cn, bool bilevel )
+{
+    if( bilevel )
+    {
+        for( int x = 0; x < width; x += 8 )
+        {
+            uchar v = 0;
+            for( int i = 0; i < 8 && x + i < width; i++ )
+                if( src[x + i] )
+                    v |= (uchar)(0x80 >> i);
+            dst[x >> 3] = v;
+        }
+    }
+    else if( depth == CV_8U )
+    {
+        if( cn == 1 )
+            memcpy( dst, src, width );
+        else if( cn == 3 )
+            icvCvt_BGR2RGB_8u_C3R( src, 0, dst, 0, Size(width, 1) );
+        else
+            icvCvt_BGRA2RGBA_8u_C4R( src, 0, dst, 0, Size(width, 1) );
+    }
+    else
+    {
+        const ushort* s = (const ushort*)src;
+        for( int x = 0; x < width; x++, s += cn, dst += cn*2 )
+        {
+            for( int c = 0; c < cn; c++ )
+            {
+                const ushort v = s[cn >= 3 && c < 3 ? 2 - c : c];
+                dst[c*2] = (uchar)(v >> 8);
+                dst[c*2 + 1] = (uchar)v;
+            }
+        }
+    }
+}
+
+static inline int pngPaeth( int a, int b, int c )
+{
+    int pa = std::abs(b - c), pb = std::abs(a - c), pc = std::abs(a + b - 2*c);
+    return pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+}
+
+/** Filters the row, the filter type is stored to dst[0]. The adaptive filter is chosen by
+    the minimum sum of absolute differences (the heuristic of libpng) */
+static void pngFilterRow( const uchar* row, const uchar* prev, int rowbytes, int bpp, int filter,
+                          uchar* dst, uchar* scratch )
+{
+    uchar* out[5] = { 0, dst + 1, dst + 1, dst + 1, dst + 1 };
+    if( filter < 0 )
+    {
+        for( int f = PNG_FILTER_VALUE_SUB; f <= PNG_FILTER_VALUE_PAETH; f++ )
+            out[f] = scratch + (f - 1)*rowbytes;
+    }
+    else if( filter == PNG_FILTER_VALUE_NONE )
+    {
+        dst[0] = PNG_FILTER_VALUE_NONE;
+        memcpy( dst + 1, row, rowbytes );
+        return;
+    }
+
+    for( int i = 0; i < rowbytes; i++ )
+    {
+        const int x = row[i], a = i >= bpp ? row[i - bpp] : 0;
+        const int b = prev[i], c = i >= bpp ? prev[i - bpp] : 0;
+        if( filter < 0 || filter == PNG_FILTER_VALUE_SUB )
+            out[PNG_FILTER_VALUE_SUB][i] = (uchar)(x - a);
+        if( filter < 0 || filter == PNG_FILTER_VALUE_UP )
+            out[PNG_FILTER_VALUE_UP][i] = (uchar)(x - b);
+        if( filter < 0 || filter == PNG_FILTER_VALUE_AVG )
+            out[PNG_FILTER_VALUE_AVG][i] = (uchar)(x - ((a + b) >> 1));
+        if( filter < 0 || filter == PNG_FILTER_VALUE_PAETH )
+            out[PNG_FILTER_VALUE_PAETH][i] = (uchar)(x - pngPaeth(a, b, c));
+    }
+
+    if( filter >= 0 )
+    {
+        dst[0] = (uchar)filter;
+        return;
+    }
+
+    int best = PNG_FILTER_VALUE_NONE;
+    uint64 bestSum = 0;
+    for( int f = PNG_FILTER_VALUE_NONE; f <= PNG_FILTER_VALUE_PAETH; f++ )
+    {
+        const uchar* data = f == PNG_FILTER_VALUE_NONE ? row : out[f];
+        uint64 sum = 0;
+        for( int i = 0; i < rowbytes; i++ )
+            sum += data[i] < 128 ? data[i] : 256 - data[i];
+        if( f == PNG_FILTER_VALUE_NONE || sum < bestSum )
+        {
+            best = f;
+            bestSum = sum;
+        }
+    }
+    dst[0] = (uchar)best;
+    memcpy( dst + 1, best == PNG_FILTER_VALUE_NONE ? row : out[best], rowbytes );
+}
+
+/** Compresses data to the raw deflate stream which ends by a sync flush (or by the final block),
+    so the streams of consecutive chunks are concatenated */
+static void pngDeflateChunk( const uchar* data, size_t size, const uchar* dict, size_t dictSize,
+                             int level, int strategy, bool last, std::vector<uchar>& out )
+{
+    z_stream strm;
+    memset( &strm, 0, sizeof(strm) );
+    CV_Assert( deflateInit2( &strm, level, Z_DEFLATED, -MAX_WBITS, 8, strategy ) == Z_OK );
+    if( dictSize > 0 )
+        deflateSetDictionary( &strm, dict, (uInt)dictSize );
+
+    out.resize( deflateBound( &strm, (uLong)size ) + 16 );
+    strm.next_in = (Bytef*)data;
+    strm.avail_in = (uInt)size;
+    size_t pos = 0;
+    for( ;; )
+    {
+        strm.next_out = &out[pos];
+        strm.avail_out = (uInt)(out.size() - pos);
+        int code = deflate( &strm, last ? Z_FINISH : Z_SYNC_FLUSH );
+        CV_Assert( code == Z_OK || code == Z_STREAM_END || code == Z_BUF_ERROR );
+        pos = out.size() - strm.avail_out;
+        if( last ? code == Z_STREAM_END : strm.avail_out > 0 )
+            break;
+        out.resize( out.size() * 2 );
+    }
+    out.resize( pos );
+    deflateEnd( &strm );
+}
+
 void PngEncoder::writeDataToBuf(void* _png_ptr, uchar* src, size_t size)
 {
     if( size == 0 )
@@ -344,22 +540,49 @@ void PngEncoder::flushBuf(void*)
 {
 }
 
+void PngEncoder::close()
+{
+    if( m_png_ptr )
+    {
+        png_structp png_ptr = (png_structp)m_png_ptr;
+        png_infop info_ptr = (png_infop)m_info_ptr;
+        png_destroy_write_struct( &png_ptr, &info_ptr );
+        m_png_ptr = m_info_ptr = 0;
+    }
+    if( m_f )
+    {
+        fclose( m_f );
+        m_f = 0;
+    }
+}
+
 bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
 {
-    png_structp png_ptr = png_create_write_struct( PNG_LIBPNG_VER_STRING, 0, 0, 0 );
-    png_infop info_ptr = 0;
-    FILE * volatile f = 0;
-    int y, width = img.cols, height = img.rows;
-    int depth = img.depth(), channels = img.channels();
+    if( !writeStart( img.size(), img.type(), params ) )
+        return false;
+    const bool result = writeRows( img );
+    return writeFinish() && result;
+}
+
+bool  PngEncoder::writeStart( Size size, int type, const std::vector<int>& params )
+{
+    close();
+
+    int width = size.width, height = size.height;
+    int depth = CV_MAT_DEPTH(type), channels = CV_MAT_CN(type);
     volatile bool result = false;
-    AutoBuffer<uchar*> buffer;
 
     if( depth != CV_8U && depth != CV_16U )
         return false;
 
+    png_structp png_ptr = png_create_write_struct( PNG_LIBPNG_VER_STRING, 0, 0, 0 );
+    png_infop info_ptr = 0;
+    m_png_ptr = png_ptr;
+
     if( png_ptr )
     {
         info_ptr = png_create_info_struct( png_ptr );
+        m_info_ptr = info_ptr;
 
         if( info_ptr )
         {
@@ -372,14 +595,17 @@ bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
                 }
                 else
                 {
-                    f = fopen( m_filename.c_str(), "wb" );
-                    if( f )
-                        png_init_io( png_ptr, (png_FILE_p)f );
+                    m_f = fopen( m_filename.c_str(), "wb" );
+                    if( m_f )
+                        png_init_io( png_ptr, (png_FILE_p)m_f );
                 }
 
-                int compression_level = -1; // Invalid value to allow setting 0-9 as valid
+                int compression_level = Z_BEST_SPEED;
+                bool hasLevel = false;
                 int compression_strategy = IMWRITE_PNG_STRATEGY_RLE; // Default strategy
                 bool isBilevel = false;
+                bool hasStrategy = false;
+                int speed_preset = -1;
 
                 for( size_t i = 0; i < params.size(); i += 2 )
                 {
@@ -388,21 +614,37 @@ bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
                         compression_strategy = IMWRITE_PNG_STRATEGY_DEFAULT; // Default strategy
                         compression_level = params[i+1];
                         compression_level = MIN(MAX(compression_level, 0), Z_BEST_COMPRESSION);
+                        hasLevel = true;
                     }
                     if( params[i] == IMWRITE_PNG_STRATEGY )
                     {
                         compression_strategy = params[i+1];
                         compression_strategy = MIN(MAX(compression_strategy, 0), Z_FIXED);
+                        hasStrategy = true;
                     }
                     if( params[i] == IMWRITE_PNG_BILEVEL )
                     {
                         isBilevel = params[i+1] != 0;
                     }
+                    if( params[i] == IMWRITE_SPEED_PRESET )
+                    {
+                        speed_preset = params[i+1];
+                    }
                 }
 
-                if( m_buf || f )
+                int filter = -1; // adaptive
+                if( !hasLevel && speed_preset > IMWRITE_SPEED_PRESET_FASTEST )
                 {
-                    if( compression_level >= 0 )
+                    compression_level = speed_preset == IMWRITE_SPEED_PRESET_FAST ? 4 :
+                                        speed_preset == IMWRITE_SPEED_PRESET_BALANCED ? 6 : Z_BEST_COMPRESSION;
+                    hasLevel = true;
+                    if( !hasStrategy )
+                        compression_strategy = IMWRITE_PNG_STRATEGY_DEFAULT;
+                }
+
+                if( m_buf || m_f )
+                {
+                    if( hasLevel )
                     {
                         png_set_compression_level( png_ptr, compression_level );
                     }
@@ -412,6 +654,8 @@ bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
                         // (see http://wiki.linuxquestions.org/wiki/Libpng)
                         png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
                         png_set_compression_level(png_ptr, Z_BEST_SPEED);
+                        compression_level = Z_BEST_SPEED;
+                        filter = PNG_FILTER_VALUE_SUB;
                     }
                     png_set_compression_strategy(png_ptr, compression_strategy);
 
@@ -430,22 +674,203 @@ bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
                     if( !isBigEndian() )
                         png_set_swap( png_ptr );
 
-                    buffer.allocate(height);
-                    for( y = 0; y < height; y++ )
-                        buffer[y] = img.data + y*img.step;
-
-                    png_write_image( png_ptr, buffer.data() );
-                    png_write_end( png_ptr, info_ptr );
-
+                    m_width = width;
+                    m_type = type;
+                    m_rows_left = height;
+
+                    const size_t rowbytes = isBilevel ? (width + 7) / 8 : (size_t)width * CV_ELEM_SIZE(type);
+                    // opt-in: output of the default settings stays the same as of libpng
+                    m_chunked = speed_preset >= 0 && (rowbytes + 1) * height >= PNG_CHUNKED_MIN_SIZE;
+                    m_bilevel = isBilevel;
+                    m_level = compression_level;
+                    m_strategy = compression_strategy;
+                    // libpng doesn't filter images with less than 8 bits per sample by default
+                    m_filter = filter < 0 && isBilevel ? PNG_FILTER_VALUE_NONE : filter;
+                    m_prev_row.clear();
+                    m_window.clear();
+                    m_adler = adler32( 0L, Z_NULL, 0 );
+                    m_idat_started = false;
                     result = true;
                 }
             }
         }
     }
 
-    png_destroy_write_struct( &png_ptr, &info_ptr );
-    if(f) fclose( (FILE*)f );
+    if( !result )
+        close();
+    return result;
+}
 
+bool  PngEncoder::writeRows( const Mat& img )
+{
+    png_structp png_ptr = (png_structp)m_png_ptr;
+    if( !png_ptr )
+        return false;
+    CV_CheckEQ(img.cols, m_width, "");
+    CV_CheckTypeEQ(img.type(), m_type, "");
+    CV_CheckLE(img.rows, m_rows_left, "Too many rows");
+
+    if( m_chunked )
+    {
+        // rows are compressed by batches of chunks to bound the memory
+        const int rowsPerChunk = (int)std::max( (size_t)1, PNG_CHUNK_SIZE / (img.cols * img.elemSize() + 1) );
+        const int rowsPerBatch = rowsPerChunk * std::max( getNumThreads(), 1 ) * 2;
+        for( int y = 0; y < img.rows; y += rowsPerBatch )
+        {
+            const Mat rows = img.rowRange( y, std::min(y + rowsPerBatch, img.rows) );
+            std::vector<std::vector<uchar> > idat;
+            compressRows( rows, idat );
+            m_rows_left -= rows.rows;
+            if( !writeChunks( idat, "IDAT" ) )
+                return false;
+        }
+        return true;
+    }
+
+    volatile bool result = false;
+
+    if( setjmp( png_jmpbuf ( png_ptr ) ) == 0 )
+    {
+        for( int y = 0; y < img.rows; y++ )
+            png_write_row( png_ptr, img.ptr<uchar>(y) );
+        m_rows_left -= img.rows;
+        result = true;
+    }
+
+    if( !result )
+        close();
+    return result;
+}
+
+void  PngEncoder::compressRows( const Mat& img, std::vector<std::vector<uchar> >& idat )
+{
+    const int width = img.cols, depth = img.depth(), cn = img.channels();
+    const int bpp = m_bilevel ? 1 : (int)img.elemSize();
+    const int rowbytes = m_bilevel ? (width + 7) / 8 : width * bpp;
+    const size_t stride = (size_t)rowbytes + 1;
+    const int rowsPerChunk = (int)std::max( (size_t)1, PNG_CHUNK_SIZE / (img.cols * img.elemSize() + 1) );
+    const int nchunks = (img.rows + rowsPerChunk - 1) / rowsPerChunk;
+    const bool bilevel = m_bilevel;
+    const int filter = m_filter;
+
+    // the tail of the previous data precedes the filtered rows
+    const size_t offset = m_window.size();
+    std::vector<uchar> filtered( offset + stride * img.rows );
+    if( offset > 0 )
+        memcpy( &filtered[0], &m_window[0], offset );
+    if( m_prev_row.empty() )
+        m_prev_row.assign( rowbytes, 0 );
+    const uchar* prevRow0 = &m_prev_row[0];
+
+    parallel_for_(Range(0, nchunks), [&](const Range& range)
+    {
+        AutoBuffer<uchar> _buf( rowbytes * 6 );
+        uchar* prev = _buf.data();
+        uchar* cur = prev + rowbytes;
+        uchar* scratch = cur + rowbytes;
+        for( int k = range.start; k < range.end; k++ )
+        {
+            const int y0 = k * rowsPerChunk, y1 = std::min( y0 + rowsPerChunk, img.rows );
+            if( y0 > 0 )
+                pngFileRow( img.ptr(y0 - 1), prev, width, depth, cn, bilevel );
+            else
+                memcpy( prev, prevRow0, rowbytes );
+            for( int y = y0; y < y1; y++ )
+            {
+                pngFileRow( img.ptr(y), cur, width, depth, cn, bilevel );
+                pngFilterRow( cur, prev, rowbytes, bpp, filter, &filtered[offset + stride * y], scratch );
+                std::swap( prev, cur );
+            }
+        }
+    });
+
+    const bool lastRows = m_rows_left == img.rows;
+    std::vector<uLong> adlers( nchunks );
+    idat.resize( nchunks );
+    parallel_for_(Range(0, nchunks), [&](const Range& range)
+    {
+        for( int k = range.start; k < range.end; k++ )
+        {
+            const size_t start = offset + stride * rowsPerChunk * k;
+            const size_t end = std::min( start + stride * rowsPerChunk, filtered.size() );
+            const size_t dictStart = start - std::min( start, PNG_WINDOW_SIZE );
+            pngDeflateChunk( &filtered[start], end - start, &filtered[dictStart], start - dictStart,
+                             m_level, m_strategy, lastRows && k == nchunks - 1, idat[k] );
+            adlers[k] = adler32( adler32( 0L, Z_NULL, 0 ), &filtered[start], (uInt)(end - start) );
+        }
+    });
+
+    // zlib header and trailer
+    if( !m_idat_started )
+    {
+        // FLEVEL as deflate() sets it
+        const int levelFlags = m_strategy >= Z_HUFFMAN_ONLY || m_level < 2 ? 0 :
+                               m_level < 6 ? 1 : m_level == 6 ? 2 : 3;
+        int header = (((MAX_WBITS - 8) << 4) + Z_DEFLATED) << 8 | (levelFlags << 6);
+        header += 31 - header % 31;
+        const uchar zhdr[] = { (uchar)(header >> 8), (uchar)header };
+        idat[0].insert( idat[0].begin(), zhdr, zhdr + 2 );
+        m_idat_started = true;
+    }
+    for( int k = 0; k < nchunks; k++ )
+    {
+        const size_t start = offset + stride * rowsPerChunk * k;
+        const size_t end = std::min( start + stride * rowsPerChunk, filtered.size() );
+        m_adler = adler32_combine( m_adler, adlers[k], (z_off_t)(end - start) );
+    }
+    if( lastRows )
+    {
+        const uchar trailer[] = { (uchar)(m_adler >> 24), (uchar)(m_adler >> 16), (uchar)(m_adler >> 8), (uchar)m_adler };
+        idat.back().insert( idat.back().end(), trailer, trailer + 4 );
+    }
+
+    pngFileRow( img.ptr(img.rows - 1), &m_prev_row[0], width, depth, cn, bilevel );
+    const size_t windowSize = std::min( filtered.size(), PNG_WINDOW_SIZE );
+    m_window.assign( filtered.end() - windowSize, filtered.end() );
+}
+
+bool  PngEncoder::writeChunks( const std::vector<std::vector<uchar> >& chunks, const char* name )
+{
+    png_structp png_ptr = (png_structp)m_png_ptr;
+    volatile bool result = false;
+
+    if( setjmp( png_jmpbuf ( png_ptr ) ) == 0 )
+    {
+        for( size_t i = 0; i < chunks.size(); i++ )
+            png_write_chunk( png_ptr, (png_const_bytep)name, chunks[i].empty() ? NULL : &chunks[i][0], chunks[i].size() );
+        result = true;
+    }
+
+    if( !result )
+        close();
+    return result;
+}
+
+bool  PngEncoder::writeFinish()
+{
+    png_structp png_ptr = (png_structp)m_png_ptr;
+    if( !png_ptr )
+        return false;
+    volatile bool result = false;
+
+    if( m_rows_left > 0 )
+    {
+        // incomplete image
+        close();
+        return false;
+    }
+
+    if( m_chunked )
+    {
+        result = writeChunks( std::vector<std::vector<uchar> >(1), "IEND" );
+    }
+    else if( setjmp( png_jmpbuf ( png_ptr ) ) == 0 )
+    {
+        png_write_end( png_ptr, (png_infop)m_info_ptr );
+        result = true;
+    }
+
+    close();
     return result;
 }
 
@@ -60,6 +60,7 @@ public:
 
     bool  readData( Mat& img ) CV_OVERRIDE;
     bool  readHeader() CV_OVERRIDE;
+    bool  setROI( const Rect& roi ) CV_OVERRIDE;
     void  close();
 
     ImageDecoder newDecoder() const CV_OVERRIDE;
@@ -86,12 +87,36 @@ public:
 
     bool  isFormatSupported( int depth ) const CV_OVERRIDE;
     bool  write( const Mat& img, const std::vector<int>& params ) CV_OVERRIDE;
+    bool  writeStart( Size size, int type, const std::vector<int>& params ) CV_OVERRIDE;
+    bool  writeRows( const Mat& rows ) CV_OVERRIDE;
+    bool  writeFinish() CV_OVERRIDE;
 
     ImageEncoder newEncoder() const CV_OVERRIDE;
 
 protected:
     static void writeDataToBuf(void* png_ptr, uchar* src, size_t size);
     static void flushBuf(void* png_ptr);
+    void  close();
+    void  compressRows( const Mat& img, std::vector<std::vector<uchar> >& idat );
+    bool  writeChunks( const std::vector<std::vector<uchar> >& idat, const char* name );
+
+    void* m_png_ptr;  // pointer to the compressor of the started image
+    void* m_info_ptr; // pointer to the image information structure
+    FILE* m_f;
+    int   m_width;
+    int   m_type;
+    int   m_rows_left;
+
+    // image data compressed by independent chunks of rows in parallel
+    bool  m_chunked;
+    bool  m_bilevel;
+    int   m_level;
+    int   m_strategy;
+    int   m_filter;                 // PNG filter of rows, adaptive if negative
+    std::vector<uchar> m_prev_row;  // the last written row in the file layout
+    std::vector<uchar> m_window;    // the last filtered data, the dictionary of the next chunk
+    unsigned long m_adler;          // checksum of the filtered data
+    bool  m_idat_started;
 };
 
 }
@@ -336,36 +336,37 @@ bool SPngDecoder::readData(Mat &img)
                     {
                         AutoBuffer<unsigned char> imageBuffer(image_size);
                         ret = spng_decode_image(png_ptr, imageBuffer.data(), image_size, fmt, 0);
-                        int step = m_width * img.channels();
+                        // decoded image is continuous, output may be a ROI of a larger matrix
+                        int src_step = (int)(image_size / m_height);
                         if (fmt == SPNG_FMT_RGB8)
                         {
                             spngCvt_BGR2Gray_8u_C3C1R(
                                 imageBuffer.data(),
-                                step,
+                                src_step,
                                 img.data,
-                                step, Size(m_width, m_height), 2);
+                                (int)img.step, Size(m_width, m_height), 2);
                         }
                         else if (fmt == SPNG_FMT_RGBA8)
                         {
                             spngCvt_BGRA2Gray_8u_C4C1R(
                                 imageBuffer.data(),
-                                step,
+                                src_step,
                                 img.data,
-                                step, Size(m_width, m_height), 2);
+                                (int)img.step, Size(m_width, m_height), 2);
                         }
                         else if (fmt == SPNG_FMT_RGBA16)
                         {
                             spngCvt_BGRA2Gray_16u_CnC1R(
-                                reinterpret_cast<const ushort *>(imageBuffer.data()), step / 3,
+                                reinterpret_cast<const ushort *>(imageBuffer.data()), src_step / (int)sizeof(ushort),
                                 reinterpret_cast<ushort *>(img.data),
-                                step / 3, Size(m_width, m_height),
+                                (int)img.step1(), Size(m_width, m_height),
                                 4, 2);
                         }
                     }
                 }
                 else if (color)
                 { // RGB -> BGR, convert row by row if png is non-interlaced, otherwise convert image as one
-                    int step = m_width * img.channels();
+                    int step = (int)img.step;
                     AutoBuffer<uchar *> _buffer(m_height);
                     uchar **buffer = _buffer.data();
                     for (int y = 0; y < m_height; y++)
@@ -390,7 +391,7 @@ bool SPngDecoder::readData(Mat &img)
                         } while (ret == SPNG_OK);
                         if (ihdr.interlace_method && !m_use_rgb)
                         {
-                            icvCvt_RGBA2BGRA_16u_C4R(reinterpret_cast<const ushort *>(img.data), step * 2, reinterpret_cast<ushort *>(img.data), step * 2, Size(m_width, m_height));
+                            icvCvt_RGBA2BGRA_16u_C4R(reinterpret_cast<const ushort *>(img.data), step, reinterpret_cast<ushort *>(img.data), step, Size(m_width, m_height));
                         }
                     }
                     else if (img.channels() == 4)
@@ -429,8 +430,8 @@ bool SPngDecoder::readData(Mat &img)
                         } while (ret == SPNG_OK);
                         if (ihdr.interlace_method && !m_use_rgb)
                         {
-                            icvCvt_RGB2BGR_16u_C3R(reinterpret_cast<const ushort *>(img.data), step,
-                                                   reinterpret_cast<ushort *>(img.data), step, Size(m_width, m_height));
+                            icvCvt_RGB2BGR_16u_C3R(reinterpret_cast<const ushort *>(img.data), (int)img.step1(),
+                                                   reinterpret_cast<ushort *>(img.data), (int)img.step1(), Size(m_width, m_height));
                         }
                     }
                     else
@@ -461,7 +462,7 @@ bool SPngDecoder::readData(Mat &img)
                         if (ret)
                             break;
 
-                        ret = spng_decode_row(png_ptr, img.data + row_info.row_num * image_width, image_width);
+                        ret = spng_decode_row(png_ptr, img.data + row_info.row_num * img.step, image_width);
                     } while (ret == SPNG_OK);
                 }
             }
@@ -584,6 +584,20 @@ static void _unpack14To16(const uchar* src, const uchar* srcEnd, ushort* dst, us
 }
 //end _unpack14To16()
 
+bool  TiffDecoder::setROI( const Rect& roi )
+{
+    CV_Assert(!m_tif.empty());
+    TIFF* tif = (TIFF*)m_tif.get();
+    uint16_t img_orientation = ORIENTATION_TOPLEFT;
+    CV_TIFF_CHECK_CALL_DEBUG(TIFFGetField(tif, TIFFTAG_ORIENTATION, &img_orientation));
+    // flipped or rotated images are cropped after decoding
+    if (img_orientation != ORIENTATION_TOPLEFT)
+        return BaseImageDecoder::setROI(roi);
+    CV_Assert(roi.x >= 0 && roi.y >= 0 && roi.x + roi.width <= m_width && roi.y + roi.height <= m_height);
+    m_roi = roi == Rect(0, 0, m_width, m_height) ? Rect() : roi;
+    return true;
+}
+
 bool  TiffDecoder::readData( Mat& img )
 {
     int type = img.type();
@@ -592,6 +606,10 @@ bool  TiffDecoder::readData( Mat& img )
     CV_Assert(!m_tif.empty());
     TIFF* tif = (TIFF*)m_tif.get();
 
+    // in ROI mode tiles (strips) which intersect the region are decoded into the band, other tiles are skipped
+    Rect region(0, 0, m_width, m_height);
+    Mat roi_dst;
+
     uint16_t photometric = (uint16_t)-1;
     CV_TIFF_CHECK_CALL(TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, &photometric));
 
@@ -791,15 +809,29 @@ bool  TiffDecoder::readData( Mat& img )
             const int  convert_flag = MAKE_FLAG( ncn, wanted_channels );
             const bool isNeedConvert16to8 = ( doReadScanline ) && ( bpp == 16 ) && ( dst_bpp == 8);
 
-            for (int y = 0; y < m_height; y += (int)tile_height0)
+            if (!m_roi.empty())
+            {
+                CV_Assert(img.size() == m_roi.size());
+                const Point tl(m_roi.x - m_roi.x % (int)tile_width0, m_roi.y - m_roi.y % (int)tile_height0);
+                const Point br(std::min(divUp(m_roi.x + m_roi.width, tile_width0) * (int)tile_width0, m_width),
+                               std::min(divUp(m_roi.y + m_roi.height, tile_height0) * (int)tile_height0, m_height));
+                region = Rect(tl, br);
+                roi_dst = img;
+                img = Mat(region.size(), type);
+            }
+            const int tiles_per_row = divUp(m_width, tile_width0);
+
+            for (int y = region.y; y < region.y + region.height; y += (int)tile_height0)
             {
                 int tile_height = std::min((int)tile_height0, m_height - y);
 
-                const int img_y = vert_flip ? m_height - y - tile_height : y;
+                const int img_y = (vert_flip ? m_height - y - tile_height : y) - region.y;
 
-                for(int x = 0; x < m_width; x += (int)tile_width0, tileidx++)
+                tileidx = (y / (int)tile_height0) * tiles_per_row + region.x / (int)tile_width0;
+                for(int x = region.x; x < region.x + region.width; x += (int)tile_width0, tileidx++)
                 {
                     int tile_width = std::min((int)tile_width0, m_width - x);
+                    const int img_x = x - region.x;
 
                     switch (dst_bpp)
                     {
@@ -839,7 +871,7 @@ bool  TiffDecoder::readData( Mat& img )
                                 bstart += (tile_height0 - tile_height) * tile_width0 * 4;
                             }
 
-                            uchar* img_line_buffer = (uchar*) img.ptr(y, 0);
+                            uchar* img_line_buffer = (uchar*) img.ptr(y - region.y, 0);
 
                             for (int i = 0; i < tile_height; i++)
                             {
@@ -907,14 +939,14 @@ bool  TiffDecoder::readData( Mat& img )
                                     if (wanted_channels == 4)
                                     {
                                         icvCvt_BGRA2RGBA_8u_C4R(bstart + i*tile_width0*4, 0,
-                                                img.ptr(img_y + tile_height - i - 1, x), 0,
+                                                img.ptr(img_y + tile_height - i - 1, img_x), 0,
                                                 Size(tile_width, 1) );
                                     }
                                     else
                                     {
                                         CV_CheckEQ(wanted_channels, 3, "TIFF-8bpp: BGR/BGRA images are supported only");
                                         icvCvt_BGRA2BGR_8u_C4C3R(bstart + i*tile_width0*4, 0,
-                                                img.ptr(img_y + tile_height - i - 1, x), 0,
+                                                img.ptr(img_y + tile_height - i - 1, img_x), 0,
                                                 Size(tile_width, 1), m_use_rgb ? 0 : 2);
                                     }
                                 }
@@ -922,7 +954,7 @@ bool  TiffDecoder::readData( Mat& img )
                                 {
                                     CV_CheckEQ(wanted_channels, 1, "");
                                     icvCvt_BGRA2Gray_8u_C4C1R( bstart + i*tile_width0*4, 0,
-                                            img.ptr(img_y + tile_height - i - 1, x), 0,
+                                            img.ptr(img_y + tile_height - i - 1, img_x), 0,
                                             Size(tile_width, 1), 2);
                                 }
                             }
@@ -972,17 +1004,17 @@ bool  TiffDecoder::readData( Mat& img )
                                     {
                                         CV_CheckEQ(wanted_channels, 3, "");
                                         icvCvt_Gray2BGR_16u_C1C3R(buffer16, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                img.ptr<ushort>(img_y + i, img_x), 0,
                                                 Size(tile_width, 1));
                                     }
                                     else if (ncn == 3)
                                     {
                                         CV_CheckEQ(wanted_channels, 3, "");
                                         if (m_use_rgb)
-                                            std::memcpy(buffer16, img.ptr<ushort>(img_y + i, x), tile_width * sizeof(ushort));
+                                            std::memcpy(buffer16, img.ptr<ushort>(img_y + i, img_x), tile_width * sizeof(ushort));
                                         else
                                             icvCvt_RGB2BGR_16u_C3R(buffer16, 0,
-                                                    img.ptr<ushort>(img_y + i, x), 0,
+                                                    img.ptr<ushort>(img_y + i, img_x), 0,
                                                     Size(tile_width, 1));
                                     }
                                     else if (ncn == 4)
@@ -990,14 +1022,14 @@ bool  TiffDecoder::readData( Mat& img )
                                         if (wanted_channels == 4)
                                         {
                                             icvCvt_BGRA2RGBA_16u_C4R(buffer16, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                img.ptr<ushort>(img_y + i, img_x), 0,
                                                 Size(tile_width, 1));
                                         }
                                         else
                                         {
                                             CV_CheckEQ(wanted_channels, 3, "TIFF-16bpp: BGR/BGRA images are supported only");
                                             icvCvt_BGRA2BGR_16u_C4C3R(buffer16, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                img.ptr<ushort>(img_y + i, img_x), 0,
                                                 Size(tile_width, 1), m_use_rgb ? 0 : 2);
                                         }
                                     }
@@ -1011,14 +1043,14 @@ bool  TiffDecoder::readData( Mat& img )
                                     CV_CheckEQ(wanted_channels, 1, "");
                                     if( ncn == 1 )
                                     {
-                                        std::memcpy(img.ptr<ushort>(img_y + i, x),
+                                        std::memcpy(img.ptr<ushort>(img_y + i, img_x),
                                                     buffer16,
                                                     tile_width*sizeof(ushort));
                                     }
                                     else
                                     {
                                         icvCvt_BGRA2Gray_16u_CnC1R(buffer16, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                img.ptr<ushort>(img_y + i, img_x), 0,
                                                 Size(tile_width, 1), ncn, 2);
                                     }
                                 }
@@ -1040,7 +1072,7 @@ bool  TiffDecoder::readData( Mat& img )
 
                             Mat m_tile(Size(tile_width0, tile_height0), CV_MAKETYPE((dst_bpp == 32) ? (depth == CV_32S ? CV_32S : CV_32F) : CV_64F, ncn), src_buffer);
                             Rect roi_tile(0, 0, tile_width, tile_height);
-                            Rect roi_img(x, img_y, tile_width, tile_height);
+                            Rect roi_img(img_x, img_y, tile_width, tile_height);
                             if (!m_hdr && ncn == 3 && !m_use_rgb)
                                 extend_cvtColor(m_tile(roi_tile), img(roi_img), COLOR_RGB2BGR);
                             else if (!m_hdr && ncn == 4)
@@ -1074,6 +1106,13 @@ bool  TiffDecoder::readData( Mat& img )
         else
             cvtColor(img, img, COLOR_XYZ2BGR);
     }
+
+    if (!roi_dst.empty())
+    {
+        const Mat band = img;
+        img = roi_dst;
+        band(Rect(m_roi.tl() - region.tl(), m_roi.size())).copyTo(img);
+    }
     return true;
 }
 
@@ -1083,10 +1122,13 @@ TiffEncoder::TiffEncoder()
 {
     m_description = "TIFF Files (*.tiff;*.tif)";
     m_buf_supported = true;
+    m_type = -1;
+    m_next_row = 0;
 }
 
 TiffEncoder::~TiffEncoder()
 {
+    m_tif.release();
 }
 
 ImageEncoder TiffEncoder::newEncoder() const
@@ -1108,11 +1150,11 @@ public:
             : m_buf(buf), m_buf_pos(0)
     {}
 
-    TIFF* open ()
+    TIFF* open (const char* mode = "w")
     {
         // do NOT put "wb" as the mode, because the b means "big endian" mode, not "binary" mode.
         // http://www.simplesystems.org/libtiff/functions/TIFFOpen.html
-        return TIFFClientOpen( "", "w", reinterpret_cast<thandle_t>(this), &TiffEncoderBufHelper::read,
+        return TIFFClientOpen( "", mode, reinterpret_cast<thandle_t>(this), &TiffEncoderBufHelper::read,
                                &TiffEncoderBufHelper::write, &TiffEncoderBufHelper::seek,
                                &TiffEncoderBufHelper::close, &TiffEncoderBufHelper::size,
                                /*map=*/0, /*unmap=*/0 );
@@ -1196,6 +1238,300 @@ static bool readParam(const std::vector<int>& params, int key, int& value)
     return false;
 }
 
+/** Sets tags of the image data layout and compression of the current directory */
+static bool setPageTags(TIFF* tif, Size size, int type, const std::vector<int>& params, Size tileSize)
+{
+    int compression = COMPRESSION_LZW;
+    int predictor = PREDICTOR_HORIZONTAL;
+    int resUnit = -1, dpiX = -1, dpiY = -1;
+    int zipQuality = -1, speedPreset = -1;
+
+    if (!readParam(params, IMWRITE_TIFF_COMPRESSION, compression) && readParam(params, IMWRITE_SPEED_PRESET, speedPreset))
+    {
+        switch (speedPreset)
+        {
+            case IMWRITE_SPEED_PRESET_FASTEST:
+                compression = COMPRESSION_ADOBE_DEFLATE;
+                zipQuality = 1;
+                break;
+            case IMWRITE_SPEED_PRESET_FAST:
+                compression = COMPRESSION_ADOBE_DEFLATE;
+                zipQuality = 4;
+                break;
+            case IMWRITE_SPEED_PRESET_SMALLEST:
+                compression = COMPRESSION_ADOBE_DEFLATE;
+                zipQuality = 9;
+                break;
+            default:
+                break;
+        }
+    }
+    readParam(params, IMWRITE_TIFF_PREDICTOR, predictor);
+    readParam(params, IMWRITE_TIFF_RESUNIT, resUnit);
+    readParam(params, IMWRITE_TIFF_XDPI, dpiX);
+    readParam(params, IMWRITE_TIFF_YDPI, dpiY);
+
+    int channels = CV_MAT_CN(type);
+    int width = size.width, height = size.height;
+    int depth = CV_MAT_DEPTH(type);
+
+    int bitsPerChannel = -1;
+    uint16_t sample_format = SAMPLEFORMAT_INT;
+    switch (depth)
+    {
+        case CV_8U:
+            sample_format = SAMPLEFORMAT_UINT;
+            /* FALLTHRU */
+        case CV_8S:
+        {
+            bitsPerChannel = 8;
+            break;
+        }
+
+        case CV_16U:
+            sample_format = SAMPLEFORMAT_UINT;
+            /* FALLTHRU */
+        case CV_16S:
+        {
+            bitsPerChannel = 16;
+            break;
+        }
+
+        case CV_32S:
+        {
+            bitsPerChannel = 32;
+            sample_format = SAMPLEFORMAT_INT;
+            break;
+        }
+        case CV_32F:
+        {
+            bitsPerChannel = 32;
+            compression = COMPRESSION_NONE;
+            sample_format = SAMPLEFORMAT_IEEEFP;
+            break;
+        }
+        case CV_64F:
+        {
+            bitsPerChannel = 64;
+            compression = COMPRESSION_NONE;
+            sample_format = SAMPLEFORMAT_IEEEFP;
+            break;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+
+    const int bitsPerByte = 8;
+    size_t fileStep = (width * channels * bitsPerChannel) / bitsPerByte;
+    CV_Assert(fileStep > 0);
+
+    int colorspace = channels > 1 ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK;
+
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, bitsPerChannel));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_COMPRESSION, compression));
+    if (compression == COMPRESSION_ADOBE_DEFLATE && zipQuality > 0)
+    {
+        CV_TIFF_CHECK_CALL_DEBUG(TIFFSetField(tif, TIFFTAG_ZIPQUALITY, zipQuality));
+    }
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, colorspace));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, channels));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG));
+    if (tileSize.empty())
+    {
+        int rowsPerStrip = (int)((1 << 13) / fileStep);
+        readParam(params, IMWRITE_TIFF_ROWSPERSTRIP, rowsPerStrip);
+        rowsPerStrip = std::max(1, std::min(height, rowsPerStrip));
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, rowsPerStrip));
+    }
+    else
+    {
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_TILEWIDTH, tileSize.width));
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_TILELENGTH, tileSize.height));
+    }
+
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, sample_format));
+
+    if (compression == COMPRESSION_LZW || compression == COMPRESSION_ADOBE_DEFLATE || compression == COMPRESSION_DEFLATE)
+    {
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PREDICTOR, predictor));
+    }
+
+    if (resUnit >= RESUNIT_NONE && resUnit <= RESUNIT_CENTIMETER)
+    {
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_RESOLUTIONUNIT, resUnit));
+    }
+    if (dpiX >= 0)
+    {
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_XRESOLUTION, (float)dpiX));
+    }
+    if (dpiY >= 0)
+    {
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_YRESOLUTION, (float)dpiY));
+    }
+    return true;
+}
+
+/** Converts BGR(A) pixels to the RGB(A) order of the file */
+static void convertToFile(const Mat& src, const Mat& dst)
+{
+    switch (src.channels())
+    {
+        case 1:
+        {
+            src.copyTo(dst);
+            break;
+        }
+
+        case 3:
+        {
+            extend_cvtColor(src, dst, COLOR_BGR2RGB);
+            break;
+        }
+
+        case 4:
+        {
+            extend_cvtColor(src, dst, COLOR_BGRA2RGBA);
+            break;
+        }
+
+        default:
+        {
+            CV_Assert(0);
+        }
+    }
+}
+
+/** Destination of libtiff output which keeps the data written since the last reset.
+    Strips are appended to the end of file, so the data of a strip is captured */
+class TiffStripSink
+{
+public:
+    TiffStripSink() : m_pos(0), m_size(0) {}
+
+    TIFF* open()
+    {
+        return TIFFClientOpen( "", "w", reinterpret_cast<thandle_t>(this), &TiffStripSink::read,
+                               &TiffStripSink::write, &TiffStripSink::seek,
+                               &TiffStripSink::close, &TiffStripSink::size,
+                               /*map=*/0, /*unmap=*/0 );
+    }
+
+    static tmsize_t read( thandle_t /*handle*/, void* /*buffer*/, tmsize_t /*n*/ )
+    {
+        return 0;
+    }
+
+    static tmsize_t write( thandle_t handle, void* buffer, tmsize_t n )
+    {
+        TiffStripSink *sink = reinterpret_cast<TiffStripSink*>(handle);
+        const uchar* data = (const uchar*)buffer;
+        sink->data.insert(sink->data.end(), data, data + n);
+        sink->m_pos += n;
+        sink->m_size = std::max(sink->m_size, sink->m_pos);
+        return n;
+    }
+
+    static toff_t seek( thandle_t handle, toff_t offset, int whence )
+    {
+        TiffStripSink *sink = reinterpret_cast<TiffStripSink*>(handle);
+        switch (whence)
+        {
+            case SEEK_SET:
+                sink->m_pos = offset;
+                break;
+            case SEEK_CUR:
+                sink->m_pos += offset;
+                break;
+            case SEEK_END:
+                sink->m_pos = sink->m_size + offset;
+                break;
+        }
+        return sink->m_pos;
+    }
+
+    static toff_t size( thandle_t handle )
+    {
+        return reinterpret_cast<TiffStripSink*>(handle)->m_size;
+    }
+
+    static int close( thandle_t /*handle*/ )
+    {
+        return 0;
+    }
+
+    std::vector<uchar> data;
+
+private:
+    toff_t m_pos;
+    toff_t m_size;
+};
+
+static bool isParallelCompression(int compression)
+{
+    // codecs without tables shared by strips
+    return compression == COMPRESSION_LZW || compression == COMPRESSION_ADOBE_DEFLATE ||
+           compression == COMPRESSION_DEFLATE || compression == COMPRESSION_PACKBITS;
+}
+
+/** Compresses strips of the page by the threads of parallel_for_ and writes them in order */
+static void writeStripsParallel(TIFF* tif, const Mat& img, const std::vector<int>& params, int rowsPerStrip)
+{
+    const int nstrips = (img.rows + rowsPerStrip - 1) / rowsPerStrip;
+    const size_t stripSize = (size_t)rowsPerStrip * img.cols * img.elemSize();
+    const int nthreads = std::max(getNumThreads(), 1);
+    // the compressed data of a batch is kept in memory
+    const int stripsPerBatch = std::min(nstrips, std::max(nthreads * 4, (int)(((size_t)64 << 20) / stripSize)));
+    std::vector<std::vector<uchar> > strips(stripsPerBatch);
+
+    for (int batch = 0; batch < nstrips; batch += stripsPerBatch)
+    {
+        const int count = std::min(stripsPerBatch, nstrips - batch);
+        parallel_for_(Range(batch, batch + count), [&](const Range& range)
+        {
+            // each thread compresses the strips by its own handle with the same tags
+            TiffStripSink sink;
+            TIFF* stripTif = sink.open();
+            CV_Assert(stripTif);
+            cv::Ptr<void> tif_cleanup(stripTif, cv_tiffCloseHandle);
+            CV_TIFF_CHECK_CALL(TIFFSetField(stripTif, TIFFTAG_IMAGEWIDTH, img.cols));
+            CV_TIFF_CHECK_CALL(TIFFSetField(stripTif, TIFFTAG_IMAGELENGTH, img.rows));
+            CV_Assert(setPageTags(stripTif, img.size(), img.type(), params, Size()));
+
+            Mat buffer(rowsPerStrip, img.cols, img.type());
+            for (int strip = range.start; strip < range.end; strip++)
+            {
+                const int y = strip * rowsPerStrip, rows = std::min(rowsPerStrip, img.rows - y);
+                const Mat stripBuffer = buffer.rowRange(0, rows);
+                convertToFile(img.rowRange(y, y + rows), stripBuffer);
+                sink.data.clear();
+                CV_TIFF_CHECK_CALL(TIFFWriteEncodedStrip(stripTif, strip, stripBuffer.data, (tmsize_t)(stripBuffer.total() * stripBuffer.elemSize())) != (tmsize_t)-1);
+                strips[strip - batch].swap(sink.data);
+            }
+        }, nthreads * 2);
+
+        for (int i = 0; i < count; i++)
+        {
+            std::vector<uchar>& data = strips[i];
+            CV_TIFF_CHECK_CALL(TIFFWriteRawStrip(tif, batch + i, data.empty() ? NULL : &data[0], (tmsize_t)data.size()) != (tmsize_t)-1);
+            std::vector<uchar>().swap(data);
+        }
+    }
+}
+
+/** Checks whether strips of the stripped page are worth compressing in parallel */
+static bool useParallelStrips(TIFF* tif, const Mat& img, int& rowsPerStrip)
+{
+    uint16_t compression = COMPRESSION_NONE;
+    uint32_t stripRows = 0;
+    CV_TIFF_CHECK_CALL(TIFFGetField(tif, TIFFTAG_COMPRESSION, &compression));
+    CV_TIFF_CHECK_CALL(TIFFGetField(tif, TIFFTAG_ROWSPERSTRIP, &stripRows));
+    rowsPerStrip = (int)stripRows;
+    return isParallelCompression(compression) && getNumThreads() > 1 && rowsPerStrip < img.rows &&
+           img.total() * img.elemSize() >= ((size_t)1 << 20);
+}
+
 bool TiffEncoder::writeLibTiff( const std::vector<Mat>& img_vec, const std::vector<int>& params)
 {
     // do NOT put "wb" as the mode, because the b means "big endian" mode, not "binary" mode.
@@ -1217,17 +1553,6 @@ bool TiffEncoder::writeLibTiff( const std::vector<Mat>& img_vec, const std::vect
     }
     cv::Ptr<void> tif_cleanup(tif, cv_tiffCloseHandle);
 
-    //Settings that matter to all images
-    int compression = COMPRESSION_LZW;
-    int predictor = PREDICTOR_HORIZONTAL;
-    int resUnit = -1, dpiX = -1, dpiY = -1;
-
-    readParam(params, IMWRITE_TIFF_COMPRESSION, compression);
-    readParam(params, IMWRITE_TIFF_PREDICTOR, predictor);
-    readParam(params, IMWRITE_TIFF_RESUNIT, resUnit);
-    readParam(params, IMWRITE_TIFF_XDPI, dpiX);
-    readParam(params, IMWRITE_TIFF_YDPI, dpiY);
-
     //Iterate through each image in the vector and write them out as Tiff directories
     for (size_t page = 0; page < img_vec.size(); page++)
     {
@@ -1257,133 +1582,179 @@ bool TiffEncoder::writeLibTiff( const std::vector<Mat>& img_vec, const std::vect
             continue;
         }
 
-        int page_compression = compression;
+        if (!setPageTags(tif, img.size(), type, params, Size()))
+            return false;
 
-        int bitsPerChannel = -1;
-        uint16_t sample_format = SAMPLEFORMAT_INT;
-        switch (depth)
+        int rowsPerStrip = 0;
+        if (useParallelStrips(tif, img, rowsPerStrip))
         {
-            case CV_8U:
-                sample_format = SAMPLEFORMAT_UINT;
-                /* FALLTHRU */
-            case CV_8S:
-            {
-                bitsPerChannel = 8;
-                break;
-            }
+            writeStripsParallel(tif, img, params, rowsPerStrip);
+            CV_TIFF_CHECK_CALL(TIFFWriteDirectory(tif));
+            continue;
+        }
 
-            case CV_16U:
-                sample_format = SAMPLEFORMAT_UINT;
-                /* FALLTHRU */
-            case CV_16S:
-            {
-                bitsPerChannel = 16;
-                break;
-            }
+        // row buffer, because TIFFWriteScanline modifies the original data!
+        size_t scanlineSize = TIFFScanlineSize(tif);
+        AutoBuffer<uchar> _buffer(scanlineSize + 32);
+        uchar* buffer = _buffer.data(); CV_DbgAssert(buffer);
+        Mat m_buffer(Size(width, 1), CV_MAKETYPE(depth, channels), buffer, (size_t)scanlineSize);
 
-            case CV_32S:
-            {
-                bitsPerChannel = 32;
-                sample_format = SAMPLEFORMAT_INT;
-                break;
-            }
-            case CV_32F:
-            {
-                bitsPerChannel = 32;
-                page_compression = COMPRESSION_NONE;
-                sample_format = SAMPLEFORMAT_IEEEFP;
-                break;
-            }
-            case CV_64F:
-            {
-                bitsPerChannel = 64;
-                page_compression = COMPRESSION_NONE;
-                sample_format = SAMPLEFORMAT_IEEEFP;
-                break;
-            }
-            default:
-            {
-                return false;
-            }
+        for (int y = 0; y < height; ++y)
+        {
+            convertToFile(img(Rect(0, y, width, 1)), m_buffer);
+            CV_TIFF_CHECK_CALL(TIFFWriteScanline(tif, buffer, y, 0) == 1);
         }
 
-        const int bitsPerByte = 8;
-        size_t fileStep = (width * channels * bitsPerChannel) / bitsPerByte;
-        CV_Assert(fileStep > 0);
+        CV_TIFF_CHECK_CALL(TIFFWriteDirectory(tif));
+    }
 
-        int rowsPerStrip = (int)((1 << 13) / fileStep);
-        readParam(params, IMWRITE_TIFF_ROWSPERSTRIP, rowsPerStrip);
-        rowsPerStrip = std::max(1, std::min(height, rowsPerStrip));
+    return true;
+}
 
-        int colorspace = channels > 1 ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK;
+bool TiffEncoder::writeStart(Size size, int type, const std::vector<int>& params)
+{
+    writeFinish();
 
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, bitsPerChannel));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_COMPRESSION, page_compression));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, colorspace));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, channels));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, rowsPerStrip));
+    int channels = CV_MAT_CN(type);
+    int depth = CV_MAT_DEPTH(type);
+    CV_CheckType(type, depth == CV_8U || depth == CV_8S || depth == CV_16U || depth == CV_16S || depth == CV_32S || depth == CV_32F || depth == CV_64F, "");
+    CV_CheckType(type, channels >= 1 && channels <= 4, "");
+    CV_Assert(!size.empty());
 
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, sample_format));
+    int compression_param = -1;
+    if (type == CV_32FC3 && readParam(params, IMWRITE_TIFF_COMPRESSION, compression_param) && compression_param == COMPRESSION_SGILOG)
+    {
+        // the whole image is converted to XYZ by write_32FC3_SGILOG()
+        m_last_error = "SGILOG compression is not supported by streaming encoding";
+        return false;
+    }
 
-        if (page_compression == COMPRESSION_LZW || page_compression == COMPRESSION_ADOBE_DEFLATE || page_compression == COMPRESSION_DEFLATE)
-        {
-            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PREDICTOR, predictor));
-        }
+    Size tileSize;
+    readParam(params, IMWRITE_TIFF_TILEWIDTH, tileSize.width);
+    readParam(params, IMWRITE_TIFF_TILELENGTH, tileSize.height);
+    if (tileSize.width <= 0 || tileSize.height <= 0)
+        tileSize = Size();
+    else if (tileSize.width % 16 != 0 || tileSize.height % 16 != 0)
+        CV_Error(Error::StsBadArg, "TIFF tile size must be a multiple of 16");
 
-        if (resUnit >= RESUNIT_NONE && resUnit <= RESUNIT_CENTIMETER)
-        {
-            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_RESOLUTIONUNIT, resUnit));
-        }
-        if (dpiX >= 0)
-        {
-            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_XRESOLUTION, (float)dpiX));
-        }
-        if (dpiY >= 0)
-        {
-            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_YRESOLUTION, (float)dpiY));
-        }
+    // BigTIFF for images which can exceed 4Gb limit of 32-bit offsets (compression may inflate the data)
+    const uint64 rawSize = (uint64)size.width * size.height * CV_ELEM_SIZE(type);
+    const char* mode = rawSize >= ((uint64)1 << 31) ? "w8" : "w";
 
-        // row buffer, because TIFFWriteScanline modifies the original data!
-        size_t scanlineSize = TIFFScanlineSize(tif);
-        AutoBuffer<uchar> _buffer(scanlineSize + 32);
-        uchar* buffer = _buffer.data(); CV_DbgAssert(buffer);
-        Mat m_buffer(Size(width, 1), CV_MAKETYPE(depth, channels), buffer, (size_t)scanlineSize);
+    TIFF* tif = NULL;
+    if (m_buf)
+    {
+        m_buf_helper = makePtr<TiffEncoderBufHelper>(m_buf);
+        tif = m_buf_helper->open(mode);
+    }
+    else
+    {
+        tif = TIFFOpen(m_filename.c_str(), mode);
+    }
+    if (!tif)
+    {
+        m_buf_helper.release();
+        return false;
+    }
+    m_tif = cv::Ptr<void>(tif, cv_tiffCloseHandle);
 
-        for (int y = 0; y < height; ++y)
-        {
-            switch (channels)
-            {
-                case 1:
-                {
-                    std::memcpy(buffer, img.ptr(y), scanlineSize);
-                    break;
-                }
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, size.width));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGELENGTH, size.height));
+    if (!setPageTags(tif, size, type, params, tileSize))
+    {
+        writeFinish();
+        return false;
+    }
 
-                case 3:
-                {
-                    extend_cvtColor(img(Rect(0, y, width, 1)), (const Mat&)m_buffer, COLOR_BGR2RGB);
-                    break;
-                }
+    m_size = size;
+    m_type = type;
+    m_tile_size = tileSize;
+    m_next_row = 0;
+    if (tileSize.empty())
+        m_file_buffer.create(1, size.width, type);
+    else
+        m_file_buffer.create(tileSize, type);
+    return true;
+}
 
-                case 4:
-                {
-                    extend_cvtColor(img(Rect(0, y, width, 1)), (const Mat&)m_buffer, COLOR_BGRA2RGBA);
-                    break;
-                }
+bool TiffEncoder::writeRows(const Mat& rows)
+{
+    TIFF* tif = (TIFF*)m_tif.get();
+    if (!tif)
+        return false;
+    CV_CheckEQ(rows.cols, m_size.width, "");
+    CV_CheckTypeEQ(rows.type(), m_type, "");
+    CV_CheckLE(m_next_row + rows.rows, m_size.height, "Too many rows");
 
-                default:
-                {
-                    CV_Assert(0);
-                }
+    if (!m_tile_size.empty())
+    {
+        // the rows are collected into a band of tiles
+        if (m_band.empty())
+            m_band.create(m_tile_size.height, m_size.width, m_type);
+        for (int y = 0; y < rows.rows; )
+        {
+            const int bandY = m_next_row - m_next_row % m_tile_size.height;
+            const int bandHeight = std::min(m_tile_size.height, m_size.height - bandY);
+            const int bandRow = m_next_row - bandY;
+            const int count = std::min(rows.rows - y, bandHeight - bandRow);
+            rows.rowRange(y, y + count).copyTo(m_band.rowRange(bandRow, bandRow + count));
+            y += count;
+            m_next_row += count;
+            if (bandRow + count < bandHeight)
+                continue;
+            for (int x = 0; x < m_size.width; x += m_tile_size.width)
+            {
+                const int w = std::min(m_tile_size.width, m_size.width - x);
+                if (!writeTile(m_band(Rect(x, 0, w, bandHeight)), Point(x, bandY)))
+                    return false;
             }
-
-            CV_TIFF_CHECK_CALL(TIFFWriteScanline(tif, buffer, y, 0) == 1);
         }
+        return true;
+    }
 
-        CV_TIFF_CHECK_CALL(TIFFWriteDirectory(tif));
+    for (int y = 0; y < rows.rows; y++, m_next_row++)
+    {
+        // row buffer, because TIFFWriteScanline modifies the original data!
+        convertToFile(rows.row(y), m_file_buffer);
+        CV_TIFF_CHECK_CALL(TIFFWriteScanline(tif, m_file_buffer.data, m_next_row, 0) == 1);
     }
+    return true;
+}
+
+Size TiffEncoder::getTileSize() const
+{
+    return m_tile_size;
+}
 
+bool TiffEncoder::writeTile(const Mat& tile, Point pos)
+{
+    TIFF* tif = (TIFF*)m_tif.get();
+    if (!tif || m_tile_size.empty())
+        return false;
+    CV_CheckTypeEQ(tile.type(), m_type, "");
+    CV_Assert(pos.x >= 0 && pos.y >= 0 && pos.x < m_size.width && pos.y < m_size.height);
+    CV_Assert(pos.x % m_tile_size.width == 0 && pos.y % m_tile_size.height == 0);
+    CV_CheckEQ(tile.cols, std::min(m_tile_size.width, m_size.width - pos.x), "");
+    CV_CheckEQ(tile.rows, std::min(m_tile_size.height, m_size.height - pos.y), "");
+
+    // tiles at the right and bottom borders are padded
+    if (tile.size() != m_tile_size)
+        m_file_buffer.setTo(Scalar::all(0));
+    convertToFile(tile, m_file_buffer(Rect(Point(), tile.size())));
+    CV_TIFF_CHECK_CALL(TIFFWriteTile(tif, m_file_buffer.data, pos.x, pos.y, 0, 0) != (tmsize_t)-1);
+    return true;
+}
+
+bool TiffEncoder::writeFinish()
+{
+    if (!m_tif)
+        return false;
+    Ptr<TiffEncoderBufHelper> buf_helper = m_buf_helper;  // outlives the handle
+    Ptr<void> tif = m_tif;
+    m_tif.release();
+    m_buf_helper.release();
+    m_band.release();
+    CV_TIFF_CHECK_CALL(TIFFWriteDirectory((TIFF*)tif.get()));
     return true;
 }
 
@@ -1425,9 +1796,26 @@ bool  TiffEncoder::write( const Mat& img, const std::vector<int>& params)
 
     CV_CheckType(type, depth == CV_8U || depth == CV_8S || depth == CV_16U || depth == CV_16S || depth == CV_32S || depth == CV_32F || depth == CV_64F, "");
 
-    std::vector<Mat> img_vec;
-    img_vec.push_back(img);
-    return writeLibTiff(img_vec, params);
+    int compression_param = -1;
+    if (type == CV_32FC3 && (!readParam(params, IMWRITE_TIFF_COMPRESSION, compression_param) || compression_param == COMPRESSION_SGILOG))
+    {
+        // SGILOG is not supported by streaming encoding
+        std::vector<Mat> img_vec;
+        img_vec.push_back(img);
+        return writeLibTiff(img_vec, params);
+    }
+
+    if (!writeStart(img.size(), type, params))
+        return false;
+    int rowsPerStrip = 0;
+    if (m_tile_size.empty() && useParallelStrips((TIFF*)m_tif.get(), img, rowsPerStrip))
+        writeStripsParallel((TIFF*)m_tif.get(), img, params, rowsPerStrip);
+    else if (!writeRows(img))
+    {
+        writeFinish();
+        return false;
+    }
+    return writeFinish();
 }
 
 static void extend_cvtColor( InputArray _src, OutputArray _dst, int code )
@@ -98,6 +98,7 @@ public:
 
     bool  readHeader() CV_OVERRIDE;
     bool  readData( Mat& img ) CV_OVERRIDE;
+    bool  setROI( const Rect& roi ) CV_OVERRIDE;
     void  close();
     bool  nextPage() CV_OVERRIDE;
 
@@ -117,6 +118,8 @@ private:
 };
 
 // ... and writer
+class TiffEncoderBufHelper;
+
 class TiffEncoder CV_FINAL : public BaseImageEncoder
 {
 public:
@@ -129,12 +132,28 @@ public:
 
     bool writemulti(const std::vector<Mat>& img_vec, const std::vector<int>& params) CV_OVERRIDE;
 
+    bool writeStart(Size size, int type, const std::vector<int>& params) CV_OVERRIDE;
+    bool writeRows(const Mat& rows) CV_OVERRIDE;
+    Size getTileSize() const CV_OVERRIDE;
+    bool writeTile(const Mat& tile, Point pos) CV_OVERRIDE;
+    bool writeFinish() CV_OVERRIDE;
+
     ImageEncoder newEncoder() const CV_OVERRIDE;
 
 protected:
     bool writeLibTiff( const std::vector<Mat>& img_vec, const std::vector<int>& params );
     bool write_32FC3_SGILOG(const Mat& img, void* tif);
 
+    // state of the streaming encoding
+    Ptr<TiffEncoderBufHelper> m_buf_helper;
+    Ptr<void> m_tif;
+    Size m_size;
+    int m_type;
+    Size m_tile_size;
+    int m_next_row;
+    Mat m_file_buffer; // converted row or tile
+    Mat m_band;   // rows of the current band of tiles
+
 private:
     TiffEncoder(const TiffEncoder &); // copy disabled
     TiffEncoder& operator=(const TiffEncoder &); // assign disabled
@@ -148,12 +148,20 @@ bool WebPDecoder::readHeader()
     return false;
 }
 
+bool WebPDecoder::setROI(const Rect& roi)
+{
+    CV_Assert(roi.x >= 0 && roi.y >= 0 && roi.x + roi.width <= m_width && roi.y + roi.height <= m_height);
+    m_roi = roi == Rect(0, 0, m_width, m_height) ? Rect() : roi;
+    return true;
+}
+
 bool WebPDecoder::readData(Mat &img)
 {
     CV_CheckGE(m_width, 0, ""); CV_CheckGE(m_height, 0, "");
 
-    CV_CheckEQ(img.cols, m_width, "");
-    CV_CheckEQ(img.rows, m_height, "");
+    const Rect roi = m_roi.empty() ? Rect(0, 0, m_width, m_height) : m_roi;
+    CV_CheckEQ(img.cols, roi.width, "");
+    CV_CheckEQ(img.rows, roi.height, "");
 
     if (m_buf.empty())
     {
@@ -165,10 +173,55 @@ bool WebPDecoder::readData(Mat &img)
     }
     CV_Assert(data.type() == CV_8UC1); CV_Assert(data.rows == 1);
 
+    if (!m_roi.empty())
+    {
+        CV_CheckType(img.type(), img.type() == CV_8UC1 || img.type() == CV_8UC3 || img.type() == CV_8UC4, "");
+        // libwebp crops from even coordinates, rows and columns outside of the crop are not decoded
+        const Rect crop(Point(roi.x & ~1, roi.y & ~1), roi.br());
+        const int cn = img.channels() == 1 ? channels : img.channels();
+        Mat crop_img;
+        if (crop == roi && img.channels() != 1)
+            crop_img = img;  // copy header
+        else
+            crop_img.create(crop.size(), CV_8UC(cn));
+
+        WebPDecoderConfig config;
+        CV_Assert(WebPInitDecoderConfig(&config));
+        config.options.use_cropping = 1;
+        config.options.crop_left = crop.x;
+        config.options.crop_top = crop.y;
+        config.options.crop_width = crop.width;
+        config.options.crop_height = crop.height;
+        if (cn == 3)
+            config.output.colorspace = m_use_rgb ? MODE_RGB : MODE_BGR;
+        else
+            config.output.colorspace = m_use_rgb ? MODE_RGBA : MODE_BGRA;
+        config.output.is_external_memory = 1;
+        config.output.u.RGBA.rgba = crop_img.ptr();
+        config.output.u.RGBA.stride = (int)crop_img.step;
+        config.output.u.RGBA.size = crop_img.dataend - crop_img.ptr();
+        const VP8StatusCode status = WebPDecode(data.ptr(), data.total(), &config);
+        WebPFreeDecBuffer(&config.output);
+        if (status != VP8_STATUS_OK)
+            return false;
+
+        const Mat read_img = crop_img(Rect(roi.tl() - crop.tl(), roi.size()));
+        if (read_img.data == img.data)
+        {
+            // nothing
+        }
+        else if (img.channels() == 1)
+            cvtColor(read_img, img, cn == 4 ? COLOR_BGRA2GRAY : COLOR_BGR2GRAY);
+        else
+            read_img.copyTo(img);
+        return true;
+    }
+
     {
         Mat read_img;
         CV_CheckType(img.type(), img.type() == CV_8UC1 || img.type() == CV_8UC3 || img.type() == CV_8UC4, "");
-        if (img.type() != m_type)
+        // libwebp adds or drops alpha itself, so color images are decoded directly into img
+        if (img.channels() == 1)
         {
             read_img.create(m_height, m_width, m_type);
         }
@@ -181,9 +234,8 @@ bool WebPDecoder::readData(Mat &img)
         size_t out_data_size = read_img.dataend - out_data;
 
         uchar *res_ptr = NULL;
-        if (channels == 3)
+        if (read_img.channels() == 3)
         {
-            CV_CheckTypeEQ(read_img.type(), CV_8UC3, "");
             if (m_use_rgb)
                 res_ptr = WebPDecodeRGBInto(data.ptr(), data.total(), out_data,
                                             (int)out_data_size, (int)read_img.step);
@@ -191,7 +243,7 @@ bool WebPDecoder::readData(Mat &img)
                 res_ptr = WebPDecodeBGRInto(data.ptr(), data.total(), out_data,
                                             (int)out_data_size, (int)read_img.step);
         }
-        else if (channels == 4)
+        else
         {
             CV_CheckTypeEQ(read_img.type(), CV_8UC4, "");
             if (m_use_rgb)
@@ -205,25 +257,9 @@ bool WebPDecoder::readData(Mat &img)
         if (res_ptr != out_data)
             return false;
 
-        if (read_img.data == img.data && img.type() == m_type)
-        {
-            // nothing
-        }
-        else if (img.type() == CV_8UC1)
-        {
-            cvtColor(read_img, img, COLOR_BGR2GRAY);
-        }
-        else if (img.type() == CV_8UC3 && m_type == CV_8UC4)
-        {
-            cvtColor(read_img, img, COLOR_BGRA2BGR);
-        }
-        else if (img.type() == CV_8UC4 && m_type == CV_8UC3)
-        {
-            cvtColor(read_img, img, COLOR_BGR2BGRA);
-        }
-        else
+        if (img.channels() == 1)
         {
-            CV_Error(Error::StsInternal, "");
+            cvtColor(read_img, img, read_img.channels() == 4 ? COLOR_BGRA2GRAY : COLOR_BGR2GRAY);
         }
     }
     return true;
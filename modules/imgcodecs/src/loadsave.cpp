@@ -52,6 +52,7 @@
 #include <iostream>
 #include <fstream>
 #include <cerrno>
+#include <atomic>
 #include <opencv2/core/utils/logger.hpp>
 #include <opencv2/core/utils/configuration.private.hpp>
 #include <opencv2/imgcodecs.hpp>
@@ -275,12 +276,17 @@ static ImageDecoder findDecoder( const String& filename ) {
     return ImageDecoder();
 }
 
-static ImageDecoder findDecoder( const Mat& buf )
+/**
+ * Find the decoder of the image in memory
+ *
+ * @return Index of the decoder in the list of registered codecs or -1
+*/
+static int findDecoderIndex( const Mat& buf )
 {
     size_t i, maxlen = 0;
 
     if( buf.rows*buf.cols < 1 || !buf.isContinuous() )
-        return ImageDecoder();
+        return -1;
 
     ImageCodecInitializer& codecs = getCodecs();
     for( i = 0; i < codecs.decoders.size(); i++ )
@@ -297,10 +303,16 @@ static ImageDecoder findDecoder( const Mat& buf )
     for( i = 0; i < codecs.decoders.size(); i++ )
     {
         if( codecs.decoders[i]->checkSignature(signature) )
-            return codecs.decoders[i]->newDecoder();
+            return (int)i;
     }
 
-    return ImageDecoder();
+    return -1;
+}
+
+static ImageDecoder findDecoder( const Mat& buf )
+{
+    const int idx = findDecoderIndex(buf);
+    return idx >= 0 ? getCodecs().decoders[idx]->newDecoder() : ImageDecoder();
 }
 
 static ImageEncoder findEncoder( const String& _ext )
@@ -344,6 +356,21 @@ static ImageEncoder findEncoder( const String& _ext )
 }
 
 
+/** Returns the scale factor requested by IMREAD_REDUCED_* flags */
+static int getScaleDenom(int flags)
+{
+    if( flags > IMREAD_LOAD_GDAL )
+    {
+        if( flags & IMREAD_REDUCED_GRAYSCALE_2 )
+            return 2;
+        else if( flags & IMREAD_REDUCED_GRAYSCALE_4 )
+            return 4;
+        else if( flags & IMREAD_REDUCED_GRAYSCALE_8 )
+            return 8;
+    }
+    return 1;
+}
+
 static void ExifTransform(int orientation, OutputArray img)
 {
     switch( orientation )
@@ -421,16 +448,7 @@ imread_( const String& filename, int flags, OutputArray mat )
         return 0;
     }
 
-    int scale_denom = 1;
-    if( flags > IMREAD_LOAD_GDAL )
-    {
-        if( flags & IMREAD_REDUCED_GRAYSCALE_2 )
-            scale_denom = 2;
-        else if( flags & IMREAD_REDUCED_GRAYSCALE_4 )
-            scale_denom = 4;
-        else if( flags & IMREAD_REDUCED_GRAYSCALE_8 )
-            scale_denom = 8;
-    }
+    const int scale_denom = getScaleDenom(flags);
 
     // Try to decode image by RGB instead of BGR.
     if (flags & IMREAD_COLOR_RGB && flags != IMREAD_UNCHANGED)
@@ -468,19 +486,24 @@ imread_( const String& filename, int flags, OutputArray mat )
     // grab the decoded type
     const int type = calcType(decoder->type(), flags);
 
+    // if decoder is JpegDecoder then decoder->setScale always returns 1
+    const bool needResize = decoder->setScale( scale_denom ) > 1;
+    const Size dstSize = needResize ? Size(size.width / scale_denom, size.height / scale_denom) : size;
+
     if (mat.empty())
     {
-        mat.create( size.height, size.width, type );
+        mat.create( dstSize.height, dstSize.width, type );
     }
     else
     {
-        CV_CheckEQ(size, mat.size(), "");
+        // decoders write rows with the step of the matrix, so it may be a ROI of a larger matrix
+        CV_CheckEQ(dstSize, mat.size(), "");
         CV_CheckTypeEQ(type, mat.type(), "");
-        CV_Assert(mat.isContinuous());
     }
 
     // read the image data
-    Mat real_mat = mat.getMat();
+    const bool direct = !needResize && (decoder->isStepSupported() || mat.isContinuous());
+    Mat real_mat = direct ? mat.getMat() : Mat(size, type);
     const void * original_ptr = real_mat.data;
     bool success = false;
     try
@@ -505,9 +528,13 @@ imread_( const String& filename, int flags, OutputArray mat )
         return false;
     }
 
-    if( decoder->setScale( scale_denom ) > 1 ) // if decoder is JpegDecoder then decoder->setScale always returns 1
+    if( needResize )
+    {
+        resize( real_mat, mat, dstSize, 0, 0, INTER_LINEAR_EXACT);
+    }
+    else if( !direct )
     {
-        resize( mat, mat, Size( size.width / scale_denom, size.height / scale_denom ), 0, 0, INTER_LINEAR_EXACT);
+        real_mat.copyTo(mat);
     }
 
     /// optionally rotate the data if EXIF orientation flag says so
@@ -816,8 +843,13 @@ bool imwrite( const String& filename, InputArray _img,
     return imwrite_(filename, img_vec, params, false);
 }
 
+/**
+ * Decodes the image from memory
+ *
+ * @param[in] decoderCache Optional decoder instances to reuse, indexed as the registered codecs
+*/
 static bool
-imdecode_( const Mat& buf, int flags, Mat& mat )
+imdecode_( const Mat& buf, int flags, Mat& mat, std::vector<ImageDecoder>* decoderCache = NULL )
 {
     CV_Assert(!buf.empty());
     CV_Assert(buf.isContinuous());
@@ -826,20 +858,25 @@ imdecode_( const Mat& buf, int flags, Mat& mat )
 
     String filename;
 
-    ImageDecoder decoder = findDecoder(buf_row);
+    ImageDecoder decoder;
+    if( decoderCache )
+    {
+        const int idx = findDecoderIndex(buf_row);
+        if( idx < 0 )
+            return false;
+        decoderCache->resize(getCodecs().decoders.size());
+        ImageDecoder& cached = (*decoderCache)[idx];
+        if( !cached )
+            cached = getCodecs().decoders[idx]->newDecoder();
+        decoder = cached;
+        decoder->setRGB(false);
+    }
+    else
+        decoder = findDecoder(buf_row);
     if( !decoder )
         return false;
 
-    int scale_denom = 1;
-    if( flags > IMREAD_LOAD_GDAL )
-    {
-        if( flags & IMREAD_REDUCED_GRAYSCALE_2 )
-            scale_denom = 2;
-        else if( flags & IMREAD_REDUCED_GRAYSCALE_4 )
-            scale_denom = 4;
-        else if( flags & IMREAD_REDUCED_GRAYSCALE_8 )
-            scale_denom = 8;
-    }
+    const int scale_denom = getScaleDenom(flags);
 
     // Try to decode image by RGB instead of BGR.
     if (flags & IMREAD_COLOR_RGB && flags != IMREAD_UNCHANGED)
@@ -901,12 +938,20 @@ imdecode_( const Mat& buf, int flags, Mat& mat )
 
     const int type = calcType(decoder->type(), flags);
 
-    mat.create( size.height, size.width, type );
+    // if decoder is JpegDecoder then decoder->setScale always returns 1
+    const bool needResize = decoder->setScale( scale_denom ) > 1;
+
+    // decoders write rows with the step of the matrix, so the preallocated output
+    // (including a ROI of a larger matrix) receives the pixels without copies
+    const Mat preallocated = mat;
+    const bool direct = !needResize && (decoder->isStepSupported() || mat.isContinuous());
+    Mat decoded = direct ? mat : Mat();
+    decoded.create( size.height, size.width, type );
 
     success = false;
     try
     {
-        if (decoder->readData(mat))
+        if (decoder->readData(decoded))
             success = true;
     }
     catch (const cv::Exception& e)
@@ -931,15 +976,29 @@ imdecode_( const Mat& buf, int flags, Mat& mat )
         return false;
     }
 
-    if( decoder->setScale( scale_denom ) > 1 ) // if decoder is JpegDecoder then decoder->setScale always returns 1
+    if( needResize )
+    {
+        resize(decoded, mat, Size( size.width / scale_denom, size.height / scale_denom ), 0, 0, INTER_LINEAR_EXACT);
+    }
+    else if (!direct)
     {
-        resize(mat, mat, Size( size.width / scale_denom, size.height / scale_denom ), 0, 0, INTER_LINEAR_EXACT);
+        decoded.copyTo(mat);
+    }
+    else
+    {
+        mat = decoded;
     }
 
     /// optionally rotate the data if EXIF' orientation flag says so
     if (!mat.empty() && (flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED)
     {
         ApplyExifOrientation(decoder->getExifTag(ORIENTATION), mat);
+        if (mat.data != preallocated.data && mat.size() == preallocated.size() && mat.type() == preallocated.type())
+        {
+            // the output was preallocated with the size of the transposed image
+            mat.copyTo(preallocated);
+            mat = preallocated;
+        }
     }
 
     return true;
@@ -969,6 +1028,289 @@ Mat imdecode( InputArray _buf, int flags, Mat* dst )
         return cv::Mat();
 }
 
+/** Decodes a range of images of the batch, decoder instances and buffers are reused within the range */
+class DecodeBatchBody CV_FINAL : public ParallelLoopBody
+{
+public:
+    DecodeBatchBody(const std::vector<Mat>& bufs_, int flags_, std::vector<Mat>* dst_, Mat* tensor_, bool nchw_,
+                    std::atomic<int>& failures_)
+        : bufs(bufs_), flags(flags_), dst(dst_), tensor(tensor_), nchw(nchw_), failures(failures_)
+    {
+        // nothing
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        std::vector<ImageDecoder> decoders;
+        Mat decoded, converted;  // intermediate images of NCHW tensors
+        for (int i = range.start; i < range.end; i++)
+        {
+            bool success = false;
+            try
+            {
+                if (dst)
+                    success = !bufs[i].empty() && imdecode_(bufs[i], flags, (*dst)[i], &decoders);
+                else
+                    success = !bufs[i].empty() && decodeToTensor(i, decoders, decoded, converted);
+            }
+            catch (const cv::Exception& e)
+            {
+                CV_LOG_ERROR(NULL, "imdecodeBatch(" << i << "): " << e.what());
+            }
+            if (success)
+                continue;
+            failures++;
+            if (dst)
+                (*dst)[i].release();
+            else
+                getItem(i).setTo(Scalar::all(0));
+        }
+    }
+
+protected:
+    /** Returns the whole item of the tensor, HxW image of C channels for NHWC */
+    Mat getItem(int i) const
+    {
+        const int* sz = tensor->size.p;
+        return nchw ? Mat(sz[1] * sz[2], sz[3], tensor->type(), tensor->ptr(i))
+                    : Mat(sz[1], sz[2], CV_MAKETYPE(tensor->depth(), sz[3]), tensor->ptr(i));
+    }
+
+    bool decodeToTensor(int i, std::vector<ImageDecoder>& decoders, Mat& decoded, Mat& converted) const
+    {
+        const int* sz = tensor->size.p;
+        const int cn = nchw ? sz[1] : sz[3];
+        const Size size = nchw ? Size(sz[3], sz[2]) : Size(sz[2], sz[1]);
+
+        // items of NHWC tensors of the decoded type receive the pixels directly
+        Mat item = getItem(i);
+        Mat& img = nchw ? decoded : item;
+        const uchar* const data = img.data;
+        if (!imdecode_(bufs[i], flags, img, &decoders))
+            return false;
+        if (img.size() != size || img.channels() != cn)
+        {
+            CV_LOG_ERROR(NULL, "imdecodeBatch(" << i << "): decoded image " << img.size() << " with "
+                         << img.channels() << " channels doesn't match the tensor item " << size << " with " << cn);
+            return false;
+        }
+
+        if (!nchw)
+        {
+            if (img.data != data)  // another type or the image was transformed (reduced, oriented)
+                img.convertTo(getItem(i), tensor->depth());
+            return true;
+        }
+
+        const Mat* src = &decoded;
+        if (decoded.depth() != tensor->depth())
+        {
+            decoded.convertTo(converted, tensor->depth());
+            src = &converted;
+        }
+        std::vector<Mat> planes(cn);
+        for (int c = 0; c < cn; c++)
+            planes[c] = Mat(size, tensor->type(), tensor->ptr(i, c));
+        split(*src, planes.data());
+        return true;
+    }
+
+    const std::vector<Mat>& bufs;
+    const int flags;
+    std::vector<Mat>* const dst;
+    Mat* const tensor;
+    const bool nchw;
+    std::atomic<int>& failures;
+};
+
+static bool imdecodeBatch_(const std::vector<Mat>& bufs, int flags, std::vector<Mat>* dst, Mat* tensor, bool nchw)
+{
+    const int n = (int)bufs.size();
+    std::atomic<int> failures(0);
+    if (n == 0)
+        return true;
+    // several images per stripe to reuse decoders, stripes are balanced by the thread pool
+    const int nstripes = std::min(n, std::max(getNumThreads(), 1) * 4);
+    parallel_for_(Range(0, n), DecodeBatchBody(bufs, flags, dst, tensor, nchw, failures), nstripes);
+    return failures.load() == 0;
+}
+
+bool imdecodeBatch( const std::vector<Mat>& bufs, int flags, std::vector<Mat>& dst )
+{
+    CV_TRACE_FUNCTION();
+
+    dst.resize(bufs.size());
+    return imdecodeBatch_(bufs, flags, &dst, NULL, false);
+}
+
+bool imdecodeBatch( const std::vector<Mat>& bufs, int flags, Mat& tensor, bool nchw )
+{
+    CV_TRACE_FUNCTION();
+
+    CV_CheckEQ(tensor.dims, 4, "4D tensor is expected");
+    CV_CheckEQ(tensor.size[0], (int)bufs.size(), "The tensor must have an item for each buffer");
+    CV_Assert(tensor.isContinuous());
+    const int cn = nchw ? tensor.size[1] : tensor.size[3];
+    CV_CheckLE(cn, CV_CN_MAX, "");
+    CV_CheckEQ(tensor.channels(), 1, "Channels are the dimension of the tensor");
+    return imdecodeBatch_(bufs, flags, NULL, &tensor, nchw);
+}
+
+/**
+ * Decodes a region of the image, the source of the decoder must be set.
+ *
+ * @param[in] decoder Decoder with the source
+ * @param[in] roi Region in coordinates of the full-resolution image
+ * @param[in] flags Flags of cv::imread
+ * @param[out] mat Decoded region
+ * @param[in] name Name of the source for logging
+*/
+static bool
+decodeROI_( ImageDecoder& decoder, const Rect& roi, int flags, Mat& mat, const String& name )
+{
+    const int scale_denom = getScaleDenom(flags);
+    try
+    {
+        if( !decoder->readHeader() )
+            return false;
+    }
+    catch (const cv::Exception& e)
+    {
+        CV_LOG_ERROR(NULL, "decodeROI_('" << name << "'): can't read header: " << e.what());
+        return false;
+    }
+    catch (...)
+    {
+        CV_LOG_ERROR(NULL, "decodeROI_('" << name << "'): can't read header: unknown exception");
+        return false;
+    }
+
+    const Size size = validateInputImageSize(Size(decoder->width(), decoder->height()));
+    const int type = calcType(decoder->type(), flags);
+
+    // JpegDecoder scales natively, its readHeader() reports the reduced size
+    const bool nativeScale = decoder->setScale( scale_denom ) == 1;
+    Rect region;
+    if (nativeScale)
+        region = Rect(Point(roi.x / scale_denom, roi.y / scale_denom),
+                      Point(divUp(roi.x + roi.width, scale_denom), divUp(roi.y + roi.height, scale_denom)));
+    else
+        region = Rect(Point(roi.x / scale_denom * scale_denom, roi.y / scale_denom * scale_denom),
+                      Point(divUp(roi.x + roi.width, scale_denom) * scale_denom,
+                            divUp(roi.y + roi.height, scale_denom) * scale_denom));
+    region &= Rect(Point(), size);
+    if (region.empty())
+        return false;
+
+    bool success = false;
+    try
+    {
+        decoder->setReadExif((flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED);
+        if (decoder->setROI(region))
+        {
+            mat.create(region.size(), type);
+            success = decoder->readData(mat);
+        }
+        else
+        {
+            Mat full(size, type);
+            success = decoder->readData(full);
+            if (success)
+                full(region).copyTo(mat);
+        }
+    }
+    catch (const cv::Exception& e)
+    {
+        CV_LOG_ERROR(NULL, "decodeROI_('" << name << "'): can't read data: " << e.what());
+    }
+    catch (...)
+    {
+        CV_LOG_ERROR(NULL, "decodeROI_('" << name << "'): can't read data: unknown exception");
+    }
+    if (!success)
+        return false;
+
+    if (!nativeScale && scale_denom > 1)
+    {
+        resize(mat, mat, Size(std::max(1, region.width / scale_denom), std::max(1, region.height / scale_denom)),
+               0, 0, INTER_LINEAR_EXACT);
+    }
+
+    if (!mat.empty() && (flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED)
+    {
+        ApplyExifOrientation(decoder->getExifTag(ORIENTATION), mat);
+    }
+
+    return true;
+}
+
+static ImageDecoder prepareDecoder_( ImageDecoder decoder, int flags )
+{
+    if (!decoder)
+        return decoder;
+    if (flags & IMREAD_COLOR_RGB && flags != IMREAD_UNCHANGED)
+        decoder->setRGB(true);
+    decoder->setScale(getScaleDenom(flags));
+    return decoder;
+}
+
+Mat imreadROI( const String& filename, const Rect& roi, int flags )
+{
+    CV_TRACE_FUNCTION();
+    CV_CheckGE(roi.x, 0, ""); CV_CheckGE(roi.y, 0, "");
+    CV_CheckGT(roi.width, 0, ""); CV_CheckGT(roi.height, 0, "");
+
+    Mat img;
+    ImageDecoder decoder = prepareDecoder_(findDecoder(filename), flags);
+    if (!decoder || !decoder->setSource(filename) || !decodeROI_(decoder, roi, flags, img, filename))
+        img.release();
+    return img;
+}
+
+Mat imdecodeROI( InputArray _buf, const Rect& roi, int flags )
+{
+    CV_TRACE_FUNCTION();
+    CV_CheckGE(roi.x, 0, ""); CV_CheckGE(roi.y, 0, "");
+    CV_CheckGT(roi.width, 0, ""); CV_CheckGT(roi.height, 0, "");
+
+    Mat buf = _buf.getMat(), img;
+    CV_Assert(!buf.empty());
+    CV_Assert(buf.isContinuous());
+    CV_Assert(buf.checkVector(1, CV_8U) > 0);
+    Mat buf_row = buf.reshape(1, 1);
+
+    ImageDecoder decoder = prepareDecoder_(findDecoder(buf_row), flags);
+    if (!decoder)
+        return Mat();
+    if (decoder->setSource(buf_row))
+    {
+        if (!decodeROI_(decoder, roi, flags, img, String()))
+            img.release();
+        return img;
+    }
+
+    // the decoder reads files only
+    const String filename = tempfile();
+    FILE* f = fopen( filename.c_str(), "wb" );
+    if( !f )
+        return Mat();
+    const size_t bufSize = buf_row.total()*buf.elemSize();
+    const bool written = fwrite(buf_row.ptr(), 1, bufSize, f) == bufSize;
+    if( fclose(f) != 0 || !written )
+    {
+        remove(filename.c_str());
+        CV_Error( Error::StsError, "failed to write image data to temporary file" );
+    }
+    if (!decoder->setSource(filename) || !decodeROI_(decoder, roi, flags, img, filename))
+        img.release();
+    decoder.release();
+    if (0 != remove(filename.c_str()))
+    {
+        CV_LOG_WARNING(NULL, "unable to remove temporary file: " << filename);
+    }
+    return img;
+}
+
 static bool
 imdecodemulti_(const Mat& buf, int flags, std::vector<Mat>& mats, int start, int count)
 {
@@ -1461,6 +1803,248 @@ ImageCollection::iterator ImageCollection::iterator::operator++(int) {
     return tmp;
 }
 
+/* ImageWriter API */
+
+class ImageWriter::Impl {
+public:
+    Impl() : m_type(-1), m_encoderType(-1), m_nextRow(0), m_bandCovered(0), m_tilesWritten(0) {}
+    ~Impl();
+
+    bool open(const String& filename, Size size, int type, const std::vector<int>& params);
+    bool isOpened() const { return !m_encoder.empty(); }
+    Size getTileSize() const { return isOpened() ? m_tileSize : Size(); }
+    bool write(const Mat& rows);
+    bool writeTile(const Mat& tile, Point pos);
+    bool close();
+
+private:
+    Mat toEncoderType(const Mat& src);
+    void abort();
+
+    ImageEncoder m_encoder;
+    String m_filename;
+    Size m_size;
+    int m_type;
+    int m_encoderType;
+    Size m_tileSize;        // tiles accepted by the encoder
+    int m_nextRow;          // the first row which is not passed to the encoder
+    Mat m_band;             // band of tiles for encoders which accept rows only
+    std::vector<uchar> m_bandMask;  // columns of the band covered by tiles
+    int m_bandCovered;
+    std::vector<uchar> m_tileMask;  // tiles of the grid passed to the encoder
+    int m_tilesWritten;
+};
+
+ImageWriter::Impl::~Impl()
+{
+    if (!isOpened())
+        return;
+    try
+    {
+        abort();
+    }
+    catch (...)
+    {
+        // nothing
+    }
+}
+
+bool ImageWriter::Impl::open(const String& filename, Size size, int type, const std::vector<int>& params)
+{
+    if (isOpened())
+        abort();
+    CV_Assert(!size.empty());
+    const int cn = CV_MAT_CN(type);
+    CV_CheckType(type, cn == 1 || cn == 3 || cn == 4, "");
+    CV_Check(params.size(), (params.size() & 1) == 0, "Encoding 'params' must be key-value pairs");
+    CV_CheckLE(params.size(), (size_t)(CV_IO_MAX_IMAGE_PARAMS*2), "");
+
+    ImageEncoder encoder = findEncoder(filename);
+    if (!encoder)
+        CV_Error(Error::StsError, "could not find a writer for the specified extension");
+
+    int encoderType = type;
+    if (!encoder->isFormatSupported(CV_MAT_DEPTH(type)))
+    {
+        CV_LOG_ONCE_WARNING(NULL, "Unsupported depth image for selected encoder is fallbacked to CV_8U.");
+        CV_Assert(encoder->isFormatSupported(CV_8U));
+        encoderType = CV_MAKETYPE(CV_8U, cn);
+    }
+
+    encoder->setDestination(filename);
+    if (!encoder->writeStart(size, encoderType, params))
+    {
+        CV_LOG_DEBUG(NULL, "ImageWriter('" << filename << "'): can't start streaming encoding");
+        return false;
+    }
+
+    m_encoder = encoder;
+    m_filename = filename;
+    m_size = size;
+    m_type = type;
+    m_encoderType = encoderType;
+    m_tileSize = encoder->getTileSize();
+    m_nextRow = 0;
+    m_bandCovered = 0;
+    m_tilesWritten = 0;
+    if (!m_tileSize.empty())
+        m_tileMask.assign((size_t)divUp(size.width, m_tileSize.width) * divUp(size.height, m_tileSize.height), 0);
+    return true;
+}
+
+Mat ImageWriter::Impl::toEncoderType(const Mat& src)
+{
+    CV_CheckTypeEQ(src.type(), m_type, "");
+    if (m_encoderType == m_type)
+        return src;
+    Mat temp;
+    src.convertTo(temp, m_encoderType);
+    return temp;
+}
+
+bool ImageWriter::Impl::write(const Mat& rows)
+{
+    CV_Assert(isOpened());
+    CV_CheckEQ(rows.cols, m_size.width, "Strip must have the width of the image");
+    CV_CheckLE(m_nextRow + rows.rows, m_size.height, "Too many rows");
+    CV_Assert(m_tilesWritten == 0 && m_bandCovered == 0);
+    if (rows.empty())
+        return true;
+
+    if (!m_encoder->writeRows(toEncoderType(rows)))
+    {
+        abort();
+        return false;
+    }
+    m_nextRow += rows.rows;
+    return true;
+}
+
+bool ImageWriter::Impl::writeTile(const Mat& tile, Point pos)
+{
+    CV_Assert(isOpened());
+    CV_CheckTypeEQ(tile.type(), m_type, "");
+    CV_Assert(Rect(Point(), m_size).contains(pos) && pos.x + tile.cols <= m_size.width && pos.y + tile.rows <= m_size.height);
+    if (tile.empty())
+        return true;
+
+    if (!m_tileSize.empty())
+    {
+        CV_Assert(m_nextRow == 0);
+        CV_Assert(pos.x % m_tileSize.width == 0 && pos.y % m_tileSize.height == 0);
+        uchar& written = m_tileMask[(size_t)(pos.y / m_tileSize.height) * divUp(m_size.width, m_tileSize.width) + pos.x / m_tileSize.width];
+        CV_Assert(!written && "Tiles must not overlap");
+        if (!m_encoder->writeTile(toEncoderType(tile), pos))
+        {
+            abort();
+            return false;
+        }
+        written = 1;
+        m_tilesWritten++;
+        return true;
+    }
+
+    // the encoder accepts rows only, tiles are collected into a band
+    CV_CheckEQ(pos.y, m_nextRow, "Tiles must be written band by band from top to bottom");
+    if (m_bandCovered == 0)
+    {
+        m_band.create(tile.rows, m_size.width, m_encoderType);
+        m_bandMask.assign(m_size.width, 0);
+    }
+    CV_CheckEQ(tile.rows, m_band.rows, "Tiles of a band must have the same height");
+    for (int x = pos.x; x < pos.x + tile.cols; x++)
+    {
+        CV_Assert(!m_bandMask[x] && "Tiles must not overlap");
+        m_bandMask[x] = 1;
+    }
+    toEncoderType(tile).copyTo(m_band(Rect(pos.x, 0, tile.cols, tile.rows)));
+    m_bandCovered += tile.cols;
+
+    if (m_bandCovered == m_size.width)
+    {
+        m_bandCovered = 0;
+        if (!m_encoder->writeRows(m_band))
+        {
+            abort();
+            return false;
+        }
+        m_nextRow += m_band.rows;
+    }
+    return true;
+}
+
+void ImageWriter::Impl::abort()
+{
+    ImageEncoder encoder = m_encoder;
+    m_encoder.release();
+    m_band.release();
+    std::vector<uchar>().swap(m_bandMask);
+    std::vector<uchar>().swap(m_tileMask);
+    encoder->writeFinish();
+    remove(m_filename.c_str());
+}
+
+bool ImageWriter::Impl::close()
+{
+    if (!isOpened())
+        return false;
+    const bool complete = m_nextRow == m_size.height || (!m_tileMask.empty() && m_tilesWritten == (int)m_tileMask.size());
+    if (!complete)
+    {
+        CV_LOG_WARNING(NULL, "ImageWriter('" << m_filename << "'): the image is incomplete");
+        abort();
+        return false;
+    }
+    ImageEncoder encoder = m_encoder;
+    m_encoder.release();
+    m_band.release();
+    std::vector<uchar>().swap(m_tileMask);
+    if (!encoder->writeFinish())
+    {
+        remove(m_filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+ImageWriter::ImageWriter() : pImpl(makePtr<Impl>()) {}
+
+ImageWriter::ImageWriter(const String& filename, Size size, int type, const std::vector<int>& params)
+    : pImpl(makePtr<Impl>())
+{
+    pImpl->open(filename, size, type, params);
+}
+
+ImageWriter::~ImageWriter() {}
+
+bool ImageWriter::open(const String& filename, Size size, int type, const std::vector<int>& params)
+{
+    CV_TRACE_FUNCTION();
+    return pImpl->open(filename, size, type, params);
+}
+
+bool ImageWriter::isOpened() const { return pImpl->isOpened(); }
+
+Size ImageWriter::getTileSize() const { return pImpl->getTileSize(); }
+
+bool ImageWriter::write(InputArray rows)
+{
+    CV_TRACE_FUNCTION();
+    return pImpl->write(rows.getMat());
+}
+
+bool ImageWriter::writeTile(InputArray tile, Point pos)
+{
+    CV_TRACE_FUNCTION();
+    return pImpl->writeTile(tile.getMat(), pos);
+}
+
+bool ImageWriter::close()
+{
+    CV_TRACE_FUNCTION();
+    return pImpl->close();
+}
+
 }
 
 /* End of file. */
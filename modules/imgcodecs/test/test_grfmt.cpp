@@ -506,6 +506,102 @@ TEST(Imgcodecs, imdecode_user_buffer)
     EXPECT_TRUE(result.empty());
 }
 
+typedef testing::TestWithParam<string> Imgcodecs_UserBuffer;
+
+static void checkDecodeIntoROI(const vector<uchar>& buf)
+{
+    const int flags[] = { IMREAD_COLOR, IMREAD_COLOR_RGB, IMREAD_GRAYSCALE, IMREAD_REDUCED_COLOR_2 };
+    for (size_t i = 0; i < sizeof(flags) / sizeof(flags[0]); i++)
+    {
+        SCOPED_TRACE(flags[i]);
+        const Mat ref = imdecode(buf, flags[i]);
+        ASSERT_FALSE(ref.empty());
+
+        Mat big(ref.rows + 10, ref.cols + 20, ref.type(), Scalar::all(77));
+        Mat roi = big(Rect(Point(7, 3), ref.size()));
+        const uchar* ptr = roi.data;
+        Mat result = imdecode(buf, flags[i], &roi);
+        EXPECT_EQ(ptr, roi.data);  // no reallocation
+        EXPECT_EQ(ptr, result.data);
+        EXPECT_EQ(0, cvtest::norm(ref, roi, NORM_INF));
+        roi.setTo(Scalar::all(77));
+        EXPECT_EQ(0, cvtest::norm(big, Mat(big.size(), big.type(), Scalar::all(77)), NORM_INF));  // nothing is written outside
+    }
+}
+
+#if defined(HAVE_PNG) || defined(HAVE_SPNG)
+static void checkDecodeIntoROI_interlacedPng()
+{
+    // 11x9 RGB image with Adam7 interlacing (not written by the encoder), pixel (x, y) is (20*x, 25*y, 200 - 10*(x + y))
+    static const uchar png[] = {
+        0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+        0x00, 0x00, 0x00, 0x0b, 0x00, 0x00, 0x00, 0x09, 0x08, 0x02, 0x00, 0x00, 0x01, 0x1c, 0x01, 0x71,
+        0xec, 0x00, 0x00, 0x00, 0xdb, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x0d, 0xcb, 0x91, 0x16, 0x44,
+        0x31, 0x0c, 0x45, 0xd1, 0xfb, 0x11, 0x95, 0xca, 0x70, 0x39, 0x5c, 0x7e, 0x52, 0x09, 0x97, 0xc3,
+        0xe5, 0x48, 0xa5, 0x1c, 0x0e, 0x97, 0x9f, 0x54, 0xca, 0xc3, 0xf9, 0xac, 0x19, 0x39, 0xb2, 0xd7,
+        0x01, 0x10, 0x1b, 0xfa, 0xaf, 0xee, 0x28, 0x60, 0x6c, 0x70, 0x30, 0x20, 0x9b, 0x45, 0xb7, 0x30,
+        0x0a, 0xae, 0xc2, 0x02, 0x82, 0x22, 0xa6, 0x22, 0x21, 0x15, 0x25, 0x44, 0xa3, 0x46, 0x24, 0x80,
+        0x6e, 0xa1, 0xcd, 0x64, 0x4a, 0xba, 0x49, 0x82, 0xfe, 0xab, 0x5b, 0x71, 0x65, 0x17, 0x75, 0xde,
+        0x5e, 0xc3, 0x0b, 0x12, 0xbe, 0x15, 0xaf, 0xfc, 0x05, 0xeb, 0x62, 0x20, 0xd1, 0x5b, 0xc9, 0x85,
+        0x96, 0xd1, 0xb8, 0xd4, 0x91, 0xc4, 0xab, 0x2c, 0x91, 0x61, 0xd2, 0xaf, 0x3c, 0x48, 0xbe, 0xaa,
+        0x0f, 0xf1, 0x6e, 0xfe, 0x5c, 0x27, 0xa4, 0x18, 0x35, 0xba, 0xc4, 0x63, 0x41, 0x37, 0x3e, 0x40,
+        0xfe, 0xa6, 0x7c, 0x4b, 0x7e, 0x6b, 0xde, 0x9c, 0x5d, 0xb2, 0x69, 0x5e, 0x96, 0x75, 0xe7, 0x71,
+        0xb3, 0x44, 0xee, 0x40, 0x7b, 0x53, 0xdb, 0xa5, 0x79, 0x6d, 0xc6, 0x6d, 0x49, 0x53, 0x6d, 0xc3,
+        0x9a, 0xec, 0xd6, 0x6f, 0xe3, 0x68, 0x0f, 0x30, 0x3d, 0x4d, 0x2b, 0x73, 0xd5, 0xa9, 0x3c, 0x87,
+        0x4c, 0xd1, 0xd9, 0x6d, 0xf2, 0x9e, 0xcf, 0x9d, 0x35, 0x26, 0x01, 0x67, 0xa5, 0xa3, 0xe5, 0x8c,
+        0x7a, 0x84, 0x4f, 0x97, 0xc3, 0x7a, 0x1e, 0x3b, 0x75, 0x1f, 0xba, 0xa7, 0xc4, 0xf9, 0xfc, 0x00,
+        0xd8, 0x00, 0x77, 0xe3, 0x09, 0xf8, 0xb3, 0x73, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44,
+        0xae, 0x42, 0x60, 0x82
+    };
+    const vector<uchar> buf(png, png + sizeof(png));
+    Mat expected(9, 11, CV_8UC3);
+    for (int y = 0; y < expected.rows; y++)
+        for (int x = 0; x < expected.cols; x++)
+            expected.at<Vec3b>(y, x) = Vec3b((uchar)(200 - 10*(x + y)), (uchar)(25*y), (uchar)(20*x));
+    EXPECT_EQ(0, cvtest::norm(expected, imdecode(buf, IMREAD_COLOR), NORM_INF));
+    checkDecodeIntoROI(buf);
+}
+#endif
+
+TEST_P(Imgcodecs_UserBuffer, imdecode_into_roi)
+{
+    const string ext = GetParam();
+    Mat src(37, 53, CV_8UC3);
+    randu(src, Scalar::all(0), Scalar::all(255));
+    vector<uchar> buf;
+    ASSERT_TRUE(imencode(ext, src, buf));
+    checkDecodeIntoROI(buf);
+#if defined(HAVE_PNG) || defined(HAVE_SPNG)
+    if (ext == ".png")
+    {
+        SCOPED_TRACE("interlaced");
+        checkDecodeIntoROI_interlacedPng();
+    }
+#endif
+}
+
+const string user_buffer_exts[] =
+{
+#ifdef HAVE_JPEG
+    ".jpg",
+#endif
+#if defined(HAVE_PNG) || defined(HAVE_SPNG)
+    ".png",
+#endif
+#ifdef HAVE_TIFF
+    ".tiff",
+#endif
+#ifdef HAVE_WEBP
+    ".webp",
+#endif
+    ".bmp",
+#ifdef HAVE_IMGCODEC_PXM
+    ".ppm",
+#endif
+};
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgcodecs_UserBuffer, testing::ValuesIn(user_buffer_exts));
+
 }} // namespace
 
 #if defined(HAVE_OPENEXR) && defined(OPENCV_IMGCODECS_ENABLE_OPENEXR_TESTS)
@@ -378,6 +378,21 @@ INSTANTIATE_TEST_CASE_P( /* nothing */,
                             testing::Values(70, 95, 100),    // IMWRITE_JPEG_LUMA_QUALITY
                             testing::Values(70, 95, 100) )); // IMWRITE_JPEG_CHROMA_QUALITY
 
+TEST(Imgcodecs_Jpeg, encode_speed_preset)
+{
+    Mat src(240, 320, CV_8UC3);
+    randu(src, Scalar::all(0), Scalar::all(255));
+    GaussianBlur(src, src, Size(5, 5), 0);
+    vector<uchar> def, smallest, fastest;
+    ASSERT_TRUE(imencode(".jpg", src, def));
+    ASSERT_TRUE(imencode(".jpg", src, smallest, { IMWRITE_SPEED_PRESET, IMWRITE_SPEED_PRESET_SMALLEST }));
+    ASSERT_TRUE(imencode(".jpg", src, fastest, { IMWRITE_SPEED_PRESET, IMWRITE_SPEED_PRESET_FASTEST }));
+    EXPECT_LT(smallest.size(), def.size());
+    // optimized Huffman tables don't change the image
+    EXPECT_EQ(0, cvtest::norm(imdecode(def, IMREAD_COLOR), imdecode(smallest, IMREAD_COLOR), NORM_INF));
+    EXPECT_GT(cvtest::PSNR(src, imdecode(fastest, IMREAD_COLOR)), 30);
+}
+
 #endif // HAVE_JPEG
 
 }} // namespace
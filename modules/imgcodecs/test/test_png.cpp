@@ -202,6 +202,63 @@ const string exif_files[] =
 INSTANTIATE_TEST_CASE_P(ExifFiles, Imgcodecs_PNG_Exif,
     testing::ValuesIn(exif_files));
 
+#ifdef OPENCV_IMGCODECS_PNG_WITH_EXIF
+static uint32_t pngCRC(const uchar* data, size_t size)
+{
+    uint32_t crc = 0xffffffff;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        for (int k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+    }
+    return crc ^ 0xffffffff;
+}
+
+static void putBigEndian32(std::vector<uchar>& buf, uint32_t v)
+{
+    buf.push_back((uchar)(v >> 24)); buf.push_back((uchar)(v >> 16));
+    buf.push_back((uchar)(v >> 8)); buf.push_back((uchar)v);
+}
+
+// eXIf chunk after image data is read by png_read_end() only
+TEST(Imgcodecs_Png, imdecodeROI_exif_after_IDAT)
+{
+    Mat src(48, 64, CV_8UC3);
+    randu(src, Scalar::all(0), Scalar::all(255));
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode(".png", src, buf));
+    ASSERT_GT(buf.size(), 12u);
+
+    // Exif: big-endian TIFF header, IFD with Orientation = 3 (rotated by 180 degrees)
+    const uchar exif[] = { 'M', 'M', 0, 42, 0, 0, 0, 8, 0, 1,
+                           0x01, 0x12, 0, 3, 0, 0, 0, 1, 0, 3, 0, 0,
+                           0, 0, 0, 0 };
+    std::vector<uchar> chunk;
+    putBigEndian32(chunk, (uint32_t)sizeof(exif));
+    const char name[] = "eXIf";
+    chunk.insert(chunk.end(), name, name + 4);
+    chunk.insert(chunk.end(), exif, exif + sizeof(exif));
+    putBigEndian32(chunk, pngCRC(&chunk[4], chunk.size() - 4));
+    buf.insert(buf.end() - 12, chunk.begin(), chunk.end());  // before IEND
+
+    Mat full = imdecode(buf, IMREAD_COLOR);
+    Mat rotated;
+    cv::rotate(src, rotated, ROTATE_180);
+    ASSERT_EQ(0, cvtest::norm(rotated, full, NORM_INF));
+
+    // the region is in coordinates of the stored image, the orientation is applied to the decoded region
+    const Rect roi(8, 4, 32, 20);
+    Mat dst = imdecodeROI(buf, roi, IMREAD_COLOR);
+    cv::rotate(src(roi), rotated, ROTATE_180);
+    EXPECT_EQ(0, cvtest::norm(rotated, dst, NORM_INF));
+
+    // decoding stops after the region if the orientation is not needed
+    dst = imdecodeROI(buf, roi, IMREAD_COLOR | IMREAD_IGNORE_ORIENTATION);
+    EXPECT_EQ(0, cvtest::norm(src(roi), dst, NORM_INF));
+}
+#endif
+
 
 typedef testing::TestWithParam<string> Imgcodecs_Png_PngSuite;
 
@@ -421,6 +478,91 @@ const string pngsuite_files_corrupted[] = {
 INSTANTIATE_TEST_CASE_P(/*nothing*/, Imgcodecs_Png_PngSuite_Corrupted,
                         testing::ValuesIn(pngsuite_files_corrupted));
 
+typedef testing::TestWithParam<tuple<perf::MatType, int, int> > Imgcodecs_Png_Parallel;
+
+TEST_P(Imgcodecs_Png_Parallel, encode_big)
+{
+    const int type = get<0>(GetParam());
+    const int key = get<1>(GetParam()), value = get<2>(GetParam());
+    // with speed preset, 1Mb and more is compressed by chunks of rows
+    Mat img(700, 600, type);
+    RNG& rng = theRNG();
+    rng.fill(img(Rect(0, 0, 600, 350)), RNG::UNIFORM, 0, CV_MAT_DEPTH(type) == CV_8U ? 256 : 65536);
+    img(Rect(0, 350, 600, 350)).setTo(Scalar(7, 77, 177, 255));
+    std::vector<int> params;
+    if (key != IMWRITE_SPEED_PRESET)
+    {
+        // format-specific parameters take precedence
+        params.push_back(IMWRITE_SPEED_PRESET);
+        params.push_back(IMWRITE_SPEED_PRESET_FASTEST);
+    }
+    if (key >= 0)
+    {
+        params.push_back(key);
+        params.push_back(value);
+    }
+
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode(".png", img, buf, params));
+    EXPECT_EQ(0, cvtest::norm(img, imdecode(buf, IMREAD_UNCHANGED), NORM_INF));
+
+    // the result doesn't depend on the number of threads
+    const int threads = getNumThreads();
+    setNumThreads(1);
+    std::vector<uchar> buf1;
+    EXPECT_TRUE(imencode(".png", img, buf1, params));
+    setNumThreads(threads);
+    EXPECT_TRUE(buf == buf1);
+
+    // streaming encoding
+    const string fname = cv::tempfile(".png");
+    ImageWriter writer(fname, img.size(), img.type(), params);
+    ASSERT_TRUE(writer.isOpened());
+    for (int y = 0; y < img.rows; y += 123)
+        ASSERT_TRUE(writer.write(img.rowRange(y, std::min(y + 123, img.rows))));
+    ASSERT_TRUE(writer.close());
+    EXPECT_EQ(0, cvtest::norm(img, imread(fname, IMREAD_UNCHANGED), NORM_INF));
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgcodecs_Png_Parallel, testing::Values(
+    make_tuple(perf::MatType(CV_8UC3), -1, 0),
+    make_tuple(perf::MatType(CV_8UC4), IMWRITE_SPEED_PRESET, IMWRITE_SPEED_PRESET_FAST),
+    make_tuple(perf::MatType(CV_8UC3), IMWRITE_SPEED_PRESET, IMWRITE_SPEED_PRESET_BALANCED),
+    make_tuple(perf::MatType(CV_16UC3), IMWRITE_SPEED_PRESET, IMWRITE_SPEED_PRESET_SMALLEST),
+    make_tuple(perf::MatType(CV_16UC1), IMWRITE_PNG_COMPRESSION, 9),
+    make_tuple(perf::MatType(CV_8UC1), IMWRITE_PNG_STRATEGY, IMWRITE_PNG_STRATEGY_HUFFMAN_ONLY)
+));
+
+TEST(Imgcodecs_Png, speed_preset_size)
+{
+    Mat img(400, 400, CV_8UC3);
+    randu(img, Scalar::all(0), Scalar::all(255));
+    GaussianBlur(img, img, Size(0, 0), 5);
+    size_t sizes[4] = {};
+    for (int preset = IMWRITE_SPEED_PRESET_FASTEST; preset <= IMWRITE_SPEED_PRESET_SMALLEST; preset++)
+    {
+        std::vector<uchar> buf;
+        ASSERT_TRUE(imencode(".png", img, buf, { IMWRITE_SPEED_PRESET, preset }));
+        EXPECT_EQ(0, cvtest::norm(img, imdecode(buf, IMREAD_UNCHANGED), NORM_INF));
+        sizes[preset] = buf.size();
+    }
+    EXPECT_LE(sizes[IMWRITE_SPEED_PRESET_SMALLEST], sizes[IMWRITE_SPEED_PRESET_BALANCED]);
+    EXPECT_LE(sizes[IMWRITE_SPEED_PRESET_BALANCED], sizes[IMWRITE_SPEED_PRESET_FAST]);
+    EXPECT_LE(sizes[IMWRITE_SPEED_PRESET_FAST], sizes[IMWRITE_SPEED_PRESET_FASTEST]);
+}
+
+TEST(Imgcodecs_Png, encode_big_bilevel)
+{
+    Mat img(3000, 3000, CV_8UC1, Scalar::all(0));
+    randu(img(Rect(0, 0, 3000, 1000)), Scalar::all(0), Scalar::all(2));
+    circle(img, Point(1500, 2000), 700, Scalar::all(1), FILLED);
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode(".png", img, buf, { IMWRITE_PNG_BILEVEL, 1, IMWRITE_SPEED_PRESET, IMWRITE_SPEED_PRESET_FAST }));
+    Mat dst = imdecode(buf, IMREAD_GRAYSCALE);
+    EXPECT_EQ(0, cvtest::norm(img * 255, dst, NORM_INF));
+}
+
 #endif // HAVE_PNG
 
 }} // namespace
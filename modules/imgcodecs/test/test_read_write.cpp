@@ -612,4 +612,294 @@ TEST(Imgcodecs_Params, imencode_regression_22752)
     EXPECT_ANY_THROW(cv::imencode("test.jpg", img, buf, params));  // parameters size or missing JPEG codec
 }
 
+typedef testing::TestWithParam<string> Imgcodecs_ROI;
+
+TEST_P(Imgcodecs_ROI, imdecodeROI)
+{
+    const string ext = GetParam();
+    Mat small(60, 80, CV_8UC3), src;
+    randu(small, Scalar::all(0), Scalar::all(255));
+    resize(small, src, Size(317, 241), 0, 0, INTER_LINEAR);
+    vector<int> params;
+    if (ext == ".tiff")
+    {
+        params.push_back(IMWRITE_TIFF_ROWSPERSTRIP);
+        params.push_back(16);
+    }
+    vector<uchar> buf;
+    ASSERT_TRUE(imencode(ext, src, buf, params));
+    const Mat full = imdecode(buf, IMREAD_COLOR);
+    ASSERT_FALSE(full.empty());
+
+    const Rect rois[] = { Rect(0, 0, 317, 241), Rect(0, 0, 16, 8), Rect(37, 45, 101, 77),
+                          Rect(64, 128, 64, 64), Rect(300, 230, 17, 11), Rect(250, 200, 100, 100) };
+    for (size_t i = 0; i < sizeof(rois) / sizeof(rois[0]); i++)
+    {
+        SCOPED_TRACE(rois[i]);
+        const Rect roi = rois[i] & Rect(Point(), full.size());
+        Mat dst;
+        ASSERT_NO_THROW(dst = imdecodeROI(buf, rois[i], IMREAD_COLOR));
+        ASSERT_EQ(roi.size(), dst.size());
+        EXPECT_EQ(0, cvtest::norm(full(roi), dst, NORM_INF));
+    }
+    EXPECT_TRUE(imdecodeROI(buf, Rect(400, 0, 10, 10), IMREAD_COLOR).empty());
+    EXPECT_ANY_THROW(imdecodeROI(buf, Rect(10, 10, 0, 10), IMREAD_COLOR));
+}
+
+TEST_P(Imgcodecs_ROI, imreadROI_reduced)
+{
+    const string ext = GetParam();
+    Mat small(60, 80, CV_8UC3), src;
+    randu(small, Scalar::all(0), Scalar::all(255));
+    resize(small, src, Size(320, 240), 0, 0, INTER_LINEAR);
+    const string filename = cv::tempfile(ext.c_str());
+    ASSERT_TRUE(imwrite(filename, src));
+
+    const int flags[] = { IMREAD_REDUCED_COLOR_2, IMREAD_REDUCED_GRAYSCALE_4, IMREAD_REDUCED_COLOR_8 };
+    for (size_t i = 0; i < sizeof(flags) / sizeof(flags[0]); i++)
+    {
+        SCOPED_TRACE(flags[i]);
+        const int scale = flags[i] == IMREAD_REDUCED_COLOR_2 ? 2 : flags[i] == IMREAD_REDUCED_GRAYSCALE_4 ? 4 : 8;
+        const Mat full = imread(filename, flags[i]);
+        ASSERT_FALSE(full.empty());
+        const Rect roi(64, 32, 128, 96);
+        Mat dst;
+        ASSERT_NO_THROW(dst = imreadROI(filename, roi, flags[i]));
+        const Rect expected(roi.x / scale, roi.y / scale, roi.width / scale, roi.height / scale);
+        ASSERT_EQ(expected.size(), dst.size());
+        EXPECT_EQ(full.type(), dst.type());
+        EXPECT_EQ(0, cvtest::norm(full(expected), dst, NORM_INF));
+    }
+    EXPECT_EQ(0, remove(filename.c_str()));
+}
+
+const string roi_exts[] =
+{
+#ifdef HAVE_JPEG
+    ".jpg",
+#endif
+#if defined(HAVE_PNG) || defined(HAVE_SPNG)
+    ".png",
+#endif
+#ifdef HAVE_TIFF
+    ".tiff",
+#endif
+#ifdef HAVE_WEBP
+    ".webp",
+#endif
+    ".bmp",
+};
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgcodecs_ROI, testing::ValuesIn(roi_exts));
+
+TEST(Imgcodecs_Batch, imdecodeBatch)
+{
+    const string batch_exts[] = { ".png", ".jpg", ".bmp" };
+    vector<Mat> bufs;
+    vector<Mat> expected;
+    for (int i = 0; i < 24; i++)
+    {
+        const string ext = batch_exts[i % 3];
+        if (!haveImageWriter(ext))
+            continue;
+        Mat img(48 + i, 64, CV_8UC3);
+        randu(img, Scalar::all(0), Scalar::all(255));
+        vector<uchar> buf;
+        ASSERT_TRUE(imencode(ext, img, buf));
+        bufs.push_back(Mat(buf, true));
+        expected.push_back(imdecode(buf, IMREAD_COLOR));
+    }
+    bufs.push_back(Mat(1, 16, CV_8UC1, Scalar::all(7)));  // not an image
+
+    vector<Mat> dst;
+    EXPECT_FALSE(imdecodeBatch(bufs, IMREAD_COLOR, dst));
+    ASSERT_EQ(bufs.size(), dst.size());
+    EXPECT_TRUE(dst.back().empty());
+    vector<const uchar*> data;
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        EXPECT_EQ(0, cvtest::norm(expected[i], dst[i], NORM_INF)) << i;
+        data.push_back(dst[i].data);
+    }
+
+    // output buffers are reused
+    bufs.pop_back();
+    EXPECT_TRUE(imdecodeBatch(bufs, IMREAD_COLOR, dst));
+    ASSERT_EQ(bufs.size(), dst.size());
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        EXPECT_EQ(data[i], dst[i].data) << i;
+        EXPECT_EQ(0, cvtest::norm(expected[i], dst[i], NORM_INF)) << i;
+    }
+}
+
+TEST(Imgcodecs_Batch, imdecodeBatch_tensor)
+{
+    const int N = 10;
+    vector<Mat> bufs, expected;
+    for (int i = 0; i < N; i++)
+    {
+        Mat img(24, 32, CV_8UC3);
+        randu(img, Scalar::all(0), Scalar::all(255));
+        vector<uchar> buf;
+        ASSERT_TRUE(imencode(".bmp", img, buf));
+        bufs.push_back(Mat(buf, true));
+        expected.push_back(img);
+    }
+    bufs[3] = Mat(1, 16, CV_8UC1, Scalar::all(7));
+
+    {
+        const int sz[] = { N, 24, 32, 3 };
+        Mat tensor(4, sz, CV_8U, Scalar::all(255));
+        EXPECT_FALSE(imdecodeBatch(bufs, IMREAD_COLOR, tensor, false));
+        for (int i = 0; i < N; i++)
+        {
+            const Mat item(24, 32, CV_8UC3, tensor.ptr(i));
+            EXPECT_EQ(0, cvtest::norm(i == 3 ? Mat::zeros(24, 32, CV_8UC3) : expected[i], item, NORM_INF)) << i;
+        }
+    }
+    {
+        const int sz[] = { N, 3, 24, 32 };
+        Mat tensor(4, sz, CV_32F, Scalar::all(-1));
+        EXPECT_FALSE(imdecodeBatch(bufs, IMREAD_COLOR, tensor, true));
+        for (int i = 0; i < N; i++)
+        {
+            if (i == 3)
+                continue;
+            vector<Mat> planes;
+            split(expected[i], planes);
+            for (int c = 0; c < 3; c++)
+            {
+                Mat plane;
+                planes[c].convertTo(plane, CV_32F);
+                EXPECT_EQ(0, cvtest::norm(plane, Mat(24, 32, CV_32F, tensor.ptr<float>(i, c)), NORM_INF)) << i;
+            }
+        }
+        EXPECT_EQ(0, countNonZero(Mat(3 * 24, 32, CV_32F, tensor.ptr<float>(3))));
+    }
+    {
+        const int sz[] = { N, 24, 30, 3 };  // size mismatch
+        Mat tensor(4, sz, CV_8U);
+        EXPECT_FALSE(imdecodeBatch(bufs, IMREAD_COLOR, tensor, false));
+        EXPECT_EQ(0, countNonZero(tensor.reshape(1, N)));
+    }
+}
+
+typedef testing::TestWithParam<string> Imgcodecs_ImageWriter;
+
+TEST_P(Imgcodecs_ImageWriter, strips_and_tiles)
+{
+    const string ext = GetParam();
+    Mat img(157, 203, CV_8UC3);
+    randu(img, Scalar::all(0), Scalar::all(255));
+    const string ref_name = cv::tempfile(ext.c_str());
+    ASSERT_TRUE(imwrite(ref_name, img));
+    const Mat expected = imread(ref_name);
+    EXPECT_EQ(0, remove(ref_name.c_str()));
+    ASSERT_FALSE(expected.empty());
+
+    const string fname = cv::tempfile(ext.c_str());
+    {
+        ImageWriter writer(fname, img.size(), img.type());
+        ASSERT_TRUE(writer.isOpened());
+        EXPECT_TRUE(writer.getTileSize().empty());
+        for (int y = 0; y < img.rows; y += 17)
+            ASSERT_TRUE(writer.write(img.rowRange(y, std::min(y + 17, img.rows))));
+        EXPECT_TRUE(writer.close());
+        EXPECT_EQ(0, cvtest::norm(expected, imread(fname), NORM_INF));
+    }
+    {
+        // tiles are collected into bands, right to left within a band
+        ImageWriter writer(fname, img.size(), img.type());
+        ASSERT_TRUE(writer.isOpened());
+        for (int y = 0; y < img.rows; y += 32)
+            for (int x = (img.cols - 1) / 48 * 48; x >= 0; x -= 48)
+            {
+                const Rect r = Rect(x, y, 48, 32) & Rect(Point(), img.size());
+                ASSERT_TRUE(writer.writeTile(img(r), r.tl()));
+            }
+        EXPECT_TRUE(writer.close());
+        EXPECT_EQ(0, cvtest::norm(expected, imread(fname), NORM_INF));
+    }
+    {
+        // incomplete image is not kept
+        ImageWriter writer(fname, img.size(), img.type());
+        ASSERT_TRUE(writer.write(img.rowRange(0, 10)));
+        EXPECT_FALSE(writer.close());
+        EXPECT_FALSE(writer.isOpened());
+        EXPECT_TRUE(imread(fname).empty());
+    }
+    remove(fname.c_str());
+}
+
+const string writer_exts[] = {
+#ifdef HAVE_JPEG
+    ".jpg",
+#endif
+#ifdef HAVE_PNG
+    ".png",
+#endif
+#ifdef HAVE_TIFF
+    ".tiff",
+#endif
+};
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgcodecs_ImageWriter, testing::ValuesIn(writer_exts));
+
+#ifdef HAVE_TIFF
+TEST(Imgcodecs_ImageWriterTIFF, tiled)
+{
+    Mat img(150, 100, CV_16UC4);
+    randu(img, Scalar::all(0), Scalar::all(65535));
+    const std::vector<int> params = { IMWRITE_TIFF_TILEWIDTH, 32, IMWRITE_TIFF_TILELENGTH, 48 };
+    const string fname = cv::tempfile(".tiff");
+    {
+        ImageWriter writer(fname, img.size(), img.type(), params);
+        ASSERT_TRUE(writer.isOpened());
+        ASSERT_EQ(Size(32, 48), writer.getTileSize());
+        // any order of tiles
+        for (int y = (img.rows - 1) / 48 * 48; y >= 0; y -= 48)
+            for (int x = 0; x < img.cols; x += 32)
+            {
+                const Rect r = Rect(x, y, 32, 48) & Rect(Point(), img.size());
+                ASSERT_TRUE(writer.writeTile(img(r), r.tl()));
+            }
+        EXPECT_TRUE(writer.close());
+        EXPECT_EQ(0, cvtest::norm(img, imread(fname, IMREAD_UNCHANGED), NORM_INF));
+    }
+    {
+        // strips are split into tiles
+        ImageWriter writer(fname, img.size(), img.type(), params);
+        ASSERT_TRUE(writer.isOpened());
+        for (int y = 0; y < img.rows; y += 20)
+            ASSERT_TRUE(writer.write(img.rowRange(y, std::min(y + 20, img.rows))));
+        EXPECT_TRUE(writer.close());
+        EXPECT_EQ(0, cvtest::norm(img, imread(fname, IMREAD_UNCHANGED), NORM_INF));
+    }
+    {
+        // a tile written twice doesn't replace a missing one
+        ImageWriter writer(fname, img.size(), img.type(), params);
+        ASSERT_TRUE(writer.isOpened());
+        for (int y = 0; y < img.rows; y += 48)
+            for (int x = 0; x < img.cols; x += 32)
+            {
+                const Rect r = Rect(x, y, 32, 48) & Rect(Point(), img.size());
+                if (r.tl() != Point(32, 48))
+                {
+                    ASSERT_TRUE(writer.writeTile(img(r), r.tl()));
+                }
+            }
+        EXPECT_ANY_THROW(writer.writeTile(img(Rect(0, 0, 32, 48)), Point(0, 0)));
+        EXPECT_FALSE(writer.close());
+        EXPECT_TRUE(imread(fname).empty());
+    }
+    {
+        // imwrite() uses the same encoding path
+        ASSERT_TRUE(imwrite(fname, img, params));
+        EXPECT_EQ(0, cvtest::norm(img, imread(fname, IMREAD_UNCHANGED), NORM_INF));
+    }
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+#endif
+
 }} // namespace
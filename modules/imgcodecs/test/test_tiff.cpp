@@ -1300,6 +1300,43 @@ TEST(Imgcodecs_Tiff, read_bigtiff_images)
     }
 }
 
+typedef testing::TestWithParam<tuple<perf::MatType, int, int> > Imgcodecs_Tiff_Parallel;
+
+TEST_P(Imgcodecs_Tiff_Parallel, encode_big)
+{
+    const int type = get<0>(GetParam());
+    const int key = get<1>(GetParam()), value = get<2>(GetParam());
+    Mat img(800, 700, type);
+    randu(img(Rect(0, 0, 700, 400)), Scalar::all(0), Scalar::all(CV_MAT_DEPTH(type) == CV_8U ? 256 : 65536));
+    img(Rect(0, 400, 700, 400)).setTo(Scalar(7, 77, 177, 255));
+    std::vector<int> params;
+    if (key >= 0)
+    {
+        params.push_back(key);
+        params.push_back(value);
+    }
+
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode(".tiff", img, buf, params));
+    EXPECT_EQ(0, cvtest::norm(img, imdecode(buf, IMREAD_UNCHANGED), NORM_INF));
+
+    // strips compressed in parallel are the same
+    const int threads = getNumThreads();
+    setNumThreads(1);
+    std::vector<uchar> buf1;
+    EXPECT_TRUE(imencode(".tiff", img, buf1, params));
+    setNumThreads(threads);
+    EXPECT_TRUE(buf == buf1);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgcodecs_Tiff_Parallel, testing::Values(
+    make_tuple(perf::MatType(CV_8UC3), -1, 0),
+    make_tuple(perf::MatType(CV_8UC4), IMWRITE_SPEED_PRESET, IMWRITE_SPEED_PRESET_FASTEST),
+    make_tuple(perf::MatType(CV_16UC1), IMWRITE_SPEED_PRESET, IMWRITE_SPEED_PRESET_SMALLEST),
+    make_tuple(perf::MatType(CV_8UC1), IMWRITE_TIFF_COMPRESSION, IMWRITE_TIFF_COMPRESSION_PACKBITS),
+    make_tuple(perf::MatType(CV_16UC3), IMWRITE_TIFF_ROWSPERSTRIP, 100)
+));
+
 #endif
 
 }} // namespace
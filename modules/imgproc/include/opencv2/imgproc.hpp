@@ -365,7 +365,11 @@ enum GrabCutModes {
     /** The value means that the algorithm should just resume. */
     GC_EVAL            = 2,
     /** The value means that the algorithm should just run the grabCut algorithm (a single iteration) with the fixed model */
-    GC_EVAL_FREEZE_MODEL = 3
+    GC_EVAL_FREEZE_MODEL = 3,
+    /** The flag can be combined with the other modes. The graph cut is computed on a downscaled copy of a large
+    image first, then only the pixels near the found boundary are segmented at the full resolution. It's much
+    faster on large images, but thin structures missed at the coarse level can't be recovered. */
+    GC_COARSE_TO_FINE    = 8
 };
 
 //! distanceTransform algorithm flags
@@ -1394,6 +1398,20 @@ public:
      */
     CV_WRAP virtual int compareSegments(const Size& size, InputArray lines1, InputArray lines2, InputOutputArray image = noArray()) = 0;
 
+    /** @brief Sets the size of tiles used for parallel region growing.
+
+    By default (tileSize = 0) the regions are grown one by one over the whole image in the order of
+    the gradient magnitude. With a positive size the image is split into tiles of tileSize x tileSize
+    pixels, which are processed in parallel. Regions contained in a tile are grown within it, regions
+    crossing the tile borders are grown afterwards over the whole image in the order of their seed points.
+    The result doesn't depend on the number of threads, but may slightly differ from the default one
+    near the tile borders.
+    @param tileSize Size of the tiles in pixels of the input image, 0 disables the tiling.
+     */
+    CV_WRAP virtual void setTileSize(int tileSize) = 0;
+    /** @see setTileSize */
+    CV_WRAP virtual int getTileSize() const = 0;
+
     virtual ~LineSegmentDetector() { }
 };
 
@@ -2450,6 +2468,36 @@ CV_EXPORTS_W void warpAffine( InputArray src, OutputArray dst,
                               int borderMode = BORDER_CONSTANT,
                               const Scalar& borderValue = Scalar());
 
+/** @brief Applies affine transformations to a batch of regions of one image.
+
+The function is equivalent to calling #warpAffine once per matrix in M:
+\f[\texttt{dst} [i] = \texttt{warpAffine} ( \texttt{src} , \texttt{M} [i], \texttt{dsize} [i], \texttt{flags} , \texttt{borderMode} , \texttt{borderValue} )\f]
+but all the outputs are computed in a single parallel loop, which makes it much faster when
+many small crops (e.g. aligned faces or license plates) are extracted from the same frame.
+The results are the same as produced by #warpAffine without hardware-specific (HAL, IPP,
+OpenCL) acceleration.
+
+@param src input image.
+@param dst vector of output images of the same type as src; dst[i] has the size dsize[i]. When
+dst[i] already has the right size and type it is not reallocated, so several outputs may be
+headers of one contiguous buffer.
+@param M vector of \f$2\times 3\f$ transformation matrices (CV_32F or CV_64F); a \f$N\times 6\f$
+matrix or std::vector<Matx23d> is accepted as well.
+@param dsize sizes of the output images: either one size shared by all outputs or one size per
+matrix. An empty size means src.size().
+@param flags combination of interpolation methods (see #InterpolationFlags) and the optional
+flag #WARP_INVERSE_MAP, see #warpAffine.
+@param borderMode pixel extrapolation method (see #BorderTypes).
+@param borderValue value used in case of a constant border; by default, it is 0.
+
+@sa  warpAffine, warpPerspectiveBatch
+ */
+CV_EXPORTS_W void warpAffineBatch( InputArray src, OutputArrayOfArrays dst,
+                                   InputArrayOfArrays M, const std::vector<Size>& dsize,
+                                   int flags = INTER_LINEAR,
+                                   int borderMode = BORDER_CONSTANT,
+                                   const Scalar& borderValue = Scalar());
+
 /** @example samples/cpp/warpPerspective_demo.cpp
 An example program shows using cv::getPerspectiveTransform and cv::warpPerspective for image warping
 */
@@ -2482,6 +2530,30 @@ CV_EXPORTS_W void warpPerspective( InputArray src, OutputArray dst,
                                    int borderMode = BORDER_CONSTANT,
                                    const Scalar& borderValue = Scalar());
 
+/** @brief Applies perspective transformations to a batch of regions of one image.
+
+The function is the perspective counterpart of #warpAffineBatch: it is equivalent to calling
+#warpPerspective once per matrix in M, with all the outputs computed in a single parallel loop.
+
+@param src input image.
+@param dst vector of output images of the same type as src; dst[i] has the size dsize[i].
+@param M vector of \f$3\times 3\f$ transformation matrices (CV_32F or CV_64F); a \f$N\times 9\f$
+matrix or std::vector<Matx33d> is accepted as well.
+@param dsize sizes of the output images: either one size shared by all outputs or one size per
+matrix. An empty size means src.size().
+@param flags combination of interpolation methods (#INTER_LINEAR or #INTER_NEAREST) and the
+optional flag #WARP_INVERSE_MAP, see #warpPerspective.
+@param borderMode pixel extrapolation method (#BORDER_CONSTANT or #BORDER_REPLICATE).
+@param borderValue value used in case of a constant border; by default, it equals 0.
+
+@sa  warpPerspective, warpAffineBatch
+ */
+CV_EXPORTS_W void warpPerspectiveBatch( InputArray src, OutputArrayOfArrays dst,
+                                        InputArrayOfArrays M, const std::vector<Size>& dsize,
+                                        int flags = INTER_LINEAR,
+                                        int borderMode = BORDER_CONSTANT,
+                                        const Scalar& borderValue = Scalar());
+
 /** @brief Applies a generic geometrical transformation to an image.
 
 The function remap transforms the source image using the specified map:
@@ -4004,6 +4076,8 @@ The function retrieves contours from the binary image using the algorithm @cite
 are a useful tool for shape analysis and object detection and recognition. See squares.cpp in the
 OpenCV sample directory.
 @note Since opencv 3.2 source image is not modified by this function.
+@note Large 8-bit images are processed in parallel (in horizontal bands) when several threads are
+available, see #setNumThreads. The contours and the hierarchy are the same as in the serial mode.
 
 @param image Source, an 8-bit single-channel image. Non-zero pixels are treated as 1's. Zero
 pixels remain 0's, so the image is treated as binary . You can use #compare, #inRange, #threshold ,
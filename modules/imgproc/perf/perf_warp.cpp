@@ -77,6 +77,34 @@ PERF_TEST_P(TestWarpAffine, DISABLED_WarpAffine_ovx,
     SANITY_CHECK(dst, 1);
 }
 
+typedef TestBaseWithParam< tuple<MatType, int> > TestWarpAffineBatch;
+
+PERF_TEST_P( TestWarpAffineBatch, WarpAffineBatch,
+             Combine(
+                Values(CV_8UC1, CV_8UC3),
+                Values(16, 256)
+             )
+)
+{
+    int dataType = get<0>(GetParam());
+    int n        = get<1>(GetParam());
+
+    Mat src(sz1080p, dataType);
+    cvtest::fillGradient(src);
+    RNG rng(12345);
+    std::vector<Mat> M(n), dst;
+    for (int i = 0; i < n; i++)
+    {
+        Point2f center((float)rng.uniform(0, src.cols), (float)rng.uniform(0, src.rows));
+        M[i] = getRotationMatrix2D(center, rng.uniform(-30., 30.), rng.uniform(0.5, 1.5));
+    }
+    declare.in(src);
+
+    TEST_CYCLE() warpAffineBatch(src, dst, M, std::vector<Size>(1, Size(112, 112)));
+
+    SANITY_CHECK_NOTHING();
+}
+
 PERF_TEST_P( TestWarpPerspective, WarpPerspective,
              Combine(
                 Values( szVGA, sz720p, sz1080p ),
@@ -43,6 +43,7 @@
 #include "precomp.hpp"
 #include "opencl_kernels_imgproc.hpp"
 #include "opencv2/core/hal/intrin.hpp"
+#include "opencv2/core/utils/buffer_area.private.hpp"
 #include <deque>
 
 #include "opencv2/core/openvx/ovx_defs.hpp"
@@ -360,7 +361,6 @@ public:
         CV_DbgAssert(cn > 0);
 
         Mat dx, dy;
-        AutoBuffer<short> dxMax(0), dyMax(0);
         std::deque<uchar*> stack, borderPeaksLocal;
         const int rowStart = max(0, boundaries.start - 1), rowEnd = min(src.rows, boundaries.end + 1);
         int *_mag_p, *_mag_a, *_mag_n;
@@ -385,25 +385,33 @@ public:
         }
 
         CV_TRACE_REGION_NEXT("magnitude");
+        // temporary buffers are served by ArenaScope if it is active
+        utils::BufferArea area;
+        short* dxyMax = NULL;
+        int* magBuf = NULL;
+        if(cn > 1)
+            area.allocate(dxyMax, 2 * dx.cols + 2 * dy.cols);
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        area.allocate(magBuf, 3 * (mapstep * cn + CV_SIMD_WIDTH));
+#else
+        area.allocate(magBuf, 3 * (mapstep * cn));
+#endif
+        area.commit();
         if(cn > 1)
         {
-            dxMax.allocate(2 * dx.cols);
-            dyMax.allocate(2 * dy.cols);
-            _dx_a = dxMax.data();
+            _dx_a = dxyMax;
             _dx_n = _dx_a + dx.cols;
-            _dy_a = dyMax.data();
+            _dy_a = _dx_n + dx.cols;
             _dy_n = _dy_a + dy.cols;
         }
 
         // _mag_p: previous row, _mag_a: actual row, _mag_n: next row
 #if (CV_SIMD || CV_SIMD_SCALABLE)
-        AutoBuffer<int> buffer(3 * (mapstep * cn + CV_SIMD_WIDTH));
-        _mag_p = alignPtr(buffer.data() + 1, CV_SIMD_WIDTH);
+        _mag_p = alignPtr(magBuf + 1, CV_SIMD_WIDTH);
         _mag_a = alignPtr(_mag_p + mapstep * cn, CV_SIMD_WIDTH);
         _mag_n = alignPtr(_mag_a + mapstep * cn, CV_SIMD_WIDTH);
 #else
-        AutoBuffer<int> buffer(3 * (mapstep * cn));
-        _mag_p = buffer.data() + 1;
+        _mag_p = magBuf + 1;
         _mag_a = _mag_p + mapstep * cn;
         _mag_n = _mag_a + mapstep * cn;
 #endif
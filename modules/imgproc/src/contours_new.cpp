@@ -169,7 +169,8 @@ static bool icvTraceContour(Mat& image, const Point& start, const Point& end, bo
     return false;
 }
 
-template <typename T>
+// SET_FLAGS=false doesn't modify the image, several contours can be traced concurrently then
+template <typename T, bool SET_FLAGS = true>
 static void icvFetchContourEx(Mat& image,
                               const Point& start,
                               T nbd,
@@ -194,7 +195,8 @@ static void icvFetchContourEx(Mat& image,
 
     if (s == s_end)
     {
-        Trait<T>::setRightFlag(i0, i0, nbd);
+        if (SET_FLAGS)
+            Trait<T>::setRightFlag(i0, i0, nbd);
         if (!res_contour.isChain)
         {
             res_contour.pts.push_back(pt);
@@ -221,13 +223,16 @@ static void icvFetchContourEx(Mat& image,
             s &= 7;
 
             // check "right" bound
-            if ((unsigned)(s - 1) < (unsigned)s_end)
-            {
-                Trait<T>::setRightFlag(i3, i0, nbd);
-            }
-            else if (Trait<T>::isVal(i3, i0))
+            if (SET_FLAGS)
             {
-                Trait<T>::setNewFlag(i3, i0, nbd);
+                if ((unsigned)(s - 1) < (unsigned)s_end)
+                {
+                    Trait<T>::setRightFlag(i3, i0, nbd);
+                }
+                else if (Trait<T>::isVal(i3, i0))
+                {
+                    Trait<T>::setNewFlag(i3, i0, nbd);
+                }
             }
 
             if (res_contour.isChain)
@@ -309,6 +314,8 @@ public:
     int findFirstBoundingContour(const Point& last_pos, const int y, const int lval, int par);
     int findNextX(int x, int y, int& prev, int& p);
     bool findNext();
+    bool isParallelScanUsed() const;
+    void findAllParallel();
 
     static shared_ptr<ContourScanner_> create(Mat img, int mode, int method, Point offset);
 };  // class ContourScanner_
@@ -625,6 +632,254 @@ bool ContourScanner_::findNext()
 
 //==============================================================================
 
+//
+// Parallel variant: borders are found from components of runs
+//
+
+// Each border of the Suzuki algorithm separates a foreground component (8-connected)
+// and an adjacent background component (4-connected): the outer border of the component or a hole.
+// The serial scan meets the border at the first pixel of the foreground component (outer border)
+// or of the background component (hole), so the order of contours and the hierarchy are defined
+// by the components. They are found from row runs: runs are extracted and connected within
+// horizontal bands in parallel, then bands are stitched at their borders. All contours are traced
+// in parallel after that.
+
+namespace {
+
+static const int MIN_BAND_HEIGHT = 64;
+
+// Runs of a band: starts of the alternating background and foreground runs of each row,
+// the first run of a row is background (the image has zero border)
+struct RunBand
+{
+    int y0, y1;
+    int base;  // global index of the first run
+    vector<int> xs;
+    vector<int> rowStart;  // rows.size() + 1 elements
+};
+
+static void extractRuns(const uchar* row, int width, vector<int>& xs)
+{
+    xs.push_back(0);
+    uchar prev = 0;
+    int x = 1;
+    for (;;)
+    {
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        const v_uint8 v_prev = vx_setall_u8(prev);
+        for (; x <= width - VTraits<v_uint8>::vlanes(); x += VTraits<v_uint8>::vlanes())
+        {
+            v_uint8 vmask = v_ne(vx_load(row + x), v_prev);
+            if (v_check_any(vmask))
+            {
+                x += v_scan_forward(vmask);
+                break;
+            }
+        }
+#endif
+        for (; x < width && row[x] == prev; x++)
+            ;
+        if (x >= width)
+            break;
+        xs.push_back(x);
+        prev = row[x];
+        x++;
+    }
+}
+
+// the root of a component is its first run
+static inline int findRoot(vector<int>& parent, int i)
+{
+    while (parent[i] != i)
+    {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+static inline void unite(vector<int>& parent, int a, int b)
+{
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if (a < b)
+        parent[b] = a;
+    else if (b < a)
+        parent[a] = b;
+}
+
+// Connects runs of the neighbour rows, P is the upper row
+static void uniteRows(const int* P, int np, int gp, const int* Q, int nq, int gq, int width, vector<int>& parent)
+{
+    int i = 0;
+    for (int j = 0; j < nq; j++)
+    {
+        const int q0 = Q[j], q1 = j + 1 < nq ? Q[j + 1] : width;
+        const int ext = j & 1;  // foreground runs are 8-connected, so the diagonal neighbours are connected
+        while (i < np && (i + 1 < np ? P[i + 1] : width) < q0)
+            i++;
+        for (int k = i; k < np && P[k] < q1 + ext; k++)
+        {
+            const int p1 = k + 1 < np ? P[k + 1] : width;
+            if ((k & 1) == (j & 1) && p1 + ext > q0)
+                unite(parent, gp + k, gq + j);
+        }
+    }
+}
+
+}  // namespace
+
+bool ContourScanner_::isParallelScanUsed() const
+{
+    return !isInt() && getNumThreads() > 1 && image.rows >= MIN_BAND_HEIGHT * 2 &&
+           image.total() >= (size_t)(1 << 16);
+}
+
+void ContourScanner_::findAllParallel()
+{
+    const int width = image.cols, height = image.rows;
+    const int nbands = std::max(std::min(getNumThreads(), height / MIN_BAND_HEIGHT), 1);
+    vector<RunBand> bands(nbands);
+    for (int b = 0; b < nbands; b++)
+    {
+        bands[b].y0 = (int)((int64)height * b / nbands);
+        bands[b].y1 = (int)((int64)height * (b + 1) / nbands);
+    }
+
+    parallel_for_(Range(0, nbands), [&](const Range& range) {
+        for (int b = range.start; b < range.end; b++)
+        {
+            RunBand& band = bands[b];
+            band.rowStart.reserve(band.y1 - band.y0 + 1);
+            for (int y = band.y0; y < band.y1; y++)
+            {
+                band.rowStart.push_back((int)band.xs.size());
+                extractRuns(image.ptr<uchar>(y), width, band.xs);
+            }
+            band.rowStart.push_back((int)band.xs.size());
+        }
+    });
+
+    int total = 0;
+    for (int b = 0; b < nbands; b++)
+    {
+        bands[b].base = total;
+        CV_Assert(bands[b].xs.size() < (size_t)(std::numeric_limits<int>::max() - total));
+        total += (int)bands[b].xs.size();
+    }
+
+    // connect runs within bands
+    vector<int> parent(total);
+    parallel_for_(Range(0, nbands), [&](const Range& range) {
+        for (int b = range.start; b < range.end; b++)
+        {
+            const RunBand& band = bands[b];
+            const int* xs = band.xs.data();
+            for (size_t i = 0; i < band.xs.size(); i++)
+                parent[band.base + i] = band.base + (int)i;
+            for (int r = 1; r < band.y1 - band.y0; r++)
+            {
+                const int p = band.rowStart[r - 1], q = band.rowStart[r], e = band.rowStart[r + 1];
+                uniteRows(xs + p, q - p, band.base + p, xs + q, e - q, band.base + q, width, parent);
+            }
+        }
+    });
+
+    // stitch bands
+    for (int b = 1; b < nbands; b++)
+    {
+        const RunBand &upper = bands[b - 1], &lower = bands[b];
+        const int r = upper.y1 - upper.y0 - 1;
+        const int p = upper.rowStart[r], np = upper.rowStart[r + 1] - p;
+        const int nq = lower.rowStart[1];
+        uniteRows(upper.xs.data() + p, np, upper.base + p, lower.xs.data(), nq, lower.base, width, parent);
+    }
+    for (int i = 0; i < total; i++)
+        parent[i] = parent[parent[i]];
+
+    // borders in the order of the raster scan: the first runs of components (except the background
+    // around the image), the parent is defined by the component of the run on the left
+    struct Border
+    {
+        Point pt;
+        bool isHole;
+        int run, leftRoot;
+    };
+    vector<Border> borders;
+    for (int b = 0; b < nbands; b++)
+    {
+        const RunBand& band = bands[b];
+        for (int r = 0; r < band.y1 - band.y0; r++)
+        {
+            for (int k = band.rowStart[r]; k < band.rowStart[r + 1]; k++)
+            {
+                const int g = band.base + k;
+                if (parent[g] != g || g == 0)
+                    continue;
+                Border border;
+                border.isHole = ((k - band.rowStart[r]) & 1) == 0;
+                border.pt = Point(band.xs[k] - (border.isHole ? 1 : 0), band.y0 + r);
+                border.run = g;
+                border.leftRoot = parent[g - 1];
+                borders.push_back(border);
+            }
+        }
+    }
+    bands.clear();
+
+    // contours and their parents
+    vector<int> contourRuns, contourParents;  // runs of created contours are sorted
+    vector<const Border*> contourBorders;
+    for (size_t i = 0; i < borders.size(); i++)
+    {
+        const Border& border = borders[i];
+        if (mode == RETR_EXTERNAL && (border.isHole || border.leftRoot != 0))
+            continue;
+        int par = 0;
+        if (mode == RETR_TREE ? border.leftRoot != 0 : (mode == RETR_CCOMP && border.isHole))
+        {
+            const vector<int>::const_iterator it =
+                std::lower_bound(contourRuns.begin(), contourRuns.end(), border.leftRoot);
+            CV_Assert(it != contourRuns.end() && *it == border.leftRoot);
+            par = (int)(it - contourRuns.begin()) + 1;
+        }
+        contourRuns.push_back(border.run);
+        contourParents.push_back(par);
+        contourBorders.push_back(&border);
+    }
+
+    const int ncontours = (int)contourBorders.size();
+    vector<Contour> contours(ncontours);
+    const bool isChain = (this->approx_method1 == CV_CHAIN_CODE);
+    const bool isDirect = (this->approx_method1 == CHAIN_APPROX_NONE);
+    parallel_for_(Range(0, ncontours), [&](const Range& range) {
+        for (int i = range.start; i < range.end; i++)
+        {
+            Contour& c = contours[i];
+            const Point start_pt = contourBorders[i]->pt;
+            c.isHole = contourBorders[i]->isHole;
+            c.isChain = isChain;
+            c.origin = start_pt + offset;
+            icvFetchContourEx<schar, false>(image, start_pt, MASK8_NEW, c, isDirect);
+            if (this->approx_method1 != this->approx_method2)
+            {
+                c.pts = approximateChainTC89(c.codes, c.origin, this->approx_method2);
+                c.isChain = false;
+            }
+            c.origin = start_pt;
+        }
+    });
+
+    for (int i = 0; i < ncontours; i++)
+    {
+        CNode& node = tree.newElem();
+        std::swap(node.body, contours[i]);
+        tree.addChild(contourParents[i], node.self());
+    }
+}
+
+//==============================================================================
+
 void cv::findContours(InputArray _image,
                       OutputArrayOfArrays _contours,
                       OutputArray _hierarchy,
@@ -679,8 +934,15 @@ void cv::findContours(InputArray _image,
 
     // find contours
     ContourScanner scanner = ContourScanner_::create(image, mode, method, offset + Point(-1, -1));
-    while (scanner->findNext())
+    if (scanner->isParallelScanUsed())
+    {
+        scanner->findAllParallel();
+    }
+    else
     {
+        while (scanner->findNext())
+        {
+        }
     }
 
     contourTreeToResults(scanner->tree, res_type, _contours, _hierarchy);
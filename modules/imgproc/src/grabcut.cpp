@@ -62,6 +62,23 @@ class GMM
 public:
     static const int componentsCount = 5;
 
+    /*
+     Sums of samples of the components. The sums are exact for integer colors,
+     so the samples can be accumulated in parallel and in any order.
+    */
+    struct Samples
+    {
+        Samples() { reset(); }
+        void reset();
+        void add( int ci, const Vec3d color );
+        void add( const Samples& samples );
+
+        double sums[componentsCount][3];
+        double prods[componentsCount][3][3];
+        int sampleCounts[componentsCount];
+        int totalSampleCount;
+    };
+
     GMM( Mat& _model );
     double operator()( const Vec3d color ) const;
     double operator()( int ci, const Vec3d color ) const;
@@ -69,6 +86,7 @@ public:
 
     void initLearning();
     void addSample( int ci, const Vec3d color );
+    void addSamples( const Samples& _samples );
     void endLearning();
 
 private:
@@ -81,10 +99,7 @@ private:
     double inverseCovs[componentsCount][3][3];
     double covDeterms[componentsCount];
 
-    double sums[componentsCount][3];
-    double prods[componentsCount][3][3];
-    int sampleCounts[componentsCount];
-    int totalSampleCount;
+    Samples samples;
 };
 
 GMM::GMM( Mat& _model )
@@ -107,7 +122,6 @@ GMM::GMM( Mat& _model )
     for( int ci = 0; ci < componentsCount; ci++ )
         if( coefs[ci] > 0 )
              calcInverseCovAndDeterm(ci, 0.0);
-    totalSampleCount = 0;
 }
 
 double GMM::operator()( const Vec3d color ) const
@@ -152,7 +166,7 @@ int GMM::whichComponent( const Vec3d color ) const
     return k;
 }
 
-void GMM::initLearning()
+void GMM::Samples::reset()
 {
     for( int ci = 0; ci < componentsCount; ci++)
     {
@@ -165,7 +179,7 @@ void GMM::initLearning()
     totalSampleCount = 0;
 }
 
-void GMM::addSample( int ci, const Vec3d color )
+void GMM::Samples::add( int ci, const Vec3d color )
 {
     sums[ci][0] += color[0]; sums[ci][1] += color[1]; sums[ci][2] += color[2];
     prods[ci][0][0] += color[0]*color[0]; prods[ci][0][1] += color[0]*color[1]; prods[ci][0][2] += color[0]*color[2];
@@ -175,8 +189,42 @@ void GMM::addSample( int ci, const Vec3d color )
     totalSampleCount++;
 }
 
+void GMM::Samples::add( const Samples& s )
+{
+    for( int ci = 0; ci < componentsCount; ci++ )
+    {
+        for( int i = 0; i < 3; i++ )
+        {
+            sums[ci][i] += s.sums[ci][i];
+            for( int j = 0; j < 3; j++ )
+                prods[ci][i][j] += s.prods[ci][i][j];
+        }
+        sampleCounts[ci] += s.sampleCounts[ci];
+    }
+    totalSampleCount += s.totalSampleCount;
+}
+
+void GMM::initLearning()
+{
+    samples.reset();
+}
+
+void GMM::addSample( int ci, const Vec3d color )
+{
+    samples.add( ci, color );
+}
+
+void GMM::addSamples( const Samples& _samples )
+{
+    samples.add( _samples );
+}
+
 void GMM::endLearning()
 {
+    const int* sampleCounts = samples.sampleCounts;
+    const int totalSampleCount = samples.totalSampleCount;
+    double (*sums)[3] = samples.sums;
+    double (*prods)[3][3] = samples.prods;
     for( int ci = 0; ci < componentsCount; ci++ )
     {
         int n = sampleCounts[ci];
@@ -239,34 +287,43 @@ void GMM::calcInverseCovAndDeterm(int ci, const double singularFix)
 */
 static double calcBeta( const Mat& img )
 {
-    double beta = 0;
-    for( int y = 0; y < img.rows; y++ )
+    // the sums of integer squares are exact, so the order of rows doesn't matter
+    std::vector<double> rowSums( img.rows, 0. );
+    parallel_for_( Range(0, img.rows), [&]( const Range& range )
     {
-        for( int x = 0; x < img.cols; x++ )
+        for( int y = range.start; y < range.end; y++ )
         {
-            Vec3d color = img.at<Vec3b>(y,x);
-            if( x>0 ) // left
-            {
-                Vec3d diff = color - (Vec3d)img.at<Vec3b>(y,x-1);
-                beta += diff.dot(diff);
-            }
-            if( y>0 && x>0 ) // upleft
-            {
-                Vec3d diff = color - (Vec3d)img.at<Vec3b>(y-1,x-1);
-                beta += diff.dot(diff);
-            }
-            if( y>0 ) // up
+            double beta = 0;
+            for( int x = 0; x < img.cols; x++ )
             {
-                Vec3d diff = color - (Vec3d)img.at<Vec3b>(y-1,x);
-                beta += diff.dot(diff);
-            }
-            if( y>0 && x<img.cols-1) // upright
-            {
-                Vec3d diff = color - (Vec3d)img.at<Vec3b>(y-1,x+1);
-                beta += diff.dot(diff);
+                Vec3d color = img.at<Vec3b>(y,x);
+                if( x>0 ) // left
+                {
+                    Vec3d diff = color - (Vec3d)img.at<Vec3b>(y,x-1);
+                    beta += diff.dot(diff);
+                }
+                if( y>0 && x>0 ) // upleft
+                {
+                    Vec3d diff = color - (Vec3d)img.at<Vec3b>(y-1,x-1);
+                    beta += diff.dot(diff);
+                }
+                if( y>0 ) // up
+                {
+                    Vec3d diff = color - (Vec3d)img.at<Vec3b>(y-1,x);
+                    beta += diff.dot(diff);
+                }
+                if( y>0 && x<img.cols-1) // upright
+                {
+                    Vec3d diff = color - (Vec3d)img.at<Vec3b>(y-1,x+1);
+                    beta += diff.dot(diff);
+                }
             }
+            rowSums[y] = beta;
         }
-    }
+    } );
+    double beta = 0;
+    for( int y = 0; y < img.rows; y++ )
+        beta += rowSums[y];
     if( beta <= std::numeric_limits<double>::epsilon() )
         beta = 0;
     else
@@ -286,41 +343,44 @@ static void calcNWeights( const Mat& img, Mat& leftW, Mat& upleftW, Mat& upW, Ma
     upleftW.create( img.rows, img.cols, CV_64FC1 );
     upW.create( img.rows, img.cols, CV_64FC1 );
     uprightW.create( img.rows, img.cols, CV_64FC1 );
-    for( int y = 0; y < img.rows; y++ )
+    parallel_for_( Range(0, img.rows), [&]( const Range& range )
     {
-        for( int x = 0; x < img.cols; x++ )
+        for( int y = range.start; y < range.end; y++ )
         {
-            Vec3d color = img.at<Vec3b>(y,x);
-            if( x-1>=0 ) // left
-            {
-                Vec3d diff = color - (Vec3d)img.at<Vec3b>(y,x-1);
-                leftW.at<double>(y,x) = gamma * exp(-beta*diff.dot(diff));
-            }
-            else
-                leftW.at<double>(y,x) = 0;
-            if( x-1>=0 && y-1>=0 ) // upleft
-            {
-                Vec3d diff = color - (Vec3d)img.at<Vec3b>(y-1,x-1);
-                upleftW.at<double>(y,x) = gammaDivSqrt2 * exp(-beta*diff.dot(diff));
-            }
-            else
-                upleftW.at<double>(y,x) = 0;
-            if( y-1>=0 ) // up
-            {
-                Vec3d diff = color - (Vec3d)img.at<Vec3b>(y-1,x);
-                upW.at<double>(y,x) = gamma * exp(-beta*diff.dot(diff));
-            }
-            else
-                upW.at<double>(y,x) = 0;
-            if( x+1<img.cols && y-1>=0 ) // upright
+            for( int x = 0; x < img.cols; x++ )
             {
-                Vec3d diff = color - (Vec3d)img.at<Vec3b>(y-1,x+1);
-                uprightW.at<double>(y,x) = gammaDivSqrt2 * exp(-beta*diff.dot(diff));
+                Vec3d color = img.at<Vec3b>(y,x);
+                if( x-1>=0 ) // left
+                {
+                    Vec3d diff = color - (Vec3d)img.at<Vec3b>(y,x-1);
+                    leftW.at<double>(y,x) = gamma * exp(-beta*diff.dot(diff));
+                }
+                else
+                    leftW.at<double>(y,x) = 0;
+                if( x-1>=0 && y-1>=0 ) // upleft
+                {
+                    Vec3d diff = color - (Vec3d)img.at<Vec3b>(y-1,x-1);
+                    upleftW.at<double>(y,x) = gammaDivSqrt2 * exp(-beta*diff.dot(diff));
+                }
+                else
+                    upleftW.at<double>(y,x) = 0;
+                if( y-1>=0 ) // up
+                {
+                    Vec3d diff = color - (Vec3d)img.at<Vec3b>(y-1,x);
+                    upW.at<double>(y,x) = gamma * exp(-beta*diff.dot(diff));
+                }
+                else
+                    upW.at<double>(y,x) = 0;
+                if( x+1<img.cols && y-1>=0 ) // upright
+                {
+                    Vec3d diff = color - (Vec3d)img.at<Vec3b>(y-1,x+1);
+                    uprightW.at<double>(y,x) = gammaDivSqrt2 * exp(-beta*diff.dot(diff));
+                }
+                else
+                    uprightW.at<double>(y,x) = 0;
             }
-            else
-                uprightW.at<double>(y,x) = 0;
         }
-    }
+    } );
 }
 
 /*
@@ -415,16 +475,19 @@ static void initGMMs( const Mat& img, const Mat& mask, GMM& bgdGMM, GMM& fgdGMM
 */
 static void assignGMMsComponents( const Mat& img, const Mat& mask, const GMM& bgdGMM, const GMM& fgdGMM, Mat& compIdxs )
 {
-    Point p;
-    for( p.y = 0; p.y < img.rows; p.y++ )
+    parallel_for_( Range(0, img.rows), [&]( const Range& range )
     {
-        for( p.x = 0; p.x < img.cols; p.x++ )
+        Point p;
+        for( p.y = range.start; p.y < range.end; p.y++ )
         {
-            Vec3d color = img.at<Vec3b>(p);
-            compIdxs.at<int>(p) = mask.at<uchar>(p) == GC_BGD || mask.at<uchar>(p) == GC_PR_BGD ?
-                bgdGMM.whichComponent(color) : fgdGMM.whichComponent(color);
+            for( p.x = 0; p.x < img.cols; p.x++ )
+            {
+                Vec3d color = img.at<Vec3b>(p);
+                compIdxs.at<int>(p) = mask.at<uchar>(p) == GC_BGD || mask.at<uchar>(p) == GC_PR_BGD ?
+                    bgdGMM.whichComponent(color) : fgdGMM.whichComponent(color);
+            }
         }
-    }
+    } );
 }
 
 /*
@@ -432,66 +495,98 @@ static void assignGMMsComponents( const Mat& img, const Mat& mask, const GMM& bg
 */
 static void learnGMMs( const Mat& img, const Mat& mask, const Mat& compIdxs, GMM& bgdGMM, GMM& fgdGMM )
 {
-    bgdGMM.initLearning();
-    fgdGMM.initLearning();
-    Point p;
-    for( int ci = 0; ci < GMM::componentsCount; ci++ )
+    // samples of the stripes are summed in the fixed order
+    const int nstripes = std::min( img.rows, std::max( getNumThreads(), 1 ) * 4 );
+    std::vector<GMM::Samples> bgdSamples( nstripes ), fgdSamples( nstripes );
+    parallel_for_( Range(0, nstripes), [&]( const Range& range )
     {
-        for( p.y = 0; p.y < img.rows; p.y++ )
+        for( int k = range.start; k < range.end; k++ )
         {
-            for( p.x = 0; p.x < img.cols; p.x++ )
+            GMM::Samples& bgd = bgdSamples[k];
+            GMM::Samples& fgd = fgdSamples[k];
+            Point p;
+            for( p.y = img.rows*k/nstripes; p.y < img.rows*(k+1)/nstripes; p.y++ )
             {
-                if( compIdxs.at<int>(p) == ci )
+                for( p.x = 0; p.x < img.cols; p.x++ )
                 {
+                    int ci = compIdxs.at<int>(p);
                     if( mask.at<uchar>(p) == GC_BGD || mask.at<uchar>(p) == GC_PR_BGD )
-                        bgdGMM.addSample( ci, img.at<Vec3b>(p) );
+                        bgd.add( ci, img.at<Vec3b>(p) );
                     else
-                        fgdGMM.addSample( ci, img.at<Vec3b>(p) );
+                        fgd.add( ci, img.at<Vec3b>(p) );
                 }
             }
         }
+    } );
+    bgdGMM.initLearning();
+    fgdGMM.initLearning();
+    for( int k = 0; k < nstripes; k++ )
+    {
+        bgdGMM.addSamples( bgdSamples[k] );
+        fgdGMM.addSamples( fgdSamples[k] );
     }
     bgdGMM.endLearning();
     fgdGMM.endLearning();
 }
 
+/*
+  Calculate weights of terminal edges of the graph
+*/
+static void calcTWeights( const Mat& img, const Mat& mask, const GMM& bgdGMM, const GMM& fgdGMM, double lambda, Mat& tWeights )
+{
+    tWeights.create( img.size(), CV_64FC2 );
+    parallel_for_( Range(0, img.rows), [&]( const Range& range )
+    {
+        Point p;
+        for( p.y = range.start; p.y < range.end; p.y++ )
+        {
+            for( p.x = 0; p.x < img.cols; p.x++ )
+            {
+                double fromSource, toSink;
+                uchar m = mask.at<uchar>(p);
+                if( m == GC_PR_BGD || m == GC_PR_FGD )
+                {
+                    Vec3b color = img.at<Vec3b>(p);
+                    fromSource = -log( bgdGMM(color) );
+                    toSink = -log( fgdGMM(color) );
+                }
+                else if( m == GC_BGD )
+                {
+                    fromSource = 0;
+                    toSink = lambda;
+                }
+                else // GC_FGD
+                {
+                    fromSource = lambda;
+                    toSink = 0;
+                }
+                tWeights.at<Vec2d>(p) = Vec2d( fromSource, toSink );
+            }
+        }
+    } );
+}
+
 /*
   Construct GCGraph
 */
-static void constructGCGraph( const Mat& img, const Mat& mask, const GMM& bgdGMM, const GMM& fgdGMM, double lambda,
+static void constructGCGraph( const Mat& tWeights,
                        const Mat& leftW, const Mat& upleftW, const Mat& upW, const Mat& uprightW,
                        GCGraph<double>& graph )
 {
-    int vtxCount = img.cols*img.rows,
-        edgeCount = 2*(4*img.cols*img.rows - 3*(img.cols + img.rows) + 2);
+    int vtxCount = tWeights.cols*tWeights.rows,
+        edgeCount = 2*(4*tWeights.cols*tWeights.rows - 3*(tWeights.cols + tWeights.rows) + 2);
     graph.create(vtxCount, edgeCount);
     Point p;
-    for( p.y = 0; p.y < img.rows; p.y++ )
+    for( p.y = 0; p.y < tWeights.rows; p.y++ )
     {
-        for( p.x = 0; p.x < img.cols; p.x++)
+        for( p.x = 0; p.x < tWeights.cols; p.x++)
         {
             // add node
             int vtxIdx = graph.addVtx();
-            Vec3b color = img.at<Vec3b>(p);
 
             // set t-weights
-            double fromSource, toSink;
-            if( mask.at<uchar>(p) == GC_PR_BGD || mask.at<uchar>(p) == GC_PR_FGD )
-            {
-                fromSource = -log( bgdGMM(color) );
-                toSink = -log( fgdGMM(color) );
-            }
-            else if( mask.at<uchar>(p) == GC_BGD )
-            {
-                fromSource = 0;
-                toSink = lambda;
-            }
-            else // GC_FGD
-            {
-                fromSource = lambda;
-                toSink = 0;
-            }
-            graph.addTermWeights( vtxIdx, fromSource, toSink );
+            const Vec2d& tw = tWeights.at<Vec2d>(p);
+            graph.addTermWeights( vtxIdx, tw[0], tw[1] );
 
             // set n-weights
             if( p.x>0 )
@@ -502,17 +597,17 @@ static void constructGCGraph( const Mat& img, const Mat& mask, const GMM& bgdGMM
             if( p.x>0 && p.y>0 )
             {
                 double w = upleftW.at<double>(p);
-                graph.addEdges( vtxIdx, vtxIdx-img.cols-1, w, w );
+                graph.addEdges( vtxIdx, vtxIdx-tWeights.cols-1, w, w );
             }
             if( p.y>0 )
             {
                 double w = upW.at<double>(p);
-                graph.addEdges( vtxIdx, vtxIdx-img.cols, w, w );
+                graph.addEdges( vtxIdx, vtxIdx-tWeights.cols, w, w );
             }
-            if( p.x<img.cols-1 && p.y>0 )
+            if( p.x<tWeights.cols-1 && p.y>0 )
             {
                 double w = uprightW.at<double>(p);
-                graph.addEdges( vtxIdx, vtxIdx-img.cols+1, w, w );
+                graph.addEdges( vtxIdx, vtxIdx-tWeights.cols+1, w, w );
             }
         }
     }
@@ -540,6 +635,188 @@ static void estimateSegmentation( GCGraph<double>& graph, Mat& mask )
     }
 }
 
+/*
+  Coarse level for the coarse-to-fine segmentation. A vertex of the level is a cell of 2^levels x 2^levels
+  pixels of the image, its weights are the sums of the weights of the cell pixels and the edges between
+  the cells, so the level graph is the image graph restricted to the labelings constant in the cells.
+*/
+struct GCCoarseLevel
+{
+    int levels;
+    Size size;
+    Mat leftW, upleftW, upW, uprightW;
+};
+
+static void initCoarseLevel( const Size& imgSize, const Mat& leftW, const Mat& upleftW, const Mat& upW, const Mat& uprightW,
+                             GCCoarseLevel& coarse )
+{
+    // the graph of the coarse level has no more than 2^18 vertices
+    const double maxCoarseArea = 1 << 18;
+    coarse.levels = 0;
+    while( (double)imgSize.area() / (1 << 2*coarse.levels) > maxCoarseArea )
+        coarse.levels++;
+    if( coarse.levels == 0 )
+        return;
+
+    const int L = coarse.levels, cellSize = 1 << L;
+    coarse.size = Size( (imgSize.width + cellSize - 1) >> L, (imgSize.height + cellSize - 1) >> L );
+    Mat* cW[] = { &coarse.leftW, &coarse.upleftW, &coarse.upW, &coarse.uprightW };
+    for( int k = 0; k < 4; k++ )
+        cW[k]->create( coarse.size, CV_64FC1 );
+
+    // the edges between the cells are accumulated in the cells of the same row,
+    // the edges pointing right are stored in the right cells as the left ones
+    parallel_for_( Range(0, coarse.size.height), [&]( const Range& range )
+    {
+        const Mat* fW[] = { &leftW, &upleftW, &upW, &uprightW };
+        const int dx[] = { -1, -1, 0, 1 };
+        for( int cy = range.start; cy < range.end; cy++ )
+        {
+            for( int k = 0; k < 4; k++ )
+                cW[k]->row(cy).setTo( Scalar::all(0) );
+            for( int y = cy << L; y < std::min((cy + 1) << L, imgSize.height); y++ )
+            {
+                for( int x = 0; x < imgSize.width; x++ )
+                {
+                    const int cx = x >> L;
+                    for( int k = 0; k < 4; k++ )
+                    {
+                        const int qx = x + dx[k], qy = k == 0 ? y : y - 1;
+                        if( (unsigned)qx >= (unsigned)imgSize.width || qy < 0 )
+                            continue;
+                        const int dcx = (qx >> L) - cx, dcy = (qy >> L) - cy;
+                        if( dcx == 0 && dcy == 0 )
+                            continue;
+                        const double w = fW[k]->at<double>(y, x);
+                        if( dcy == 0 ) // the left or the right cell
+                            cW[0]->at<double>(cy, std::max(cx, cx + dcx)) += w;
+                        else
+                            cW[dcx + 2]->at<double>(cy, cx) += w;
+                    }
+                }
+            }
+        }
+    } );
+}
+
+/*
+  Estimate segmentation on the coarse level and refine it in the image only near the found boundary
+*/
+static void estimateSegmentationCoarseToFine( const Mat& tWeights, Mat& mask,
+                                              const Mat& leftW, const Mat& upleftW, const Mat& upW, const Mat& uprightW,
+                                              const GCCoarseLevel& coarse )
+{
+    const int L = coarse.levels;
+    const Size size = mask.size();
+
+    // segment the coarse level
+    Mat clabels( coarse.size, CV_8UC1 );
+    {
+        Mat ctWeights( coarse.size, CV_64FC2 );
+        parallel_for_( Range(0, coarse.size.height), [&]( const Range& range )
+        {
+            for( int cy = range.start; cy < range.end; cy++ )
+            {
+                Vec2d* ctw = ctWeights.ptr<Vec2d>(cy);
+                for( int cx = 0; cx < coarse.size.width; cx++ )
+                    ctw[cx] = Vec2d();
+                for( int y = cy << L; y < std::min((cy + 1) << L, size.height); y++ )
+                {
+                    const Vec2d* tw = tWeights.ptr<Vec2d>(y);
+                    for( int x = 0; x < size.width; x++ )
+                        ctw[x >> L] += tw[x];
+                }
+            }
+        } );
+        GCGraph<double> graph;
+        constructGCGraph( ctWeights, coarse.leftW, coarse.upleftW, coarse.upW, coarse.uprightW, graph );
+        graph.maxFlow();
+        for( int cy = 0; cy < coarse.size.height; cy++ )
+            for( int cx = 0; cx < coarse.size.width; cx++ )
+                clabels.at<uchar>(cy, cx) = graph.inSourceSegment( cy*coarse.size.width + cx ) ? 1 : 0;
+    }
+
+    // pixels of the cells near the coarse boundary are segmented in the image,
+    // the other pixels take the labels of their cells
+    Mat cmin, cmax;
+    erode( clabels, cmin, Mat() );
+    dilate( clabels, cmax, Mat() );
+    Mat cband = cmin != cmax;
+
+    Mat vtxIdxs( size, CV_32SC1, Scalar(-1) );
+    int vtxCount = 0;
+    for( int y = 0; y < size.height; y++ )
+    {
+        const uchar* bandRow = cband.ptr<uchar>(y >> L);
+        int* idxRow = vtxIdxs.ptr<int>(y);
+        for( int x = 0; x < size.width; x++ )
+            if( bandRow[x >> L] )
+                idxRow[x] = vtxCount++;
+    }
+
+    GCGraph<double> graph;
+    if( vtxCount > 0 )
+    {
+        graph.create( vtxCount, 8*vtxCount );
+        const int dx[] = { -1, -1, 0, 1, 1, 1, 0, -1 };
+        const int dy[] = { 0, -1, -1, -1, 0, 1, 1, 1 };
+        Point p;
+        for( p.y = 0; p.y < size.height; p.y++ )
+        {
+            for( p.x = 0; p.x < size.width; p.x++ )
+            {
+                if( vtxIdxs.at<int>(p) < 0 )
+                    continue;
+                int vtxIdx = graph.addVtx();
+                CV_DbgAssert( vtxIdx == vtxIdxs.at<int>(p) );
+                Vec2d tw = tWeights.at<Vec2d>(p);
+
+                // n-weights: the first 4 neighbors precede the pixel, the weights of the others are stored in them
+                for( int k = 0; k < 8; k++ )
+                {
+                    const Point q( p.x + dx[k], p.y + dy[k] );
+                    if( (unsigned)q.x >= (unsigned)size.width || (unsigned)q.y >= (unsigned)size.height )
+                        continue;
+                    const double w = k == 0 ? leftW.at<double>(p) : k == 1 ? upleftW.at<double>(p) :
+                                     k == 2 ? upW.at<double>(p) : k == 3 ? uprightW.at<double>(p) :
+                                     k == 4 ? leftW.at<double>(q) : k == 5 ? upleftW.at<double>(q) :
+                                     k == 6 ? upW.at<double>(q) : uprightW.at<double>(q);
+                    const int qIdx = vtxIdxs.at<int>(q);
+                    if( qIdx >= 0 )
+                    {
+                        if( k < 4 )
+                            graph.addEdges( vtxIdx, qIdx, w, w );
+                    }
+                    else
+                    {
+                        // the neighbor with the fixed label is a terminal
+                        const uchar m = mask.at<uchar>(q);
+                        const bool fgd = m == GC_FGD || (m != GC_BGD && clabels.at<uchar>(q.y >> L, q.x >> L) != 0);
+                        tw[fgd ? 0 : 1] += w;
+                    }
+                }
+                graph.addTermWeights( vtxIdx, tw[0], tw[1] );
+            }
+        }
+        if( vtxCount > 1 )
+            graph.maxFlow();
+    }
+
+    Point p;
+    for( p.y = 0; p.y < size.height; p.y++ )
+    {
+        for( p.x = 0; p.x < size.width; p.x++ )
+        {
+            uchar& m = mask.at<uchar>(p);
+            if( m != GC_PR_BGD && m != GC_PR_FGD )
+                continue;
+            const int vtxIdx = vtxIdxs.at<int>(p);
+            const bool fgd = vtxIdx >= 0 ? graph.inSourceSegment( vtxIdx ) : clabels.at<uchar>(p.y >> L, p.x >> L) != 0;
+            m = fgd ? GC_PR_FGD : GC_PR_BGD;
+        }
+    }
+}
+
 void cv::grabCut( InputArray _img, InputOutputArray _mask, Rect rect,
                   InputOutputArray _bgdModel, InputOutputArray _fgdModel,
                   int iterCount, int mode )
@@ -556,6 +833,9 @@ void cv::grabCut( InputArray _img, InputOutputArray _mask, Rect rect,
     if( img.type() != CV_8UC3 )
         CV_Error( cv::Error::StsBadArg, "image must have CV_8UC3 type" );
 
+    const bool coarseToFine = (mode & GC_COARSE_TO_FINE) != 0;
+    mode &= ~GC_COARSE_TO_FINE;
+
     GMM bgdGMM( bgdModel ), fgdGMM( fgdModel );
     Mat compIdxs( img.size(), CV_32SC1 );
 
@@ -584,13 +864,25 @@ void cv::grabCut( InputArray _img, InputOutputArray _mask, Rect rect,
     Mat leftW, upleftW, upW, uprightW;
     calcNWeights( img, leftW, upleftW, upW, uprightW, beta, gamma );
 
+    GCCoarseLevel coarse;
+    coarse.levels = 0;
+    if( coarseToFine )
+        initCoarseLevel( img.size(), leftW, upleftW, upW, uprightW, coarse );
+
+    Mat tWeights;
     for( int i = 0; i < iterCount; i++ )
     {
-        GCGraph<double> graph;
         assignGMMsComponents( img, mask, bgdGMM, fgdGMM, compIdxs );
         if( mode != GC_EVAL_FREEZE_MODEL )
             learnGMMs( img, mask, compIdxs, bgdGMM, fgdGMM );
-        constructGCGraph(img, mask, bgdGMM, fgdGMM, lambda, leftW, upleftW, upW, uprightW, graph );
+        calcTWeights( img, mask, bgdGMM, fgdGMM, lambda, tWeights );
+        if( coarse.levels > 0 )
+        {
+            estimateSegmentationCoarseToFine( tWeights, mask, leftW, upleftW, upW, uprightW, coarse );
+            continue;
+        }
+        GCGraph<double> graph;
+        constructGCGraph( tWeights, leftW, upleftW, upW, uprightW, graph );
         estimateSegmentation( graph, mask );
     }
 }
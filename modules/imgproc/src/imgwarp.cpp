@@ -3466,6 +3466,135 @@ void cv::warpPerspective( InputArray _src, OutputArray _dst, InputArray _M0,
 }
 
 
+namespace cv
+{
+
+static void warpTransformBatch( InputArray _src, OutputArrayOfArrays _dst, InputArrayOfArrays _M,
+                                const std::vector<Size>& dsize, int flags, int borderType,
+                                const Scalar& borderValue, bool perspective )
+{
+    Mat src = _src.getMat();
+    CV_Assert( src.cols > 0 && src.rows > 0 );
+
+    int interpolation = flags & INTER_MAX;
+    CV_Assert( src.channels() <= 4 || (interpolation != INTER_LANCZOS4 &&
+                                       interpolation != INTER_CUBIC) );
+    if( interpolation == INTER_AREA )
+        interpolation = INTER_LINEAR;
+
+    std::vector<Mat> M0;
+    _M.getMatVector(M0);
+    int i, n = (int)M0.size(), mrows = perspective ? 3 : 2;
+    CV_Assert( dsize.size() == 1 || dsize.size() == M0.size() );
+
+    _dst.create(n, 1, src.type(), -1, true);
+    std::vector<Mat> dst(n);
+    // the invokers keep pointers to the coefficients, so the storage is allocated once
+    std::vector<double> coeffs(n*9);
+    bool inplace = false;
+
+    for( i = 0; i < n; i++ )
+    {
+        Size sz = dsize[dsize.size() == 1 ? 0 : i];
+        _dst.create(sz.empty() ? src.size() : sz, src.type(), i);
+        dst[i] = _dst.getMat(i);
+        inplace |= dst[i].data == src.data;
+
+        const Mat& Mi = M0[i];
+        CV_Assert( (Mi.depth() == CV_32F || Mi.depth() == CV_64F) &&
+                   Mi.isContinuous() && Mi.total()*Mi.channels() == (size_t)mrows*3 );
+        double* M = &coeffs[i*9];
+        Mat matM(mrows, 3, CV_64F, M);
+        Mi.reshape(1, mrows).convertTo(matM, matM.type());
+
+        if( flags & WARP_INVERSE_MAP )
+            continue;
+        if( perspective )
+            invert(matM, matM);
+        else
+        {
+            double D = M[0]*M[4] - M[1]*M[3];
+            D = D != 0 ? 1./D : 0;
+            double A11 = M[4]*D, A22=M[0]*D;
+            M[0] = A11; M[1] *= -D;
+            M[3] *= -D; M[4] = A22;
+            double b1 = -M[0]*M[2] - M[1]*M[5];
+            double b2 = -M[3]*M[2] - M[4]*M[5];
+            M[2] = b1; M[5] = b2;
+        }
+    }
+
+    if( inplace )
+        src = src.clone();
+
+    size_t deltaSize = 0;
+    if( !perspective )
+        for( i = 0; i < n; i++ )
+            deltaSize += dst[i].cols*2;
+    AutoBuffer<int> _abdelta(deltaSize);
+    int* abdelta = _abdelta.data();
+
+    // every crop is cut into row stripes of ~64K pixels; all stripes of all crops
+    // are then processed by a single parallel_for_ call
+    std::vector<Ptr<ParallelLoopBody> > bodies(n);
+    std::vector<std::pair<int, Range> > stripes;
+    const int AB_BITS = MAX(10, (int)INTER_BITS);
+    const int AB_SCALE = 1 << AB_BITS;
+
+    for( i = 0; i < n; i++ )
+    {
+        const double* M = &coeffs[i*9];
+        if( dst[i].empty() )
+            continue;
+        if( perspective )
+            bodies[i].reset(new WarpPerspectiveInvoker(src, dst[i], M, interpolation,
+                                                       borderType, borderValue));
+        else
+        {
+            int* adelta = abdelta, *bdelta = adelta + dst[i].cols;
+            abdelta += dst[i].cols*2;
+            for( int x = 0; x < dst[i].cols; x++ )
+            {
+                adelta[x] = saturate_cast<int>(M[0]*x*AB_SCALE);
+                bdelta[x] = saturate_cast<int>(M[3]*x*AB_SCALE);
+            }
+            bodies[i].reset(new WarpAffineInvoker(src, dst[i], interpolation, borderType,
+                                                  borderValue, adelta, bdelta, M));
+        }
+
+        int stripeRows = std::max(32, (1 << 16)/dst[i].cols);
+        for( int y = 0; y < dst[i].rows; y += stripeRows )
+            stripes.push_back(std::make_pair(i, Range(y, std::min(y + stripeRows, dst[i].rows))));
+    }
+
+    parallel_for_(Range(0, (int)stripes.size()), [&](const Range& range)
+    {
+        for( int j = range.start; j < range.end; j++ )
+            (*bodies[stripes[j].first])(stripes[j].second);
+    });
+}
+
+}
+
+void cv::warpAffineBatch( InputArray src, OutputArrayOfArrays dst,
+                          InputArrayOfArrays M, const std::vector<Size>& dsize,
+                          int flags, int borderType, const Scalar& borderValue )
+{
+    CV_INSTRUMENT_REGION();
+
+    warpTransformBatch(src, dst, M, dsize, flags, borderType, borderValue, false);
+}
+
+void cv::warpPerspectiveBatch( InputArray src, OutputArrayOfArrays dst,
+                               InputArrayOfArrays M, const std::vector<Size>& dsize,
+                               int flags, int borderType, const Scalar& borderValue )
+{
+    CV_INSTRUMENT_REGION();
+
+    warpTransformBatch(src, dst, M, dsize, flags, borderType, borderValue, true);
+}
+
+
 cv::Matx23d cv::getRotationMatrix2D_(Point2f center, double angle, double scale)
 {
     CV_INSTRUMENT_REGION();
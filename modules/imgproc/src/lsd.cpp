@@ -40,6 +40,7 @@
 //M*/
 
 #include "precomp.hpp"
+#include "opencv2/core/hal/intrin.hpp"
 #include <vector>
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -62,6 +63,7 @@
 
 #define NOTUSED     0   // Label for pixels not used in yet.
 #define USED        1   // Label for pixels already used in detection.
+#define DEFERRED    2   // Label for pixels of regions crossing the tile borders.
 
 #define RELATIVE_ERROR_FACTOR 100.0
 
@@ -232,6 +234,14 @@ public:
  */
     int compareSegments(const Size& size, InputArray lines1, InputArray lines2, InputOutputArray _image = noArray()) CV_OVERRIDE;
 
+    void setTileSize(int _tile_size) CV_OVERRIDE
+    {
+        CV_CheckGE(_tile_size, 0, "");
+        tile_size = _tile_size;
+    }
+
+    int getTileSize() const CV_OVERRIDE { return tile_size; }
+
 private:
     Mat image;
     Mat scaled_image;
@@ -242,6 +252,8 @@ private:
     int img_width;
     int img_height;
     double LOG_NT;
+    size_t min_reg_size;
+    int tile_size;
 
     bool w_needed;
     bool p_needed;
@@ -283,6 +295,15 @@ private:
         double p;                 // probability of a point with angle within 'prec'
     };
 
+    struct segment
+    {
+        size_t seed;              // index of the seed point in ordered_points
+        rect rec;
+        double log_nfa;
+    };
+
+    enum { SEED_NONE = 0, SEED_SEGMENT = 1, SEED_ESCAPED = 2 };
+
     LineSegmentDetectorImpl& operator= (const LineSegmentDetectorImpl&); // to quiet MSVC
 
 /**
@@ -311,6 +332,27 @@ private:
  */
     void ll_angle(const double& threshold, const unsigned int& n_bins);
 
+/**
+ * Grow a region from the seed point and approximate it with a line segment.
+ *
+ * @param s         The seed point.
+ * @param bounds    The region is grown within these bounds.
+ * @param reg       Buffer for the points of the region.
+ * @param seg       Return: The found line segment.
+ * @return          SEED_SEGMENT if a segment is found, SEED_ESCAPED if the region crosses the bounds,
+ *                  SEED_NONE otherwise.
+ */
+    int grow_segment(const Point2i& s, const Rect& bounds, std::vector<RegionPoint>& reg, segment& seg);
+
+/**
+ * Find the line segments growing the regions in parallel over tiles of the image.
+ * Regions crossing the tile borders are grown afterwards over the whole image in the order of their seeds.
+ *
+ * @param tile      Size of the tiles.
+ * @param segments  Return: The found segments, ordered by their seed points.
+ */
+    void grow_segments_tiled(int tile, std::vector<segment>& segments);
+
 /**
  * Grow a region starting from point s with a defined precision,
  * returning the containing points size and the angle of the gradients.
@@ -319,9 +361,11 @@ private:
  * @param reg       Return: Vector of points, that are part of the region
  * @param reg_angle Return: The mean angle of the region.
  * @param prec      The precision by which each region angle should be aligned to the mean.
+ * @param bounds    The region is grown within these bounds.
+ * @return          False if an aligned point outside of the bounds is met, the region is incomplete then.
  */
-    void region_grow(const Point2i& s, std::vector<RegionPoint>& reg,
-                     double& reg_angle, const double& prec);
+    bool region_grow(const Point2i& s, std::vector<RegionPoint>& reg,
+                     double& reg_angle, const double& prec, const Rect& bounds);
 
 /**
  * Finds the bounding rotated rectangle of a region.
@@ -347,9 +391,11 @@ private:
  * near the region's starting point. Then, a new region is grown starting from the same point, but using the
  * estimated angle tolerance. If this fails to produce a rectangle with the right density of region points,
  * 'reduce_region_radius' is called to try to satisfy this condition.
+ * 'escaped' is set if the new region crosses the bounds.
  */
     bool refine(std::vector<RegionPoint>& reg, double reg_angle,
-                const double prec, double p, rect& rec, const double& density_th);
+                const double prec, double p, rect& rec, const double& density_th,
+                const Rect& bounds, bool& escaped);
 
 /**
  * Reduce the region size, by elimination the points far from the starting point, until that leads to
@@ -382,13 +428,6 @@ private:
  * @return      Whether the point is aligned.
  */
     bool isAligned(int x, int y, const double& theta, const double& prec) const;
-
-public:
-    // Compare norm
-    static inline bool compare_norm( const normPoint& n1, const normPoint& n2 )
-    {
-        return (n1.norm > n2.norm);
-    }
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -406,7 +445,8 @@ CV_EXPORTS Ptr<LineSegmentDetector> createLineSegmentDetector(
 
 LineSegmentDetectorImpl::LineSegmentDetectorImpl(int _refine, double _scale, double _sigma_scale, double _quant,
         double _ang_th, double _log_eps, double _density_th, int _n_bins)
-        : img_width(0), img_height(0), LOG_NT(0), w_needed(false), p_needed(false), n_needed(false),
+        : img_width(0), img_height(0), LOG_NT(0), min_reg_size(0), tile_size(0),
+          w_needed(false), p_needed(false), n_needed(false),
           SCALE(_scale), doRefine(_refine), SIGMA_SCALE(_sigma_scale), QUANT(_quant),
           ANG_TH(_ang_th), LOG_EPS(_log_eps), DENSITY_TH(_density_th), N_BINS(_n_bins)
 {
@@ -471,63 +511,186 @@ void LineSegmentDetectorImpl::flsd(std::vector<Vec4f>& lines,
     }
 
     LOG_NT = 5 * (log10(double(img_width)) + log10(double(img_height))) / 2 + log10(11.0);
-    const size_t min_reg_size = size_t(-LOG_NT/log10(p)); // minimal number of points in region that can give a meaningful event
+    min_reg_size = size_t(-LOG_NT/log10(p)); // minimal number of points in region that can give a meaningful event
 
     // // Initialize region only when needed
     // Mat region = Mat::zeros(scaled_image.size(), CV_8UC1);
     used = Mat_<uchar>::zeros(scaled_image.size()); // zeros = NOTUSED
-    std::vector<RegionPoint> reg;
 
     // Search for line segments
-    for(size_t i = 0, points_size = ordered_points.size(); i < points_size; ++i)
+    std::vector<segment> segments;
+    const int tile = tile_size > 0 ? std::max(cvRound(tile_size * std::min(SCALE, 1.0)), 1) : 0;
+    if(tile > 0 && (tile < img_width || tile < img_height))
     {
-        const Point2i& point = ordered_points[i].p;
-        if((used.at<uchar>(point) == NOTUSED) && (angles.at<double>(point) != NOTDEF))
+        grow_segments_tiled(tile, segments);
+    }
+    else
+    {
+        const Rect bounds(0, 0, img_width, img_height);
+        std::vector<RegionPoint> reg;
+        segment seg;
+        for(size_t i = 0, points_size = ordered_points.size(); i < points_size; ++i)
         {
-            double reg_angle;
-            region_grow(ordered_points[i].p, reg, reg_angle, prec);
+            const Point2i& point = ordered_points[i].p;
+            if(used.at<uchar>(point) == NOTUSED &&
+               grow_segment(point, bounds, reg, seg) == SEED_SEGMENT)
+            {
+                seg.seed = i;
+                segments.push_back(seg);
+            }
+        }
+    }
+
+    for(size_t i = 0; i < segments.size(); ++i)
+    {
+        // Found new line
+        rect& rec = segments[i].rec;
+
+        // Add the offset
+        rec.x1 += 0.5; rec.y1 += 0.5;
+        rec.x2 += 0.5; rec.y2 += 0.5;
+
+        // scale the result values if a sub-sampling was performed
+        if(SCALE != 1)
+        {
+            rec.x1 /= SCALE; rec.y1 /= SCALE;
+            rec.x2 /= SCALE; rec.y2 /= SCALE;
+            rec.width /= SCALE;
+        }
+
+        //Store the relevant data
+        lines.push_back(Vec4f(float(rec.x1), float(rec.y1), float(rec.x2), float(rec.y2)));
+        if(w_needed) widths.push_back(rec.width);
+        if(p_needed) precisions.push_back(rec.p);
+        if(n_needed && doRefine >= LSD_REFINE_ADV) nfas.push_back(segments[i].log_nfa);
+    }
+}
+
+int LineSegmentDetectorImpl::grow_segment(const Point2i& s, const Rect& bounds,
+                                          std::vector<RegionPoint>& reg, segment& seg)
+{
+    // Angle tolerance
+    const double prec = CV_PI * ANG_TH / 180;
+    const double p = ANG_TH / 180;
 
-            // Ignore small regions
-            if(reg.size() < min_reg_size) { continue; }
+    double reg_angle;
+    bool escaped = !region_grow(s, reg, reg_angle, prec, bounds);
 
-            // Construct rectangular approximation for the region
-            rect rec;
-            region2rect(reg, reg_angle, prec, p, rec);
+    if(!escaped)
+    {
+        // Ignore small regions
+        if(reg.size() < min_reg_size) { return SEED_NONE; }
 
-            double log_nfa = -1;
-            if(doRefine > LSD_REFINE_NONE)
+        // Construct rectangular approximation for the region
+        rect& rec = seg.rec;
+        region2rect(reg, reg_angle, prec, p, rec);
+
+        seg.log_nfa = -1;
+        if(doRefine > LSD_REFINE_NONE)
+        {
+            // At least REFINE_STANDARD lvl.
+            if(!refine(reg, reg_angle, prec, p, rec, DENSITY_TH, bounds, escaped))
             {
-                // At least REFINE_STANDARD lvl.
-                if(!refine(reg, reg_angle, prec, p, rec, DENSITY_TH)) { continue; }
+                if(!escaped) { return SEED_NONE; }
+            }
+            else if(doRefine >= LSD_REFINE_ADV)
+            {
+                // Compute NFA
+                seg.log_nfa = rect_improve(rec);
+                if(seg.log_nfa <= LOG_EPS) { return SEED_NONE; }
+            }
+        }
+        if(!escaped) { return SEED_SEGMENT; }
+    }
 
-                if(doRefine >= LSD_REFINE_ADV)
+    // The region is grown again over the whole image later,
+    // its points are reserved till then to not be used by the regions of the tile
+    for(size_t i = 0; i < reg.size(); ++i)
+        *(reg[i].used) = DEFERRED;
+    return SEED_ESCAPED;
+}
+
+void LineSegmentDetectorImpl::grow_segments_tiled(int tile, std::vector<segment>& segments)
+{
+    const int ntiles_x = (img_width + tile - 1) / tile;
+    const int ntiles_y = (img_height + tile - 1) / tile;
+    const int ntiles = ntiles_x * ntiles_y;
+    const size_t points_size = ordered_points.size();
+
+    // Distribute the seed points among the tiles keeping their order
+    std::vector<int> seeds(points_size), tile_ofs(ntiles + 1, 0);
+    for(size_t i = 0; i < points_size; ++i)
+    {
+        const Point2i& pt = ordered_points[i].p;
+        tile_ofs[(pt.y / tile) * ntiles_x + pt.x / tile + 1]++;
+    }
+    for(int t = 0; t < ntiles; ++t)
+        tile_ofs[t + 1] += tile_ofs[t];
+    {
+        std::vector<int> pos(tile_ofs.begin(), tile_ofs.end() - 1);
+        for(size_t i = 0; i < points_size; ++i)
+        {
+            const Point2i& pt = ordered_points[i].p;
+            seeds[pos[(pt.y / tile) * ntiles_x + pt.x / tile]++] = (int)i;
+        }
+    }
+
+    std::vector<std::vector<segment> > tile_segments(ntiles);
+
+    parallel_for_(Range(0, ntiles), [&](const Range& range)
+    {
+        // The buffer is reused by all regions of the stripe
+        std::vector<RegionPoint> reg;
+        segment seg;
+        for(int t = range.start; t < range.end; ++t)
+        {
+            const int tx = (t % ntiles_x) * tile, ty = (t / ntiles_x) * tile;
+            const Rect bounds(tx, ty, std::min(tile, img_width - tx), std::min(tile, img_height - ty));
+            for(int k = tile_ofs[t]; k < tile_ofs[t + 1]; ++k)
+            {
+                const Point2i& point = ordered_points[seeds[k]].p;
+                if(used.at<uchar>(point) != NOTUSED)
+                    continue;
+                if(grow_segment(point, bounds, reg, seg) == SEED_SEGMENT)
                 {
-                    // Compute NFA
-                    log_nfa = rect_improve(rec);
-                    if(log_nfa <= LOG_EPS) { continue; }
+                    seg.seed = seeds[k];
+                    tile_segments[t].push_back(seg);
                 }
             }
-            // Found new line
+        }
+    });
 
-            // Add the offset
-            rec.x1 += 0.5; rec.y1 += 0.5;
-            rec.x2 += 0.5; rec.y2 += 0.5;
+    for(int t = 0; t < ntiles; ++t)
+        segments.insert(segments.end(), tile_segments[t].begin(), tile_segments[t].end());
 
-            // scale the result values if a sub-sampling was performed
-            if(SCALE != 1)
-            {
-                rec.x1 /= SCALE; rec.y1 /= SCALE;
-                rec.x2 /= SCALE; rec.y2 /= SCALE;
-                rec.width /= SCALE;
-            }
+    // Regions crossing the tile borders are grown over the whole image in the order of their seeds.
+    // The points released by them are available for the following seeds as in the serial search.
+    for(int y = 0; y < img_height; ++y)
+    {
+        uchar* used_row = used.ptr<uchar>(y);
+        for(int x = 0; x < img_width; ++x)
+        {
+            if(used_row[x] == DEFERRED)
+                used_row[x] = NOTUSED;
+        }
+    }
 
-            //Store the relevant data
-            lines.push_back(Vec4f(float(rec.x1), float(rec.y1), float(rec.x2), float(rec.y2)));
-            if(w_needed) widths.push_back(rec.width);
-            if(p_needed) precisions.push_back(rec.p);
-            if(n_needed && doRefine >= LSD_REFINE_ADV) nfas.push_back(log_nfa);
+    const Rect bounds(0, 0, img_width, img_height);
+    std::vector<RegionPoint> reg;
+    segment seg;
+    for(size_t i = 0; i < points_size; ++i)
+    {
+        const Point2i& point = ordered_points[i].p;
+        if(used.at<uchar>(point) == NOTUSED &&
+           grow_segment(point, bounds, reg, seg) == SEED_SEGMENT)
+        {
+            seg.seed = i;
+            segments.push_back(seg);
         }
     }
+
+    std::sort(segments.begin(), segments.end(),
+              [](const segment& a, const segment& b) { return a.seed < b.seed; });
 }
 
 void LineSegmentDetectorImpl::ll_angle(const double& threshold,
@@ -545,57 +708,112 @@ void LineSegmentDetectorImpl::ll_angle(const double& threshold,
     angles.col(img_width - 1).setTo(NOTDEF);
 
     // Computing gradient for remaining pixels
-    double max_grad = -1;
-    for(int y = 0; y < img_height - 1; ++y)
+    std::vector<double> max_grad_rows(img_height, -1);
+    parallel_for_(Range(0, img_height - 1), [&](const Range& range)
     {
-        const uchar* scaled_image_row = scaled_image.ptr<uchar>(y);
-        const uchar* next_scaled_image_row = scaled_image.ptr<uchar>(y+1);
-        double* angles_row = angles.ptr<double>(y);
-        double* modgrad_row = modgrad.ptr<double>(y);
-        for(int x = 0; x < img_width-1; ++x)
-        {
-            int DA = next_scaled_image_row[x + 1] - scaled_image_row[x];
-            int BC = scaled_image_row[x + 1] - next_scaled_image_row[x];
-            int gx = DA + BC;    // gradient x component
-            int gy = DA - BC;    // gradient y component
-            double norm = std::sqrt((gx * gx + gy * gy) / 4.0); // gradient norm
-
-            modgrad_row[x] = norm;    // store gradient
+        const int len = img_width - 1;
+        AutoBuffer<float> _buf(len * 2);
+        float* gx_buf = _buf.data();
+        float* ngy_buf = gx_buf + len;
 
-            if (norm <= threshold)  // norm too small, gradient no defined
+        for(int y = range.start; y < range.end; ++y)
+        {
+            const uchar* scaled_image_row = scaled_image.ptr<uchar>(y);
+            const uchar* next_scaled_image_row = scaled_image.ptr<uchar>(y+1);
+            double* angles_row = angles.ptr<double>(y);
+            double* modgrad_row = modgrad.ptr<double>(y);
+
+            int x = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+            const int VECSZ = VTraits<v_int16>::vlanes();
+            for(; x <= len - VECSZ; x += VECSZ)
             {
-                angles_row[x] = NOTDEF;
+                v_int16 a = v_reinterpret_as_s16(vx_load_expand(scaled_image_row + x));
+                v_int16 b = v_reinterpret_as_s16(vx_load_expand(scaled_image_row + x + 1));
+                v_int16 c = v_reinterpret_as_s16(vx_load_expand(next_scaled_image_row + x));
+                v_int16 d = v_reinterpret_as_s16(vx_load_expand(next_scaled_image_row + x + 1));
+                v_int16 DA = v_sub(d, a), BC = v_sub(b, c);
+                v_int32 gx0, gx1, ngy0, ngy1;
+                v_expand(v_add(DA, BC), gx0, gx1);
+                v_expand(v_sub(BC, DA), ngy0, ngy1);
+                v_store(gx_buf + x, v_cvt_f32(gx0));
+                v_store(gx_buf + x + VECSZ/2, v_cvt_f32(gx1));
+                v_store(ngy_buf + x, v_cvt_f32(ngy0));
+                v_store(ngy_buf + x + VECSZ/2, v_cvt_f32(ngy1));
             }
-            else
+#endif
+            for(; x < len; ++x)
             {
-                angles_row[x] = fastAtan2(float(gx), float(-gy)) * DEG_TO_RADS;  // gradient angle computation
-                if (norm > max_grad) { max_grad = norm; }
+                int DA = next_scaled_image_row[x + 1] - scaled_image_row[x];
+                int BC = scaled_image_row[x + 1] - next_scaled_image_row[x];
+                gx_buf[x] = float(DA + BC);    // gradient x component
+                ngy_buf[x] = float(BC - DA);   // negated gradient y component
             }
 
+            double max_grad = -1;
+            for(x = 0; x < len; ++x)
+            {
+                // the squares of the components are exact in float
+                const float gx = gx_buf[x], gy = ngy_buf[x];
+                double norm = std::sqrt((gx * gx + gy * gy) / 4.0); // gradient norm
+
+                modgrad_row[x] = norm;    // store gradient
+
+                if (norm <= threshold)  // norm too small, gradient no defined
+                {
+                    angles_row[x] = NOTDEF;
+                }
+                else
+                {
+                    // scalar fastAtan2(), vectorized versions may use FMA and differ in the last bits
+                    angles_row[x] = fastAtan2(gx, gy) * DEG_TO_RADS;  // gradient angle computation
+                    if (norm > max_grad) { max_grad = norm; }
+                }
+            }
+            max_grad_rows[y] = max_grad;
         }
-    }
+    });
+    const double max_grad = *std::max_element(max_grad_rows.begin(), max_grad_rows.end());
 
-    // Compute histogram of gradient values
+    // Compute histogram of gradient values.
+    // Points with undefined gradient can't be seeds of regions, so they aren't ordered.
     double bin_coef = (max_grad > 0) ? double(n_bins - 1) / max_grad : 0; // If all image is smooth, max_grad <= 0
+    std::vector<int> bin_ofs(n_bins + 1, 0);
     for(int y = 0; y < img_height - 1; ++y)
     {
+        const double* angles_row = angles.ptr<double>(y);
         const double* modgrad_row = modgrad.ptr<double>(y);
         for(int x = 0; x < img_width - 1; ++x)
         {
+            if(angles_row[x] != NOTDEF)
+                bin_ofs[n_bins - int(modgrad_row[x] * bin_coef)]++;
+        }
+    }
+    for(unsigned int i = 0; i < n_bins; ++i)
+        bin_ofs[i + 1] += bin_ofs[i];
+
+    // Bucket sort in the descending order of the norm, the points of a bin keep the raster order
+    // to ensure deterministic region growing and thus overall LSD result determinism.
+    ordered_points.resize(bin_ofs[n_bins]);
+    for(int y = 0; y < img_height - 1; ++y)
+    {
+        const double* angles_row = angles.ptr<double>(y);
+        const double* modgrad_row = modgrad.ptr<double>(y);
+        for(int x = 0; x < img_width - 1; ++x)
+        {
+            if(angles_row[x] == NOTDEF)
+                continue;
             normPoint _point;
             int i = int(modgrad_row[x] * bin_coef);
             _point.p = Point(x, y);
             _point.norm = i;
-            ordered_points.push_back(_point);
+            ordered_points[bin_ofs[n_bins - 1 - i]++] = _point;
         }
     }
-
-    // Use stable sort to ensure deterministic region growing and thus overall LSD result determinism.
-    std::stable_sort(ordered_points.begin(), ordered_points.end(), compare_norm);
 }
 
-void LineSegmentDetectorImpl::region_grow(const Point2i& s, std::vector<RegionPoint>& reg,
-                                      double& reg_angle, const double& prec)
+bool LineSegmentDetectorImpl::region_grow(const Point2i& s, std::vector<RegionPoint>& reg,
+                                      double& reg_angle, const double& prec, const Rect& bounds)
 {
     reg.clear();
 
@@ -612,6 +830,7 @@ void LineSegmentDetectorImpl::region_grow(const Point2i& s, std::vector<RegionPo
     float sumdx = float(std::cos(reg_angle));
     float sumdy = float(std::sin(reg_angle));
     *seed.used = USED;
+    bool contained = true;
 
     //Try neighboring regions
     for (size_t i = 0;i<reg.size();i++)
@@ -619,6 +838,18 @@ void LineSegmentDetectorImpl::region_grow(const Point2i& s, std::vector<RegionPo
         const RegionPoint& rpoint = reg[i];
         int xx_min = std::max(rpoint.x - 1, 0), xx_max = std::min(rpoint.x + 1, img_width - 1);
         int yy_min = std::max(rpoint.y - 1, 0), yy_max = std::min(rpoint.y + 1, img_height - 1);
+        if(xx_min < bounds.x || xx_max >= bounds.x + bounds.width ||
+           yy_min < bounds.y || yy_max >= bounds.y + bounds.height)
+        {
+            // The neighborhood crosses the bounds, the points outside can't be checked for usage.
+            // The region keeps growing within the bounds to reserve all its points there.
+            for(int yy = yy_min; yy <= yy_max && contained; ++yy)
+                for(int xx = xx_min; xx <= xx_max && contained; ++xx)
+                    if(!bounds.contains(Point(xx, yy)) && isAligned(xx, yy, reg_angle, prec))
+                        contained = false;
+            xx_min = std::max(xx_min, bounds.x); xx_max = std::min(xx_max, bounds.x + bounds.width - 1);
+            yy_min = std::max(yy_min, bounds.y); yy_max = std::min(yy_max, bounds.y + bounds.height - 1);
+        }
         for(int yy = yy_min; yy <= yy_max; ++yy)
         {
             uchar* used_row = used.ptr<uchar>(yy);
@@ -627,7 +858,7 @@ void LineSegmentDetectorImpl::region_grow(const Point2i& s, std::vector<RegionPo
             for(int xx = xx_min; xx <= xx_max; ++xx)
             {
                 uchar& is_used = used_row[xx];
-                if(is_used != USED &&
+                if(is_used == NOTUSED &&
                    (isAligned(xx, yy, reg_angle, prec)))
                 {
                     const double& angle = angles_row[xx];
@@ -650,6 +881,7 @@ void LineSegmentDetectorImpl::region_grow(const Point2i& s, std::vector<RegionPo
             }
         }
     }
+    return contained;
 }
 
 void LineSegmentDetectorImpl::region2rect(const std::vector<RegionPoint>& reg,
@@ -749,7 +981,8 @@ double LineSegmentDetectorImpl::get_theta(const std::vector<RegionPoint>& reg, c
 }
 
 bool LineSegmentDetectorImpl::refine(std::vector<RegionPoint>& reg, double reg_angle,
-                                 const double prec, double p, rect& rec, const double& density_th)
+                                 const double prec, double p, rect& rec, const double& density_th,
+                                 const Rect& bounds, bool& escaped)
 {
     double density = double(reg.size()) / (dist(rec.x1, rec.y1, rec.x2, rec.y2) * rec.width);
 
@@ -780,7 +1013,11 @@ bool LineSegmentDetectorImpl::refine(std::vector<RegionPoint>& reg, double reg_a
     double tau = 2.0 * sqrt((s_sum - 2.0 * mean_angle * sum) / double(n) + mean_angle * mean_angle);
 
     // Try new region
-    region_grow(Point(reg[0].x, reg[0].y), reg, reg_angle, tau);
+    if (!region_grow(Point(reg[0].x, reg[0].y), reg, reg_angle, tau, bounds))
+    {
+        escaped = true;
+        return false;
+    }
 
     if (reg.size() < 2) { return false; }
 
@@ -977,7 +1214,6 @@ double LineSegmentDetectorImpl::rect_nfa(const rect& rec) const
     double top_y = ordered_y[0].y, bottom_y = ordered_y[2].y;
 
     // Loop around all points in the region and count those that are aligned.
-    std::vector<cv::Point> points;
     double left_limit, right_limit;
     for(int y = (int) ceil(top_y); y <= (int) ceil(bottom_y); ++y)
     {
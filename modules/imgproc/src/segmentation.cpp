@@ -41,6 +41,7 @@
 //M*/
 
 #include "precomp.hpp"
+#include "opencv2/core/hal/intrin.hpp"
 
 /****************************************************************************************\
 *                                       Watershed                                        *
@@ -53,7 +54,7 @@ struct WSNode
 {
     int next;
     int mask_ofs;
-    int img_ofs;
+    int diff_ofs;
 };
 
 // Queue for WSNodes
@@ -82,6 +83,49 @@ allocWSNodes( std::vector<WSNode>& storage )
     return sz;
 }
 
+// Computes the highest absolute channel differences of the pixels and their right (hdiff)
+// and bottom (vdiff) neighbors
+static void
+calcWSDiffs( const Mat& src, Mat& hdiff, Mat& vdiff )
+{
+    const Size size = src.size();
+    hdiff.create( size, CV_8UC1 );
+    vdiff.create( size, CV_8UC1 );
+    parallel_for_( Range(0, size.height), [&]( const Range& range )
+    {
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const uchar* img = src.ptr(i);
+            const uchar* next = src.ptr(std::min(i + 1, size.height - 1));
+            uchar* hd = hdiff.ptr(i);
+            uchar* vd = vdiff.ptr(i);
+            int j = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+            const int VECSZ = VTraits<v_uint8>::vlanes();
+            for( ; j <= size.width - 1 - VECSZ; j += VECSZ )
+            {
+                v_uint8 b0, g0, r0, b1, g1, r1, b2, g2, r2;
+                v_load_deinterleave( img + j*3, b0, g0, r0 );
+                v_load_deinterleave( img + j*3 + 3, b1, g1, r1 );
+                v_load_deinterleave( next + j*3, b2, g2, r2 );
+                v_store( hd + j, v_max(v_max(v_absdiff(b0, b1), v_absdiff(g0, g1)), v_absdiff(r0, r1)) );
+                v_store( vd + j, v_max(v_max(v_absdiff(b0, b2), v_absdiff(g0, g2)), v_absdiff(r0, r2)) );
+            }
+#endif
+            for( ; j < size.width; j++ )
+            {
+                const uchar* ptr = img + j*3;
+                const uchar* right = j < size.width - 1 ? ptr + 3 : ptr;
+                const uchar* bottom = next + j*3;
+                hd[j] = (uchar)std::max(std::max(std::abs(ptr[0] - right[0]), std::abs(ptr[1] - right[1])),
+                                        std::abs(ptr[2] - right[2]));
+                vd[j] = (uchar)std::max(std::max(std::abs(ptr[0] - bottom[0]), std::abs(ptr[1] - bottom[1])),
+                                        std::abs(ptr[2] - bottom[2]));
+            }
+        }
+    } );
+}
+
 }
 
 
@@ -108,17 +152,13 @@ void cv::watershed( InputArray _src, InputOutputArray _markers )
     // Non-empty queue with highest priority
     int active_queue;
     int i, j;
-    // Color differences
-    int db, dg, dr;
     int subs_tab[513];
 
-    // MAX(a,b) = b + MAX(a-b,0)
-    #define ws_max(a,b) ((b) + subs_tab[(a)-(b)+NQ])
     // MIN(a,b) = a - MAX(a-b,0)
     #define ws_min(a,b) ((a) - subs_tab[(a)-(b)+NQ])
 
-    // Create a new node with offsets mofs and iofs in queue idx
-    #define ws_push(idx,mofs,iofs)          \
+    // Create a new node with offsets mofs and dofs in queue idx
+    #define ws_push(idx,mofs,dofs)          \
     {                                       \
         if( !free_node )                    \
             free_node = allocWSNodes( storage );\
@@ -126,7 +166,7 @@ void cv::watershed( InputArray _src, InputOutputArray _markers )
         free_node = storage[free_node].next;\
         storage[node].next = 0;             \
         storage[node].mask_ofs = mofs;      \
-        storage[node].img_ofs = iofs;       \
+        storage[node].diff_ofs = dofs;      \
         if( q[idx].last )                   \
             storage[q[idx].last].next=node; \
         else                                \
@@ -135,7 +175,7 @@ void cv::watershed( InputArray _src, InputOutputArray _markers )
     }
 
     // Get next node from queue idx
-    #define ws_pop(idx,mofs,iofs)           \
+    #define ws_pop(idx,mofs,dofs)           \
     {                                       \
         node = q[idx].first;                \
         q[idx].first = storage[node].next;  \
@@ -144,27 +184,20 @@ void cv::watershed( InputArray _src, InputOutputArray _markers )
         storage[node].next = free_node;     \
         free_node = node;                   \
         mofs = storage[node].mask_ofs;      \
-        iofs = storage[node].img_ofs;       \
-    }
-
-    // Get highest absolute channel difference in diff
-    #define c_diff(ptr1,ptr2,diff)           \
-    {                                        \
-        db = std::abs((ptr1)[0] - (ptr2)[0]);\
-        dg = std::abs((ptr1)[1] - (ptr2)[1]);\
-        dr = std::abs((ptr1)[2] - (ptr2)[2]);\
-        diff = ws_max(db,dg);                \
-        diff = ws_max(diff,dr);              \
-        CV_Assert( 0 <= diff && diff <= 255 );  \
+        dofs = storage[node].diff_ofs;      \
     }
 
     CV_Assert( src.type() == CV_8UC3 && dst.type() == CV_32SC1 );
     CV_Assert( src.size() == dst.size() );
 
-    // Current pixel in input image
-    const uchar* img = src.ptr();
-    // Step size to next row in input image
-    int istep = int(src.step/sizeof(img[0]));
+    // Highest absolute channel differences to the right and bottom neighbors,
+    // computed in parallel beforehand
+    Mat hdiffs, vdiffs;
+    calcWSDiffs( src, hdiffs, vdiffs );
+    const uchar* hdiff = hdiffs.ptr();
+    const uchar* vdiff = vdiffs.ptr();
+    // Step size to next row in difference images
+    int dstep = size.width;
 
     // Current pixel in mask image
     int* mask = dst.ptr<int>();
@@ -184,7 +217,7 @@ void cv::watershed( InputArray _src, InputOutputArray _markers )
     // determine the initial boundaries of the basins
     for( i = 1; i < size.height-1; i++ )
     {
-        img += istep; mask += mstep;
+        mask += mstep;
         mask[0] = mask[size.width-1] = WSHED; // boundary pixels
 
         for( j = 1; j < size.width-1; j++ )
@@ -194,29 +227,20 @@ void cv::watershed( InputArray _src, InputOutputArray _markers )
             if( m[0] == 0 && (m[-1] > 0 || m[1] > 0 || m[-mstep] > 0 || m[mstep] > 0) )
             {
                 // Find smallest difference to adjacent markers
-                const uchar* ptr = img + j*3;
-                int idx = 256, t;
+                const int dofs = i*dstep + j;
+                int idx = 256;
                 if( m[-1] > 0 )
-                    c_diff( ptr, ptr - 3, idx );
+                    idx = hdiff[dofs - 1];
                 if( m[1] > 0 )
-                {
-                    c_diff( ptr, ptr + 3, t );
-                    idx = ws_min( idx, t );
-                }
+                    idx = ws_min( idx, hdiff[dofs] );
                 if( m[-mstep] > 0 )
-                {
-                    c_diff( ptr, ptr - istep, t );
-                    idx = ws_min( idx, t );
-                }
+                    idx = ws_min( idx, vdiff[dofs - dstep] );
                 if( m[mstep] > 0 )
-                {
-                    c_diff( ptr, ptr + istep, t );
-                    idx = ws_min( idx, t );
-                }
+                    idx = ws_min( idx, vdiff[dofs] );
 
                 // Add to according queue
                 CV_Assert( 0 <= idx && idx <= 255 );
-                ws_push( idx, i*mstep + j, i*istep + j*3 );
+                ws_push( idx, i*mstep + j, dofs );
                 m[0] = IN_QUEUE;
             }
         }
@@ -232,16 +256,14 @@ void cv::watershed( InputArray _src, InputOutputArray _markers )
         return;
 
     active_queue = i;
-    img = src.ptr();
     mask = dst.ptr<int>();
 
     // recursively fill the basins
     for(;;)
     {
-        int mofs, iofs;
+        int mofs, dofs;
         int lab = 0, t;
         int* m;
-        const uchar* ptr;
 
         // Get non-empty queue with highest priority
         // Exit condition: empty priority queue
@@ -256,11 +278,10 @@ void cv::watershed( InputArray _src, InputOutputArray _markers )
         }
 
         // Get next node
-        ws_pop( active_queue, mofs, iofs );
+        ws_pop( active_queue, mofs, dofs );
 
-        // Calculate pointer to current pixel in input and marker image
+        // Calculate pointer to current pixel in marker image
         m = mask + mofs;
-        ptr = img + iofs;
 
         // Check surrounding pixels for labels
         // to determine label for current pixel
@@ -295,29 +316,29 @@ void cv::watershed( InputArray _src, InputOutputArray _markers )
         // Add adjacent, unlabeled pixels to corresponding queue
         if( m[-1] == 0 )
         {
-            c_diff( ptr, ptr - 3, t );
-            ws_push( t, mofs - 1, iofs - 3 );
+            t = hdiff[dofs - 1];
+            ws_push( t, mofs - 1, dofs - 1 );
             active_queue = ws_min( active_queue, t );
             m[-1] = IN_QUEUE;
         }
         if( m[1] == 0 )
         {
-            c_diff( ptr, ptr + 3, t );
-            ws_push( t, mofs + 1, iofs + 3 );
+            t = hdiff[dofs];
+            ws_push( t, mofs + 1, dofs + 1 );
             active_queue = ws_min( active_queue, t );
             m[1] = IN_QUEUE;
         }
         if( m[-mstep] == 0 )
         {
-            c_diff( ptr, ptr - istep, t );
-            ws_push( t, mofs - mstep, iofs - istep );
+            t = vdiff[dofs - dstep];
+            ws_push( t, mofs - mstep, dofs - dstep );
             active_queue = ws_min( active_queue, t );
             m[-mstep] = IN_QUEUE;
         }
         if( m[mstep] == 0 )
         {
-            c_diff( ptr, ptr + istep, t );
-            ws_push( t, mofs + mstep, iofs + istep );
+            t = vdiff[dofs];
+            ws_push( t, mofs + mstep, dofs + dstep );
             active_queue = ws_min( active_queue, t );
             m[mstep] = IN_QUEUE;
         }
@@ -40,6 +40,7 @@
 //M*/
 
 #include "test_precomp.hpp"
+#include "opencv2/core/utils/arena.hpp"
 
 namespace opencv_test { namespace {
 
@@ -327,5 +328,29 @@ TEST_P(CannyVX, Accuracy)
                 )
     );
 
+TEST(Canny, arena_scope)
+{
+    Mat src(480, 640, CV_8UC3);
+    RNG& rng = theRNG();
+    rng.fill(src, RNG::UNIFORM, 0, 256);
+    GaussianBlur(src, src, Size(7, 7), 2);
+    Mat gray;
+    cvtColor(src, gray, COLOR_BGR2GRAY);
+
+    Mat refColor, refGray;
+    Canny(src, refColor, 10, 30);
+    Canny(gray, refGray, 10, 30);
+
+    for (int iter = 0; iter < 2; iter++)
+    {
+        cv::utils::ArenaScope arena;
+        Mat dstColor, dstGray;
+        Canny(src, dstColor, 10, 30);
+        Canny(gray, dstGray, 10, 30);
+        EXPECT_EQ(0, cvtest::norm(refColor, dstColor, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(refGray, dstGray, NORM_INF));
+    }
+}
+
 }} // namespace
 /* End of file. */
@@ -561,6 +561,70 @@ INSTANTIATE_TEST_CASE_P(
                                      CHAIN_APPROX_TC89_L1,
                                      CHAIN_APPROX_TC89_KCOS)));
 
+// The banded parallel scan must produce the same contours and hierarchy as the serial scan
+typedef testing::TestWithParam<tuple<int, int>> Imgproc_FindContours_Parallel;
+
+TEST_P(Imgproc_FindContours_Parallel, same_as_serial)
+{
+    const int mode = get<0>(GetParam());
+    const int method = get<1>(GetParam());
+    const int nthreads = getNumThreads();
+
+    RNG& rng = TS::ptr()->get_rng();
+    const Size sz(rng.uniform(300, 700), rng.uniform(300, 700));
+    for (int c = 0; c < 5; ++c)
+    {
+        Mat img = Mat::zeros(sz, CV_8UC1);
+        if (c < 4)
+        {
+            // noise + filter + threshold, c == 0 is the noise itself
+            cvtest::randUni(rng, img, 0, 255);
+            if (c > 0)
+                boxFilter(img, img, CV_8U, Size(5, 5));
+            cv::threshold(img, img, c == 0 ? 200 : 44 + c * 42, 255, THRESH_BINARY);
+        }
+        else
+        {
+            // nested rings crossing band borders
+            const Point center(sz.width / 2, sz.height / 2);
+            for (int r = std::min(sz.width, sz.height) / 2 - 2; r > 0; r -= 6)
+                circle(img, center, r, Scalar::all(255), 3);
+            img.row(0).setTo(255);
+            img.col(sz.width - 1).setTo(255);
+        }
+
+        vector<Mat> contours_s, contours_p;
+        vector<Vec4i> hierarchy_s, hierarchy_p;
+        setNumThreads(1);
+        findContours(img, contours_s, hierarchy_s, mode, method, Point(3, -5));
+        setNumThreads(4);
+        findContours(img, contours_p, hierarchy_p, mode, method, Point(3, -5));
+        setNumThreads(nthreads);
+
+        SCOPED_TRACE(format("c = %d", c));
+        ASSERT_EQ(contours_s.size(), contours_p.size());
+        for (size_t i = 0; i < contours_s.size(); ++i)
+        {
+            ASSERT_EQ(contours_s[i].size(), contours_p[i].size()) << "contour = " << i;
+            EXPECT_EQ(0, cvtest::norm(contours_s[i], contours_p[i], NORM_INF)) << "contour = " << i;
+        }
+        ASSERT_EQ(hierarchy_s.size(), hierarchy_p.size());
+        if (!hierarchy_s.empty())
+        {
+            EXPECT_EQ(0, cvtest::norm(Mat(hierarchy_s), Mat(hierarchy_p), NORM_INF));
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    ,
+    Imgproc_FindContours_Parallel,
+    testing::Combine(testing::Values(RETR_EXTERNAL, RETR_LIST, RETR_CCOMP, RETR_TREE),
+                     testing::Values(0,
+                                     CHAIN_APPROX_NONE,
+                                     CHAIN_APPROX_SIMPLE,
+                                     CHAIN_APPROX_TC89_KCOS)));
+
 TEST(Imgproc_FindContours, link_runs)
 {
     const Size sz {500, 500};
@@ -175,4 +175,31 @@ TEST(Imgproc_GrabCut, repeatability)
     EXPECT_EQ(0, countNonZero(mask_2 != mask_3));
 }
 
+TEST(Imgproc_GrabCut, coarse_to_fine)
+{
+    // large enough to be segmented at the coarse level
+    Mat image(600, 800, CV_8UC3);
+    RNG& rng = theRNG();
+    rng.fill(image, RNG::NORMAL, Scalar(60, 120, 60), Scalar::all(15));
+    Mat object(image.size(), CV_8UC3);
+    rng.fill(object, RNG::NORMAL, Scalar(40, 60, 200), Scalar::all(15));
+    Mat objectMask = Mat::zeros(image.size(), CV_8UC1);
+    ellipse(objectMask, Point(420, 290), Size(230, 160), 30, 0, 360, Scalar::all(255), FILLED);
+    circle(objectMask, Point(250, 400), 60, Scalar::all(255), FILLED);
+    object.copyTo(image, objectMask);
+    const Rect roi(100, 60, 620, 480);
+
+    Mat mask_ref, bgdModel_ref, fgdModel_ref;
+    theRNG().state = 12378213;
+    grabCut(image, mask_ref, roi, bgdModel_ref, fgdModel_ref, 2, GC_INIT_WITH_RECT);
+
+    Mat mask, bgdModel, fgdModel;
+    theRNG().state = 12378213;
+    grabCut(image, mask, roi, bgdModel, fgdModel, 2, GC_INIT_WITH_RECT | GC_COARSE_TO_FINE);
+
+    Mat fgd_ref = (mask_ref & 1) != 0, fgd = (mask & 1) != 0;
+    EXPECT_LE(countNonZero(fgd_ref != objectMask), (int)(image.total() / 1000));
+    EXPECT_LE(countNonZero(fgd != fgd_ref), (int)(image.total() / 1000));
+}
+
 }} // namespace
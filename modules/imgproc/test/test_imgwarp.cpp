@@ -1556,6 +1556,82 @@ TEST(Imgproc_Warp, regression_19566)  // valgrind should detect problem if any
 }
 
 
+TEST(Imgproc_Warp, batch)
+{
+    // results are bit-exact with the generic implementation of warpAffine()/warpPerspective()
+    struct IPPGuard
+    {
+        bool useIPP;
+        IPPGuard() : useIPP(cv::ipp::useIPP()) { cv::ipp::setUseIPP(false); }
+        ~IPPGuard() { cv::ipp::setUseIPP(useIPP); }
+    } ippGuard;
+
+    RNG& rng = theRNG();
+    Mat src(480, 640, CV_8UC3);
+    rng.fill(src, RNG::UNIFORM, 0, 256);
+
+    const int n = 40;
+    std::vector<Mat> affine, persp;
+    std::vector<Size> sizes;
+    for (int i = 0; i < n; i++)
+    {
+        Point2f center((float)rng.uniform(0, src.cols), (float)rng.uniform(0, src.rows));
+        Mat A = getRotationMatrix2D(center, rng.uniform(-180., 180.), rng.uniform(0.5, 2.));
+        if (i % 2)
+            A.convertTo(A, CV_32F);
+        affine.push_back(A);
+        Mat P = Mat::eye(3, 3, CV_64F);
+        A.convertTo(P.rowRange(0, 2), CV_64F);
+        P.at<double>(2, 0) = rng.uniform(-1e-4, 1e-4);
+        P.at<double>(2, 1) = rng.uniform(-1e-4, 1e-4);
+        persp.push_back(P);
+        sizes.push_back(i == 0 ? Size(700, 300) : Size(rng.uniform(1, 160), rng.uniform(1, 160)));
+    }
+
+    const int flags[] = { INTER_LINEAR, INTER_NEAREST, INTER_CUBIC | WARP_INVERSE_MAP };
+    const int borders[] = { BORDER_CONSTANT, BORDER_REPLICATE, BORDER_REFLECT_101 };
+    for (int k = 0; k < 3; k++)
+    {
+        SCOPED_TRACE(cv::format("flags=%d border=%d", flags[k], borders[k]));
+        std::vector<Mat> dst;
+        warpAffineBatch(src, dst, affine, sizes, flags[k], borders[k], Scalar(1, 2, 3));
+        ASSERT_EQ((size_t)n, dst.size());
+        for (int i = 0; i < n; i++)
+        {
+            Mat ref;
+            warpAffine(src, ref, affine[i], sizes[i], flags[k], borders[k], Scalar(1, 2, 3));
+            EXPECT_EQ(ref.size(), dst[i].size());
+            EXPECT_EQ(0, cvtest::norm(ref, dst[i], NORM_INF)) << "affine, i=" << i;
+        }
+
+        warpPerspectiveBatch(src, dst, persp, sizes, flags[k] & ~INTER_CUBIC, borders[k]);
+        ASSERT_EQ((size_t)n, dst.size());
+        for (int i = 0; i < n; i++)
+        {
+            Mat ref;
+            warpPerspective(src, ref, persp[i], sizes[i], flags[k] & ~INTER_CUBIC, borders[k]);
+            EXPECT_EQ(0, cvtest::norm(ref, dst[i], NORM_INF)) << "perspective, i=" << i;
+        }
+    }
+
+    // one shared size; the outputs are preallocated views of a single contiguous tensor
+    Mat tensor(n*64, 64, CV_8UC3);
+    std::vector<Mat> crops(n);
+    for (int i = 0; i < n; i++)
+        crops[i] = tensor.rowRange(i*64, (i + 1)*64);
+    std::vector<Matx23d> affine2(n);
+    for (int i = 0; i < n; i++)
+        affine[i].convertTo(affine2[i], CV_64F);
+    warpAffineBatch(src, crops, affine2, std::vector<Size>(1, Size(64, 64)));
+    for (int i = 0; i < n; i++)
+    {
+        ASSERT_EQ(tensor.ptr(i*64), crops[i].data);
+        Mat ref;
+        warpAffine(src, ref, affine[i], Size(64, 64));
+        EXPECT_EQ(0, cvtest::norm(ref, crops[i], NORM_INF)) << "i=" << i;
+    }
+}
+
 TEST(Imgproc_GetAffineTransform, singularity)
 {
     Point2f A_sample[3];
@@ -402,4 +402,57 @@ TEST_F(Imgproc_LSD_Common, compareSegmentsVec4i)
     ASSERT_EQ(result2, 11);
 }
 
+TEST_F(Imgproc_LSD_Common, defaultModeRegression)
+{
+    // reference output of the default mode, the angles use fastAtan2()
+    const Vec4f ref[] = {
+        Vec4f(354.5859f, 227.0102f, 415.9826f, 273.0646f),
+        Vec4f(318.1810f, 275.3790f, 355.0630f, 227.4039f),
+        Vec4f(380.3458f, 325.6953f, 421.7323f, 272.0506f),
+        Vec4f(422.6349f, 271.2787f, 356.2228f, 221.4950f),
+        Vec4f(353.9594f, 221.2674f, 312.1588f, 275.5560f),
+        Vec4f(414.6348f, 273.6133f, 378.8057f, 320.1870f),
+        Vec4f(311.0025f, 276.3716f, 378.0061f, 326.6167f),
+        Vec4f(379.0376f, 320.6591f, 318.4521f, 275.1891f),
+    };
+    GenerateRotatedRect(test_image);
+    Ptr<LineSegmentDetector> detector = createLineSegmentDetector();
+    detector->detect(test_image, lines);
+
+    ASSERT_EQ(sizeof(ref) / sizeof(ref[0]), lines.size());
+    for (size_t i = 0; i < lines.size(); ++i)
+        EXPECT_LE(cvtest::norm(Mat(ref[i]), Mat(lines[i]), NORM_INF), 1e-3) << "i=" << i;
+}
+
+TEST_F(Imgproc_LSD_Common, tiles)
+{
+    Ptr<LineSegmentDetector> detector = createLineSegmentDetector(LSD_REFINE_ADV);
+    EXPECT_EQ(0, detector->getTileSize());
+    detector->setTileSize(64);
+    EXPECT_EQ(64, detector->getTileSize());
+
+    const int threads = getNumThreads();
+    for (int i = 0; i < EPOCHS; ++i)
+    {
+        const unsigned int numOfLines = 1;
+        GenerateLines(test_image, numOfLines);
+        detector->detect(test_image, lines);
+        if(numOfLines * 2 != lines.size()) continue;  // * 2 because of Gibbs effect
+
+        // the result doesn't depend on the number of threads
+        GenerateRotatedRect(test_image);
+        vector<Vec4f> lines_par, lines_ser;
+        vector<double> nfa_par, nfa_ser;
+        setNumThreads(4);
+        detector->detect(test_image, lines_par, noArray(), noArray(), nfa_par);
+        setNumThreads(1);
+        detector->detect(test_image, lines_ser, noArray(), noArray(), nfa_ser);
+        setNumThreads(threads);
+        if(lines_par.size() != lines_ser.size() || lines_par.size() < 2u) continue;
+        if(cvtest::norm(lines_par, lines_ser, NORM_INF) == 0 &&
+           cvtest::norm(nfa_par, nfa_ser, NORM_INF) == 0) ++passedtests;
+    }
+    ASSERT_EQ(EPOCHS, passedtests);
+}
+
 }} // namespace